@@ -46,6 +46,9 @@ LIBCMIS_C_API void libcmis_document_free( libcmis_DocumentPtr document );
 
 LIBCMIS_C_API libcmis_vector_folder_Ptr libcmis_document_getParents( libcmis_DocumentPtr document, libcmis_ErrorPtr error );
 
+/** Download the content stream by passing the data to writeFn as it arrives.
+    The download is aborted if writeFn returns less than its nmemb argument.
+  */
 LIBCMIS_C_API void libcmis_document_getContentStream(
         libcmis_DocumentPtr document,
         libcmis_writeFn writeFn,
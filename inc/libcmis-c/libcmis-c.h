@@ -42,9 +42,11 @@
 #include "libcmis-c/oauth2-data.h"
 #include "libcmis-c/rendition.h"
 #include "libcmis-c/repository.h"
+#include "libcmis-c/request-metrics.h"
 #include "libcmis-c/types.h"
 #include "libcmis-c/session.h"
 #include "libcmis-c/session-factory.h"
+#include "libcmis-c/session-statistics.h"
 #include "libcmis-c/vectors.h"
 
 #endif
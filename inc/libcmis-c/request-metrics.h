@@ -0,0 +1,64 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#ifndef _LIBCMIS_REQUEST_METRICS_H_
+#define _LIBCMIS_REQUEST_METRICS_H_
+
+#include "libcmis-c/libcmis-c-api.h"
+#include "libcmis-c/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+LIBCMIS_C_API const char* libcmis_request_metrics_getMethod( libcmis_RequestMetricsPtr metrics );
+
+/** The URL of the request without its query and fragment.
+  */
+LIBCMIS_C_API const char* libcmis_request_metrics_getUrlTemplate( libcmis_RequestMetricsPtr metrics );
+
+/** The HTTP status of the response, or 0 if none was received.
+  */
+LIBCMIS_C_API long libcmis_request_metrics_getStatus( libcmis_RequestMetricsPtr metrics );
+
+/** The times are in seconds from the start of the request.
+  */
+LIBCMIS_C_API double libcmis_request_metrics_getNameLookupTime( libcmis_RequestMetricsPtr metrics );
+LIBCMIS_C_API double libcmis_request_metrics_getConnectTime( libcmis_RequestMetricsPtr metrics );
+LIBCMIS_C_API double libcmis_request_metrics_getAppConnectTime( libcmis_RequestMetricsPtr metrics );
+LIBCMIS_C_API double libcmis_request_metrics_getStartTransferTime( libcmis_RequestMetricsPtr metrics );
+LIBCMIS_C_API double libcmis_request_metrics_getTotalTime( libcmis_RequestMetricsPtr metrics );
+
+LIBCMIS_C_API long libcmis_request_metrics_getDownloadSize( libcmis_RequestMetricsPtr metrics );
+LIBCMIS_C_API long libcmis_request_metrics_getUploadSize( libcmis_RequestMetricsPtr metrics );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
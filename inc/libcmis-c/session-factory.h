@@ -51,6 +51,25 @@ LIBCMIS_C_API const char* libcmis_getNoProxy( void );
 LIBCMIS_C_API const char* libcmis_getProxyUser( void );
 LIBCMIS_C_API const char* libcmis_getProxyPass( void );
 
+/** Choose what the sessions share through the process-wide connection
+    cache: DNS cache, TLS sessions and live connections. All of them
+    are shared by default.
+  */
+LIBCMIS_C_API void libcmis_setConnectionCacheOptions(
+        bool shareDns,
+        bool shareSslSessions,
+        bool shareConnections );
+
+/** Drop the cached DNS entries, TLS sessions and idle connections.
+  */
+LIBCMIS_C_API void libcmis_flushConnectionCache( void );
+
+/** Set the function called with the timings and sizes of every HTTP request
+    sent by the sessions, or NULL to stop collecting them. The function may
+    be called from other threads than the one sending the requests.
+  */
+LIBCMIS_C_API void libcmis_setRequestMetricsCallback( libcmis_requestMetricsCallback callback );
+
 LIBCMIS_C_API libcmis_SessionPtr libcmis_createSession(
         char* bindingUrl,
         char* repositoryId,
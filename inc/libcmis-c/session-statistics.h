@@ -0,0 +1,97 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#ifndef _LIBCMIS_SESSION_STATISTICS_H_
+#define _LIBCMIS_SESSION_STATISTICS_H_
+
+#include "libcmis-c/libcmis-c-api.h"
+#include "libcmis-c/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+LIBCMIS_C_API void libcmis_session_statistics_free( libcmis_SessionStatisticsPtr statistics );
+
+/** Number of HTTP requests sent with a method, like "GET".
+  */
+LIBCMIS_C_API long libcmis_session_statistics_getRequests(
+        libcmis_SessionStatisticsPtr statistics,
+        const char* method );
+
+LIBCMIS_C_API long libcmis_session_statistics_getRequestsCount( libcmis_SessionStatisticsPtr statistics );
+
+/** Number of HTTP responses by status class: 2 for the 2xx statuses,
+    etc. 0 counts the requests which got no response.
+  */
+LIBCMIS_C_API long libcmis_session_statistics_getResponses(
+        libcmis_SessionStatisticsPtr statistics,
+        int statusClass );
+
+LIBCMIS_C_API long libcmis_session_statistics_getBytesReceived( libcmis_SessionStatisticsPtr statistics );
+LIBCMIS_C_API long libcmis_session_statistics_getBytesSent( libcmis_SessionStatisticsPtr statistics );
+LIBCMIS_C_API long libcmis_session_statistics_getRetries( libcmis_SessionStatisticsPtr statistics );
+LIBCMIS_C_API long libcmis_session_statistics_getTokenRefreshes( libcmis_SessionStatisticsPtr statistics );
+
+LIBCMIS_C_API long libcmis_session_statistics_getObjectCacheHits( libcmis_SessionStatisticsPtr statistics );
+LIBCMIS_C_API long libcmis_session_statistics_getObjectCacheMisses( libcmis_SessionStatisticsPtr statistics );
+LIBCMIS_C_API long libcmis_session_statistics_getTypeCacheHits( libcmis_SessionStatisticsPtr statistics );
+LIBCMIS_C_API long libcmis_session_statistics_getTypeCacheMisses( libcmis_SessionStatisticsPtr statistics );
+LIBCMIS_C_API long libcmis_session_statistics_getPathCacheHits( libcmis_SessionStatisticsPtr statistics );
+LIBCMIS_C_API long libcmis_session_statistics_getPathCacheMisses( libcmis_SessionStatisticsPtr statistics );
+
+/** Names of the operations and HTTP requests with latencies, like
+    "Folder::getChildren" or "HTTP GET".
+  */
+LIBCMIS_C_API libcmis_vector_string_Ptr libcmis_session_statistics_getLatencyNames(
+        libcmis_SessionStatisticsPtr statistics );
+
+LIBCMIS_C_API long libcmis_session_statistics_getLatencyCount(
+        libcmis_SessionStatisticsPtr statistics,
+        const char* name );
+
+/** The latencies are in milliseconds, 0 for unknown names.
+  */
+LIBCMIS_C_API double libcmis_session_statistics_getLatencyMean(
+        libcmis_SessionStatisticsPtr statistics,
+        const char* name );
+
+LIBCMIS_C_API double libcmis_session_statistics_getLatencyMaximum(
+        libcmis_SessionStatisticsPtr statistics,
+        const char* name );
+
+LIBCMIS_C_API double libcmis_session_statistics_getLatencyPercentile(
+        libcmis_SessionStatisticsPtr statistics,
+        const char* name,
+        double percentile );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
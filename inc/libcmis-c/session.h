@@ -76,6 +76,14 @@ LIBCMIS_C_API libcmis_vector_object_type_Ptr libcmis_session_getBaseTypes(
         libcmis_SessionPtr session,
         libcmis_ErrorPtr error );
 
+/** Get a snapshot of the counters of the session, to free with
+    libcmis_session_statistics_free( ).
+  */
+LIBCMIS_C_API libcmis_SessionStatisticsPtr libcmis_session_getStatistics(
+        libcmis_SessionPtr session );
+
+LIBCMIS_C_API void libcmis_session_resetStatistics( libcmis_SessionPtr session );
+
 #ifdef __cplusplus
 }
 #endif
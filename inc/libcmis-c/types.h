@@ -221,6 +221,22 @@ typedef char* ( *libcmis_OAuth2AuthCodeProvider )( const char* authUrl,
 typedef struct libcmis_rendition* libcmis_RenditionPtr;
 typedef struct libcmis_vector_rendition* libcmis_vector_rendition_Ptr;
 
+
+/* RequestMetrics */
+
+
+typedef struct libcmis_request_metrics* libcmis_RequestMetricsPtr;
+
+/** The metrics are only valid during the call.
+  */
+typedef void ( *libcmis_requestMetricsCallback )( libcmis_RequestMetricsPtr metrics );
+
+
+/* SessionStatistics */
+
+
+typedef struct libcmis_session_statistics* libcmis_SessionStatisticsPtr;
+
 #ifdef __cplusplus
 }
 #endif
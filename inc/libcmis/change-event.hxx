@@ -0,0 +1,121 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _CHANGE_EVENT_HXX_
+#define _CHANGE_EVENT_HXX_
+
+#include <string>
+#include <vector>
+
+#include <boost/date_time.hpp>
+#include <boost/shared_ptr.hpp>
+#include <libxml/tree.h>
+
+#include "libcmis/libcmis-api.h"
+
+namespace libcmis
+{
+    struct LIBCMIS_API ChangeType {
+        enum Type
+        {
+            Created,
+            Updated,
+            Deleted,
+            Security
+        };
+    };
+
+    /** Entry of the repository change log.
+
+        \sa 2.2.6.2 section of the CMIS specifications
+      */
+    class LIBCMIS_API ChangeEvent
+    {
+        private:
+            std::string m_objectId;
+            ChangeType::Type m_changeType;
+            boost::posix_time::ptime m_changeTime;
+
+        public:
+            ChangeEvent( std::string objectId, ChangeType::Type changeType,
+                         boost::posix_time::ptime changeTime = boost::posix_time::ptime( ) );
+
+            /** Parse an object XML node containing a cmis:changeEventInfo
+                element next to the cmis:properties.
+              */
+            ChangeEvent( xmlNodePtr node );
+            ~ChangeEvent( );
+
+            const std::string& getObjectId( ) const;
+            ChangeType::Type getChangeType( ) const;
+
+            /** Provides the time of the change, or a not_a_date_time value
+                if the server didn't send it.
+              */
+            boost::posix_time::ptime getChangeTime( ) const;
+
+            std::string toString( ) const;
+
+            /** Parses the CMIS enumTypeOfChanges value, or throws
+                an exception for unknown values.
+              */
+            static ChangeType::Type parseChangeType( std::string value );
+    };
+
+    typedef boost::shared_ptr< ChangeEvent > ChangeEventPtr;
+
+    /** Page of the repository change log as returned by
+        Session::getContentChanges( ).
+      */
+    class LIBCMIS_API ContentChanges
+    {
+        private:
+            std::vector< ChangeEventPtr > m_events;
+            std::string m_changeLogToken;
+            bool m_hasMoreItems;
+
+        public:
+            ContentChanges( );
+            ContentChanges( const std::vector< ChangeEventPtr >& events,
+                            std::string changeLogToken, bool hasMoreItems );
+            ~ContentChanges( );
+
+            const std::vector< ChangeEventPtr >& getEvents( ) const;
+
+            /** Token to give to the next Session::getContentChanges( ) call
+                to get the changes following these ones.
+              */
+            const std::string& getChangeLogToken( ) const;
+
+            /** Tells whether more changes are immediately available with
+                the next token.
+              */
+            bool hasMoreItems( ) const;
+    };
+}
+
+#endif
@@ -40,6 +40,7 @@
 
 namespace libcmis
 {
+    class EncodedData;
     class Folder;
     class Session;
 
@@ -76,6 +77,25 @@ namespace libcmis
             virtual boost::shared_ptr< std::istream > getContentStream( std::string streamId = std::string( ) ) 
                         = 0;
 
+            /** Download the content stream straight to the sink as the data
+                arrives, without ever holding the whole content in memory.
+                Use this rather than getContentStream( ) for big documents.
+
+                <p>The default implementation copies the stream returned by
+                getContentStream( ) for the bindings that can't do better.</p>
+
+                @param sink receives the content, it can write to a FILE*, an
+                       std::ostream or a function.
+                @param streamId of the rendition
+
+                @throws Exception
+                    if anything wrong happened during the file transfer or
+                    if the sink failed to write the data. In such a case, the
+                    sink may have received only a part of the content.
+              */
+            virtual void downloadContentStream( boost::shared_ptr< EncodedData > sink,
+                                                std::string streamId = std::string( ) );
+
             /** Set or replace the content stream of the document.
 
                 @param is the output stream containing the new data for the content stream
@@ -35,6 +35,9 @@
 #include "libcmis/exception.hxx"
 #include "libcmis/libcmis-api.h"
 #include "libcmis/object.hxx"
+#include "libcmis/object-iterator.hxx"
+#include "libcmis/object-tree.hxx"
+#include "libcmis/operation-context.hxx"
 
 namespace libcmis
 {
@@ -60,7 +63,48 @@ namespace libcmis
             virtual std::vector< std::string > getPaths( );
 
             virtual boost::shared_ptr< Folder > getFolderParent( );
-            virtual std::vector< ObjectPtr > getChildren( ) = 0;
+            virtual std::vector< ObjectPtr > getChildren( const OperationContext& context = OperationContext( ) ) = 0;
+
+            /** Iterate over the children, requesting them page by page
+                when needed.
+
+                \param pageSize
+                    the maximum number of children to request at once, or
+                    0 to let the server decide.
+                \param readAhead
+                    the number of pages to request in the background
+                    while the current one is consumed. Only the AtomPub
+                    binding supports it for now, the others ignore it.
+                \param context
+                    tells which properties and extra data the server should
+                    send with the children.
+              */
+            virtual ObjectIteratorPtr listChildren( long pageSize = 0, long readAhead = 0,
+                                                    const OperationContext& context = OperationContext( ) );
+
+            /** Get the objects below the folder down to the given depth.
+
+                The bindings having a descendants service get the whole
+                tree in one request, the others request the children of
+                all the folders of a level at once.
+
+                \param depth
+                    the number of levels to fetch or -1 for all of them.
+                \param context
+                    tells which properties and extra data the server should
+                    send with the objects.
+
+                \throw Exception if depth is 0 or lower than -1.
+              */
+            std::vector< ObjectTreePtr > getDescendants( int depth = -1,
+                                                         const OperationContext& context = OperationContext( ) );
+
+            /** Get the folders below the folder down to the given depth,
+                like getDescendants( ) without the documents.
+              */
+            std::vector< ObjectTreePtr > getFolderTree( int depth = -1,
+                                                        const OperationContext& context = OperationContext( ) );
+
             virtual std::string getParentId( );
             virtual std::string getPath( );
 
@@ -75,6 +119,14 @@ namespace libcmis
                                     bool continueOnError = false ) = 0;
         
             virtual std::string toString( );
+
+        protected:
+            /** Get the tree below the folder for getDescendants( ) and
+                getFolderTree( ), depth being already checked. The default
+                implementation requests the children of each folder in turn.
+              */
+            virtual std::vector< ObjectTreePtr > getTree( int depth, bool foldersOnly,
+                                                          const OperationContext& context );
     };
     typedef boost::shared_ptr< Folder > FolderPtr;
 
@@ -31,18 +31,25 @@
 #include "libcmis/libcmis-api.h"
 
 #include "libcmis/allowable-actions.hxx"
+#include "libcmis/change-event.hxx"
 #include "libcmis/document.hxx"
 #include "libcmis/exception.hxx"
 #include "libcmis/folder.hxx"
 #include "libcmis/oauth2-data.hxx"
+#include "libcmis/object-iterator.hxx"
+#include "libcmis/object-tree.hxx"
 #include "libcmis/object-type.hxx"
 #include "libcmis/object.hxx"
+#include "libcmis/operation-context.hxx"
 #include "libcmis/property-type.hxx"
 #include "libcmis/property.hxx"
 #include "libcmis/rendition.hxx"
 #include "libcmis/repository.hxx"
+#include "libcmis/request-metrics.hxx"
 #include "libcmis/session-factory.hxx"
+#include "libcmis/session-statistics.hxx"
 #include "libcmis/session.hxx"
+#include "libcmis/trace.hxx"
 #include "libcmis/xml-utils.hxx"
 #include "libcmis/xmlserializable.hxx"
 
@@ -0,0 +1,124 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _OBJECT_ITERATOR_HXX_
+#define _OBJECT_ITERATOR_HXX_
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "libcmis/exception.hxx"
+#include "libcmis/libcmis-api.h"
+#include "libcmis/object.hxx"
+
+namespace libcmis
+{
+    /** Lazy iterator over a list of objects the server returns in pages.
+
+        A page is only requested when the objects already fetched have
+        all been consumed: the time to get the first object and the
+        memory used don't depend on the total number of objects.
+      */
+    class LIBCMIS_API ObjectIterator
+    {
+        private:
+            std::vector< ObjectPtr > m_page;
+            size_t m_position;
+            bool m_started;
+            bool m_hasMoreItems;
+            long m_numItems;
+
+            /** Fetch pages until there is something to read or nothing
+                more on the server.
+              */
+            void fillPage( );
+
+        protected:
+            ObjectIterator( );
+
+            /** Fetch the next page from the server.
+
+                Implementations need to call setHasMoreItems( ) to tell
+                if there are pages after this one, and setNumItems( )
+                if the server provides the total number of objects.
+              */
+            virtual std::vector< ObjectPtr > fetchNextPage( ) = 0;
+
+            void setHasMoreItems( bool hasMoreItems ) { m_hasMoreItems = hasMoreItems; }
+            void setNumItems( long numItems ) { m_numItems = numItems; }
+
+        public:
+            virtual ~ObjectIterator( ) { }
+
+            /** Tells whether next( ) will return an object. This may
+                request the next page to the server.
+              */
+            bool hasNext( );
+
+            /** Get the next object, requesting the next page if needed.
+
+                \throw Exception if there are no more objects.
+              */
+            ObjectPtr next( );
+
+            /** Get all the objects not consumed yet in the current page,
+                or the whole next page if the current one is consumed.
+
+                \return the objects or an empty vector at the end.
+              */
+            std::vector< ObjectPtr > nextPage( );
+
+            /** Tells whether the server has more objects than the ones
+                already fetched.
+              */
+            bool hasMoreItems( );
+
+            /** Provides the total number of objects or a negative
+                value if the server doesn't say.
+              */
+            long getNumItems( );
+    };
+    typedef boost::shared_ptr< ObjectIterator > ObjectIteratorPtr;
+
+    /** Iterator over objects that are all already known.
+      */
+    class LIBCMIS_API ObjectListIterator : public ObjectIterator
+    {
+        private:
+            std::vector< ObjectPtr > m_objects;
+
+        public:
+            ObjectListIterator( const std::vector< ObjectPtr >& objects );
+            virtual ~ObjectListIterator( ) { }
+
+        protected:
+            virtual std::vector< ObjectPtr > fetchNextPage( );
+    };
+}
+
+#endif
@@ -0,0 +1,66 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _OBJECT_TREE_HXX_
+#define _OBJECT_TREE_HXX_
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "libcmis/libcmis-api.h"
+#include "libcmis/object.hxx"
+
+namespace libcmis
+{
+    class ObjectTree;
+    typedef boost::shared_ptr< ObjectTree > ObjectTreePtr;
+
+    /** Node of a tree of objects as returned by Folder::getDescendants( )
+        and Folder::getFolderTree( ).
+
+        The children of the nodes at the requested depth are not fetched:
+        their children vector is empty even if they have some.
+      */
+    class LIBCMIS_API ObjectTree
+    {
+        private:
+            ObjectPtr m_object;
+            std::vector< ObjectTreePtr > m_children;
+
+        public:
+            ObjectTree( ObjectPtr object );
+            ~ObjectTree( );
+
+            ObjectPtr getObject( ) const;
+            const std::vector< ObjectTreePtr >& getChildren( ) const;
+
+            void addChild( ObjectTreePtr child );
+    };
+}
+
+#endif
@@ -0,0 +1,104 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _OPERATION_CONTEXT_HXX_
+#define _OPERATION_CONTEXT_HXX_
+
+#include <string>
+#include <vector>
+
+#include "libcmis/libcmis-api.h"
+
+namespace libcmis
+{
+    struct LIBCMIS_API IncludeRelationships {
+        enum Type
+        {
+            None,
+            Source,
+            Target,
+            Both
+        };
+    };
+
+    /** Options telling the server what to send back with the objects.
+
+        The default values request all the properties and the allowable
+        actions, like when no context is provided. Asking only for the
+        needed properties reduces the size of the responses.
+      */
+    class LIBCMIS_API OperationContext
+    {
+        private:
+            std::vector< std::string > m_propertyFilter;
+            bool m_includeAllowableActions;
+            std::string m_renditionFilter;
+            IncludeRelationships::Type m_includeRelationships;
+
+        public:
+            OperationContext( );
+
+            /** Only request the properties with these ids. The ones
+                libcmis needs to create the objects are always requested.
+                An empty filter, the default, requests all the properties.
+              */
+            void setPropertyFilter( const std::vector< std::string >& propertyIds );
+            const std::vector< std::string >& getPropertyFilter( ) const;
+
+            bool isPropertyFilterSet( ) const;
+
+            /** Provides the value of the CMIS filter parameter: the
+                comma-separated list of the filtered properties, including
+                cmis:objectId, cmis:objectTypeId and cmis:baseTypeId, or "*"
+                if no filter is set.
+              */
+            std::string getFilter( ) const;
+
+            void setIncludeAllowableActions( bool include );
+            bool isIncludeAllowableActions( ) const;
+
+            /** Set the CMIS rendition filter, like "cmis:thumbnail" or "*".
+                An empty value, the default, keeps the binding's default.
+              */
+            void setRenditionFilter( const std::string& filter );
+            const std::string& getRenditionFilter( ) const;
+
+            void setIncludeRelationships( IncludeRelationships::Type include );
+            IncludeRelationships::Type getIncludeRelationships( ) const;
+
+            /** Provides the CMIS value of includeRelationships: none,
+                source, target or both.
+              */
+            std::string getIncludeRelationshipsString( ) const;
+
+            /** Tells whether all the options have their default values.
+              */
+            bool isDefault( ) const;
+    };
+}
+
+#endif
@@ -0,0 +1,117 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _REQUEST_METRICS_HXX_
+#define _REQUEST_METRICS_HXX_
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include "libcmis/libcmis-api.h"
+
+namespace libcmis
+{
+    /** Timings and sizes of one HTTP request sent by a session.
+
+        The times are in seconds from the start of the request and each
+        of them includes the previous ones: the connect time includes the
+        name lookup, the first byte time includes the TLS handshake, etc.
+        A step that didn't happen, like the TLS handshake over plain HTTP
+        or the name lookup on a reused connection, is reported as 0.
+      */
+    class LIBCMIS_API RequestMetrics
+    {
+        private:
+            RequestMetrics( );
+
+            std::string m_method;
+            std::string m_urlTemplate;
+            long m_status;
+            double m_nameLookupTime;
+            double m_connectTime;
+            double m_appConnectTime;
+            double m_startTransferTime;
+            double m_totalTime;
+            long m_downloadSize;
+            long m_uploadSize;
+
+        public:
+            RequestMetrics( std::string method, std::string urlTemplate, long status,
+                            double nameLookupTime, double connectTime,
+                            double appConnectTime, double startTransferTime,
+                            double totalTime, long downloadSize, long uploadSize );
+            ~RequestMetrics( );
+
+            const std::string& getMethod( ) const { return m_method; }
+
+            /** The URL of the request without its query and fragment, to
+                group the requests by endpoint without the object ids and
+                tokens that can be found in the parameters.
+              */
+            const std::string& getUrlTemplate( ) const { return m_urlTemplate; }
+
+            /** The HTTP status of the response, or 0 if none was received.
+              */
+            long getStatus( ) const { return m_status; }
+
+            double getNameLookupTime( ) const { return m_nameLookupTime; }
+            double getConnectTime( ) const { return m_connectTime; }
+
+            /** Time until the end of the TLS handshake.
+              */
+            double getAppConnectTime( ) const { return m_appConnectTime; }
+
+            /** Time until the first byte of the response.
+              */
+            double getStartTransferTime( ) const { return m_startTransferTime; }
+            double getTotalTime( ) const { return m_totalTime; }
+
+            /** Number of bytes of the response body, before any decompression.
+              */
+            long getDownloadSize( ) const { return m_downloadSize; }
+            long getUploadSize( ) const { return m_uploadSize; }
+    };
+
+    /** Observer notified by all the sessions after each HTTP request.
+
+        It is called from the thread running the request, which isn't the
+        calling thread for the asynchronous requests: the implementations
+        need to be thread-safe and quick, as the request or the next ones
+        wait for them. The exceptions they throw are ignored.
+      */
+    class LIBCMIS_API RequestObserver
+    {
+        public:
+            virtual ~RequestObserver( ) { };
+
+            virtual void requestDone( const RequestMetrics& metrics ) = 0;
+    };
+    typedef boost::shared_ptr< RequestObserver > RequestObserverPtr;
+}
+
+#endif
@@ -36,7 +36,9 @@
 #include "libcmis/libcmis-api.h"
 #include "libcmis/oauth2-data.hxx"
 #include "libcmis/repository.hxx"
+#include "libcmis/request-metrics.hxx"
 #include "libcmis/session.hxx"
+#include "libcmis/trace.hxx"
 
 // needed for a callback type
 typedef void CURL;
@@ -126,6 +128,67 @@ namespace libcmis
             static const std::string& getProxyUser() { return s_proxyUser; }
             static const std::string& getProxyPass() { return s_proxyPass; }
 
+            /** Configure the process-wide connection cache used by all the sessions.
+
+                By default the sessions share the DNS cache, the TLS session cache
+                and the live connections, so that creating a new session to an
+                already known host doesn't cost a DNS lookup, a TCP connect and a
+                TLS handshake. Disabling all three makes each session use its own
+                connection again.
+
+                Changing the options starts a new, empty cache, as if
+                flushConnectionCache() had been called.
+              */
+            static void setConnectionCacheOptions( bool shareDns,
+                    bool shareSslSessions,
+                    bool shareConnections );
+
+            /** Drop the cached DNS entries, TLS sessions and idle connections.
+
+                The sessions switch to a new, empty cache on their next request.
+                The old cache is released once no session uses it anymore.
+              */
+            static void flushConnectionCache( );
+
+            /** Adapt the number of requests all the sessions send at the same
+                time to each host.
+
+                The limit of a host starts at initialLimit and grows while the
+                latency stays flat. It is cut when the server throttles the
+                requests with a 429 or 503 status or when the latency rises.
+                The requests past the limit wait for the running ones.
+
+                \param initialLimit
+                    the number of requests allowed at first for a new host.
+                \param maxLimit
+                    the highest limit of a host. 0, the default, disables
+                    the limits.
+              */
+            static void setConcurrencyLimits( unsigned int initialLimit, unsigned int maxLimit );
+
+            /** Get the current limit of requests at the same time to a host,
+                given as host[:port] or as a URL, or 0 if there is none.
+              */
+            static unsigned int getConcurrencyLimit( const std::string& host );
+
+            /** Get the number of requests waiting for the limit of a host.
+              */
+            static unsigned int getQueuedRequests( const std::string& host );
+
+            /** Set the observer receiving the timings and sizes of every HTTP
+                request sent by the sessions, or an empty pointer to stop
+                collecting them.
+              */
+            static void setRequestObserver( const RequestObserverPtr& observer );
+            static RequestObserverPtr getRequestObserver( );
+
+            /** Set the exporter receiving a span for each operation of the
+                sessions and of their objects, with the HTTP requests it sent,
+                or an empty pointer to stop tracing.
+              */
+            static void setTraceExporter( const TraceExporterPtr& exporter );
+            static TraceExporterPtr getTraceExporter( );
+
             /** Create a session from the given parameters. The binding type is automatically
                 detected based on the provided URL.
 
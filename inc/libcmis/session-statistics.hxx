@@ -0,0 +1,161 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _SESSION_STATISTICS_HXX_
+#define _SESSION_STATISTICS_HXX_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "libcmis/libcmis-api.h"
+
+namespace libcmis
+{
+    /** Distribution of durations with a fixed relative precision, like
+        the HDR histograms.
+
+        The durations are counted in microseconds, exactly below 8µs and
+        then in 8 buckets per power of two, so that each bucket is at
+        most 12.5% wide whatever the scale.
+      */
+    class LIBCMIS_API LatencyHistogram
+    {
+        private:
+            std::vector< long > m_counts;
+            long m_count;
+            long m_minimum;
+            long m_maximum;
+            double m_sum;
+
+        public:
+            LatencyHistogram( );
+            LatencyHistogram( std::vector< long > counts, long minimum, long maximum, double sum );
+            ~LatencyHistogram( );
+
+            long getCount( ) const { return m_count; }
+
+            /** The durations are all in milliseconds, 0 when nothing
+                was counted.
+              */
+            double getMinimum( ) const;
+            double getMaximum( ) const;
+            double getMean( ) const;
+
+            /** The duration under which the given percentage of the
+                values are, at the precision of the buckets.
+              */
+            double getPercentile( double percentile ) const;
+
+            /** The number of values counted in each bucket.
+              */
+            const std::vector< long >& getCounts( ) const { return m_counts; }
+
+            static size_t getBucketsCount( );
+
+            /** Get the bucket of a duration in microseconds.
+              */
+            static size_t getBucket( long microseconds );
+
+            /** Get the lowest duration in microseconds counted in a bucket.
+              */
+            static long getBucketLowerBound( size_t bucket );
+    };
+
+    /** Snapshot of the counters of a session since its creation or
+        since they were last reset.
+      */
+    class LIBCMIS_API SessionStatistics
+    {
+        private:
+            std::map< std::string, long > m_requestsByMethod;
+            std::vector< long > m_responsesByClass;
+            long m_bytesReceived;
+            long m_bytesSent;
+            long m_retries;
+            long m_tokenRefreshes;
+            long m_objectCacheHits;
+            long m_objectCacheMisses;
+            long m_typeCacheHits;
+            long m_typeCacheMisses;
+            long m_pathCacheHits;
+            long m_pathCacheMisses;
+            std::map< std::string, LatencyHistogram > m_latencies;
+
+        public:
+            SessionStatistics( );
+            ~SessionStatistics( );
+
+            /** Number of HTTP requests sent, by method.
+              */
+            const std::map< std::string, long >& getRequestsByMethod( ) const { return m_requestsByMethod; }
+            long getRequests( const std::string& method ) const;
+            long getRequestsCount( ) const;
+
+            /** Number of HTTP responses by status class: 2 for the 2xx
+                statuses, etc. 0 counts the requests which got no response.
+              */
+            long getResponses( int statusClass ) const;
+
+            /** Bytes of the response and request bodies, as transferred.
+              */
+            long getBytesReceived( ) const { return m_bytesReceived; }
+            long getBytesSent( ) const { return m_bytesSent; }
+
+            /** Number of requests sent again because they were throttled.
+              */
+            long getRetries( ) const { return m_retries; }
+            long getTokenRefreshes( ) const { return m_tokenRefreshes; }
+
+            /** Lookups in the caches of the session, only counted when the
+                cache is enabled.
+              */
+            long getObjectCacheHits( ) const { return m_objectCacheHits; }
+            long getObjectCacheMisses( ) const { return m_objectCacheMisses; }
+            long getTypeCacheHits( ) const { return m_typeCacheHits; }
+            long getTypeCacheMisses( ) const { return m_typeCacheMisses; }
+            long getPathCacheHits( ) const { return m_pathCacheHits; }
+            long getPathCacheMisses( ) const { return m_pathCacheMisses; }
+
+            /** Durations of the operations, named like Folder::getChildren,
+                and of the HTTP requests, named like HTTP GET.
+              */
+            const std::map< std::string, LatencyHistogram >& getLatencies( ) const { return m_latencies; }
+
+            void addRequests( const std::string& method, long count );
+            void addResponses( int statusClass, long count );
+            void setBytes( long received, long sent );
+            void setRetries( long retries ) { m_retries = retries; }
+            void setTokenRefreshes( long refreshes ) { m_tokenRefreshes = refreshes; }
+            void setObjectCache( long hits, long misses );
+            void setTypeCache( long hits, long misses );
+            void setPathCache( long hits, long misses );
+            void setLatency( const std::string& name, const LatencyHistogram& histogram );
+    };
+}
+
+#endif
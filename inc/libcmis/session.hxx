@@ -33,10 +33,13 @@
 #include <boost/shared_ptr.hpp>
 
 #include "libcmis/libcmis-api.h"
+#include "libcmis/change-event.hxx"
 #include "libcmis/object-type.hxx"
 #include "libcmis/object.hxx"
 #include "libcmis/folder.hxx"
+#include "libcmis/operation-context.hxx"
 #include "libcmis/repository.hxx"
+#include "libcmis/session-statistics.hxx"
 
 namespace libcmis
 {
@@ -65,12 +68,18 @@ namespace libcmis
             virtual FolderPtr getRootFolder()= 0;
             
             /** Get a CMIS object from its ID.
+
+                \param context
+                    tells which properties and extra data the server should
+                    send with the object.
               */
-            virtual ObjectPtr getObject( std::string id ) = 0;
+            virtual ObjectPtr getObject( std::string id,
+                                         const OperationContext& context = OperationContext( ) ) = 0;
 
             /** Get a CMIS object from one of its path.
               */
-            virtual ObjectPtr getObjectByPath( std::string path ) = 0;
+            virtual ObjectPtr getObjectByPath( std::string path,
+                                               const OperationContext& context = OperationContext( ) ) = 0;
 
             /** Get a CMIS folder from its ID.
               */
@@ -84,6 +93,146 @@ namespace libcmis
               */
             virtual std::vector< ObjectTypePtr > getBaseTypes( ) = 0;
 
+            /** Run a CMIS query on the server.
+
+                The results are requested page by page while they are
+                consumed. Only the rows with a cmis:baseTypeId value become
+                objects: the statement needs to select it, SELECT * does.
+
+                \param statement
+                    the CMIS SQL query statement.
+                \param searchAllVersions
+                    whether to search in the non-latest versions of the
+                    documents too.
+                \param maxItems
+                    the maximum number of results to request at once, or 0
+                    to let the server decide.
+                \param context
+                    tells which extra data the server should send with the
+                    results.
+
+                \throw Exception if the binding doesn't support queries.
+              */
+            virtual ObjectIteratorPtr query( std::string /*statement*/, bool /*searchAllVersions*/ = false,
+                                             long /*maxItems*/ = 0,
+                                             const OperationContext& /*context*/ = OperationContext( ) )
+            {
+                throw Exception( "Query isn't supported by this binding", "notSupported" );
+            };
+
+            /** Get the changes made in the repository since a point of its
+                change log.
+
+                \param changeLogToken
+                    the token returned by a previous call, or an empty string
+                    to start from the oldest change the server provides.
+                    Google Drive keeps no history: it only gives the
+                    token of the current state for an empty token.
+                \param maxItems
+                    the maximum number of changes to get at once, or 0
+                    to let the server decide.
+
+                \throw Exception if the binding doesn't support change tracking.
+              */
+            virtual ContentChanges getContentChanges( std::string /*changeLogToken*/ = std::string( ),
+                                                      long /*maxItems*/ = 0 )
+            {
+                throw Exception( "Change log isn't supported by this binding", "notSupported" );
+            };
+
+            /** Set how long, in seconds, the type definitions returned by
+                getType( ) are reused before asking the server again.
+
+                Objects of the same type share the cached definition. 0
+                disables the cache and a negative value, the default, keeps
+                the definitions until they are invalidated.
+              */
+            virtual void setTypeCacheTtl( long /*seconds*/ ) { };
+
+            /** Forget the cached definition of a type, for example after
+                changing it on the server.
+              */
+            virtual void invalidateType( std::string /*id*/ ) { };
+
+            /** Forget all the cached type definitions.
+              */
+            virtual void invalidateTypes( ) { };
+
+            /** Parse the objects properties only from the data sent by the
+                server, without fetching their type definition first.
+
+                The properties get temporary definitions built from the
+                property elements. They are completed when the object type
+                definition is actually needed: getTypeDescription( ) is
+                called or an update requires it. Listing objects then costs
+                no additional request.
+              */
+            virtual void setLazyTypeResolution( bool /*lazy*/ ) { };
+
+            virtual bool isLazyTypeResolution( ) { return false; };
+
+            /** Keep the objects returned by getObject( ) to give them back
+                without asking the server, the same instance for a given id.
+
+                Only the objects requested without operation context are
+                cached. The changes made through libcmis drop the affected
+                entries, but the changes made by other clients are only seen
+                once the entries expired.
+
+                \param maxObjects
+                    the maximum number of cached objects, the least recently
+                    used ones are dropped first. 0, the default, disables
+                    the cache.
+                \param ttl
+                    how long, in seconds, the objects are reused. Past that,
+                    they are refreshed, with a conditional request when the
+                    binding supports it. A negative value keeps them until
+                    they are dropped.
+                \param maxBytes
+                    the approximate memory the cached objects can use, 0 for
+                    no limit.
+              */
+            virtual void setObjectCache( size_t /*maxObjects*/, long /*ttl*/ = -1, size_t /*maxBytes*/ = 0 ) { };
+
+            /** Set how long, in seconds, the ids of the objects found by
+                getObjectByPath( ) are reused to resolve the same paths or
+                the paths below them.
+
+                Only the bindings resolving the paths one segment at a time,
+                Google Drive and OneDrive, use it. 0, the default, disables
+                the cache and a negative value keeps the ids until they are
+                invalidated. Renaming, moving or deleting an object through
+                libcmis drops its paths.
+              */
+            virtual void setPathCacheTtl( long /*seconds*/ ) { };
+
+            /** Forget the cached object with the given id and its paths.
+              */
+            virtual void invalidateObject( std::string /*id*/ ) { };
+
+            /** Forget all the cached objects and paths.
+              */
+            virtual void invalidateObjects( ) { };
+
+            /** Number of getObject( ) calls answered from the object cache.
+              */
+            virtual long getObjectCacheHits( ) { return 0; };
+
+            /** Number of getObject( ) calls that needed to ask the server
+                while the object cache is enabled.
+              */
+            virtual long getObjectCacheMisses( ) { return 0; };
+
+            /** Get a snapshot of the counters of the session: requests,
+                bytes, retries, token refreshes, cache hits and misses and
+                the latencies of the operations and HTTP requests.
+              */
+            virtual SessionStatistics getStatistics( ) { return SessionStatistics( ); };
+
+            /** Set all the counters and latency histograms back to 0.
+              */
+            virtual void resetStatistics( ) { };
+
             /** Enable or disable the SSL certificate verification.
 
                 By default, SSL certificates are verified and errors are thrown in case of
@@ -96,6 +245,38 @@ namespace libcmis
               */
             virtual void setNoSSLCertificateCheck( bool noCheck ) = 0;
 
+            /** Let the server compress the responses like the feeds, WSDL
+                documents or JSON metadata: they are decoded transparently.
+
+                The content streams are always downloaded as they are. This
+                is enabled by default.
+              */
+            virtual void setCompressedResponses( bool /*compress*/ ) { };
+
+            /** Retry the requests the server throttled with a 429 or 503
+                status, like Google Drive or Microsoft Graph do when the
+                rate limits are reached.
+
+                Only the idempotent requests, like GET, PUT or DELETE, are
+                retried after waiting for the delay of the Retry-After header
+                or an exponential backoff with jitter.
+
+                \param maxRetries
+                    the number of times a request is retried. 0, the
+                    default, disables the retries.
+                \param initialDelay
+                    the backoff delay in milliseconds before the first retry,
+                    doubled for each following one.
+                \param maxDelay
+                    the longest delay in milliseconds: a request isn't retried
+                    if the server asks to wait longer.
+                \param retriesPerMinute
+                    the number of retries the whole session can do per
+                    minute, negative for no limit.
+              */
+            virtual void setRetryPolicy( unsigned int /*maxRetries*/, long /*initialDelay*/ = 500,
+                                         long /*maxDelay*/ = 30000, long /*retriesPerMinute*/ = -1 ) { };
+
             virtual std::string getRefreshToken() { return ""; };
     };
 }
@@ -0,0 +1,146 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _TRACE_HXX_
+#define _TRACE_HXX_
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/date_time.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "libcmis/libcmis-api.h"
+#include "libcmis/request-metrics.hxx"
+
+namespace libcmis
+{
+    /** Span of a public Session, Object, Folder or Document operation, with
+        the HTTP requests it sent.
+
+        The operations called by another one get their own span, pointing
+        to the calling one with their parent id: all the spans of a call
+        to the API share the id of the outermost one as trace id.
+      */
+    class LIBCMIS_API TraceSpan
+    {
+        private:
+            TraceSpan( );
+
+            unsigned long m_traceId;
+            unsigned long m_id;
+            unsigned long m_parentId;
+            std::string m_name;
+            boost::posix_time::ptime m_startTime;
+            double m_duration;
+            bool m_failed;
+            std::vector< RequestMetrics > m_requests;
+
+        public:
+            TraceSpan( unsigned long traceId, unsigned long id, unsigned long parentId,
+                       std::string name, boost::posix_time::ptime startTime );
+            ~TraceSpan( );
+
+            unsigned long getTraceId( ) const { return m_traceId; }
+            unsigned long getId( ) const { return m_id; }
+
+            /** The id of the span of the calling operation, or 0 for
+                the outermost one.
+              */
+            unsigned long getParentId( ) const { return m_parentId; }
+
+            /** The name of the operation, like Folder::getChildren.
+              */
+            const std::string& getName( ) const { return m_name; }
+
+            /** UTC time of the start of the operation.
+              */
+            boost::posix_time::ptime getStartTime( ) const { return m_startTime; }
+
+            /** Duration of the operation in seconds.
+              */
+            double getDuration( ) const { return m_duration; }
+            void setDuration( double duration ) { m_duration = duration; }
+
+            /** Whether the operation ended with an exception.
+              */
+            bool hasFailed( ) const { return m_failed; }
+            void setFailed( bool failed ) { m_failed = failed; }
+
+            /** The HTTP requests sent by the operation itself, without
+                the ones of the operations it called.
+              */
+            const std::vector< RequestMetrics >& getRequests( ) const { return m_requests; }
+            void addRequest( const RequestMetrics& request ) { m_requests.push_back( request ); }
+
+            long getDownloadSize( ) const;
+            long getUploadSize( ) const;
+    };
+
+    /** Receives the spans once their operation is over.
+
+        The spans are given one at a time, from the thread which ran the
+        operation: the exporters don't need to lock anything, but the
+        operation waits for them.
+      */
+    class LIBCMIS_API TraceExporter
+    {
+        public:
+            virtual ~TraceExporter( ) { };
+
+            virtual void exportSpan( const TraceSpan& span ) = 0;
+    };
+    typedef boost::shared_ptr< TraceExporter > TraceExporterPtr;
+
+    /** Exporter appending each span as a line of JSON to a file.
+      */
+    class LIBCMIS_API JsonLinesTraceExporter : public TraceExporter
+    {
+        private:
+            JsonLinesTraceExporter( const JsonLinesTraceExporter& copy );
+            JsonLinesTraceExporter& operator=( const JsonLinesTraceExporter& copy );
+
+            std::ofstream m_stream;
+
+        public:
+            /** Open the file at path for appending.
+
+                \throw Exception if the file can't be opened.
+              */
+            JsonLinesTraceExporter( const std::string& path );
+            virtual ~JsonLinesTraceExporter( );
+
+            virtual void exportSpan( const TraceSpan& span );
+
+            /** Write span as a single line of JSON, without the end of line.
+              */
+            static std::string toJson( const TraceSpan& span );
+    };
+}
+
+#endif
@@ -28,6 +28,7 @@
 #ifndef _XML_UTILS_HXX_
 #define _XML_UTILS_HXX_
 
+#include <istream>
 #include <map>
 #include <ostream>
 #include <sstream>
@@ -67,10 +68,21 @@ namespace libcmis
       */
     class LIBCMIS_API EncodedData
     {
+        public:
+            /** Function receiving the data, with the same semantics as
+                fwrite: returning less than nmemb means that the data
+                couldn't be written.
+              */
+            typedef size_t ( *WriteFunction )( const void* buf, size_t size, size_t nmemb, void* userData );
+
         private:
             xmlTextWriterPtr m_writer;
             FILE* m_stream;
             std::ostream* m_outStream;
+            std::string* m_buffer;
+            WriteFunction m_writeFunction;
+            void* m_writeData;
+            bool m_failed;
 
             std::string m_encoding;
             bool m_decode;
@@ -81,12 +93,21 @@ namespace libcmis
         public:
             EncodedData( FILE* stream );
             EncodedData( std::ostream* stream );
+
+            /** Append the data to buffer.
+              */
+            EncodedData( std::string* buffer );
             EncodedData( const EncodedData& rCopy );
             EncodedData( xmlTextWriterPtr writer );
+            EncodedData( WriteFunction writeFunction, void* userData );
 
             EncodedData& operator=( const EncodedData& rCopy );
 
             void setEncoding( std::string encoding ) { m_encoding = encoding; }
+
+            /** Tells whether some data couldn't be written to the output.
+              */
+            bool hasFailed( ) const { return m_failed; }
             void decode( void* buf, size_t size, size_t nmemb );
             void encode( void* buf, size_t size, size_t nmemb );
             void finish( );
@@ -101,16 +122,47 @@ namespace libcmis
     {
         private:
             std::map< std::string, std::string > m_headers;
+            boost::shared_ptr< std::string > m_body;
+            bool m_bodyBuffered;
             boost::shared_ptr< std::stringstream > m_stream;
             boost::shared_ptr< EncodedData > m_data;
 
         public:
             HttpResponse( );
+
+            /** Response whose content goes to data as it arrives instead
+                of being kept in getBody( ).
+              */
+            HttpResponse( boost::shared_ptr< EncodedData > data );
             ~HttpResponse( ) { };
 
             std::map< std::string, std::string >& getHeaders( ) { return m_headers; }
+
+            /** Value of the name header, looked up ignoring the case,
+                or an empty string if the response doesn't have it.
+              */
+            std::string getHeader( const std::string& name ) const;
             boost::shared_ptr< EncodedData > getData( ) { return m_data; }
-            boost::shared_ptr< std::stringstream > getStream( ) { return m_stream; }
+
+            /** Content of the response, kept in a single buffer that can
+                be parsed in place.
+              */
+            const std::string& getBody( ) const { return *m_body; }
+
+            /** Stream reading the content without copying it. The stream
+                keeps the content alive after the response is gone.
+              */
+            boost::shared_ptr< std::istream > getBodyStream( );
+
+            /** Copy of the content in a stringstream: getBody( ) or
+                getBodyStream( ) avoid that copy.
+              */
+            boost::shared_ptr< std::stringstream > getStream( );
+
+            /** Grow the content buffer ahead of the data, for example
+                when the Content-Length header is known.
+              */
+            void reserveBody( size_t size );
     };
     typedef boost::shared_ptr< HttpResponse > HttpResponsePtr;
 
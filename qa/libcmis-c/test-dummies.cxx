@@ -98,12 +98,12 @@ namespace dummies
         return root;
     }
 
-    libcmis::ObjectPtr Session::getObject( string id )
+    libcmis::ObjectPtr Session::getObject( string id, const libcmis::OperationContext& )
     {
         return getFolder( id );
     }
 
-    libcmis::ObjectPtr Session::getObjectByPath( string path )
+    libcmis::ObjectPtr Session::getObjectByPath( string path, const libcmis::OperationContext& )
     {
         return getFolder( path );
     }
@@ -133,6 +133,23 @@ namespace dummies
         return string( );
     }
 
+    libcmis::SessionStatistics Session::getStatistics( )
+    {
+        libcmis::SessionStatistics statistics;
+        statistics.addRequests( "GET", 3 );
+        statistics.addRequests( "PUT", 1 );
+        statistics.addResponses( 2, 3 );
+        statistics.addResponses( 4, 1 );
+        statistics.setBytes( 2048, 512 );
+        statistics.setRetries( 1 );
+        statistics.setObjectCache( 5, 2 );
+
+        vector< long > counts( libcmis::LatencyHistogram::getBucketsCount( ), 0 );
+        counts[ libcmis::LatencyHistogram::getBucket( 1000 ) ] = 2;
+        statistics.setLatency( "Session::getObject", libcmis::LatencyHistogram( counts, 1000, 1000, 2000 ) );
+        return statistics;
+    }
+
     Repository::Repository( ) :
         libcmis::Repository( )
     {
@@ -449,7 +466,7 @@ namespace dummies
         return parent;
     }
 
-    vector< libcmis::ObjectPtr > Folder::getChildren( )
+    vector< libcmis::ObjectPtr > Folder::getChildren( const libcmis::OperationContext& )
     {
         if ( m_triggersFaults )
             throw libcmis::Exception( "Fault triggered" );
@@ -53,13 +53,16 @@ namespace dummies
             virtual bool setRepository( std::string repositoryId );
             virtual std::vector< libcmis::RepositoryPtr > getRepositories( );
             virtual libcmis::FolderPtr getRootFolder();
-            virtual libcmis::ObjectPtr getObject( std::string id );
-            virtual libcmis::ObjectPtr getObjectByPath( std::string path );
+            virtual libcmis::ObjectPtr getObject( std::string id,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
+            virtual libcmis::ObjectPtr getObjectByPath( std::string path,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
             virtual libcmis::FolderPtr getFolder( std::string id );
             virtual libcmis::ObjectTypePtr getType( std::string id );
             virtual std::vector< libcmis::ObjectTypePtr > getBaseTypes( );
             virtual std::string getRefreshToken( );
             virtual void setNoSSLCertificateCheck( bool /*noCheck*/ ) { }
+            virtual libcmis::SessionStatistics getStatistics( );
     };
 
     class Repository : public libcmis::Repository
@@ -162,7 +165,7 @@ namespace dummies
             ~Folder( ) { }
             
             virtual libcmis::FolderPtr getFolderParent( );
-            virtual std::vector< libcmis::ObjectPtr > getChildren( );
+            virtual std::vector< libcmis::ObjectPtr > getChildren( const libcmis::OperationContext& context = libcmis::OperationContext( ) );
             virtual std::string getPath( );
 
             virtual bool isRootFolder( );
@@ -30,6 +30,8 @@
 #include <cppunit/TestFixture.h>
 #include <cppunit/TestAssert.h>
 
+#include <libcmis/session-factory.hxx>
+
 #include <libcmis-c/libcmis-c.h>
 
 #include "internals.hxx"
@@ -37,6 +39,26 @@
 
 using namespace std;
 
+namespace
+{
+    int lcl_metricsCalls = 0;
+    string lcl_metricsMethod;
+    string lcl_metricsUrl;
+    long lcl_metricsStatus = 0;
+    long lcl_metricsDownloadSize = 0;
+    long lcl_metricsUploadSize = 0;
+
+    void lcl_metricsCallback( libcmis_RequestMetricsPtr metrics )
+    {
+        ++lcl_metricsCalls;
+        lcl_metricsMethod = libcmis_request_metrics_getMethod( metrics );
+        lcl_metricsUrl = libcmis_request_metrics_getUrlTemplate( metrics );
+        lcl_metricsStatus = libcmis_request_metrics_getStatus( metrics );
+        lcl_metricsDownloadSize = libcmis_request_metrics_getDownloadSize( metrics );
+        lcl_metricsUploadSize = libcmis_request_metrics_getUploadSize( metrics );
+    }
+}
+
 class SessionTest : public CppUnit::TestFixture
 {
     private:
@@ -45,10 +67,14 @@ class SessionTest : public CppUnit::TestFixture
     public:
         void getRepositoriesTest( );
         void getBaseTypesTest( );
+        void getStatisticsTest( );
+        void requestMetricsCallbackTest( );
 
         CPPUNIT_TEST_SUITE( SessionTest );
         CPPUNIT_TEST( getRepositoriesTest );
         CPPUNIT_TEST( getBaseTypesTest );
+        CPPUNIT_TEST( getStatisticsTest );
+        CPPUNIT_TEST( requestMetricsCallbackTest );
         CPPUNIT_TEST_SUITE_END( );
 };
 
@@ -86,3 +112,54 @@ void SessionTest::getBaseTypesTest( )
     libcmis_vector_object_type_free( types );
     libcmis_session_free( session );
 }
+
+void SessionTest::getStatisticsTest( )
+{
+    libcmis_SessionPtr session = getTested( );
+
+    libcmis_SessionStatisticsPtr statistics = libcmis_session_getStatistics( session );
+
+    CPPUNIT_ASSERT_EQUAL( long( 3 ), libcmis_session_statistics_getRequests( statistics, "GET" ) );
+    CPPUNIT_ASSERT_EQUAL( long( 0 ), libcmis_session_statistics_getRequests( statistics, "POST" ) );
+    CPPUNIT_ASSERT_EQUAL( long( 4 ), libcmis_session_statistics_getRequestsCount( statistics ) );
+    CPPUNIT_ASSERT_EQUAL( long( 1 ), libcmis_session_statistics_getResponses( statistics, 4 ) );
+    CPPUNIT_ASSERT_EQUAL( long( 2048 ), libcmis_session_statistics_getBytesReceived( statistics ) );
+    CPPUNIT_ASSERT_EQUAL( long( 512 ), libcmis_session_statistics_getBytesSent( statistics ) );
+    CPPUNIT_ASSERT_EQUAL( long( 1 ), libcmis_session_statistics_getRetries( statistics ) );
+    CPPUNIT_ASSERT_EQUAL( long( 5 ), libcmis_session_statistics_getObjectCacheHits( statistics ) );
+    CPPUNIT_ASSERT_EQUAL( long( 2 ), libcmis_session_statistics_getObjectCacheMisses( statistics ) );
+
+    libcmis_vector_string_Ptr names = libcmis_session_statistics_getLatencyNames( statistics );
+    CPPUNIT_ASSERT_EQUAL( size_t( 1 ), libcmis_vector_string_size( names ) );
+    CPPUNIT_ASSERT_EQUAL( string( "Session::getObject" ), string( libcmis_vector_string_get( names, 0 ) ) );
+    CPPUNIT_ASSERT_EQUAL( long( 2 ), libcmis_session_statistics_getLatencyCount( statistics, "Session::getObject" ) );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE( "Wrong mean", 1.0, libcmis_session_statistics_getLatencyMean( statistics, "Session::getObject" ), 0.001 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE( "Wrong percentile", 1.0, libcmis_session_statistics_getLatencyPercentile( statistics, "Session::getObject", 99 ), 0.001 );
+    CPPUNIT_ASSERT_EQUAL( long( 0 ), libcmis_session_statistics_getLatencyCount( statistics, "Folder::getChildren" ) );
+
+    libcmis_vector_string_free( names );
+    libcmis_session_statistics_free( statistics );
+    libcmis_session_free( session );
+}
+
+void SessionTest::requestMetricsCallbackTest( )
+{
+    libcmis_setRequestMetricsCallback( lcl_metricsCallback );
+
+    // The sessions notify the observer set on the factory after each request:
+    // send the metrics of a mock request the same way.
+    libcmis::RequestObserverPtr observer = libcmis::SessionFactory::getRequestObserver( );
+    CPPUNIT_ASSERT_MESSAGE( "No observer set for the callback", observer.get( ) != NULL );
+    observer->requestDone( libcmis::RequestMetrics( "PUT", "http://mockup/content", 201,
+                0.001, 0.002, 0.0, 0.005, 0.01, 12, 34 ) );
+
+    CPPUNIT_ASSERT_EQUAL( 1, lcl_metricsCalls );
+    CPPUNIT_ASSERT_EQUAL( string( "PUT" ), lcl_metricsMethod );
+    CPPUNIT_ASSERT_EQUAL( string( "http://mockup/content" ), lcl_metricsUrl );
+    CPPUNIT_ASSERT_EQUAL( long( 201 ), lcl_metricsStatus );
+    CPPUNIT_ASSERT_EQUAL( long( 12 ), lcl_metricsDownloadSize );
+    CPPUNIT_ASSERT_EQUAL( long( 34 ), lcl_metricsUploadSize );
+
+    libcmis_setRequestMetricsCallback( NULL );
+    CPPUNIT_ASSERT_MESSAGE( "Observer not reset", libcmis::SessionFactory::getRequestObserver( ).get( ) == NULL );
+}
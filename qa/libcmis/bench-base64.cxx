@@ -0,0 +1,102 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+/* Throughput benchmark of the base64 codec used by EncodedData.
+ *
+ * Not run by make check: build it with `make bench-base64` and run it
+ * with an optional size in MiB (default 64).
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <libcmis/xml-utils.hxx>
+
+#include "base64.hxx"
+
+using namespace std;
+
+namespace
+{
+    double lcl_run( const string& input, bool encode, FILE* out )
+    {
+        rewind( out );
+        libcmis::EncodedData data( out );
+        data.setEncoding( "base64" );
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now( );
+        // Feed it like curl would: in 16KiB runs
+        const size_t runSize = 16 * 1024;
+        for ( size_t pos = 0; pos < input.size( ); pos += runSize )
+        {
+            size_t len = min( runSize, input.size( ) - pos );
+            if ( encode )
+                data.encode( ( void* )( input.data( ) + pos ), 1, len );
+            else
+                data.decode( ( void* )( input.data( ) + pos ), 1, len );
+        }
+        data.finish( );
+        fflush( out );
+        chrono::duration< double > elapsed = chrono::steady_clock::now( ) - start;
+
+        return double( input.size( ) ) / ( 1024 * 1024 ) / elapsed.count( );
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    size_t size = 64;
+    if ( argc > 1 )
+        size = strtoul( argv[1], NULL, 10 );
+    size *= 1024 * 1024;
+
+    string raw( size, '\0' );
+    for ( size_t i = 0; i < size; ++i )
+        raw[i] = char( rand( ) & 0xFF );
+
+    FILE* out = tmpfile( );
+    if ( !out )
+    {
+        perror( "tmpfile" );
+        return 1;
+    }
+
+    lcl_run( raw, true, out );
+    string encoded( size / 3 * 4 + 4, '\0' );
+    rewind( out );
+    encoded.resize( fread( &encoded[0], 1, encoded.size( ), out ) );
+
+    printf( "implementation: %s\n", libcmis::base64::getImplementation( ) );
+    printf( "encode: %.1f MB/s\n", lcl_run( raw, true, out ) );
+    printf( "decode: %.1f MB/s\n", lcl_run( encoded, false, out ) );
+
+    fclose( out );
+    return 0;
+}
@@ -53,6 +53,7 @@
 
 #include <mockup-config.h>
 #include "test-helpers.hxx"
+#include "atom-feed-reader.hxx"
 #include "atom-session.hxx"
 
 using namespace std;
@@ -60,6 +61,22 @@ using libcmis::PropertyPtrMap;
 
 typedef std::unique_ptr<AtomPubSession> AtomPubSessionPtr;
 
+namespace
+{
+    class SpansCollector : public libcmis::TraceExporter
+    {
+        public:
+            SpansCollector( ) : m_spans( ) { }
+
+            virtual void exportSpan( const libcmis::TraceSpan& span )
+            {
+                m_spans.push_back( span );
+            }
+
+            vector< libcmis::TraceSpan > m_spans;
+    };
+}
+
 class AtomTest : public CppUnit::TestFixture
 {
     public:
@@ -71,9 +88,14 @@ class AtomTest : public CppUnit::TestFixture
         void getRepositoriesTest( );
         void getTypeTest( );
         void getUnexistantTypeTest( );
+        void typeCacheTest( );
+        void objectCacheTest( );
+        void refreshNotModifiedTest( );
         void getTypeParentsTest( );
         void getTypeChildrenTest( );
         void getObjectTest( );
+        void getObjectLazyTypeTest( );
+        void getObjectOperationContextTest( );
         void getDocumentTest( );
         void getDocumentRelationshipsTest( );
         void getUnexistantObjectTest( );
@@ -85,8 +107,20 @@ class AtomTest : public CppUnit::TestFixture
         void getAllowableActionsTest( );
         void getAllowableActionsNotIncludedTest( );
         void getChildrenTest( );
+        void traceSpansTest( );
+        void sessionStatisticsTest( );
+        void listChildrenTest( );
+        void listChildrenReadAheadTest( );
+        void listChildrenSkipCountReadAheadTest( );
+        void listChildrenShortPagesReadAheadTest( );
+        void getDescendantsTest( );
+        void queryTest( );
+        void getContentChangesTest( );
+        void feedReaderTest( );
         void getDocumentParentsTest( );
         void getContentStreamTest( );
+        void downloadContentStreamTest( );
+        void downloadContentStreamWriteErrorTest( );
         void setContentStreamTest( );
         void updatePropertiesTest( );
         void updatePropertiesEmptyTest( );
@@ -110,9 +144,14 @@ class AtomTest : public CppUnit::TestFixture
         CPPUNIT_TEST( getRepositoriesTest );
         CPPUNIT_TEST( getTypeTest );
         CPPUNIT_TEST( getUnexistantTypeTest );
+        CPPUNIT_TEST( typeCacheTest );
+        CPPUNIT_TEST( objectCacheTest );
+        CPPUNIT_TEST( refreshNotModifiedTest );
         CPPUNIT_TEST( getTypeParentsTest );
         CPPUNIT_TEST( getTypeChildrenTest );
         CPPUNIT_TEST( getObjectTest );
+        CPPUNIT_TEST( getObjectLazyTypeTest );
+        CPPUNIT_TEST( getObjectOperationContextTest );
         CPPUNIT_TEST( getDocumentTest );
         CPPUNIT_TEST( getDocumentRelationshipsTest );
         CPPUNIT_TEST( getUnexistantObjectTest );
@@ -124,8 +163,20 @@ class AtomTest : public CppUnit::TestFixture
         CPPUNIT_TEST( getAllowableActionsTest );
         CPPUNIT_TEST( getAllowableActionsNotIncludedTest );
         CPPUNIT_TEST( getChildrenTest );
+        CPPUNIT_TEST( traceSpansTest );
+        CPPUNIT_TEST( sessionStatisticsTest );
+        CPPUNIT_TEST( listChildrenTest );
+        CPPUNIT_TEST( listChildrenReadAheadTest );
+        CPPUNIT_TEST( listChildrenSkipCountReadAheadTest );
+        CPPUNIT_TEST( listChildrenShortPagesReadAheadTest );
+        CPPUNIT_TEST( getDescendantsTest );
+        CPPUNIT_TEST( queryTest );
+        CPPUNIT_TEST( getContentChangesTest );
+        CPPUNIT_TEST( feedReaderTest );
         CPPUNIT_TEST( getDocumentParentsTest );
         CPPUNIT_TEST( getContentStreamTest );
+        CPPUNIT_TEST( downloadContentStreamTest );
+        CPPUNIT_TEST( downloadContentStreamWriteErrorTest );
         CPPUNIT_TEST( setContentStreamTest );
         CPPUNIT_TEST( updatePropertiesTest );
         CPPUNIT_TEST( updatePropertiesEmptyTest );
@@ -379,6 +430,104 @@ void AtomTest::getUnexistantTypeTest( )
     }
 }
 
+void AtomTest::typeCacheTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+
+    libcmis::ObjectTypePtr first = session->getType( "cmis:folder" );
+    libcmis::ObjectTypePtr second = session->getType( "cmis:folder" );
+    CPPUNIT_ASSERT_MESSAGE( "Cached type not shared", first == second );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Type fetched more than once", 1,
+            curl_mockup_getRequestsCount( "http://mockup/mock/type", "id=cmis:folder", "GET" ) );
+
+    session->invalidateType( "cmis:folder" );
+    libcmis::ObjectTypePtr refetched = session->getType( "cmis:folder" );
+    CPPUNIT_ASSERT_MESSAGE( "Invalidated type still used", first != refetched );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Invalidated type not fetched again", 2,
+            curl_mockup_getRequestsCount( "http://mockup/mock/type", "id=cmis:folder", "GET" ) );
+
+    session->setTypeCacheTtl( 0 );
+    session->getType( "cmis:folder" );
+    session->getType( "cmis:folder" );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Type cached with a 0 TTL", 4,
+            curl_mockup_getRequestsCount( "http://mockup/mock/type", "id=cmis:folder", "GET" ) );
+}
+
+void AtomTest::objectCacheTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=valid-object", "GET", DATA_DIR "/atom/valid-object.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=test-document", "GET", DATA_DIR "/atom/test-document.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=test-document", "DELETE", "", 204, false );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=DocumentLevel2", "GET", DATA_DIR "/atom/type-docLevel2.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+
+    // Disabled by default
+    session->getObject( "valid-object" );
+    session->getObject( "valid-object" );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Object cached by default", 2,
+            curl_mockup_getRequestsCount( "http://mockup/mock/id", "id=valid-object", "GET" ) );
+
+    session->setObjectCache( 1 );
+    libcmis::ObjectPtr first = session->getObject( "valid-object" );
+    libcmis::ObjectPtr second = session->getObject( "valid-object" );
+    CPPUNIT_ASSERT_MESSAGE( "Cached object not shared", first == second );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Object fetched more than once", 3,
+            curl_mockup_getRequestsCount( "http://mockup/mock/id", "id=valid-object", "GET" ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong hits count", long( 1 ), session->getObjectCacheHits( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong misses count", long( 1 ), session->getObjectCacheMisses( ) );
+
+    // A filtered object isn't the cached one
+    libcmis::OperationContext context;
+    context.setIncludeAllowableActions( false );
+    session->getObject( "valid-object", context );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Cache used with a context", 4,
+            curl_mockup_getRequestsCount( "http://mockup/mock/id", "id=valid-object", "GET" ) );
+
+    // The least recently used object is dropped
+    libcmis::ObjectPtr document = session->getObject( "test-document" );
+    session->getObject( "valid-object" );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Evicted object not fetched again", 5,
+            curl_mockup_getRequestsCount( "http://mockup/mock/id", "id=valid-object", "GET" ) );
+
+    // Changes drop the object
+    session->getObject( "test-document" );
+    document->remove( );
+    session->getObject( "test-document" );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Removed object still cached", 3,
+            curl_mockup_getRequestsCount( "http://mockup/mock/id", "id=test-document", "GET" ) );
+}
+
+void AtomTest::refreshNotModifiedTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=valid-object", "GET", DATA_DIR "/atom/valid-object.xml",
+                             0, true, "ETag: \"v1\"\r\n" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+    libcmis::ObjectPtr object = session->getObject( "valid-object" );
+    object->refresh( );
+    string expectedName = object->getName( );
+
+    // The entry didn't change since the last refresh
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=valid-object", "GET", "", 304, false );
+    object->refresh( );
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Entry not requested", 3,
+            curl_mockup_getRequestsCount( "http://mockup/mock/id", "id=valid-object", "GET" ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Parsed state lost", expectedName, object->getName( ) );
+    CPPUNIT_ASSERT_MESSAGE( "Refresh timestamp not set", object->getRefreshTimestamp( ) > 0 );
+}
+
 void AtomTest::getTypeParentsTest( )
 {
     curl_mockup_reset( );
@@ -426,6 +575,57 @@ void AtomTest::getObjectTest( )
     CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong Id for fetched object", expectedId, actual->getId( ) );
 }
 
+void AtomTest::getObjectOperationContextTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=valid-object", "GET", DATA_DIR "/atom/valid-object.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+
+    libcmis::OperationContext context;
+    vector< string > filter;
+    filter.push_back( "cmis:name" );
+    context.setPropertyFilter( filter );
+    context.setIncludeAllowableActions( false );
+
+    libcmis::ObjectPtr actual = session->getObject( "valid-object", context );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong Id for fetched object", string( "valid-object" ), actual->getId( ) );
+
+    // The required properties are always added to the filter
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Property filter not sent", 1,
+            curl_mockup_getRequestsCount( "http://mockup/mock/id",
+                "filter=cmis:objectId,cmis:objectTypeId,cmis:baseTypeId,cmis:name", "GET" ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Allowable actions shouldn't be requested", 1,
+            curl_mockup_getRequestsCount( "http://mockup/mock/id", "includeAllowableActions=false", "GET" ) );
+}
+
+void AtomTest::getObjectLazyTypeTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=valid-object", "GET", DATA_DIR "/atom/valid-object.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+    session->setLazyTypeResolution( true );
+
+    libcmis::ObjectPtr actual = session->getObject( "valid-object" );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong name", string( "Valid Object" ), actual->getName( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Type shouldn't be fetched yet", 0,
+            curl_mockup_getRequestsCount( "http://mockup/mock/type", "id=cmis:folder", "GET" ) );
+
+    libcmis::PropertyTypePtr nameType = actual->getProperties( )["cmis:name"]->getPropertyType( );
+    CPPUNIT_ASSERT_MESSAGE( "Temporary definition expected", nameType->m_temporary );
+
+    actual->getTypeDescription( );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Type should be fetched", 1,
+            curl_mockup_getRequestsCount( "http://mockup/mock/type", "id=cmis:folder", "GET" ) );
+    CPPUNIT_ASSERT_MESSAGE( "Definition not completed", !nameType->m_temporary );
+    CPPUNIT_ASSERT_MESSAGE( "cmis:name should be updatable", nameType->isUpdatable( ) );
+}
+
 void AtomTest::getDocumentTest( )
 {
     curl_mockup_reset( );
@@ -691,6 +891,376 @@ void AtomTest::getChildrenTest( )
     CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of document children", 3, documentCount );
 }
 
+void AtomTest::traceSpansTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/children", "id=root-folder", "GET", DATA_DIR "/atom/root-children.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=root-folder", "GET", DATA_DIR "/atom/root-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=DocumentLevel2", "GET", DATA_DIR "/atom/type-docLevel2.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+    libcmis::FolderPtr root = session->getRootFolder( );
+    int previousRequests = curl_mockup_getRequestsCount( "", "", "GET" );
+
+    boost::shared_ptr< SpansCollector > collector( new SpansCollector( ) );
+    libcmis::SessionFactory::setTraceExporter( collector );
+    root->getChildren( );
+    libcmis::SessionFactory::setTraceExporter( libcmis::TraceExporterPtr( ) );
+
+    // The spans are exported when their operation is over: the
+    // outermost one comes last
+    vector< libcmis::TraceSpan >& spans = collector->m_spans;
+    CPPUNIT_ASSERT_MESSAGE( "Missing spans", spans.size( ) >= 2 );
+    const libcmis::TraceSpan& getChildren = spans.back( );
+    CPPUNIT_ASSERT_EQUAL( string( "Folder::getChildren" ), getChildren.getName( ) );
+    CPPUNIT_ASSERT_EQUAL( 0UL, getChildren.getParentId( ) );
+    CPPUNIT_ASSERT_EQUAL( getChildren.getId( ), getChildren.getTraceId( ) );
+    CPPUNIT_ASSERT( !getChildren.hasFailed( ) );
+
+    // The pages are fetched while iterating, out of listChildren( )
+    CPPUNIT_ASSERT_MESSAGE( "Missing request", !getChildren.getRequests( ).empty( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "http://mockup/mock/children" ),
+                          getChildren.getRequests( ).front( ).getUrlTemplate( ) );
+    CPPUNIT_ASSERT_EQUAL( 200L, getChildren.getRequests( ).front( ).getStatus( ) );
+
+    size_t requestsCount = 0;
+    bool hasListChildren = false;
+    for ( vector< libcmis::TraceSpan >::iterator it = spans.begin( ); it != spans.end( ); ++it )
+    {
+        CPPUNIT_ASSERT_EQUAL( getChildren.getTraceId( ), it->getTraceId( ) );
+        requestsCount += it->getRequests( ).size( );
+        if ( it->getName( ) == "Folder::listChildren" )
+        {
+            hasListChildren = true;
+            CPPUNIT_ASSERT_EQUAL( getChildren.getId( ), it->getParentId( ) );
+        }
+    }
+    CPPUNIT_ASSERT_MESSAGE( "Missing listChildren span", hasListChildren );
+
+    // Each request is in exactly one span
+    CPPUNIT_ASSERT_EQUAL( size_t( curl_mockup_getRequestsCount( "", "", "GET" ) - previousRequests ),
+                          requestsCount );
+}
+
+void AtomTest::sessionStatisticsTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=valid-object", "GET", DATA_DIR "/atom/valid-object.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=DocumentLevel2", "GET", DATA_DIR "/atom/type-docLevel2.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+    session->resetStatistics( );
+    CPPUNIT_ASSERT_EQUAL( long( 0 ), session->getStatistics( ).getRequestsCount( ) );
+    int previousRequests = curl_mockup_getRequestsCount( "", "", "GET" );
+
+    session->setObjectCache( 1 );
+    session->getObject( "valid-object" );
+    session->getObject( "valid-object" );
+
+    libcmis::SessionStatistics statistics = session->getStatistics( );
+    long requests = long( curl_mockup_getRequestsCount( "", "", "GET" ) - previousRequests );
+    CPPUNIT_ASSERT_EQUAL( requests, statistics.getRequests( "GET" ) );
+    CPPUNIT_ASSERT_EQUAL( requests, statistics.getRequestsCount( ) );
+    CPPUNIT_ASSERT_EQUAL( requests, statistics.getResponses( 2 ) );
+    CPPUNIT_ASSERT_MESSAGE( "Received bytes not counted", statistics.getBytesReceived( ) > 0 );
+    CPPUNIT_ASSERT_EQUAL( long( 1 ), statistics.getObjectCacheHits( ) );
+    CPPUNIT_ASSERT_EQUAL( long( 1 ), statistics.getObjectCacheMisses( ) );
+
+    // Both the operations and their requests are timed
+    const map< string, libcmis::LatencyHistogram >& latencies = statistics.getLatencies( );
+    map< string, libcmis::LatencyHistogram >::const_iterator it = latencies.find( "Session::getObject" );
+    CPPUNIT_ASSERT_MESSAGE( "Missing operation latency", it != latencies.end( ) );
+    CPPUNIT_ASSERT_EQUAL( long( 2 ), it->second.getCount( ) );
+    it = latencies.find( "HTTP GET" );
+    CPPUNIT_ASSERT_MESSAGE( "Missing request latency", it != latencies.end( ) );
+    CPPUNIT_ASSERT_EQUAL( requests, it->second.getCount( ) );
+
+    session->resetStatistics( );
+    statistics = session->getStatistics( );
+    CPPUNIT_ASSERT_EQUAL( long( 0 ), statistics.getRequestsCount( ) );
+    CPPUNIT_ASSERT_EQUAL( long( 0 ), statistics.getBytesReceived( ) );
+    CPPUNIT_ASSERT_EQUAL( long( 0 ), statistics.getObjectCacheHits( ) );
+    CPPUNIT_ASSERT( statistics.getLatencies( ).empty( ) );
+}
+
+void AtomTest::listChildrenTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/children", "id=root-folder", "GET", DATA_DIR "/atom/children-page1.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/children-next", "skipCount=5", "GET", DATA_DIR "/atom/children-page2.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=root-folder", "GET", DATA_DIR "/atom/root-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=DocumentLevel2", "GET", DATA_DIR "/atom/type-docLevel2.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+
+    libcmis::ObjectIteratorPtr it = session->getRootFolder()->listChildren( 5 );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Nothing should be requested before iterating", 0,
+            curl_mockup_getRequestsCount( "http://mockup/mock/children", "", "GET" ) );
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of items", long( 6 ), it->getNumItems( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Page size not requested", 1,
+            curl_mockup_getRequestsCount( "http://mockup/mock/children", "maxItems=5", "GET" ) );
+    CPPUNIT_ASSERT_MESSAGE( "Should have more items", it->hasMoreItems( ) );
+
+    vector< libcmis::ObjectPtr > page = it->nextPage( );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong first page size", size_t( 5 ), page.size( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Second page shouldn't be requested yet", 0,
+            curl_mockup_getRequestsCount( "http://mockup/mock/children-next", "", "GET" ) );
+
+    CPPUNIT_ASSERT( it->hasNext( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "child1" ), it->next( )->getId( ) );
+    CPPUNIT_ASSERT_MESSAGE( "Shouldn't have more items", !it->hasMoreItems( ) );
+    CPPUNIT_ASSERT_MESSAGE( "Shouldn't have a next item", !it->hasNext( ) );
+    CPPUNIT_ASSERT( it->nextPage( ).empty( ) );
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( "http://mockup/mock/children-next", "", "GET" ) );
+
+    try
+    {
+        it->next( );
+        CPPUNIT_FAIL( "Exception should be thrown at the end" );
+    }
+    catch ( const libcmis::Exception& )
+    {
+    }
+}
+
+void AtomTest::listChildrenReadAheadTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/children", "id=root-folder", "GET", DATA_DIR "/atom/children-page1.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/children-next", "skipCount=5", "GET", DATA_DIR "/atom/children-page2.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=root-folder", "GET", DATA_DIR "/atom/root-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=DocumentLevel2", "GET", DATA_DIR "/atom/type-docLevel2.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+
+    // Without a page size, the next links are followed
+    libcmis::ObjectIteratorPtr it = session->getRootFolder()->listChildren( 0, 3 );
+    vector< libcmis::ObjectPtr > children;
+    while ( it->hasNext( ) )
+        children.push_back( it->next( ) );
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of children", size_t( 6 ), children.size( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "child1" ), children.back( )->getId( ) );
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( "http://mockup/mock/children-next", "", "GET" ) );
+}
+
+void AtomTest::listChildrenSkipCountReadAheadTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/children", "maxItems=5", "GET", DATA_DIR "/atom/children-page1.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/children", "includeAllowableActions=true&maxItems=5&skipCount=5", "GET",
+                             DATA_DIR "/atom/children-page2.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=root-folder", "GET", DATA_DIR "/atom/root-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=DocumentLevel2", "GET", DATA_DIR "/atom/type-docLevel2.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+
+    libcmis::ObjectIteratorPtr it = session->getRootFolder()->listChildren( 5, 2 );
+    vector< libcmis::ObjectPtr > page = it->nextPage( );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong first page size", size_t( 5 ), page.size( ) );
+
+    page = it->nextPage( );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong second page size", size_t( 1 ), page.size( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "child1" ), page.front( )->getId( ) );
+    CPPUNIT_ASSERT( !it->hasNext( ) );
+
+    // The pages are computed from the skipCount, not the next links
+    CPPUNIT_ASSERT_EQUAL( 0, curl_mockup_getRequestsCount( "http://mockup/mock/children-next", "", "GET" ) );
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( "http://mockup/mock/children", "skipCount=5", "GET" ) );
+
+    // The total number of items stops the read-ahead once known
+    CPPUNIT_ASSERT_EQUAL( 0, curl_mockup_getRequestsCount( "http://mockup/mock/children", "skipCount=15", "GET" ) );
+}
+
+void AtomTest::listChildrenShortPagesReadAheadTest( )
+{
+    // The server sends 5 items per page whatever the maxItems
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/children", "maxItems=10", "GET", DATA_DIR "/atom/children-page1.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/children", "includeAllowableActions=true&maxItems=10&skipCount=5", "GET",
+                             DATA_DIR "/atom/children-page2.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=root-folder", "GET", DATA_DIR "/atom/root-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=DocumentLevel2", "GET", DATA_DIR "/atom/type-docLevel2.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+
+    libcmis::ObjectIteratorPtr it = session->getRootFolder()->listChildren( 10, 2 );
+    vector< libcmis::ObjectPtr > children;
+    while ( it->hasNext( ) )
+        children.push_back( it->next( ) );
+
+    // The pages after the short one start after the items received
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of children", size_t( 6 ), children.size( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "child1" ), children.back( )->getId( ) );
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( "http://mockup/mock/children", "skipCount=5", "GET" ) );
+}
+
+void AtomTest::getDescendantsTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/descendants", "id=root-folder", "GET", DATA_DIR "/atom/root-descendants.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=root-folder", "GET", DATA_DIR "/atom/root-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:document", "GET", DATA_DIR "/atom/type-document.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+    libcmis::FolderPtr folder = session->getRootFolder( );
+
+    try
+    {
+        folder->getDescendants( 0 );
+        CPPUNIT_FAIL( "Depth 0 should be refused" );
+    }
+    catch ( const libcmis::Exception& e )
+    {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong error type", string( "invalidArgument" ), e.getType( ) );
+    }
+
+    vector< libcmis::ObjectTreePtr > descendants = folder->getDescendants( 3 );
+
+    // The whole tree comes in one request
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of requests", 1,
+            curl_mockup_getRequestsCount( "http://mockup/mock/descendants", "depth=3", "GET" ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Children shouldn't be requested", 0,
+            curl_mockup_getRequestsCount( "http://mockup/mock/children", "", "GET" ) );
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of children", size_t( 2 ), descendants.size( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong first child", string( "child-folder" ),
+            descendants[0]->getObject( )->getId( ) );
+    CPPUNIT_ASSERT_MESSAGE( "First child should be a folder",
+            boost::dynamic_pointer_cast< libcmis::Folder >( descendants[0]->getObject( ) ).get( ) != NULL );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong second child", string( "child-document" ),
+            descendants[1]->getObject( )->getId( ) );
+    CPPUNIT_ASSERT_MESSAGE( "Document shouldn't have children", descendants[1]->getChildren( ).empty( ) );
+
+    vector< libcmis::ObjectTreePtr > grandChildren = descendants[0]->getChildren( );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of grand children", size_t( 2 ), grandChildren.size( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong grand child", string( "grandchild-folder" ),
+            grandChildren[0]->getObject( )->getId( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong name for the grand child", string( "Grandchild Folder" ),
+            grandChildren[0]->getObject( )->getName( ) );
+
+    vector< libcmis::ObjectTreePtr > greatGrandChildren = grandChildren[0]->getChildren( );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of great grand children", size_t( 1 ), greatGrandChildren.size( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong great grand child", string( "great-grandchild-document" ),
+            greatGrandChildren[0]->getObject( )->getId( ) );
+}
+
+void AtomTest::queryTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/query", "", "GET", DATA_DIR "/atom/query-results.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=DocumentLevel2", "GET", DATA_DIR "/atom/type-docLevel2.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=DocumentLevel1", "GET", DATA_DIR "/atom/type-docLevel1.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:folder", "GET", DATA_DIR "/atom/type-folder.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=cmis:document", "GET", DATA_DIR "/atom/type-document.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+    libcmis::ObjectIteratorPtr it = session->query( "SELECT * FROM cmis:document", false, 10 );
+
+    // Nothing is sent before the results are read
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Query sent too early", 0,
+            curl_mockup_getRequestsCount( "http://mockup/mock/query", "", "GET" ) );
+
+    vector< string > ids;
+    while ( it->hasNext( ) )
+        ids.push_back( it->next( )->getId( ) );
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of results", size_t( 5 ), ids.size( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong first result", string( "child1" ), ids.front( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong last result", string( "child5" ), ids.back( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong numItems", long( 5 ), it->getNumItems( ) );
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong query request", 1,
+            curl_mockup_getRequestsCount( "http://mockup/mock/query",
+                "q=SELECT * FROM cmis:document&searchAllVersions=false", "GET" ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Missing maxItems", 1,
+            curl_mockup_getRequestsCount( "http://mockup/mock/query", "maxItems=10", "GET" ) );
+}
+
+void AtomTest::getContentChangesTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/changes", "", "GET", DATA_DIR "/atom/changes.xml" );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+    libcmis::ContentChanges changes = session->getContentChanges( "token1", 2 );
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong request", 1,
+            curl_mockup_getRequestsCount( "http://mockup/mock/changes",
+                "includeProperties=false&changeLogToken=token1&maxItems=2", "GET" ) );
+
+    vector< libcmis::ChangeEventPtr > events = changes.getEvents( );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of events", size_t( 2 ), events.size( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong first object id", string( "child1" ), events[0]->getObjectId( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong first change type",
+            libcmis::ChangeType::Created, events[0]->getChangeType( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong first change time",
+            libcmis::parseDateTime( "2013-01-30T09:26:13.000Z" ), events[0]->getChangeTime( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong second object id", string( "child2" ), events[1]->getObjectId( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong second change type",
+            libcmis::ChangeType::Deleted, events[1]->getChangeType( ) );
+
+    // The next token comes from the next link
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong next token", string( "token2" ), changes.getChangeLogToken( ) );
+    CPPUNIT_ASSERT_MESSAGE( "More changes expected", changes.hasMoreItems( ) );
+}
+
+void AtomTest::feedReaderTest( )
+{
+    string feed( "<?xml version='1.0' encoding='UTF-8'?>"
+                 "<atom:feed xmlns:atom='http://www.w3.org/2005/Atom'>"
+                 "<atom:link rel='self' href='http://mockup/self'/>"
+                 "<atom:entry><atom:id>first</atom:id>"
+                 "<atom:link rel='next' href='http://mockup/not-the-feed-one'/></atom:entry>"
+                 "<atom:entry><atom:id>second</atom:id></atom:entry>"
+                 "<atom:link rel='next' href='http://mockup/next'/>"
+                 "</atom:feed>" );
+    AtomFeedReader reader( feed, "http://mockup/feed" );
+
+    vector< string > ids;
+    for ( xmlNodePtr node = reader.nextEntry( ); node != NULL; node = reader.nextEntry( ) )
+    {
+        CPPUNIT_ASSERT_EQUAL( string( "entry" ), string( ( char* ) node->name ) );
+        xmlChar* content = xmlNodeGetContent( node->children );
+        ids.push_back( string( ( char* ) content ) );
+        xmlFree( content );
+    }
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of entries", size_t( 2 ), ids.size( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "first" ), ids[0] );
+    CPPUNIT_ASSERT_EQUAL( string( "second" ), ids[1] );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong next link", string( "http://mockup/next" ), reader.getNextHref( ) );
+
+    string brokenFeed( "<atom:feed xmlns:atom='http://www.w3.org/2005/Atom'><atom:entry>" );
+    AtomFeedReader broken( brokenFeed, "http://mockup/feed" );
+    try
+    {
+        broken.nextEntry( );
+        broken.nextEntry( );
+        CPPUNIT_FAIL( "Exception should be raised: broken feed" );
+    }
+    catch ( const libcmis::Exception& )
+    {
+    }
+}
+
 void AtomTest::getDocumentParentsTest( )
 {
     curl_mockup_reset( );
@@ -749,6 +1319,59 @@ void AtomTest::getContentStreamTest( )
     }
 }
 
+namespace
+{
+    size_t lcl_failingWrite( const void*, size_t, size_t, void* )
+    {
+        return 0;
+    }
+}
+
+void AtomTest::downloadContentStreamTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=test-document", "GET", DATA_DIR "/atom/test-document.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=DocumentLevel2", "GET", DATA_DIR "/atom/type-docLevel2.xml" );
+
+    string expectedContent( "Some content stream" );
+    curl_mockup_addResponse( "http://mockup/mock/content/data.txt", "id=test-document", "GET", expectedContent.c_str( ), 0, false );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+    libcmis::ObjectPtr object = session->getObject( "test-document" );
+    libcmis::DocumentPtr document = boost::dynamic_pointer_cast< libcmis::Document >( object );
+
+    ostringstream out;
+    boost::shared_ptr< libcmis::EncodedData > sink( new libcmis::EncodedData( &out ) );
+    document->downloadContentStream( sink );
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Content stream doesn't match", expectedContent, out.str( ) );
+}
+
+void AtomTest::downloadContentStreamWriteErrorTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( "http://mockup/mock/id", "id=test-document", "GET", DATA_DIR "/atom/test-document.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/type", "id=DocumentLevel2", "GET", DATA_DIR "/atom/type-docLevel2.xml" );
+    curl_mockup_addResponse( "http://mockup/mock/content/data.txt", "id=test-document", "GET", "Some content stream", 0, false );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+
+    AtomPubSessionPtr session = getTestSession( SERVER_USERNAME, SERVER_PASSWORD );
+    libcmis::ObjectPtr object = session->getObject( "test-document" );
+    libcmis::DocumentPtr document = boost::dynamic_pointer_cast< libcmis::Document >( object );
+
+    boost::shared_ptr< libcmis::EncodedData > sink( new libcmis::EncodedData( &lcl_failingWrite, NULL ) );
+    try
+    {
+        document->downloadContentStream( sink );
+        CPPUNIT_FAIL( "Failing to write the content should abort the download" );
+    }
+    catch ( const libcmis::Exception& e )
+    {
+        CPPUNIT_ASSERT_EQUAL( string( "transferFailed" ), e.getType( ) );
+    }
+}
+
 void AtomTest::setContentStreamTest( )
 {
     curl_mockup_reset( );
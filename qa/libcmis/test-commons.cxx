@@ -26,6 +26,8 @@
  * instead of those above.
  */
 
+#include <climits>
+#include <thread>
 #include <time.h>
 
 #include <cppunit/extensions/HelperMacros.h>
@@ -46,8 +48,13 @@
 
 #include <libcmis/oauth2-data.hxx>
 #include <libcmis/object-type.hxx>
+#include <libcmis/session-factory.hxx>
+#include <libcmis/session-statistics.hxx>
+#include <libcmis/trace.hxx>
 
+#include "concurrency-limiter.hxx"
 #include "oauth2-handler.hxx"
+#include "path-cache.hxx"
 
 using namespace libcmis;
 using namespace std;
@@ -66,12 +73,21 @@ class CommonsTest : public CppUnit::TestFixture
 
         void httpSessionCRLFInjectionTest();
 
+        void pathCacheTest();
+        void concurrencyLimiterTest();
+        void traceSpanJsonTest();
+        void latencyHistogramTest();
+
         CPPUNIT_TEST_SUITE( CommonsTest );
         CPPUNIT_TEST( oauth2DataCopyTest );
         CPPUNIT_TEST( oauth2HandlerCopyTest );
         CPPUNIT_TEST( objectTypeCopyTest );
         CPPUNIT_TEST( objectTypeNocallTest );
         CPPUNIT_TEST( httpSessionCRLFInjectionTest );
+        CPPUNIT_TEST( pathCacheTest );
+        CPPUNIT_TEST( concurrencyLimiterTest );
+        CPPUNIT_TEST( traceSpanJsonTest );
+        CPPUNIT_TEST( latencyHistogramTest );
         CPPUNIT_TEST_SUITE_END( );
 };
 
@@ -230,4 +246,149 @@ void CommonsTest::httpSessionCRLFInjectionTest( )
     }
 }
 
+void CommonsTest::pathCacheTest( )
+{
+    vector< string > segments = PathCache::splitPath( "/Docs//Reports/2024/" );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of segments", size_t( 3 ), segments.size( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong last segment", string( "2024" ), segments[2] );
+
+    PathCache cache;
+    string id( "root" );
+    cache.add( segments, 2, "reports-id" );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Disabled cache used", size_t( 0 ), cache.resolve( segments, id ) );
+
+    cache.setTtl( -1 );
+    cache.add( segments, 1, "docs-id" );
+    cache.add( segments, 2, "reports-id" );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong known prefix", size_t( 2 ), cache.resolve( segments, id ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong prefix id", string( "reports-id" ), id );
+
+    // A sibling path shares the known prefix
+    vector< string > sibling = PathCache::splitPath( "/Docs/Invoices" );
+    id = "root";
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong sibling prefix", size_t( 1 ), cache.resolve( sibling, id ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong sibling prefix id", string( "docs-id" ), id );
+
+    // Removing an object forgets the paths below it
+    cache.remove( "docs-id" );
+    id = "root";
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Removed path still known", size_t( 0 ), cache.resolve( segments, id ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Id changed without known prefix", string( "root" ), id );
+
+    // Only the lookups finding the whole path are hits
+    cache.add( segments, 3, "2024-id" );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong full prefix", size_t( 3 ), cache.resolve( segments, id ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong hits count", long( 1 ), cache.getHits( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong misses count", long( 3 ), cache.getMisses( ) );
+    cache.resetCounters( );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Misses not reset", long( 0 ), cache.getMisses( ) );
+
+    // A full path added alone is kept with a TTL, but the segments above
+    // it aren't known
+    PathCache expiring;
+    expiring.setTtl( 60 );
+    vector< string > nested = PathCache::splitPath( "/Docs/Reports/a.odt" );
+    expiring.add( nested, nested.size( ), "a-id" );
+    id = "root";
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Nested path not kept", size_t( 3 ), expiring.resolve( nested, id ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong nested path id", string( "a-id" ), id );
+
+    vector< string > nestedSibling = PathCache::splitPath( "/Docs/Reports/b.odt" );
+    id = "root";
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Prefix without id known", size_t( 0 ), expiring.resolve( nestedSibling, id ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Empty prefix id returned", string( "root" ), id );
+}
+
+void CommonsTest::concurrencyLimiterTest( )
+{
+    ConcurrencyLimiter limiter( 2, 4 );
+    CPPUNIT_ASSERT( limiter.tryAcquire( ) );
+    CPPUNIT_ASSERT( limiter.tryAcquire( ) );
+    CPPUNIT_ASSERT_MESSAGE( "Limit not enforced", !limiter.tryAcquire( ) );
+
+    // The excess requests wait for a slot
+    thread waiting( [&limiter] { limiter.acquire( ); } );
+    while ( limiter.getQueued( ) == 0 )
+        this_thread::yield( );
+
+    // Requests using all the slots with a flat latency raise the limit...
+    limiter.release( 10, false );
+    waiting.join( );
+    CPPUNIT_ASSERT_EQUAL( 0u, limiter.getQueued( ) );
+    limiter.release( 10, false );
+    CPPUNIT_ASSERT( limiter.tryAcquire( ) );
+    limiter.release( 10, false );
+    limiter.release( 10, false );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Limit not raised", 3u, limiter.getLimit( ) );
+
+    // ... and throttling cuts it
+    CPPUNIT_ASSERT( limiter.tryAcquire( ) );
+    limiter.release( 10, true );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Limit not cut", 1u, limiter.getLimit( ) );
+
+    CPPUNIT_ASSERT_EQUAL( string( "example.com:8443" ),
+            ConcurrencyLimiter::getHost( "https://user@Example.com:8443/cmis?id=1" ) );
+
+    // Limits are disabled by default
+    CPPUNIT_ASSERT( !ConcurrencyLimiter::get( "http://mockup/mock" ) );
+    SessionFactory::setConcurrencyLimits( 2, 8 );
+    ConcurrencyLimiterPtr host = ConcurrencyLimiter::get( "http://mockup/mock" );
+    CPPUNIT_ASSERT( host );
+    CPPUNIT_ASSERT_EQUAL( 2u, SessionFactory::getConcurrencyLimit( "mockup" ) );
+    CPPUNIT_ASSERT_EQUAL( 0u, SessionFactory::getQueuedRequests( "http://mockup/other" ) );
+    SessionFactory::setConcurrencyLimits( 0, 0 );
+    CPPUNIT_ASSERT_EQUAL( 0u, SessionFactory::getConcurrencyLimit( "mockup" ) );
+}
+
+void CommonsTest::traceSpanJsonTest( )
+{
+    TraceSpan span( 1, 2, 1, "Folder::getChildren",
+                    boost::posix_time::time_from_string( "2026-01-02 03:04:05" ) );
+    span.setDuration( 0.5 );
+    span.addRequest( RequestMetrics( "GET", "http://mockup/\"children\"", 200,
+                                     0, 0, 0, 0.25, 0.5, 120, 0 ) );
+    span.addRequest( RequestMetrics( "PUT", "http://mockup/content", 201,
+                                     0, 0, 0, 0, 0, 2, 30 ) );
+
+    CPPUNIT_ASSERT_EQUAL( 122L, span.getDownloadSize( ) );
+    CPPUNIT_ASSERT_EQUAL( 30L, span.getUploadSize( ) );
+
+    string expected = "{\"traceId\":1,\"spanId\":2,\"parentId\":1,"
+        "\"name\":\"Folder::getChildren\",\"start\":\"2026-01-02T03:04:05Z\","
+        "\"duration\":0.5,\"failed\":false,\"downloadSize\":122,\"uploadSize\":30,"
+        "\"requests\":[{\"method\":\"GET\",\"url\":\"http://mockup/\\\"children\\\"\",\"status\":200,"
+        "\"nameLookupTime\":0,\"connectTime\":0,\"appConnectTime\":0,"
+        "\"startTransferTime\":0.25,\"totalTime\":0.5,\"downloadSize\":120,\"uploadSize\":0},"
+        "{\"method\":\"PUT\",\"url\":\"http://mockup/content\",\"status\":201,"
+        "\"nameLookupTime\":0,\"connectTime\":0,\"appConnectTime\":0,"
+        "\"startTransferTime\":0,\"totalTime\":0,\"downloadSize\":2,\"uploadSize\":30}]}";
+    CPPUNIT_ASSERT_EQUAL( expected, JsonLinesTraceExporter::toJson( span ) );
+}
+
+void CommonsTest::latencyHistogramTest( )
+{
+    // Each value falls in a bucket at most 12.5% wide
+    CPPUNIT_ASSERT_EQUAL( size_t( 5 ), LatencyHistogram::getBucket( 5 ) );
+    for ( long value = 1; value < 100000000L; value = value * 3 / 2 + 1 )
+    {
+        size_t bucket = LatencyHistogram::getBucket( value );
+        long lower = LatencyHistogram::getBucketLowerBound( bucket );
+        long upper = LatencyHistogram::getBucketLowerBound( bucket + 1 );
+        CPPUNIT_ASSERT( lower <= value && value < upper );
+        CPPUNIT_ASSERT( ( upper - lower ) * 8 <= lower || upper - lower == 1 );
+    }
+    CPPUNIT_ASSERT_EQUAL( LatencyHistogram::getBucketsCount( ) - 1, LatencyHistogram::getBucket( LONG_MAX ) );
+
+    vector< long > counts( LatencyHistogram::getBucketsCount( ), 0 );
+    counts[ LatencyHistogram::getBucket( 1000 ) ] = 99;
+    counts[ LatencyHistogram::getBucket( 50000 ) ] = 1;
+    LatencyHistogram histogram( counts, 1000, 50000, 99 * 1000 + 50000 );
+    CPPUNIT_ASSERT_EQUAL( 100L, histogram.getCount( ) );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE( "Wrong mean", 1.49, histogram.getMean( ), 0.001 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE( "Wrong median", 1.0, histogram.getPercentile( 50 ), 0.125 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE( "Wrong 99th percentile", 1.0, histogram.getPercentile( 99 ), 0.125 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE( "Maximum not reached", 50.0, histogram.getPercentile( 100 ), 0.001 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE( "Empty histogram percentile", 0.0, LatencyHistogram( ).getPercentile( 50 ), 0.001 );
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION( CommonsTest );
@@ -26,6 +26,8 @@
  * instead of those above.
  */
 
+#include <algorithm>
+
 #include <cppunit/extensions/HelperMacros.h>
 #include <cppunit/TestFixture.h>
 #include <cppunit/TestAssert.h>
@@ -44,6 +46,8 @@ class DecoderTest : public CppUnit::TestFixture
         FILE* stream;
 
         string getActual( );
+        string getLargeInput( );
+        string getLargeExpected( );
 
     public:
 
@@ -68,6 +72,8 @@ class DecoderTest : public CppUnit::TestFixture
         void base64EncodeSplitRunsTest( );
 
         void base64encodeTest( );
+        void base64EncodeLargeTest( );
+        void base64DecodeLargeTest( );
 
         CPPUNIT_TEST_SUITE( DecoderTest );
         CPPUNIT_TEST( noEncodingTest );
@@ -80,6 +86,8 @@ class DecoderTest : public CppUnit::TestFixture
         CPPUNIT_TEST( base64EncodePaddedBlockTest );
         CPPUNIT_TEST( base64EncodeSplitRunsTest );
         CPPUNIT_TEST( base64encodeTest );
+        CPPUNIT_TEST( base64EncodeLargeTest );
+        CPPUNIT_TEST( base64DecodeLargeTest );
         CPPUNIT_TEST_SUITE_END( );
 };
 
@@ -135,6 +143,41 @@ string DecoderTest::getActual( )
     return actual;
 }
 
+string DecoderTest::getLargeInput( )
+{
+    // Big enough to span several chunks of the bulk codec, and not
+    // a multiple of 3 to end with a padded block.
+    string input;
+    for ( size_t i = 0; i < 100000; ++i )
+        input += char( ( i * 7 + i / 251 ) & 0xFF );
+    return input;
+}
+
+string DecoderTest::getLargeExpected( )
+{
+    static const char chars[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    string input = getLargeInput( );
+    string expected;
+    for ( size_t i = 0; i < input.size( ); i += 3 )
+    {
+        unsigned long block = static_cast< unsigned char >( input[i] ) << 16;
+        size_t count = min( size_t( 3 ), input.size( ) - i );
+        if ( count > 1 )
+            block += static_cast< unsigned char >( input[i + 1] ) << 8;
+        if ( count > 2 )
+            block += static_cast< unsigned char >( input[i + 2] );
+        for ( size_t j = 0; j < 4; ++j )
+        {
+            if ( j <= count )
+                expected += chars[ ( block >> ( 18 - j * 6 ) ) & 0x3F ];
+            else
+                expected += '=';
+        }
+    }
+    return expected;
+}
+
 void DecoderTest::noEncodingTest()
 {
     data->decode( ( void* )"pleasure.", 1, 9 );
@@ -232,4 +275,46 @@ void DecoderTest::base64encodeTest( )
     CPPUNIT_ASSERT_EQUAL( string( "c3VyZS4=" ), actual );
 }
 
+void DecoderTest::base64EncodeLargeTest( )
+{
+    data->setEncoding( BASE64_ENCODING );
+    string input = getLargeInput( );
+
+    // Feed the data in uneven runs to break the blocks anywhere
+    size_t pos = 0;
+    size_t runSize = 1;
+    while ( pos < input.size( ) )
+    {
+        size_t len = min( runSize, input.size( ) - pos );
+        data->encode( ( void* )( input.c_str( ) + pos ), 1, len );
+        pos += len;
+        runSize = runSize * 3 + 1;
+    }
+    data->finish( );
+    CPPUNIT_ASSERT_EQUAL( getLargeExpected( ), getActual( ) );
+}
+
+void DecoderTest::base64DecodeLargeTest( )
+{
+    data->setEncoding( BASE64_ENCODING );
+
+    // Wrap the lines like MIME does: the line breaks have to be skipped
+    string encoded = getLargeExpected( );
+    string input;
+    for ( size_t i = 0; i < encoded.size( ); i += 76 )
+        input += encoded.substr( i, 76 ) + "\r\n";
+
+    size_t pos = 0;
+    size_t runSize = 5;
+    while ( pos < input.size( ) )
+    {
+        size_t len = min( runSize, input.size( ) - pos );
+        data->decode( ( void* )( input.c_str( ) + pos ), 1, len );
+        pos += len;
+        runSize = runSize * 2 + 3;
+    }
+    data->finish( );
+    CPPUNIT_ASSERT( getLargeInput( ) == getActual( ) );
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION( DecoderTest );
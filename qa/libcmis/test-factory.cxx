@@ -163,6 +163,9 @@ class FactoryTest : public CppUnit::TestFixture
         void createSessionSharePointTest( );
         void createSessionSharePointDefaultAuthTest( );
         void createSessionSharePointBadAuthTest( );
+        void connectionCacheSharedTest( );
+        void connectionCacheFlushTest( );
+        void connectionCacheDisabledTest( );
 
         CPPUNIT_TEST_SUITE( FactoryTest );
         CPPUNIT_TEST( createSessionAtomTest );
@@ -175,6 +178,9 @@ class FactoryTest : public CppUnit::TestFixture
         CPPUNIT_TEST( createSessionSharePointTest );
         CPPUNIT_TEST( createSessionSharePointDefaultAuthTest );
         CPPUNIT_TEST( createSessionSharePointBadAuthTest );
+        CPPUNIT_TEST( connectionCacheSharedTest );
+        CPPUNIT_TEST( connectionCacheFlushTest );
+        CPPUNIT_TEST( connectionCacheDisabledTest );
         CPPUNIT_TEST_SUITE_END( );
 };
 
@@ -334,3 +340,58 @@ void FactoryTest::createSessionNoCmisTest( )
             SERVER_REPOSITORY ) );
     CPPUNIT_ASSERT_MESSAGE( "Session should be NULL", !session );
 }
+
+void FactoryTest::connectionCacheSharedTest( )
+{
+    lcl_init_mockup_atom( );
+
+    unique_ptr< libcmis::Session > session1( libcmis::SessionFactory::createSession(
+            BINDING_ATOM, SERVER_USERNAME, SERVER_PASSWORD,
+            SERVER_REPOSITORY ) );
+    unique_ptr< libcmis::Session > session2( libcmis::SessionFactory::createSession(
+            BINDING_ATOM, SERVER_USERNAME, SERVER_PASSWORD,
+            SERVER_REPOSITORY ) );
+
+    CURLSH* share1 = curl_mockup_getShare( dynamic_cast< AtomPubSession* >( session1.get() )->m_curlHandle );
+    CURLSH* share2 = curl_mockup_getShare( dynamic_cast< AtomPubSession* >( session2.get() )->m_curlHandle );
+    CPPUNIT_ASSERT_MESSAGE( "Session not attached to the connection cache", share1 != NULL );
+    CPPUNIT_ASSERT_MESSAGE( "Sessions not sharing the connection cache", share1 == share2 );
+
+    CPPUNIT_ASSERT_MESSAGE( "DNS cache not shared", curl_mockup_isShared( share1, CURL_LOCK_DATA_DNS ) );
+    CPPUNIT_ASSERT_MESSAGE( "TLS sessions not shared", curl_mockup_isShared( share1, CURL_LOCK_DATA_SSL_SESSION ) );
+    CPPUNIT_ASSERT_MESSAGE( "Connections not shared", curl_mockup_isShared( share1, CURL_LOCK_DATA_CONNECT ) );
+    CPPUNIT_ASSERT_MESSAGE( "Cookies shouldn't be shared", !curl_mockup_isShared( share1, CURL_LOCK_DATA_COOKIE ) );
+}
+
+void FactoryTest::connectionCacheFlushTest( )
+{
+    lcl_init_mockup_atom( );
+
+    unique_ptr< libcmis::Session > session( libcmis::SessionFactory::createSession(
+            BINDING_ATOM, SERVER_USERNAME, SERVER_PASSWORD,
+            SERVER_REPOSITORY ) );
+    AtomPubSession* atomSession = dynamic_cast< AtomPubSession* >( session.get() );
+    CURLSH* before = curl_mockup_getShare( atomSession->m_curlHandle );
+
+    libcmis::SessionFactory::flushConnectionCache( );
+
+    // The session moves to the new cache on its next request
+    atomSession->httpGetRequest( BINDING_ATOM );
+    CURLSH* after = curl_mockup_getShare( atomSession->m_curlHandle );
+    CPPUNIT_ASSERT_MESSAGE( "Session not attached to the connection cache", after != NULL );
+    CPPUNIT_ASSERT_MESSAGE( "Session still using the flushed cache", before != after );
+}
+
+void FactoryTest::connectionCacheDisabledTest( )
+{
+    lcl_init_mockup_atom( );
+
+    libcmis::SessionFactory::setConnectionCacheOptions( false, false, false );
+    unique_ptr< libcmis::Session > session( libcmis::SessionFactory::createSession(
+            BINDING_ATOM, SERVER_USERNAME, SERVER_PASSWORD,
+            SERVER_REPOSITORY ) );
+    libcmis::SessionFactory::setConnectionCacheOptions( true, true, true );
+
+    CURLSH* share = curl_mockup_getShare( dynamic_cast< AtomPubSession* >( session.get() )->m_curlHandle );
+    CPPUNIT_ASSERT_MESSAGE( "Session shouldn't use a connection cache", share == NULL );
+}
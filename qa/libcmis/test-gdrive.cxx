@@ -52,6 +52,7 @@
 #include "gdrive-property.hxx"
 #include "oauth2-handler.hxx"
 #include "gdrive-object.hxx"
+#include "gdrive-utils.hxx"
 
 using namespace std;
 using namespace libcmis;
@@ -101,6 +102,7 @@ class GDriveTest : public CppUnit::TestFixture
         void getObjectByPathRootTest( );
         void getObjectByPathTest( );
         void getObjectByPathMissingTest( );
+        void getObjectByPathCacheTest( );
         void getDocumentTest( );
         void getFolderTest( );
         void getDocumentParentsTest( );
@@ -138,6 +140,7 @@ class GDriveTest : public CppUnit::TestFixture
         CPPUNIT_TEST( getObjectByPathRootTest );
         CPPUNIT_TEST( getObjectByPathTest );
         CPPUNIT_TEST( getObjectByPathMissingTest );
+        CPPUNIT_TEST( getObjectByPathCacheTest );
         CPPUNIT_TEST( getDocumentTest );
         CPPUNIT_TEST( getFolderTest );
         CPPUNIT_TEST( getDocumentParentsTest );
@@ -870,6 +873,47 @@ void GDriveTest::getObjectByPathMissingTest()
     }
 }
 
+void GDriveTest::getObjectByPathCacheTest( )
+{
+    // Mockup setup
+    GDriveSessionPtr session = getTestSession( USERNAME, PASSWORD );
+    session->setPathCacheTtl( -1 );
+    string searchUrl = BASE_URL + "/files/";
+    curl_mockup_addResponse( searchUrl.c_str( ), libcmis::escape( "name='Folder'" ).c_str( ), "GET",
+                             "{ \"files\": [ { \"id\": \"aFolderId\" } ] }", 200, false );
+    curl_mockup_addResponse( searchUrl.c_str( ), libcmis::escape( "name='File'" ).c_str( ), "GET",
+                             "{ \"files\": [ { \"id\": \"aFileId\" } ] }", 200, false );
+    curl_mockup_addResponse( searchUrl.c_str( ), libcmis::escape( "name='Sibling'" ).c_str( ), "GET",
+                             "{ \"files\": [ { \"id\": \"aSiblingId\" } ] }", 200, false );
+    curl_mockup_addResponse( ( GDRIVE_METADATA_LINK + "aFileId" ).c_str( ), "", "GET",
+                             "{ \"kind\": \"drive#file\", \"id\": \"aFileId\", \"name\": \"File\" }", 200, false );
+    curl_mockup_addResponse( ( GDRIVE_METADATA_LINK + "aSiblingId" ).c_str( ), "", "GET",
+                             "{ \"kind\": \"drive#file\", \"id\": \"aSiblingId\", \"name\": \"Sibling\" }", 200, false );
+
+    CPPUNIT_ASSERT_EQUAL( string( "aFileId" ), session->getObjectByPath( "/Folder/File" )->getId( ) );
+
+    // The folder is known already: only the sibling is looked for
+    CPPUNIT_ASSERT_EQUAL( string( "aSiblingId" ), session->getObjectByPath( "/Folder/Sibling" )->getId( ) );
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( searchUrl.c_str( ),
+                libcmis::escape( "name='Folder'" ).c_str( ), "GET" ) );
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( searchUrl.c_str( ),
+                libcmis::escape( "name='Sibling'" ).c_str( ), "GET" ) );
+
+    // The file was replaced by someone else: the stale id is forgotten
+    curl_mockup_reset( );
+    curl_mockup_addResponse( searchUrl.c_str( ), libcmis::escape( "name='Folder'" ).c_str( ), "GET",
+                             "{ \"files\": [ { \"id\": \"aFolderId\" } ] }", 200, false );
+    curl_mockup_addResponse( searchUrl.c_str( ), libcmis::escape( "name='File'" ).c_str( ), "GET",
+                             "{ \"files\": [ { \"id\": \"aNewFileId\" } ] }", 200, false );
+    curl_mockup_addResponse( ( GDRIVE_METADATA_LINK + "aFileId" ).c_str( ), "", "GET", "", 404, false );
+    curl_mockup_addResponse( ( GDRIVE_METADATA_LINK + "aNewFileId" ).c_str( ), "", "GET",
+                             "{ \"kind\": \"drive#file\", \"id\": \"aNewFileId\", \"name\": \"File\" }", 200, false );
+
+    CPPUNIT_ASSERT_EQUAL( string( "aNewFileId" ), session->getObjectByPath( "/Folder/File" )->getId( ) );
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( searchUrl.c_str( ),
+                libcmis::escape( "name='File'" ).c_str( ), "GET" ) );
+}
+
 void GDriveTest::getDocumentAllowableActionsTest( )
 {
     curl_mockup_reset( );
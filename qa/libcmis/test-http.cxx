@@ -0,0 +1,638 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestAssert.h>
+
+#if defined __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wkeyword-macro"
+#endif
+#define private public
+#define protected public
+#if defined __clang__
+#pragma clang diagnostic pop
+#endif
+
+#include <http-session.hxx>
+#include <oauth2-handler.hxx>
+#include <libcmis/session-factory.hxx>
+
+#include <mockup-config.h>
+
+#define SERVER_URL string( "http://mockup/http" )
+#define TOKEN_URL string( "https://token/url" )
+
+using namespace std;
+
+namespace
+{
+    /** Stream buffer that can't seek, like the ones of a pipe.
+      */
+    class UnseekableBuffer : public streambuf
+    {
+        private:
+            string m_data;
+
+        public:
+            explicit UnseekableBuffer( const string& data ) :
+                streambuf( ),
+                m_data( data )
+            {
+                char* begin = &m_data[0];
+                setg( begin, begin, begin + m_data.size( ) );
+            }
+    };
+
+    class MetricsCollector : public libcmis::RequestObserver
+    {
+        public:
+            MetricsCollector( ) : m_mutex( ), m_metrics( ) { }
+
+            virtual void requestDone( const libcmis::RequestMetrics& metrics )
+            {
+                lock_guard< mutex > guard( m_mutex );
+                m_metrics.push_back( metrics );
+            }
+
+            mutex m_mutex;
+            vector< libcmis::RequestMetrics > m_metrics;
+    };
+}
+
+class HttpTest : public CppUnit::TestFixture
+{
+    public:
+
+        void asyncGetRequestTest( );
+        void asyncCallbackTest( );
+        void asyncPostRequestTest( );
+        void asyncErrorTest( );
+        void asyncExpect100Test( );
+        void asyncRefreshTokenTest( );
+        void conditionalGetTest( );
+        void compressedResponsesTest( );
+        void requestMetricsTest( );
+        void statisticsCountersTest( );
+        void retryThrottledTest( );
+        void retryWaitUnlockedTest( );
+        void retryAsyncThrottledTest( );
+        void retryAsyncBusySessionTest( );
+        void uploadRetryTest( );
+        void uploadUnseekableStreamTest( );
+
+        CPPUNIT_TEST_SUITE( HttpTest );
+        CPPUNIT_TEST( asyncGetRequestTest );
+        CPPUNIT_TEST( asyncCallbackTest );
+        CPPUNIT_TEST( asyncPostRequestTest );
+        CPPUNIT_TEST( asyncErrorTest );
+        CPPUNIT_TEST( asyncExpect100Test );
+        CPPUNIT_TEST( asyncRefreshTokenTest );
+        CPPUNIT_TEST( conditionalGetTest );
+        CPPUNIT_TEST( compressedResponsesTest );
+        CPPUNIT_TEST( requestMetricsTest );
+        CPPUNIT_TEST( statisticsCountersTest );
+        CPPUNIT_TEST( retryThrottledTest );
+        CPPUNIT_TEST( retryWaitUnlockedTest );
+        CPPUNIT_TEST( retryAsyncThrottledTest );
+        CPPUNIT_TEST( retryAsyncBusySessionTest );
+        CPPUNIT_TEST( uploadRetryTest );
+        CPPUNIT_TEST( uploadUnseekableStreamTest );
+        CPPUNIT_TEST_SUITE_END( );
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( HttpTest );
+
+void HttpTest::asyncGetRequestTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( ( SERVER_URL + "/a" ).c_str( ), "", "GET", "content a", 200, false );
+    curl_mockup_addResponse( ( SERVER_URL + "/b" ).c_str( ), "", "GET", "content b", 200, false );
+
+    HttpSession session( "user", "pass" );
+    future< libcmis::HttpResponsePtr > a = session.httpGetRequestAsync( SERVER_URL + "/a" );
+    future< libcmis::HttpResponsePtr > b = session.httpGetRequestAsync( SERVER_URL + "/b" );
+
+    CPPUNIT_ASSERT_EQUAL( string( "content b" ), b.get( )->getBody( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "content a" ), a.get( )->getBody( ) );
+
+    // The synchronous requests still work alongside
+    libcmis::HttpResponsePtr response = session.httpGetRequest( SERVER_URL + "/a" );
+    CPPUNIT_ASSERT_EQUAL( string( "content a" ), response->getBody( ) );
+}
+
+void HttpTest::asyncCallbackTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "DELETE", "", 204, false );
+
+    HttpSession session( "user", "pass" );
+    promise< bool > called;
+    future< libcmis::HttpResponsePtr > result = session.httpDeleteRequestAsync( SERVER_URL,
+            [&called] ( libcmis::HttpResponsePtr response, exception_ptr error )
+            {
+                called.set_value( response && !error );
+            } );
+
+    CPPUNIT_ASSERT_MESSAGE( "Callback not called with the response", called.get_future( ).get( ) );
+    CPPUNIT_ASSERT( result.get( ) );
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( SERVER_URL.c_str( ), "", "DELETE" ) );
+}
+
+void HttpTest::asyncPostRequestTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "POST", "posted", 201, false );
+
+    HttpSession session( "user", "pass" );
+    istringstream is( "some body" );
+    future< libcmis::HttpResponsePtr > result =
+        session.httpPostRequestAsync( SERVER_URL, is, "text/plain" );
+
+    CPPUNIT_ASSERT_EQUAL( string( "posted" ), result.get( )->getBody( ) );
+
+    const struct HttpRequest* request = curl_mockup_getRequest( SERVER_URL.c_str( ), "", "POST" );
+    char* contentType = curl_mockup_HttpRequest_getHeader( request, "Content-Type" );
+    CPPUNIT_ASSERT_EQUAL( string( "some body" ), string( request->body ) );
+    CPPUNIT_ASSERT_EQUAL( string( "text/plain" ), string( contentType ) );
+    free( contentType );
+    curl_mockup_HttpRequest_free( request );
+}
+
+void HttpTest::asyncErrorTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "GET", "Not found", 404, false );
+
+    HttpSession session( "user", "pass" );
+    promise< bool > failed;
+    future< libcmis::HttpResponsePtr > result = session.httpGetRequestAsync( SERVER_URL,
+            [&failed] ( libcmis::HttpResponsePtr response, exception_ptr error )
+            {
+                failed.set_value( !response && error );
+            } );
+
+    CPPUNIT_ASSERT_MESSAGE( "Callback not called with the error", failed.get_future( ).get( ) );
+    try
+    {
+        result.get( );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& e )
+    {
+        CPPUNIT_ASSERT_EQUAL( long( 404 ), e.getHttpStatus( ) );
+    }
+}
+
+void HttpTest::asyncExpect100Test( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "PUT", "", 417, false );
+
+    HttpSession session( "user", "pass" );
+    istringstream is( "header:some content" );
+    is.seekg( 7 );
+    future< libcmis::HttpResponsePtr > result =
+        session.httpPutRequestAsync( SERVER_URL, is, vector< string >( ) );
+
+    try
+    {
+        result.get( );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+
+    // The request has been retried without the Expect header and this is
+    // remembered for the next requests
+    CPPUNIT_ASSERT_EQUAL( 2, curl_mockup_getRequestsCount( SERVER_URL.c_str( ), "", "PUT" ) );
+    CPPUNIT_ASSERT( session.m_no100Continue );
+
+    // The caller's stream is sent from where it was, both times
+    CPPUNIT_ASSERT_EQUAL( string( "some content" ),
+                          string( curl_mockup_getRequestBody( SERVER_URL.c_str( ), "", "PUT" ) ) );
+    CPPUNIT_ASSERT_EQUAL( streampos( 7 ), is.tellg( ) );
+}
+
+void HttpTest::asyncRefreshTokenTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "GET", "", 401, false );
+    curl_mockup_addResponse( TOKEN_URL.c_str( ), "", "POST",
+                             "{ \"access_token\": \"new-token\" }", 200, false );
+
+    HttpSession session( "user", "pass" );
+    libcmis::OAuth2DataPtr data( new libcmis::OAuth2Data( "https://auth/url", TOKEN_URL,
+                "scope", "redirect:uri", "mock-id", "mock-secret" ) );
+    session.m_oauth2Handler.reset( new OAuth2Handler( &session, data ) );
+    session.m_oauth2Handler->m_access = "old-token";
+    session.m_oauth2Handler->m_refresh = "refresh-token";
+
+    future< libcmis::HttpResponsePtr > result = session.httpGetRequestAsync( SERVER_URL );
+    try
+    {
+        result.get( );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+
+    // The token has been refreshed and the request sent again, but only once
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( TOKEN_URL.c_str( ), "", "POST" ) );
+    CPPUNIT_ASSERT_EQUAL( 2, curl_mockup_getRequestsCount( SERVER_URL.c_str( ), "", "GET" ) );
+    CPPUNIT_ASSERT_EQUAL( string( "new-token" ), session.m_oauth2Handler->getAccessToken( ) );
+}
+
+void HttpTest::conditionalGetTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "GET", "content", 200, false,
+                             "ETag: \"v1\"\r\n" );
+
+    HttpSession session( "user", "pass" );
+    libcmis::HttpValidators validators;
+    libcmis::HttpResponsePtr response = session.httpConditionalGetRequest( SERVER_URL, validators );
+    CPPUNIT_ASSERT_EQUAL( string( "content" ), response->getBody( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "\"v1\"" ), validators.getETag( ) );
+
+    // The server answers 304 to the request with the ETag
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "GET", "", 304, false );
+
+    response = session.httpConditionalGetRequest( SERVER_URL, validators );
+    CPPUNIT_ASSERT_MESSAGE( "Response returned for 304", !response );
+    CPPUNIT_ASSERT_EQUAL( string( "\"v1\"" ), validators.getETag( ) );
+
+    const struct HttpRequest* request = curl_mockup_getRequest( SERVER_URL.c_str( ), "", "GET" );
+    char* ifNoneMatch = curl_mockup_HttpRequest_getHeader( request, "If-None-Match" );
+    CPPUNIT_ASSERT_MESSAGE( "Missing If-None-Match header", ifNoneMatch != NULL );
+    CPPUNIT_ASSERT_EQUAL( string( "\"v1\"" ), libcmis::trim( string( ifNoneMatch ) ) );
+    free( ifNoneMatch );
+    curl_mockup_HttpRequest_free( request );
+}
+
+void HttpTest::compressedResponsesTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( ( SERVER_URL + "/feed" ).c_str( ), "", "GET", "feed", 200, false );
+    curl_mockup_addResponse( ( SERVER_URL + "/content" ).c_str( ), "", "GET", "content", 200, false );
+    curl_mockup_addResponse( ( SERVER_URL + "/plain" ).c_str( ), "", "GET", "plain", 200, false );
+
+    HttpSession session( "user", "pass" );
+    session.httpGetRequest( SERVER_URL + "/feed" );
+    session.httpGetContentRequest( SERVER_URL + "/content" );
+    session.setCompressedResponses( false );
+    session.httpGetRequest( SERVER_URL + "/plain" );
+
+    const char* urls[] = { "/feed", "/content", "/plain" };
+    const bool expected[] = { true, false, false };
+    for ( size_t i = 0; i < 3; ++i )
+    {
+        const struct HttpRequest* request = curl_mockup_getRequest( ( SERVER_URL + urls[i] ).c_str( ), "", "GET" );
+        char* acceptEncoding = curl_mockup_HttpRequest_getHeader( request, "Accept-Encoding" );
+        CPPUNIT_ASSERT_EQUAL_MESSAGE( string( "Wrong Accept-Encoding for " ) + urls[i],
+                                      expected[i], acceptEncoding != NULL );
+        free( acceptEncoding );
+        curl_mockup_HttpRequest_free( request );
+    }
+}
+
+void HttpTest::requestMetricsTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( ( SERVER_URL + "/feed" ).c_str( ), "", "GET", "feed", 200, false );
+    curl_mockup_addResponse( ( SERVER_URL + "/post" ).c_str( ), "", "POST", "posted", 201, false );
+    curl_mockup_addResponse( ( SERVER_URL + "/missing" ).c_str( ), "", "DELETE", "", 404, false );
+    curl_mockup_addResponse( ( SERVER_URL + "/async" ).c_str( ), "", "GET", "async", 200, false );
+
+    boost::shared_ptr< MetricsCollector > collector( new MetricsCollector( ) );
+    libcmis::SessionFactory::setRequestObserver( collector );
+
+    HttpSession session( "user", "pass" );
+    session.httpGetRequest( SERVER_URL + "/feed?id=secret" );
+    istringstream is( "some body" );
+    session.httpPostRequest( SERVER_URL + "/post", is, "text/plain" );
+    try
+    {
+        session.httpDeleteRequest( SERVER_URL + "/missing" );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+    session.httpGetRequestAsync( SERVER_URL + "/async" ).get( );
+
+    libcmis::SessionFactory::setRequestObserver( libcmis::RequestObserverPtr( ) );
+    session.httpGetRequest( SERVER_URL + "/feed" );
+
+    lock_guard< mutex > guard( collector->m_mutex );
+    CPPUNIT_ASSERT_EQUAL( size_t( 4 ), collector->m_metrics.size( ) );
+
+    // The query is left out of the URL
+    const libcmis::RequestMetrics& get = collector->m_metrics[0];
+    CPPUNIT_ASSERT_EQUAL( string( "GET" ), get.getMethod( ) );
+    CPPUNIT_ASSERT_EQUAL( SERVER_URL + "/feed", get.getUrlTemplate( ) );
+    CPPUNIT_ASSERT_EQUAL( 200L, get.getStatus( ) );
+    CPPUNIT_ASSERT_EQUAL( 4L, get.getDownloadSize( ) );
+    CPPUNIT_ASSERT_EQUAL( 0L, get.getUploadSize( ) );
+
+    const libcmis::RequestMetrics& post = collector->m_metrics[1];
+    CPPUNIT_ASSERT_EQUAL( string( "POST" ), post.getMethod( ) );
+    CPPUNIT_ASSERT_EQUAL( 201L, post.getStatus( ) );
+    CPPUNIT_ASSERT_EQUAL( 6L, post.getDownloadSize( ) );
+    CPPUNIT_ASSERT_EQUAL( 9L, post.getUploadSize( ) );
+
+    // The failed requests are reported too
+    const libcmis::RequestMetrics& del = collector->m_metrics[2];
+    CPPUNIT_ASSERT_EQUAL( string( "DELETE" ), del.getMethod( ) );
+    CPPUNIT_ASSERT_EQUAL( 404L, del.getStatus( ) );
+
+    const libcmis::RequestMetrics& async = collector->m_metrics[3];
+    CPPUNIT_ASSERT_EQUAL( string( "GET" ), async.getMethod( ) );
+    CPPUNIT_ASSERT_EQUAL( SERVER_URL + "/async", async.getUrlTemplate( ) );
+    CPPUNIT_ASSERT_EQUAL( 5L, async.getDownloadSize( ) );
+}
+
+void HttpTest::statisticsCountersTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( ( SERVER_URL + "/feed" ).c_str( ), "", "GET", "feed", 200, false );
+    curl_mockup_addResponse( ( SERVER_URL + "/post" ).c_str( ), "", "POST", "posted", 201, false );
+    curl_mockup_addResponse( ( SERVER_URL + "/missing" ).c_str( ), "", "DELETE", "", 404, false );
+    curl_mockup_addResponse( ( SERVER_URL + "/busy" ).c_str( ), "", "GET", "", 503, false, "Retry-After: 0\r\n" );
+
+    HttpSession session( "user", "pass" );
+    session.setRetryPolicy( 1, 1, 1000 );
+    session.httpGetRequest( SERVER_URL + "/feed" );
+    session.httpGetRequestAsync( SERVER_URL + "/feed" ).get( );
+    istringstream is( "some body" );
+    session.httpPostRequest( SERVER_URL + "/post", is, "text/plain" );
+    try
+    {
+        session.httpDeleteRequest( SERVER_URL + "/missing" );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+    try
+    {
+        session.httpGetRequest( SERVER_URL + "/busy" );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+
+    libcmis::SessionStatistics statistics = session.getStatisticsCounters( ).getStatistics( );
+    CPPUNIT_ASSERT_EQUAL( 4L, statistics.getRequests( "GET" ) );
+    CPPUNIT_ASSERT_EQUAL( 1L, statistics.getRequests( "POST" ) );
+    CPPUNIT_ASSERT_EQUAL( 1L, statistics.getRequests( "DELETE" ) );
+    CPPUNIT_ASSERT_EQUAL( 0L, statistics.getRequests( "PUT" ) );
+    CPPUNIT_ASSERT_EQUAL( 6L, statistics.getRequestsCount( ) );
+    CPPUNIT_ASSERT_EQUAL( 3L, statistics.getResponses( 2 ) );
+    CPPUNIT_ASSERT_EQUAL( 1L, statistics.getResponses( 4 ) );
+    CPPUNIT_ASSERT_EQUAL( 2L, statistics.getResponses( 5 ) );
+    CPPUNIT_ASSERT_EQUAL( 14L, statistics.getBytesReceived( ) );
+    CPPUNIT_ASSERT_EQUAL( 9L, statistics.getBytesSent( ) );
+    CPPUNIT_ASSERT_EQUAL( 1L, statistics.getRetries( ) );
+
+    const map< string, libcmis::LatencyHistogram >& latencies = statistics.getLatencies( );
+    CPPUNIT_ASSERT_EQUAL( size_t( 3 ), latencies.size( ) );
+    CPPUNIT_ASSERT_EQUAL( 4L, latencies.find( "HTTP GET" )->second.getCount( ) );
+
+    session.getStatisticsCounters( ).reset( );
+    statistics = session.getStatisticsCounters( ).getStatistics( );
+    CPPUNIT_ASSERT_EQUAL( 0L, statistics.getRequestsCount( ) );
+    CPPUNIT_ASSERT_EQUAL( 0L, statistics.getResponses( 2 ) );
+    CPPUNIT_ASSERT_EQUAL( 0L, statistics.getRetries( ) );
+    CPPUNIT_ASSERT( statistics.getLatencies( ).empty( ) );
+}
+
+void HttpTest::retryThrottledTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( ( SERVER_URL + "/get" ).c_str( ), "", "GET", "", 503, false, "Retry-After: 0\r\n" );
+    curl_mockup_addResponse( ( SERVER_URL + "/post" ).c_str( ), "", "POST", "", 429, false );
+    curl_mockup_addResponse( ( SERVER_URL + "/later" ).c_str( ), "", "GET", "", 429, false, "Retry-After: 120\r\n" );
+    curl_mockup_addResponse( ( SERVER_URL + "/budget" ).c_str( ), "", "DELETE", "", 429, false );
+    curl_mockup_addResponse( ( SERVER_URL + "/delete-later" ).c_str( ), "", "DELETE", "", 503, false,
+                             "Retry-After: 120\r\n" );
+
+    HttpSession session( "user", "pass" );
+    session.setRetryPolicy( 2, 1, 1000 );
+
+    // Idempotent requests are retried
+    try
+    {
+        session.httpGetRequest( SERVER_URL + "/get" );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+    CPPUNIT_ASSERT_EQUAL( 3, curl_mockup_getRequestsCount( ( SERVER_URL + "/get" ).c_str( ), "", "GET" ) );
+
+    // Others aren't
+    istringstream is( "some body" );
+    try
+    {
+        session.httpPostRequest( SERVER_URL + "/post", is, "text/plain" );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( ( SERVER_URL + "/post" ).c_str( ), "", "POST" ) );
+
+    // Don't wait longer than the maximum delay
+    try
+    {
+        session.httpGetRequest( SERVER_URL + "/later" );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( ( SERVER_URL + "/later" ).c_str( ), "", "GET" ) );
+
+    // The DELETE requests honor the Retry-After header too
+    try
+    {
+        session.httpDeleteRequest( SERVER_URL + "/delete-later" );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( ( SERVER_URL + "/delete-later" ).c_str( ), "", "DELETE" ) );
+
+    // The session's budget stops the retries
+    session.setRetryPolicy( 5, 1, 1000, 1 );
+    try
+    {
+        session.httpDeleteRequest( SERVER_URL + "/budget" );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+    CPPUNIT_ASSERT_EQUAL( 2, curl_mockup_getRequestsCount( ( SERVER_URL + "/budget" ).c_str( ), "", "DELETE" ) );
+}
+
+void HttpTest::retryWaitUnlockedTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "GET", "", 503, false, "Retry-After: 2\r\n" );
+
+    HttpSession session( "user", "pass" );
+    session.setRetryPolicy( 1, 1, 5000 );
+
+    future< void > throttled = async( launch::async, [&session]( )
+        {
+            try
+            {
+                session.httpGetRequest( SERVER_URL );
+            }
+            catch ( const CurlException& )
+            {
+            }
+        } );
+
+    // Wait for the first attempt to be over
+    while ( session.getStatisticsCounters( ).getStatistics( ).getRetries( ) == 0 )
+        this_thread::sleep_for( chrono::milliseconds( 10 ) );
+
+    // The session can be used while the request waits to be retried
+    {
+        lock_guard< recursive_mutex > lock( session.m_requestMutex );
+        CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( SERVER_URL.c_str( ), "", "GET" ) );
+    }
+
+    throttled.get( );
+    CPPUNIT_ASSERT_EQUAL( 2, curl_mockup_getRequestsCount( SERVER_URL.c_str( ), "", "GET" ) );
+}
+
+void HttpTest::retryAsyncThrottledTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "GET", "", 503, false );
+
+    HttpSession session( "user", "pass" );
+    session.setRetryPolicy( 2, 1, 1000 );
+
+    future< libcmis::HttpResponsePtr > result = session.httpGetRequestAsync( SERVER_URL );
+    try
+    {
+        result.get( );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+    CPPUNIT_ASSERT_EQUAL( 3, curl_mockup_getRequestsCount( SERVER_URL.c_str( ), "", "GET" ) );
+}
+
+void HttpTest::retryAsyncBusySessionTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "GET", "", 503, false );
+
+    HttpSession session( "user", "pass" );
+    session.setRetryPolicy( 2, 1, 1000 );
+
+    // Act as if a synchronous request was running: the retries don't
+    // wait for it
+    lock_guard< recursive_mutex > busy( session.m_requestMutex );
+    future< libcmis::HttpResponsePtr > result = session.httpGetRequestAsync( SERVER_URL );
+    CPPUNIT_ASSERT_MESSAGE( "Retries waited for the session",
+                            result.wait_for( chrono::seconds( 10 ) ) == future_status::ready );
+    CPPUNIT_ASSERT_EQUAL( 3, curl_mockup_getRequestsCount( SERVER_URL.c_str( ), "", "GET" ) );
+}
+
+void HttpTest::uploadRetryTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "PATCH", "", 417, false );
+
+    HttpSession session( "user", "pass" );
+    istringstream is( "header:some content" );
+    is.seekg( 7 );
+    try
+    {
+        session.httpPatchRequest( SERVER_URL, is, vector< string >( ) );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+
+    // The body has been rewound for the retry, which is still a PATCH
+    CPPUNIT_ASSERT_EQUAL( 2, curl_mockup_getRequestsCount( SERVER_URL.c_str( ), "", "PATCH", "" ) );
+    CPPUNIT_ASSERT_EQUAL( 0, curl_mockup_getRequestsCount( SERVER_URL.c_str( ), "", "PUT", "" ) );
+    CPPUNIT_ASSERT_EQUAL( string( "some content" ),
+                          string( curl_mockup_getRequestBody( SERVER_URL.c_str( ), "", "PATCH" ) ) );
+
+    // The stream is left where the body started
+    CPPUNIT_ASSERT_EQUAL( streampos( 7 ), is.tellg( ) );
+}
+
+void HttpTest::uploadUnseekableStreamTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_addResponse( SERVER_URL.c_str( ), "", "PUT", "", 417, false );
+
+    HttpSession session( "user", "pass" );
+    UnseekableBuffer buffer( "some content" );
+    istream is( &buffer );
+    try
+    {
+        session.httpPutRequest( SERVER_URL, is, vector< string >( ) );
+        CPPUNIT_FAIL( "Should have thrown" );
+    }
+    catch ( const CurlException& )
+    {
+    }
+
+    // The spooled body has been sent in full both times
+    CPPUNIT_ASSERT_EQUAL( 2, curl_mockup_getRequestsCount( SERVER_URL.c_str( ), "", "PUT",
+                                                           "some content" ) );
+}
@@ -46,6 +46,7 @@
 #include <fstream>
 
 #include <libcmis/document.hxx>
+#include <libcmis/folder.hxx>
 
 #include "onedrive-object.hxx"
 #include "onedrive-property.hxx"
@@ -93,6 +94,7 @@ class OneDriveTest : public CppUnit::TestFixture
         void setContentStreamTest( );
         void createDocumentTest( );
         void getObjectByPathTest( );
+        void getDescendantsTest( );
         
         CPPUNIT_TEST_SUITE( OneDriveTest );
         CPPUNIT_TEST( sessionAuthenticationTest );
@@ -115,6 +117,7 @@ class OneDriveTest : public CppUnit::TestFixture
         CPPUNIT_TEST( setContentStreamTest );
         CPPUNIT_TEST( createDocumentTest );
         CPPUNIT_TEST( getObjectByPathTest );
+        CPPUNIT_TEST( getDescendantsTest );
         CPPUNIT_TEST_SUITE_END( );
 
     private:
@@ -778,4 +781,47 @@ void OneDriveTest::getObjectByPathTest( )
     CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong objectFetched", documentId, object->getId( ) );
 }
 
+void OneDriveTest::getDescendantsTest( )
+{
+    curl_mockup_reset( );
+    OneDriveSessionPtr session = getTestSession( USERNAME, PASSWORD );
+    const string itemsUrl = BASE_URL + "/me/drive/items/";
+
+    curl_mockup_addResponse( ( itemsUrl + "root" ).c_str( ), "", "GET",
+            "{ \"id\": \"root\", \"name\": \"root\", \"folder\": { \"childCount\": 3 } }", 200, false );
+
+    // The children of the root come in two pages
+    curl_mockup_addResponse( ( itemsUrl + "root/children" ).c_str( ), "", "GET",
+            ( "{ \"value\": ["
+              "{ \"id\": \"folderA\", \"name\": \"A\", \"folder\": { \"childCount\": 1 } },"
+              "{ \"id\": \"fileA\", \"name\": \"a.txt\", \"file\": { \"mimeType\": \"text/plain\" } } ],"
+              "\"@odata.nextLink\": \"" + itemsUrl + "root/next\" }" ).c_str( ), 200, false );
+    curl_mockup_addResponse( ( itemsUrl + "root/next" ).c_str( ), "", "GET",
+            "{ \"value\": [ { \"id\": \"folderB\", \"name\": \"B\", \"folder\": { \"childCount\": 0 } } ] }",
+            200, false );
+    curl_mockup_addResponse( ( itemsUrl + "folderA/children" ).c_str( ), "", "GET",
+            "{ \"value\": [ { \"id\": \"fileB\", \"name\": \"b.txt\", \"file\": { \"mimeType\": \"text/plain\" } } ] }",
+            200, false );
+    curl_mockup_addResponse( ( itemsUrl + "folderB/children" ).c_str( ), "", "GET",
+            "{ \"value\": [ ] }", 200, false );
+
+    libcmis::FolderPtr root = boost::dynamic_pointer_cast< libcmis::Folder >( session->getObject( "root" ) );
+    CPPUNIT_ASSERT( root );
+    vector< libcmis::ObjectTreePtr > tree = root->getDescendants( );
+
+    // The folder of the second page is crawled too
+    CPPUNIT_ASSERT_EQUAL( size_t( 3 ), tree.size( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "folderA" ), tree[0]->getObject( )->getId( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "fileA" ), tree[1]->getObject( )->getId( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "folderB" ), tree[2]->getObject( )->getId( ) );
+    CPPUNIT_ASSERT_EQUAL( size_t( 1 ), tree[0]->getChildren( ).size( ) );
+    CPPUNIT_ASSERT_EQUAL( string( "fileB" ), tree[0]->getChildren( )[0]->getObject( )->getId( ) );
+    CPPUNIT_ASSERT( tree[2]->getChildren( ).empty( ) );
+
+    // Each page is requested once
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( ( itemsUrl + "root/children" ).c_str( ), "", "GET" ) );
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( ( itemsUrl + "root/next" ).c_str( ), "", "GET" ) );
+    CPPUNIT_ASSERT_EQUAL( 1, curl_mockup_getRequestsCount( ( itemsUrl + "folderB/children" ).c_str( ), "", "GET" ) );
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION( OneDriveTest );
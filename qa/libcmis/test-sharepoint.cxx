@@ -73,6 +73,7 @@ class SharePointTest : public CppUnit::TestFixture
         void getFolderAllowableActionsTest( );
         void getDocumentTest( );
         void getContentStreamTest( );
+        void compressedResponsesTest( );
         void setContentStreamTest( );
         void checkOutTest( );
         void checkInTest( );
@@ -98,6 +99,7 @@ class SharePointTest : public CppUnit::TestFixture
         CPPUNIT_TEST( getFolderAllowableActionsTest );
         CPPUNIT_TEST( getDocumentTest );
         CPPUNIT_TEST( getContentStreamTest );
+        CPPUNIT_TEST( compressedResponsesTest );
         CPPUNIT_TEST( setContentStreamTest );
         CPPUNIT_TEST( checkOutTest );
         CPPUNIT_TEST( checkInTest );
@@ -360,6 +362,56 @@ void SharePointTest::getContentStreamTest( )
     }
 }
 
+void SharePointTest::compressedResponsesTest( )
+{
+    static const string objectId ( "http://base/_api/Web/aFileId" );
+
+    SharePointSessionPtr session = getTestSession( USERNAME, PASSWORD );
+    string authorUrl = objectId + "/Author";
+    string downloadUrl = objectId + "/%24value";
+
+    curl_mockup_addResponse ( objectId.c_str( ), "",
+                              "GET", DATA_DIR "/sharepoint/file.json", 200, true);
+    curl_mockup_addResponse ( authorUrl.c_str( ), "",
+                              "GET", DATA_DIR "/sharepoint/author.json", 200, true);
+    curl_mockup_addResponse( downloadUrl.c_str( ), "", "GET", "Test content stream", 0, false );
+
+    libcmis::ObjectPtr object = session->getObject( objectId );
+    libcmis::DocumentPtr document = boost::dynamic_pointer_cast< libcmis::Document >( object );
+    document->getContentStream( );
+
+    // The JSON metadata is compressed, not the content stream
+    const char* urls[] = { objectId.c_str( ), downloadUrl.c_str( ) };
+    const bool expected[] = { true, false };
+    for ( size_t i = 0; i < 2; ++i )
+    {
+        const struct HttpRequest* request = curl_mockup_getRequest( urls[i], "", "GET" );
+        char* acceptEncoding = curl_mockup_HttpRequest_getHeader( request, "Accept-Encoding" );
+        CPPUNIT_ASSERT_EQUAL_MESSAGE( string( "Wrong Accept-Encoding for " ) + urls[i],
+                                      expected[i], acceptEncoding != NULL );
+        free( acceptEncoding );
+        curl_mockup_HttpRequest_free( request );
+    }
+
+    // The SharePoint headers are still sent
+    const struct HttpRequest* request = curl_mockup_getRequest( objectId.c_str( ), "", "GET" );
+    char* accept = curl_mockup_HttpRequest_getHeader( request, "accept" );
+    CPPUNIT_ASSERT_MESSAGE( "Missing accept header", accept != NULL );
+    CPPUNIT_ASSERT_EQUAL( string( "application/json; odata=verbose" ), string( accept ) );
+    free( accept );
+    curl_mockup_HttpRequest_free( request );
+
+    string plainUrl = BASE_URL + "/plain";
+    curl_mockup_addResponse( plainUrl.c_str( ), "", "GET", "{}", 200, false );
+    session->setCompressedResponses( false );
+    session->getJsonFromUrl( plainUrl );
+    request = curl_mockup_getRequest( plainUrl.c_str( ), "", "GET" );
+    char* acceptEncoding = curl_mockup_HttpRequest_getHeader( request, "Accept-Encoding" );
+    CPPUNIT_ASSERT_MESSAGE( "Compression still asked for", acceptEncoding == NULL );
+    free( acceptEncoding );
+    curl_mockup_HttpRequest_free( request );
+}
+
 void SharePointTest::setContentStreamTest( )
 {
     static const string objectId ( "http://base/_api/Web/aFileId" );
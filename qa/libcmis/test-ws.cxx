@@ -125,12 +125,17 @@ class WSTest : public CppUnit::TestFixture
         void getTypeChildrenTest( );
 
         void getObjectTest( );
+        void getObjectOperationContextTest( );
         void getDocumentTest( );
         void getFolderTest( );
         void getByPathValidTest( );
         void getByPathInvalidTest( );
         void getDocumentParentsTest( );
         void getChildrenTest( );
+        void listChildrenTest( );
+        void getFolderTreeTest( );
+        void queryTest( );
+        void getContentChangesTest( );
         void getContentStreamTest( );
         void setContentStreamTest( );
         void getRenditionsTest( );
@@ -165,12 +170,17 @@ class WSTest : public CppUnit::TestFixture
         CPPUNIT_TEST( getTypeParentsTest );
         CPPUNIT_TEST( getTypeChildrenTest );
         CPPUNIT_TEST( getObjectTest );
+        CPPUNIT_TEST( getObjectOperationContextTest );
         CPPUNIT_TEST( getDocumentTest );
         CPPUNIT_TEST( getFolderTest );
         CPPUNIT_TEST( getByPathValidTest );
         CPPUNIT_TEST( getByPathInvalidTest );
         CPPUNIT_TEST( getDocumentParentsTest );
         CPPUNIT_TEST( getChildrenTest );
+        CPPUNIT_TEST( listChildrenTest );
+        CPPUNIT_TEST( getFolderTreeTest );
+        CPPUNIT_TEST( queryTest );
+        CPPUNIT_TEST( getContentChangesTest );
         CPPUNIT_TEST( getContentStreamTest );
         CPPUNIT_TEST( setContentStreamTest );
         CPPUNIT_TEST( getRenditionsTest );
@@ -463,6 +473,41 @@ void WSTest::getObjectTest( )
     CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong request sent", expectedRequest, xmlRequest );
 }
 
+void WSTest::getObjectOperationContextTest( )
+{
+    // Setup the mockup
+    curl_mockup_reset( );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+    test::addWsResponse( "http://mockup/ws/services/RepositoryService", DATA_DIR "/ws/type-folder.http" );
+    test::addWsResponse( "http://mockup/ws/services/ObjectService", DATA_DIR "/ws/valid-object.http" );
+
+    WSSessionPtr session  = getTestSession( SERVER_USERNAME, SERVER_PASSWORD, true );
+
+    // Run the tested method
+    libcmis::OperationContext context;
+    vector< string > filter;
+    filter.push_back( "cmis:name" );
+    context.setPropertyFilter( filter );
+    context.setIncludeAllowableActions( false );
+    context.setIncludeRelationships( libcmis::IncludeRelationships::Source );
+    context.setRenditionFilter( "cmis:none" );
+
+    string expectedId( "valid-object" );
+    libcmis::ObjectPtr actual = session->getObject( expectedId, context );
+
+    // Check the sent request
+    string xmlRequest = lcl_getCmisRequestXml( "http://mockup/ws/services/ObjectService" );
+    string expectedRequest = "<cmism:getObject" + lcl_getExpectedNs() + ">"
+                                 "<cmism:repositoryId>mock</cmism:repositoryId>"
+                                 "<cmism:objectId>" + expectedId + "</cmism:objectId>"
+                                 "<cmism:filter>cmis:objectId,cmis:objectTypeId,cmis:baseTypeId,cmis:name</cmism:filter>"
+                                 "<cmism:includeAllowableActions>false</cmism:includeAllowableActions>"
+                                 "<cmism:includeRelationships>source</cmism:includeRelationships>"
+                                 "<cmism:renditionFilter>cmis:none</cmism:renditionFilter>"
+                             "</cmism:getObject>";
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong request sent", expectedRequest, xmlRequest );
+}
+
 void WSTest::getDocumentTest( )
 {
     curl_mockup_reset( );
@@ -666,6 +711,132 @@ void WSTest::getChildrenTest( )
     CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong request sent", expectedRequest, xmlRequest );
 }
 
+void WSTest::listChildrenTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+    test::addWsResponse( "http://mockup/ws/services/RepositoryService", DATA_DIR "/ws/type-folder.http", "<cmism:typeId>cmis:folder</cmism:typeId>" );
+    test::addWsResponse( "http://mockup/ws/services/RepositoryService", DATA_DIR "/ws/type-docLevel2.http", "<cmism:typeId>DocumentLevel2</cmism:typeId>" );
+    test::addWsResponse( "http://mockup/ws/services/ObjectService", DATA_DIR "/ws/root-folder.http", "<cmism:getObject " );
+    test::addWsResponse( "http://mockup/ws/services/NavigationService", DATA_DIR "/ws/root-children.http" );
+
+    WSSessionPtr session  = getTestSession( SERVER_USERNAME, SERVER_PASSWORD, true );
+
+    libcmis::FolderPtr folder = session->getFolder( "root-folder" );
+    libcmis::ObjectIteratorPtr it = folder->listChildren( 10 );
+
+    vector< libcmis::ObjectPtr > page = it->nextPage( );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of children", size_t( 5 ), page.size() );
+    CPPUNIT_ASSERT_MESSAGE( "Shouldn't have more items", !it->hasMoreItems( ) );
+    CPPUNIT_ASSERT_MESSAGE( "Shouldn't have a next item", !it->hasNext( ) );
+
+    // Check the sent request
+    string xmlRequest = lcl_getCmisRequestXml( "http://mockup/ws/services/NavigationService" );
+    string expectedRequest = "<cmism:getChildren" + lcl_getExpectedNs() + ">"
+                                 "<cmism:repositoryId>mock</cmism:repositoryId>"
+                                 "<cmism:folderId>root-folder</cmism:folderId>"
+                                 "<cmism:includeAllowableActions>true</cmism:includeAllowableActions>"
+                                 "<cmism:renditionFilter>*</cmism:renditionFilter>"
+                                 "<cmism:maxItems>10</cmism:maxItems>"
+                             "</cmism:getChildren>";
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong request sent", expectedRequest, xmlRequest );
+}
+
+void WSTest::getFolderTreeTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+    test::addWsResponse( "http://mockup/ws/services/RepositoryService", DATA_DIR "/ws/type-folder.http", "<cmism:typeId>cmis:folder</cmism:typeId>" );
+    test::addWsResponse( "http://mockup/ws/services/ObjectService", DATA_DIR "/ws/root-folder.http", "<cmism:getObject " );
+    test::addWsResponse( "http://mockup/ws/services/NavigationService", DATA_DIR "/ws/root-folder-tree.http" );
+
+    WSSessionPtr session  = getTestSession( SERVER_USERNAME, SERVER_PASSWORD, true );
+
+    libcmis::FolderPtr folder = session->getFolder( "root-folder" );
+    vector< libcmis::ObjectTreePtr > tree = folder->getFolderTree( 2 );
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of children", size_t( 2 ), tree.size( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong first child", string( "child-folder" ), tree[0]->getObject( )->getId( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong second child", string( "child-folder2" ), tree[1]->getObject( )->getId( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of grand children", size_t( 2 ), tree[0]->getChildren( ).size( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong grand child", string( "grandchild-folder2" ),
+            tree[0]->getChildren( )[1]->getObject( )->getId( ) );
+    CPPUNIT_ASSERT_MESSAGE( "Second child shouldn't have children", tree[1]->getChildren( ).empty( ) );
+
+    // Check the sent request
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of requests", 1,
+            curl_mockup_getRequestsCount( "http://mockup/ws/services/NavigationService", "", "POST" ) );
+    string xmlRequest = lcl_getCmisRequestXml( "http://mockup/ws/services/NavigationService" );
+    string expectedRequest = "<cmism:getFolderTree" + lcl_getExpectedNs() + ">"
+                                 "<cmism:repositoryId>mock</cmism:repositoryId>"
+                                 "<cmism:folderId>root-folder</cmism:folderId>"
+                                 "<cmism:depth>2</cmism:depth>"
+                                 "<cmism:includeAllowableActions>true</cmism:includeAllowableActions>"
+                                 "<cmism:renditionFilter>*</cmism:renditionFilter>"
+                             "</cmism:getFolderTree>";
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong request sent", expectedRequest, xmlRequest );
+}
+
+void WSTest::queryTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+    test::addWsResponse( "http://mockup/ws/services/RepositoryService", DATA_DIR "/ws/type-folder.http", "<cmism:typeId>cmis:folder</cmism:typeId>" );
+    test::addWsResponse( "http://mockup/ws/services/DiscoveryService", DATA_DIR "/ws/query.http" );
+
+    WSSessionPtr session  = getTestSession( SERVER_USERNAME, SERVER_PASSWORD, true );
+
+    libcmis::ObjectIteratorPtr it = session->query( "SELECT * FROM cmis:folder", false, 2 );
+    vector< libcmis::ObjectPtr > results = it->nextPage( );
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of results", size_t( 2 ), results.size( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong first result", string( "child-folder" ), results[0]->getId( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong second result", string( "child-folder2" ), results[1]->getId( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong numItems", long( 5 ), it->getNumItems( ) );
+    CPPUNIT_ASSERT_MESSAGE( "More items expected", it->hasMoreItems( ) );
+
+    // Check the sent request
+    string xmlRequest = lcl_getCmisRequestXml( "http://mockup/ws/services/DiscoveryService" );
+    string expectedRequest = "<cmism:query" + lcl_getExpectedNs() + ">"
+                                 "<cmism:repositoryId>mock</cmism:repositoryId>"
+                                 "<cmism:statement>SELECT * FROM cmis:folder</cmism:statement>"
+                                 "<cmism:searchAllVersions>false</cmism:searchAllVersions>"
+                                 "<cmism:includeAllowableActions>true</cmism:includeAllowableActions>"
+                                 "<cmism:maxItems>2</cmism:maxItems>"
+                             "</cmism:query>";
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong request sent", expectedRequest, xmlRequest );
+}
+
+void WSTest::getContentChangesTest( )
+{
+    curl_mockup_reset( );
+    curl_mockup_setCredentials( SERVER_USERNAME, SERVER_PASSWORD );
+    test::addWsResponse( "http://mockup/ws/services/DiscoveryService", DATA_DIR "/ws/content-changes.http" );
+
+    WSSessionPtr session  = getTestSession( SERVER_USERNAME, SERVER_PASSWORD, true );
+
+    libcmis::ContentChanges changes = session->getContentChanges( "token41" );
+
+    vector< libcmis::ChangeEventPtr > events = changes.getEvents( );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong number of events", size_t( 2 ), events.size( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong first object id", string( "child-folder" ), events[0]->getObjectId( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong first change type",
+            libcmis::ChangeType::Updated, events[0]->getChangeType( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong second change type",
+            libcmis::ChangeType::Security, events[1]->getChangeType( ) );
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong next token", string( "token42" ), changes.getChangeLogToken( ) );
+    CPPUNIT_ASSERT_MESSAGE( "No more changes expected", !changes.hasMoreItems( ) );
+
+    // Check the sent request
+    string xmlRequest = lcl_getCmisRequestXml( "http://mockup/ws/services/DiscoveryService" );
+    string expectedRequest = "<cmism:getContentChanges" + lcl_getExpectedNs() + ">"
+                                 "<cmism:repositoryId>mock</cmism:repositoryId>"
+                                 "<cmism:changeLogToken>token41</cmism:changeLogToken>"
+                                 "<cmism:includeProperties>false</cmism:includeProperties>"
+                             "</cmism:getContentChanges>";
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Wrong request sent", expectedRequest, xmlRequest );
+}
+
 void WSTest::getContentStreamTest( )
 {
     curl_mockup_reset( );
@@ -28,11 +28,13 @@
 
 #include <ctime>
 #include <sstream>
+#include <thread>
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <cppunit/TestFixture.h>
 #include <cppunit/TestAssert.h>
 #include <cppunit/ui/text/TestRunner.h>
+#include <libxml/parser.h>
 #include <libxml/tree.h>
 
 #if defined __clang__
@@ -50,6 +52,7 @@
 #include <libcmis/xml-utils.hxx>
 
 #include "test-helpers.hxx"
+#include "xpath-context.hxx"
 
 using namespace boost;
 using namespace std;
@@ -85,6 +88,8 @@ class XmlTest : public CppUnit::TestFixture
         void propertyTypeUpdateTest( );
         void escapeTest( );
         void unescapeTest( );
+        void httpResponseBodyTest( );
+        void xpathContextTest( );
 
         CPPUNIT_TEST_SUITE( XmlTest );
         CPPUNIT_TEST( parseDateTimeTest );
@@ -105,6 +110,8 @@ class XmlTest : public CppUnit::TestFixture
         CPPUNIT_TEST( propertyTypeUpdateTest );
         CPPUNIT_TEST( escapeTest );
         CPPUNIT_TEST( unescapeTest );
+        CPPUNIT_TEST( httpResponseBodyTest );
+        CPPUNIT_TEST( xpathContextTest );
         CPPUNIT_TEST_SUITE_END( );
 };
 
@@ -623,4 +630,78 @@ void XmlTest::unescapeTest( )
     CPPUNIT_ASSERT_EQUAL( string("something to escape$"), actual);
 }
 
+void XmlTest::httpResponseBodyTest( )
+{
+    boost::shared_ptr< istream > stream;
+    {
+        libcmis::HttpResponse response;
+        response.reserveBody( 12 );
+        char data[] = "some content";
+        response.getData( )->decode( data, 1, 12 );
+        response.getData( )->finish( );
+
+        CPPUNIT_ASSERT_EQUAL( string( "some content" ), response.getBody( ) );
+        CPPUNIT_ASSERT_EQUAL( string( "some content" ), response.getStream( )->str( ) );
+        stream = response.getBodyStream( );
+    }
+
+    // The stream reads the body in place, even after the response is gone
+    stream->seekg( 5 );
+    string content;
+    getline( *stream, content );
+    CPPUNIT_ASSERT_EQUAL( string( "content" ), content );
+
+    stream->clear( );
+    stream->seekg( 0, ios::beg );
+    CPPUNIT_ASSERT_EQUAL( streampos( 0 ), stream->tellg( ) );
+}
+
+void XmlTest::xpathContextTest( )
+{
+    string xml( "<atom:entry xmlns:atom='http://www.w3.org/2005/Atom'"
+                "            xmlns:cmis='http://docs.oasis-open.org/ns/cmis/core/200908/'>"
+                "<cmis:properties><cmis:propertyId propertyDefinitionId='cmis:objectId'>"
+                "<cmis:value>some-id</cmis:value></cmis:propertyId></cmis:properties>"
+                "</atom:entry>" );
+    boost::shared_ptr< xmlDoc > doc( xmlReadMemory( xml.c_str( ), xml.size( ), "", NULL, 0 ), xmlFreeDoc );
+    xmlNodePtr root = xmlDocGetRootElement( doc.get( ) );
+
+    {
+        libcmis::XPathContext outer( doc.get( ), NULL );
+        xmlXPathObjectPtr entries = outer.eval( "//atom:entry" );
+        CPPUNIT_ASSERT_EQUAL( 1, entries->nodesetval->nodeNr );
+        xmlXPathFreeObject( entries );
+
+        // Nested contexts don't interfere with each other
+        libcmis::XPathContext inner( doc.get( ), root->children );
+        CPPUNIT_ASSERT_EQUAL( string( "some-id" ), inner.getValue( "cmis:propertyId/cmis:value/text()" ) );
+        CPPUNIT_ASSERT_EQUAL( string( "some-id" ), outer.getValue( "//cmis:value/text()" ) );
+    }
+
+    // A reused context gets the new node
+    {
+        libcmis::XPathContext relative( doc.get( ), root );
+        CPPUNIT_ASSERT_EQUAL( string( "some-id" ), relative.getValue( "cmis:properties/cmis:propertyId/cmis:value/text()" ) );
+    }
+
+    string otherThreadValue;
+    thread other( [&]( )
+    {
+        libcmis::XPathContext ctx( doc.get( ), root );
+        otherThreadValue = ctx.getValue( ".//cmis:value/text()" );
+    } );
+    other.join( );
+    CPPUNIT_ASSERT_EQUAL( string( "some-id" ), otherThreadValue );
+
+    try
+    {
+        libcmis::XPathContext ctx( doc.get( ), root );
+        ctx.eval( "][" );
+        CPPUNIT_FAIL( "Exception should be raised: invalid expression" );
+    }
+    catch ( const libcmis::Exception& )
+    {
+    }
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION( XmlTest );
@@ -26,6 +26,8 @@
  * instead of those above.
  */
 
+#include <algorithm>
+
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -113,9 +115,120 @@ CURL *curl_easy_init( void )
 void curl_easy_cleanup( CURL * curl )
 {
     CurlHandle* handle = static_cast< CurlHandle* >( curl );
+    CurlShareHandle* share = handle ? static_cast< CurlShareHandle* >( handle->m_share ) : NULL;
+    if ( share )
+        share->m_users--;
     delete( handle );
 }
 
+CURLSH *curl_share_init( void )
+{
+    return new CurlShareHandle( );
+}
+
+CURLSHcode curl_share_setopt( CURLSH * sh, CURLSHoption option, ... )
+{
+    CurlShareHandle* share = static_cast< CurlShareHandle* >( sh );
+
+    va_list arg;
+    va_start( arg, option );
+    if ( option == CURLSHOPT_SHARE )
+        share->m_sharedData.push_back( va_arg( arg, int ) );
+    va_end( arg );
+
+    return CURLSHE_OK;
+}
+
+CURLSHcode curl_share_cleanup( CURLSH * sh )
+{
+    CurlShareHandle* share = static_cast< CurlShareHandle* >( sh );
+    if ( share->m_users > 0 )
+        return CURLSHE_IN_USE;
+    delete share;
+    return CURLSHE_OK;
+}
+
+CURLM *curl_multi_init( void )
+{
+    return new CurlMultiHandle( );
+}
+
+CURLMcode curl_multi_add_handle( CURLM * multi, CURL * curl )
+{
+    CurlMultiHandle* handle = static_cast< CurlMultiHandle* >( multi );
+    handle->m_pending.push_back( curl );
+    return CURLM_OK;
+}
+
+CURLMcode curl_multi_remove_handle( CURLM * multi, CURL * curl )
+{
+    CurlMultiHandle* handle = static_cast< CurlMultiHandle* >( multi );
+    handle->m_pending.erase( remove( handle->m_pending.begin( ), handle->m_pending.end( ), curl ),
+                             handle->m_pending.end( ) );
+    return CURLM_OK;
+}
+
+CURLMcode curl_multi_perform( CURLM * multi, int * running_handles )
+{
+    CurlMultiHandle* handle = static_cast< CurlMultiHandle* >( multi );
+
+    // Each transfer is run in one go
+    vector< CURL* > pending;
+    pending.swap( handle->m_pending );
+    for ( vector< CURL* >::iterator it = pending.begin( ); it != pending.end( ); ++it )
+    {
+        CURLMsg msg;
+        msg.msg = CURLMSG_DONE;
+        msg.easy_handle = *it;
+        msg.data.result = curl_easy_perform( *it );
+        handle->m_messages.push_back( msg );
+    }
+
+    if ( running_handles )
+        *running_handles = 0;
+    return CURLM_OK;
+}
+
+CURLMsg *curl_multi_info_read( CURLM * multi, int * msgs_in_queue )
+{
+    CurlMultiHandle* handle = static_cast< CurlMultiHandle* >( multi );
+    CURLMsg* msg = NULL;
+    if ( !handle->m_messages.empty( ) )
+    {
+        handle->m_lastMessage = handle->m_messages.front( );
+        handle->m_messages.pop_front( );
+        msg = &handle->m_lastMessage;
+    }
+    if ( msgs_in_queue )
+        *msgs_in_queue = handle->m_messages.size( );
+    return msg;
+}
+
+CURLMcode curl_multi_wait( CURLM *, struct curl_waitfd*, unsigned int, int, int * ret )
+{
+    if ( ret )
+        *ret = 0;
+    return CURLM_OK;
+}
+
+CURLMcode curl_multi_poll( CURLM *, struct curl_waitfd*, unsigned int, int, int * ret )
+{
+    if ( ret )
+        *ret = 0;
+    return CURLM_OK;
+}
+
+CURLMcode curl_multi_wakeup( CURLM * )
+{
+    return CURLM_OK;
+}
+
+CURLMcode curl_multi_cleanup( CURLM * multi )
+{
+    delete static_cast< CurlMultiHandle* >( multi );
+    return CURLM_OK;
+}
+
 void curl_easy_reset( CURL * curl )
 {
     CurlHandle* handle = static_cast< CurlHandle * >( curl );
@@ -269,6 +382,17 @@ CURLcode curl_easy_setopt( CURL * curl, long option, ... )
             handle->m_certInfo = va_arg( arg, long );
             break;
         }
+        case CURLOPT_SHARE:
+        {
+            CurlShareHandle* share = static_cast< CurlShareHandle* >( handle->m_share );
+            if ( share )
+                share->m_users--;
+            handle->m_share = va_arg( arg, CURLSH* );
+            share = static_cast< CurlShareHandle* >( handle->m_share );
+            if ( share )
+                share->m_users++;
+            break;
+        }
         case CURLOPT_HTTPHEADER:
         {
             handle->m_headers.clear();
@@ -280,6 +404,16 @@ CURLcode curl_easy_setopt( CURL * curl, long option, ... )
             }
             break;
         }
+        case CURLOPT_ACCEPT_ENCODING:
+        {
+            // An empty string means all the encodings curl supports
+            const char* encoding = va_arg( arg, const char* );
+            if ( encoding == NULL )
+                handle->m_acceptEncoding.clear( );
+            else
+                handle->m_acceptEncoding = *encoding ? encoding : "deflate, gzip";
+            break;
+        }
         default:
         {
             // We surely don't want to break the test for that.
@@ -293,6 +427,7 @@ CURLcode curl_easy_setopt( CURL * curl, long option, ... )
 CURLcode curl_easy_perform( CURL * curl )
 {
     CurlHandle* handle = static_cast< CurlHandle * >( curl );
+    lock_guard< recursive_mutex > lock( mockup::config->m_mutex );
 
     /* Fake a bad SSL Certificate? */
     if ( !mockup::config->m_badSSLCertificate.empty( ) && handle->m_verifyPeer && handle->m_verifyHost )
@@ -341,7 +476,12 @@ CURLcode curl_easy_perform( CURL * curl )
         delete[] buf;
     }
 
-    mockup::config->m_requests.push_back( mockup::Request( handle->m_url, handle->m_method, body.str( ), handle->m_headers ) );
+    vector< string > headers = handle->m_headers;
+    if ( !handle->m_acceptEncoding.empty( ) )
+        headers.push_back( "Accept-Encoding: " + handle->m_acceptEncoding );
+    mockup::config->m_requests.push_back( mockup::Request( handle->m_url, handle->m_method, body.str( ), headers ) );
+    handle->m_uploadSize = curl_off_t( body.str( ).size( ) );
+    handle->m_downloadSize = 0;
 
 
     return mockup::config->writeResponse( handle );
@@ -361,6 +501,18 @@ CURLcode curl_easy_getinfo( CURL * curl, long info, ... )
             *buf = handle->m_httpError;
             break;
         }
+        case CURLINFO_SIZE_UPLOAD_T:
+        {
+            curl_off_t* buf = va_arg( arg, curl_off_t* );
+            *buf = handle->m_uploadSize;
+            break;
+        }
+        case CURLINFO_SIZE_DOWNLOAD_T:
+        {
+            curl_off_t* buf = va_arg( arg, curl_off_t* );
+            *buf = handle->m_downloadSize;
+            break;
+        }
         case CURLINFO_CERTINFO:
         {
             struct curl_slist** param = va_arg( arg, struct curl_slist** );
@@ -408,8 +560,12 @@ CurlHandle::CurlHandle( ) :
     m_certInfo( false ),
     m_certs( ),
     m_httpError( 0 ),
+    m_uploadSize( 0 ),
+    m_downloadSize( 0 ),
     m_method( "GET" ),
-    m_headers( )
+    m_headers( ),
+    m_acceptEncoding( ),
+    m_share( NULL )
 {
 }
 
@@ -433,8 +589,12 @@ CurlHandle::CurlHandle( const CurlHandle& copy ) :
     m_certInfo( copy.m_certInfo ),
     m_certs( copy.m_certs ),
     m_httpError( copy.m_httpError ),
+    m_uploadSize( copy.m_uploadSize ),
+    m_downloadSize( copy.m_downloadSize ),
     m_method( copy.m_method ),
-    m_headers( copy.m_headers )
+    m_headers( copy.m_headers ),
+    m_acceptEncoding( copy.m_acceptEncoding ),
+    m_share( copy.m_share )
 {
 }
 
@@ -461,8 +621,12 @@ CurlHandle& CurlHandle::operator=( const CurlHandle& copy )
         m_certInfo = copy.m_certInfo;
         m_certs = copy.m_certs;
         m_httpError = copy.m_httpError;
+        m_uploadSize = copy.m_uploadSize;
+        m_downloadSize = copy.m_downloadSize;
         m_method = copy.m_method;
         m_headers = copy.m_headers;
+        m_acceptEncoding = copy.m_acceptEncoding;
+        m_share = copy.m_share;
     }
     return *this;
 }
@@ -472,6 +636,19 @@ CurlHandle::~CurlHandle( )
     reset();
 }
 
+CurlMultiHandle::CurlMultiHandle( ) :
+    m_pending( ),
+    m_messages( ),
+    m_lastMessage( )
+{
+}
+
+CurlShareHandle::CurlShareHandle( ) :
+    m_sharedData( ),
+    m_users( 0 )
+{
+}
+
 void CurlHandle::reset( )
 {
     m_url = string( );
@@ -499,6 +676,9 @@ void CurlHandle::reset( )
     m_certs.certinfo = NULL;
     m_certs.num_of_certs = 0;
 
+    m_uploadSize = 0;
+    m_downloadSize = 0;
     m_method = "GET";
     m_headers.clear( );
+    m_acceptEncoding.clear( );
 }
@@ -28,6 +28,8 @@
 #ifndef _MOCKUP_CURL_CURL_H_
 #define _MOCKUP_CURL_CURL_H_
 
+#include <stdint.h>
+
 #ifdef  __cplusplus
 extern "C" {
 #endif
@@ -35,6 +37,10 @@ extern "C" {
 /* Curl used symbols to mockup */
 
 typedef void CURL;
+typedef void CURLSH;
+
+/* Same as curl's own on the 32 and 64 bits Linux */
+typedef int64_t curl_off_t;
 
 typedef enum
 {
@@ -87,7 +93,9 @@ typedef enum
     CURLOPT_NOPROXY = CURLOPTTYPE_OBJECTPOINT + 177,
     CURLOPT_SSL_VERIFYPEER = CURLOPTTYPE_LONG + 64,
     CURLOPT_SSL_VERIFYHOST = CURLOPTTYPE_LONG + 81,
-    CURLOPT_CERTINFO = CURLOPTTYPE_LONG + 172
+    CURLOPT_CERTINFO = CURLOPTTYPE_LONG + 172,
+    CURLOPT_SHARE = CURLOPTTYPE_OBJECTPOINT + 100,
+    CURLOPT_ACCEPT_ENCODING = CURLOPTTYPE_OBJECTPOINT + 102
 } CURLoption;
 
 #define CURLAUTH_DIGEST_IE    (((unsigned long)1)<<4)
@@ -97,6 +105,7 @@ typedef enum
 {
   CURLE_OK = 0,
   CURLE_HTTP_RETURNED_ERROR = 22,
+  CURLE_WRITE_ERROR = 23,
   CURLE_SSL_CACERT = 60,
   /* TODO Add some more error codes from curl? */
   CURL_LAST
@@ -123,6 +132,92 @@ char *curl_easy_unescape( CURL *handle, const char *string, int length, int *out
 CURLcode curl_easy_perform( CURL *curl );
 void curl_easy_reset( CURL *curl );
 
+typedef enum
+{
+  CURLSHE_OK,
+  CURLSHE_BAD_OPTION,
+  CURLSHE_IN_USE,
+  CURLSHE_INVALID,
+  CURLSHE_LAST
+} CURLSHcode;
+
+typedef enum
+{
+  CURLSHOPT_NONE,
+  CURLSHOPT_SHARE,
+  CURLSHOPT_UNSHARE,
+  CURLSHOPT_LOCKFUNC,
+  CURLSHOPT_UNLOCKFUNC,
+  CURLSHOPT_USERDATA,
+  CURLSHOPT_LAST
+} CURLSHoption;
+
+typedef enum
+{
+  CURL_LOCK_DATA_NONE = 0,
+  CURL_LOCK_DATA_SHARE,
+  CURL_LOCK_DATA_COOKIE,
+  CURL_LOCK_DATA_DNS,
+  CURL_LOCK_DATA_SSL_SESSION,
+  CURL_LOCK_DATA_CONNECT,
+  CURL_LOCK_DATA_LAST
+} curl_lock_data;
+
+CURLSH *curl_share_init( void );
+CURLSHcode curl_share_setopt( CURLSH *share, CURLSHoption option, ... );
+CURLSHcode curl_share_cleanup( CURLSH *share );
+
+typedef void CURLM;
+
+typedef enum
+{
+  CURLM_CALL_MULTI_PERFORM = -1,
+  CURLM_OK,
+  CURLM_BAD_HANDLE,
+  CURLM_BAD_EASY_HANDLE,
+  CURLM_OUT_OF_MEMORY,
+  CURLM_INTERNAL_ERROR,
+  CURLM_LAST
+} CURLMcode;
+
+typedef enum
+{
+  CURLMSG_NONE,
+  CURLMSG_DONE,
+  CURLMSG_LAST
+} CURLMSG;
+
+struct CURLMsg
+{
+  CURLMSG msg;
+  CURL *easy_handle;
+  union
+  {
+    void *whatever;
+    CURLcode result;
+  } data;
+};
+typedef struct CURLMsg CURLMsg;
+
+struct curl_waitfd
+{
+  int fd;
+  short events;
+  short revents;
+};
+
+CURLM *curl_multi_init( void );
+CURLMcode curl_multi_add_handle( CURLM *multi, CURL *curl );
+CURLMcode curl_multi_remove_handle( CURLM *multi, CURL *curl );
+CURLMcode curl_multi_perform( CURLM *multi, int *running_handles );
+CURLMsg *curl_multi_info_read( CURLM *multi, int *msgs_in_queue );
+CURLMcode curl_multi_wait( CURLM *multi, struct curl_waitfd extra_fds[],
+                           unsigned int extra_nfds, int timeout_ms, int *ret );
+CURLMcode curl_multi_poll( CURLM *multi, struct curl_waitfd extra_fds[],
+                           unsigned int extra_nfds, int timeout_ms, int *ret );
+CURLMcode curl_multi_wakeup( CURLM *multi );
+CURLMcode curl_multi_cleanup( CURLM *multi );
+
 struct curl_certinfo
 {
     int num_of_certs;
@@ -131,11 +226,14 @@ struct curl_certinfo
 
 #define CURLINFO_LONG     0x200000
 #define CURLINFO_SLIST    0x400000
+#define CURLINFO_OFF_T    0x600000
 
 typedef enum
 {
   CURLINFO_NONE,
   CURLINFO_RESPONSE_CODE    = CURLINFO_LONG   + 2,
+  CURLINFO_SIZE_UPLOAD_T    = CURLINFO_OFF_T  + 7,
+  CURLINFO_SIZE_DOWNLOAD_T  = CURLINFO_OFF_T  + 8,
   CURLINFO_CERTINFO         = CURLINFO_SLIST  + 34,
   CURLINFO_LASTONE          = 42
 } CURLINFO;
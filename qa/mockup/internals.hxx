@@ -29,7 +29,9 @@
 #ifndef INCLUDED_QA_MOCKUP_INTERNALS_HXX
 #define INCLUDED_QA_MOCKUP_INTERNALS_HXX
 
+#include <deque>
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -69,12 +71,40 @@ class CurlHandle
         struct curl_certinfo m_certs;
 
         long m_httpError;
+        curl_off_t m_uploadSize;
+        curl_off_t m_downloadSize;
         std::string m_method;
         std::vector< std::string > m_headers;
 
+        /// Encodings curl would send in the Accept-Encoding header
+        std::string m_acceptEncoding;
+
+        /// Not reset by curl_easy_reset( ), like in curl
+        CURLSH* m_share;
+
         void reset( );
 };
 
+class CurlShareHandle
+{
+    public:
+        CurlShareHandle( );
+
+        std::vector< long > m_sharedData;
+        int m_users;
+};
+
+class CurlMultiHandle
+{
+    public:
+        CurlMultiHandle( );
+
+        /// Handles added but not performed yet
+        std::vector< CURL* > m_pending;
+        std::deque< CURLMsg > m_messages;
+        CURLMsg m_lastMessage;
+};
+
 namespace mockup
 {
     class Response
@@ -127,6 +157,11 @@ namespace mockup
             std::string m_username;
             std::string m_password;
             std::string m_badSSLCertificate;
+
+            /** Serializes the transfers and the access to the requests
+                as the asynchronous ones are run by another thread.
+              */
+            std::recursive_mutex m_mutex;
     };
 }
 
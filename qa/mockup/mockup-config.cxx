@@ -28,6 +28,7 @@
 
 #include "mockup-config.h"
 
+#include <algorithm>
 #include <memory>
 #include <stdio.h>
 #include <stdlib.h>
@@ -112,7 +113,8 @@ namespace mockup
         m_requests( ),
         m_username( ),
         m_password( ),
-        m_badSSLCertificate( )
+        m_badSSLCertificate( ),
+        m_mutex( )
     {
     }
 
@@ -192,18 +194,26 @@ namespace mockup
                 {
                     read = fread( buf, 1, bufSize, fd );
                     written = handle->m_writeFn( buf, 1, read, handle->m_writeData );
+                    handle->m_downloadSize += curl_off_t( written );
                 } while ( read == bufSize && written == read );
 
                 fclose( fd );
                 delete[] buf;
+
+                if ( written != read )
+                    code = CURLE_WRITE_ERROR;
             }
             else
             {
                 if ( !response.empty() )
                 {
                     char* buf = strdup( response.c_str() );
-                    handle->m_writeFn( buf, 1, response.size( ), handle->m_writeData );
+                    size_t written = handle->m_writeFn( buf, 1, response.size( ), handle->m_writeData );
+                    handle->m_downloadSize = curl_off_t( written );
                     free( buf );
+
+                    if ( written != response.size( ) )
+                        code = CURLE_WRITE_ERROR;
                 }
             }
         }
@@ -212,7 +222,8 @@ namespace mockup
         if ( handle->m_httpError == 0 )
             handle->m_httpError = 200;
 
-        if ( handle->m_httpError < 200 || handle->m_httpError >= 300 )
+        // Like curl with CURLOPT_FAILONERROR: 3xx statuses aren't errors
+        if ( handle->m_httpError < 200 || handle->m_httpError >= 400 )
             code = CURLE_HTTP_RETURNED_ERROR;
 
         return code;
@@ -271,6 +282,7 @@ const struct HttpRequest* curl_mockup_getRequest( const char* urlBase,
     if ( matchBody )
         matchBodyStr = matchBody;
 
+    lock_guard< recursive_mutex > lock( mockup::config->m_mutex );
     for ( vector< mockup::Request >::iterator it = mockup::config->m_requests.begin( );
             it != mockup::config->m_requests.end( ) && request == NULL; ++it )
     {
@@ -323,6 +335,7 @@ int curl_mockup_getRequestsCount( const char* urlBase,
     string matchParamString( matchParam );
     string matchBodyStr( matchBody );
 
+    lock_guard< recursive_mutex > lock( mockup::config->m_mutex );
     for ( vector< mockup::Request >::iterator it = mockup::config->m_requests.begin( );
             it != mockup::config->m_requests.end( ); ++it )
     {
@@ -407,3 +420,20 @@ void curl_mockup_setSSLBadCertificate( const char* certificate )
 {
     mockup::config->m_badSSLCertificate = string( certificate );
 }
+
+CURLSH* curl_mockup_getShare( CURL* curl )
+{
+    CurlHandle* handle = static_cast< CurlHandle* >( curl );
+    if ( NULL != handle )
+        return handle->m_share;
+    return NULL;
+}
+
+bool curl_mockup_isShared( CURLSH* sh, long lockData )
+{
+    CurlShareHandle* share = static_cast< CurlShareHandle* >( sh );
+    if ( NULL == share )
+        return false;
+    return find( share->m_sharedData.begin( ), share->m_sharedData.end( ), lockData ) !=
+           share->m_sharedData.end( );
+}
@@ -103,6 +103,14 @@ const char* curl_mockup_getNoProxy( CURL* handle );
 const char* curl_mockup_getProxyUser( CURL* handle );
 const char* curl_mockup_getProxyPass( CURL* handle );
 
+/** Get the share handle the curl handle is attached to, if any.
+  */
+CURLSH* curl_mockup_getShare( CURL* handle );
+
+/** Tells whether the share handle shares the given curl_lock_data.
+  */
+bool curl_mockup_isShared( CURLSH* share, long lockData );
+
 /** Set a fake invalid certificate to raise CURLE_SSL_CACERT. Setting it
     to an empty string will reset to no certificate.
   */
@@ -28,6 +28,8 @@
 
 #include <libcmis-c/document.h>
 
+#include <libcmis/xml-utils.hxx>
+
 #include "internals.hxx"
 
 using namespace std;
@@ -145,17 +147,10 @@ void libcmis_document_getContentStream(
             DocumentPtr doc = dynamic_pointer_cast< libcmis::Document >( document->handle );
             if ( doc )
             {
-                boost::shared_ptr< istream > stream = doc->getContentStream( );
-
-                stream->seekg( 0 );
-                size_t bufSize = 2048;
-                std::vector< char > buf( bufSize );
-                while ( !stream->eof( ) )
-                {
-                    stream->read( buf.data(), bufSize );
-                    size_t read = stream->gcount( );
-                    writeFn( ( const void * )buf.data(), size_t( 1 ), read, userData );
-                }
+                // Pass the data to writeFn as it arrives
+                boost::shared_ptr< libcmis::EncodedData > sink(
+                        new libcmis::EncodedData( writeFn, userData ) );
+                doc->downloadContentStream( sink );
             }
         }
         catch ( const libcmis::Exception& e )
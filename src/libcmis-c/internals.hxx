@@ -37,8 +37,10 @@
 #include <libcmis/object.hxx>
 #include <libcmis/property.hxx>
 #include <libcmis/repository.hxx>
+#include <libcmis/request-metrics.hxx>
 #include <libcmis/session.hxx>
 #include <libcmis/session-factory.hxx>
+#include <libcmis/session-statistics.hxx>
 
 std::string createString( char* str );
 
@@ -148,6 +150,20 @@ struct libcmis_rendition
     libcmis_rendition( ) : handle( ) { }
 };
 
+struct libcmis_request_metrics
+{
+    const libcmis::RequestMetrics* handle;
+
+    libcmis_request_metrics( ) : handle( NULL ) { }
+};
+
+struct libcmis_session_statistics
+{
+    libcmis::SessionStatistics handle;
+
+    libcmis_session_statistics( ) : handle( ) { }
+};
+
 struct libcmis_vector_bool
 {
     std::vector< bool > handle;
@@ -0,0 +1,111 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include <libcmis-c/request-metrics.h>
+
+#include "internals.hxx"
+
+using namespace std;
+
+const char* libcmis_request_metrics_getMethod( libcmis_RequestMetricsPtr metrics )
+{
+    if ( metrics != NULL && metrics->handle != NULL )
+        return metrics->handle->getMethod( ).c_str( );
+    return NULL;
+}
+
+const char* libcmis_request_metrics_getUrlTemplate( libcmis_RequestMetricsPtr metrics )
+{
+    if ( metrics != NULL && metrics->handle != NULL )
+        return metrics->handle->getUrlTemplate( ).c_str( );
+    return NULL;
+}
+
+long libcmis_request_metrics_getStatus( libcmis_RequestMetricsPtr metrics )
+{
+    long result = 0;
+    if ( metrics != NULL && metrics->handle != NULL )
+        result = metrics->handle->getStatus( );
+    return result;
+}
+
+double libcmis_request_metrics_getNameLookupTime( libcmis_RequestMetricsPtr metrics )
+{
+    double result = 0;
+    if ( metrics != NULL && metrics->handle != NULL )
+        result = metrics->handle->getNameLookupTime( );
+    return result;
+}
+
+double libcmis_request_metrics_getConnectTime( libcmis_RequestMetricsPtr metrics )
+{
+    double result = 0;
+    if ( metrics != NULL && metrics->handle != NULL )
+        result = metrics->handle->getConnectTime( );
+    return result;
+}
+
+double libcmis_request_metrics_getAppConnectTime( libcmis_RequestMetricsPtr metrics )
+{
+    double result = 0;
+    if ( metrics != NULL && metrics->handle != NULL )
+        result = metrics->handle->getAppConnectTime( );
+    return result;
+}
+
+double libcmis_request_metrics_getStartTransferTime( libcmis_RequestMetricsPtr metrics )
+{
+    double result = 0;
+    if ( metrics != NULL && metrics->handle != NULL )
+        result = metrics->handle->getStartTransferTime( );
+    return result;
+}
+
+double libcmis_request_metrics_getTotalTime( libcmis_RequestMetricsPtr metrics )
+{
+    double result = 0;
+    if ( metrics != NULL && metrics->handle != NULL )
+        result = metrics->handle->getTotalTime( );
+    return result;
+}
+
+long libcmis_request_metrics_getDownloadSize( libcmis_RequestMetricsPtr metrics )
+{
+    long result = 0;
+    if ( metrics != NULL && metrics->handle != NULL )
+        result = metrics->handle->getDownloadSize( );
+    return result;
+}
+
+long libcmis_request_metrics_getUploadSize( libcmis_RequestMetricsPtr metrics )
+{
+    long result = 0;
+    if ( metrics != NULL && metrics->handle != NULL )
+        result = metrics->handle->getUploadSize( );
+    return result;
+}
@@ -117,6 +117,28 @@ namespace
         libcmis_vector_string_free( chain );
         return result;
     }
+
+
+    class WrapperRequestObserver : public libcmis::RequestObserver
+    {
+        private:
+            libcmis_requestMetricsCallback m_callback;
+        public:
+            WrapperRequestObserver( libcmis_requestMetricsCallback callback ) :
+                m_callback( callback )
+            {
+            }
+            virtual ~WrapperRequestObserver( ) { };
+
+            virtual void requestDone( const libcmis::RequestMetrics& metrics );
+    };
+
+    void WrapperRequestObserver::requestDone( const libcmis::RequestMetrics& metrics )
+    {
+        libcmis_request_metrics wrapper;
+        wrapper.handle = &metrics;
+        m_callback( &wrapper );
+    }
 }
 
 std::string createString( char* str )
@@ -178,6 +200,26 @@ const char* libcmis_getProxyPass( )
     return libcmis::SessionFactory::getProxyPass( ).c_str();
 }
 
+void libcmis_setConnectionCacheOptions( bool shareDns, bool shareSslSessions,
+        bool shareConnections )
+{
+    libcmis::SessionFactory::setConnectionCacheOptions( shareDns, shareSslSessions,
+            shareConnections );
+}
+
+void libcmis_flushConnectionCache( )
+{
+    libcmis::SessionFactory::flushConnectionCache( );
+}
+
+void libcmis_setRequestMetricsCallback( libcmis_requestMetricsCallback callback )
+{
+    libcmis::RequestObserverPtr observer;
+    if ( callback != NULL )
+        observer.reset( new ( nothrow ) WrapperRequestObserver( callback ) );
+    libcmis::SessionFactory::setRequestObserver( observer );
+}
+
 libcmis_SessionPtr libcmis_createSession(
         char* bindingUrl,
         char* repositoryId,
@@ -0,0 +1,223 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include <libcmis-c/session-statistics.h>
+
+#include "internals.hxx"
+
+using namespace std;
+
+namespace
+{
+    const libcmis::LatencyHistogram* lcl_getLatency( libcmis_SessionStatisticsPtr statistics,
+            const char* name )
+    {
+        if ( statistics == NULL || name == NULL )
+            return NULL;
+
+        const map< string, libcmis::LatencyHistogram >& latencies = statistics->handle.getLatencies( );
+        map< string, libcmis::LatencyHistogram >::const_iterator it = latencies.find( string( name ) );
+        if ( it == latencies.end( ) )
+            return NULL;
+        return &it->second;
+    }
+}
+
+void libcmis_session_statistics_free( libcmis_SessionStatisticsPtr statistics )
+{
+    delete statistics;
+}
+
+long libcmis_session_statistics_getRequests( libcmis_SessionStatisticsPtr statistics,
+        const char* method )
+{
+    long result = 0;
+    if ( statistics != NULL && method != NULL )
+        result = statistics->handle.getRequests( string( method ) );
+    return result;
+}
+
+long libcmis_session_statistics_getRequestsCount( libcmis_SessionStatisticsPtr statistics )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getRequestsCount( );
+    return result;
+}
+
+long libcmis_session_statistics_getResponses( libcmis_SessionStatisticsPtr statistics,
+        int statusClass )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getResponses( statusClass );
+    return result;
+}
+
+long libcmis_session_statistics_getBytesReceived( libcmis_SessionStatisticsPtr statistics )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getBytesReceived( );
+    return result;
+}
+
+long libcmis_session_statistics_getBytesSent( libcmis_SessionStatisticsPtr statistics )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getBytesSent( );
+    return result;
+}
+
+long libcmis_session_statistics_getRetries( libcmis_SessionStatisticsPtr statistics )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getRetries( );
+    return result;
+}
+
+long libcmis_session_statistics_getTokenRefreshes( libcmis_SessionStatisticsPtr statistics )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getTokenRefreshes( );
+    return result;
+}
+
+long libcmis_session_statistics_getObjectCacheHits( libcmis_SessionStatisticsPtr statistics )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getObjectCacheHits( );
+    return result;
+}
+
+long libcmis_session_statistics_getObjectCacheMisses( libcmis_SessionStatisticsPtr statistics )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getObjectCacheMisses( );
+    return result;
+}
+
+long libcmis_session_statistics_getTypeCacheHits( libcmis_SessionStatisticsPtr statistics )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getTypeCacheHits( );
+    return result;
+}
+
+long libcmis_session_statistics_getTypeCacheMisses( libcmis_SessionStatisticsPtr statistics )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getTypeCacheMisses( );
+    return result;
+}
+
+long libcmis_session_statistics_getPathCacheHits( libcmis_SessionStatisticsPtr statistics )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getPathCacheHits( );
+    return result;
+}
+
+long libcmis_session_statistics_getPathCacheMisses( libcmis_SessionStatisticsPtr statistics )
+{
+    long result = 0;
+    if ( statistics != NULL )
+        result = statistics->handle.getPathCacheMisses( );
+    return result;
+}
+
+libcmis_vector_string_Ptr libcmis_session_statistics_getLatencyNames(
+        libcmis_SessionStatisticsPtr statistics )
+{
+    libcmis_vector_string_Ptr names = NULL;
+    if ( statistics != NULL )
+    {
+        try
+        {
+            names = new libcmis_vector_string( );
+            const map< string, libcmis::LatencyHistogram >& latencies = statistics->handle.getLatencies( );
+            for ( map< string, libcmis::LatencyHistogram >::const_iterator it = latencies.begin( );
+                    it != latencies.end( ); ++it )
+                names->handle.push_back( it->first );
+        }
+        catch ( const bad_alloc& )
+        {
+            delete names;
+            names = NULL;
+        }
+    }
+    return names;
+}
+
+long libcmis_session_statistics_getLatencyCount( libcmis_SessionStatisticsPtr statistics,
+        const char* name )
+{
+    long result = 0;
+    const libcmis::LatencyHistogram* histogram = lcl_getLatency( statistics, name );
+    if ( histogram != NULL )
+        result = histogram->getCount( );
+    return result;
+}
+
+double libcmis_session_statistics_getLatencyMean( libcmis_SessionStatisticsPtr statistics,
+        const char* name )
+{
+    double result = 0;
+    const libcmis::LatencyHistogram* histogram = lcl_getLatency( statistics, name );
+    if ( histogram != NULL )
+        result = histogram->getMean( );
+    return result;
+}
+
+double libcmis_session_statistics_getLatencyMaximum( libcmis_SessionStatisticsPtr statistics,
+        const char* name )
+{
+    double result = 0;
+    const libcmis::LatencyHistogram* histogram = lcl_getLatency( statistics, name );
+    if ( histogram != NULL )
+        result = histogram->getMaximum( );
+    return result;
+}
+
+double libcmis_session_statistics_getLatencyPercentile( libcmis_SessionStatisticsPtr statistics,
+        const char* name, double percentile )
+{
+    double result = 0;
+    const libcmis::LatencyHistogram* histogram = lcl_getLatency( statistics, name );
+    if ( histogram != NULL )
+        result = histogram->getPercentile( percentile );
+    return result;
+}
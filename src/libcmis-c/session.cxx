@@ -303,3 +303,27 @@ libcmis_vector_object_type_Ptr libcmis_session_getBaseTypes(
     }
     return types;
 }
+
+libcmis_SessionStatisticsPtr libcmis_session_getStatistics( libcmis_SessionPtr session )
+{
+    libcmis_SessionStatisticsPtr statistics = NULL;
+    if ( session != NULL && session->handle != NULL )
+    {
+        try
+        {
+            libcmis::SessionStatistics handle = session->handle->getStatistics( );
+            statistics = new libcmis_session_statistics( );
+            statistics->handle = handle;
+        }
+        catch ( const bad_alloc& )
+        {
+        }
+    }
+    return statistics;
+}
+
+void libcmis_session_resetStatistics( libcmis_SessionPtr session )
+{
+    if ( session != NULL && session->handle != NULL )
+        session->handle->resetStatistics( );
+}
@@ -37,7 +37,10 @@
 
 #include <libcmis/xml-utils.hxx>
 
+#include "atom-feed-reader.hxx"
 #include "atom-session.hxx"
+#include "trace-scope.hxx"
+#include "xpath-context.hxx"
 
 using namespace std;
 using namespace libcmis;
@@ -55,9 +58,7 @@ AtomDocument::AtomDocument( AtomPubSession* session, xmlNodePtr entryNd ) :
     AtomObject( session ),
     m_contentUrl( )
 {
-    xmlDocPtr doc = libcmis::wrapInDoc( entryNd );
-    refreshImpl( doc );
-    xmlFreeDoc( doc );
+    extractInfos( entryNd );
 }
 
 AtomDocument::~AtomDocument( )
@@ -66,6 +67,8 @@ AtomDocument::~AtomDocument( )
 
 vector< libcmis::FolderPtr > AtomDocument::getParents( )
 {
+    libcmis::TraceScope traceScope( "Document::getParents", getSession( ) );
+
     AtomLink* parentsLink = getLink( "up", "" );
 
     if ( ( NULL == parentsLink ) ||
@@ -74,65 +77,40 @@ vector< libcmis::FolderPtr > AtomDocument::getParents( )
 
     vector< libcmis::FolderPtr > parents;
     
-    string buf;
+    libcmis::HttpResponsePtr response;
     try
     {
-        buf = getSession()->httpGetRequest( parentsLink->getHref( ) )->getStream( )->str( );
+        response = getSession()->httpGetRequest( parentsLink->getHref( ) );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
 
-    xmlDocPtr doc = xmlReadMemory( buf.c_str(), buf.size(), parentsLink->getHref( ).c_str(), NULL, 0 );
-    if ( NULL != doc )
+    AtomFeedReader reader( response->getBody( ), parentsLink->getHref( ) );
+    for ( xmlNodePtr node = reader.nextEntry( ); node != NULL; node = reader.nextEntry( ) )
     {
-        xmlXPathContextPtr xpathCtx = xmlXPathNewContext( doc );
-        libcmis::registerNamespaces( xpathCtx );
-        if ( NULL != xpathCtx )
-        {
-            const string& entriesReq( "//atom:entry" );
-            xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression( BAD_CAST( entriesReq.c_str() ), xpathCtx );
+        libcmis::ObjectPtr object = getSession()->createObjectFromEntry( node );
+        libcmis::FolderPtr folder = boost::dynamic_pointer_cast< libcmis::Folder >( object );
 
-            if ( NULL != xpathObj && NULL != xpathObj->nodesetval )
-            {
-                int size = xpathObj->nodesetval->nodeNr;
-                for ( int i = 0; i < size; i++ )
-                {
-                    xmlNodePtr node = xpathObj->nodesetval->nodeTab[i];
-                    xmlDocPtr entryDoc = libcmis::wrapInDoc( node );
-                    libcmis::ObjectPtr object = getSession()->createObjectFromEntryDoc( entryDoc );
-                    libcmis::FolderPtr folder = boost::dynamic_pointer_cast< libcmis::Folder >( object );
-
-                    if ( folder.get() )
-                        parents.push_back( folder );
-                    xmlFreeDoc( entryDoc );
-                }
-            }
-
-            xmlXPathFreeObject( xpathObj );
-        }
-
-        xmlXPathFreeContext( xpathCtx );
-    }
-    else
-    {
-        throw libcmis::Exception( "Failed to parse folder infos" );
+        if ( folder.get() )
+            parents.push_back( folder );
     }
-    xmlFreeDoc( doc );
 
     return parents;
 }
 
 boost::shared_ptr< istream > AtomDocument::getContentStream( string /*streamId*/ )
 {
+    libcmis::TraceScope traceScope( "Document::getContentStream", getSession( ) );
+
     if ( getAllowableActions().get() && !getAllowableActions()->isAllowed( libcmis::ObjectAction::GetContentStream ) )
         throw libcmis::Exception( string( "GetContentStream is not allowed on document " ) + getId() );
 
     boost::shared_ptr< istream > stream;
     try
     {
-        stream = getSession()->httpGetRequest( m_contentUrl )->getStream( );
+        stream = getSession()->httpGetContentRequest( m_contentUrl )->getBodyStream( );
     }
     catch ( const CurlException& e )
     {
@@ -142,8 +120,30 @@ boost::shared_ptr< istream > AtomDocument::getContentStream( string /*streamId*/
     return stream;
 }
 
+void AtomDocument::downloadContentStream( boost::shared_ptr< libcmis::EncodedData > sink,
+                                          string /*streamId*/ )
+{
+    libcmis::TraceScope traceScope( "Document::downloadContentStream", getSession( ) );
+
+    if ( getAllowableActions().get() && !getAllowableActions()->isAllowed( libcmis::ObjectAction::GetContentStream ) )
+        throw libcmis::Exception( string( "GetContentStream is not allowed on document " ) + getId() );
+
+    try
+    {
+        getSession()->httpGetContentRequest( m_contentUrl, sink );
+    }
+    catch ( const CurlException& e )
+    {
+        throw e.getCmisException( );
+    }
+}
+
 void AtomDocument::setContentStream( boost::shared_ptr< ostream > os, string contentType, string fileName, bool overwrite )
 {
+    libcmis::TraceScope traceScope( "Document::setContentStream", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     if ( !os.get( ) )
         throw libcmis::Exception( "Missing stream" );
 
@@ -230,6 +230,10 @@ void AtomDocument::setContentStream( boost::shared_ptr< ostream > os, string con
 
 libcmis::DocumentPtr AtomDocument::checkOut( )
 {
+    libcmis::TraceScope traceScope( "Document::checkOut", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     if ( ( getAllowableActions( ).get() && !getAllowableActions()->isAllowed( libcmis::ObjectAction::CheckOut ) ) )
         throw libcmis::Exception( string( "CanCheckout not allowed on document " ) + getId() );
     
@@ -277,7 +281,7 @@ libcmis::DocumentPtr AtomDocument::checkOut( )
         throw e.getCmisException( );
     }
 
-    string respBuf = resp->getStream( )->str();
+    const string& respBuf = resp->getBody( );
     std::shared_ptr< xmlDoc > doc( xmlReadMemory( respBuf.c_str(), respBuf.size(), checkedOutUrl.c_str(), NULL, 0 ), xmlFreeDoc );
     if ( !doc )
         throw libcmis::Exception( "Failed to parse object infos" );
@@ -293,6 +297,11 @@ libcmis::DocumentPtr AtomDocument::checkOut( )
 
 void AtomDocument::cancelCheckout( )
 {
+    libcmis::TraceScope traceScope( "Document::cancelCheckout", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     if ( ( getAllowableActions( ).get() && !getAllowableActions()->isAllowed( libcmis::ObjectAction::CancelCheckOut ) ) )
         throw libcmis::Exception( string( "CanCancelCheckout not allowed on document " ) + getId() );
 
@@ -318,6 +327,11 @@ libcmis::DocumentPtr AtomDocument::checkIn( bool isMajor, string comment,
                             const PropertyPtrMap& properties,
                             boost::shared_ptr< ostream > stream, string contentType, string )
 {
+    libcmis::TraceScope traceScope( "Document::checkIn", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     if ( ( getAllowableActions( ).get() && !getAllowableActions()->isAllowed( libcmis::ObjectAction::CheckIn ) ) )
         throw libcmis::Exception( string( "CanCheckIn not allowed on document " ) + getId() );
 
@@ -372,7 +386,7 @@ libcmis::DocumentPtr AtomDocument::checkIn( bool isMajor, string comment,
     }
     
     // Get the returned entry and update using it
-    string respBuf = response->getStream( )->str( );
+    const string& respBuf = response->getBody( );
     std::shared_ptr< xmlDoc > doc( xmlReadMemory( respBuf.c_str(), respBuf.size(), checkInUrl.c_str(), NULL, 0 ), xmlFreeDoc );
     if ( !doc )
         throw libcmis::Exception( "Failed to parse object infos" );
@@ -388,6 +402,8 @@ libcmis::DocumentPtr AtomDocument::checkIn( bool isMajor, string comment,
 
 vector< libcmis::DocumentPtr > AtomDocument::getAllVersions( )
 {
+    libcmis::TraceScope traceScope( "Document::getAllVersions", getSession( ) );
+
     if ( getAllowableActions( ).get() &&
                 !getAllowableActions()->isAllowed( libcmis::ObjectAction::GetAllVersions ) )
         throw libcmis::Exception( string( "GetAllVersions not allowed on node " ) + getId() );
@@ -398,83 +414,49 @@ vector< libcmis::DocumentPtr > AtomDocument::getAllVersions( )
     {
         string pageUrl = link->getHref( );
 
-        string buf;
+        libcmis::HttpResponsePtr response;
         try
         {
-            buf = getSession()->httpGetRequest( pageUrl )->getStream( )->str( );
+            response = getSession()->httpGetRequest( pageUrl );
         }
         catch ( const CurlException& e )
         {
             throw e.getCmisException( );
         }
 
-        xmlDocPtr doc = xmlReadMemory( buf.c_str(), buf.size(), pageUrl.c_str(), NULL, 0 );
-        if ( NULL != doc )
+        AtomFeedReader reader( response->getBody( ), pageUrl );
+        for ( xmlNodePtr node = reader.nextEntry( ); node != NULL; node = reader.nextEntry( ) )
         {
-            xmlXPathContextPtr xpathCtx = xmlXPathNewContext( doc );
-            libcmis::registerNamespaces( xpathCtx );
-            if ( NULL != xpathCtx )
-            {
-                // Get the entries
-                const string& entriesReq( "//atom:entry" );
-                xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression( BAD_CAST( entriesReq.c_str() ), xpathCtx );
+            libcmis::ObjectPtr cmisObject = getSession()->createObjectFromEntry( node );
+            libcmis::DocumentPtr cmisDoc = boost::dynamic_pointer_cast< libcmis::Document >( cmisObject );
 
-                if ( NULL != xpathObj && NULL != xpathObj->nodesetval )
-                {
-                    int size = xpathObj->nodesetval->nodeNr;
-                    for ( int i = 0; i < size; i++ )
-                    {
-                        xmlNodePtr node = xpathObj->nodesetval->nodeTab[i];
-                        xmlDocPtr entryDoc = libcmis::wrapInDoc( node );
-                        libcmis::ObjectPtr cmisObject = getSession()->createObjectFromEntryDoc( entryDoc );
-                        libcmis::DocumentPtr cmisDoc = boost::dynamic_pointer_cast< libcmis::Document >( cmisObject );
-
-                        if ( cmisDoc.get() )
-                            versions.push_back( cmisDoc );
-                        xmlFreeDoc( entryDoc );
-                    }
-                }
-
-                xmlXPathFreeObject( xpathObj );
-            }
-
-            xmlXPathFreeContext( xpathCtx );
-        }
-        else
-        {
-            throw libcmis::Exception( "Failed to parse versions infos" );
+            if ( cmisDoc.get() )
+                versions.push_back( cmisDoc );
         }
-        xmlFreeDoc( doc );
 
     }
     return versions;
 }
 
-void AtomDocument::extractInfos( xmlDocPtr doc )
+void AtomDocument::extractInfos( xmlNodePtr entryNd )
 {
-    AtomObject::extractInfos( doc );
+    AtomObject::extractInfos( entryNd );
    
    // Get the content url 
-    xmlXPathContextPtr xpathCtx = xmlXPathNewContext( doc );
-    if ( NULL != doc )
+    if ( NULL != entryNd )
     {
-        libcmis::registerNamespaces( xpathCtx );
-
-        if ( NULL != xpathCtx )
+        libcmis::XPathContext xpathCtx( entryNd->doc, entryNd );
+        xmlXPathObjectPtr xpathObj = xpathCtx.eval( ".//atom:content" );
+        if ( xpathObj && xpathObj->nodesetval && xpathObj->nodesetval->nodeNr > 0 )
         {
-            xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression( BAD_CAST( "//atom:content" ), xpathCtx );
-            if ( xpathObj && xpathObj->nodesetval && xpathObj->nodesetval->nodeNr > 0 )
+            xmlNodePtr contentNd = xpathObj->nodesetval->nodeTab[0];
+            xmlChar* src = xmlGetProp( contentNd, BAD_CAST( "src" ) );
+            if ( src )
             {
-                xmlNodePtr contentNd = xpathObj->nodesetval->nodeTab[0];
-                xmlChar* src = xmlGetProp( contentNd, BAD_CAST( "src" ) );
-                if ( src )
-                {
-                    m_contentUrl = string( ( char* ) src );
-                    xmlFree( src );
-                }
+                m_contentUrl = string( ( char* ) src );
+                xmlFree( src );
             }
-            xmlXPathFreeObject( xpathObj );
         }
-        xmlXPathFreeContext( xpathCtx );
+        xmlXPathFreeObject( xpathObj );
     }
 }
@@ -0,0 +1,120 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "atom-feed-reader.hxx"
+
+#include <libcmis/exception.hxx>
+#include <libcmis/xml-utils.hxx>
+
+using namespace std;
+
+namespace
+{
+    bool lcl_isElement( xmlTextReaderPtr reader, const char* ns, const char* name )
+    {
+        return xmlStrEqual( xmlTextReaderConstLocalName( reader ), BAD_CAST( name ) ) &&
+               xmlStrEqual( xmlTextReaderConstNamespaceUri( reader ), BAD_CAST( ns ) );
+    }
+
+    bool lcl_isAtomElement( xmlTextReaderPtr reader, const char* name )
+    {
+        return lcl_isElement( reader, NS_ATOM_URL, name );
+    }
+}
+
+AtomFeedReader::AtomFeedReader( const string& buffer, const string& url ) :
+    m_reader( NULL ),
+    m_inEntry( false ),
+    m_nextHref( ),
+    m_numItems( -1 ),
+    m_changeLogToken( )
+{
+    m_reader = xmlReaderForMemory( buffer.c_str( ), buffer.size( ), url.c_str( ), NULL, 0 );
+    if ( NULL == m_reader )
+        throw libcmis::Exception( "Failed to parse feed" );
+}
+
+AtomFeedReader::~AtomFeedReader( )
+{
+    xmlFreeTextReader( m_reader );
+}
+
+xmlNodePtr AtomFeedReader::nextEntry( )
+{
+    // Skip the subtree of the entry we returned last time
+    int ret = m_inEntry ? xmlTextReaderNext( m_reader ) : xmlTextReaderRead( m_reader );
+    m_inEntry = false;
+
+    for ( ; ret == 1; ret = xmlTextReaderRead( m_reader ) )
+    {
+        // Only the direct children of the atom:feed are interesting
+        if ( xmlTextReaderNodeType( m_reader ) != XML_READER_TYPE_ELEMENT ||
+             xmlTextReaderDepth( m_reader ) != 1 )
+            continue;
+
+        if ( lcl_isAtomElement( m_reader, "entry" ) )
+        {
+            xmlNodePtr entry = xmlTextReaderExpand( m_reader );
+            if ( NULL == entry )
+                break;
+            m_inEntry = true;
+            return entry;
+        }
+        else if ( lcl_isAtomElement( m_reader, "link" ) )
+        {
+            xmlChar* rel = xmlTextReaderGetAttribute( m_reader, BAD_CAST( "rel" ) );
+            if ( xmlStrEqual( rel, BAD_CAST( "next" ) ) )
+            {
+                xmlChar* href = xmlTextReaderGetAttribute( m_reader, BAD_CAST( "href" ) );
+                if ( NULL != href )
+                    m_nextHref = string( ( char* ) href );
+                xmlFree( href );
+            }
+            xmlFree( rel );
+        }
+        else if ( lcl_isElement( m_reader, NS_CMISRA_URL, "numItems" ) )
+        {
+            xmlChar* value = xmlTextReaderReadString( m_reader );
+            if ( NULL != value )
+                m_numItems = libcmis::parseInteger( string( ( char* ) value ) );
+            xmlFree( value );
+        }
+        else if ( lcl_isElement( m_reader, NS_CMISRA_URL, "changeLogToken" ) )
+        {
+            xmlChar* value = xmlTextReaderReadString( m_reader );
+            if ( NULL != value )
+                m_changeLogToken = string( ( char* ) value );
+            xmlFree( value );
+        }
+    }
+
+    if ( ret != 0 )
+        throw libcmis::Exception( "Failed to parse feed" );
+
+    return NULL;
+}
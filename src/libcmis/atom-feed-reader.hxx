@@ -0,0 +1,90 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _ATOM_FEED_READER_HXX_
+#define _ATOM_FEED_READER_HXX_
+
+#include <string>
+
+#include <libxml/xmlreader.h>
+
+/** Streaming reader of an Atom feed.
+
+    The feed is parsed in a single pass: only the entry being read is
+    expanded into a tree, and that tree belongs to the reader. This
+    avoids building the whole page DOM and copying each entry into its
+    own document.
+  */
+class AtomFeedReader
+{
+    private:
+        xmlTextReaderPtr m_reader;
+        bool m_inEntry;
+        std::string m_nextHref;
+        long m_numItems;
+        std::string m_changeLogToken;
+
+    public:
+        /** \param buffer the feed, it needs to outlive the reader
+            \param url the feed URL, used as base URL
+          */
+        AtomFeedReader( const std::string& buffer, const std::string& url );
+        ~AtomFeedReader( );
+
+        AtomFeedReader( const AtomFeedReader& copy ) = delete;
+        AtomFeedReader& operator=( const AtomFeedReader& copy ) = delete;
+
+        /** Move to the next atom:entry of the feed.
+
+            \return
+                the entry node or NULL at the end of the feed. The node is
+                only valid until the next call.
+
+            \throw Exception
+                if the feed isn't well-formed XML.
+          */
+        xmlNodePtr nextEntry( );
+
+        /** Get the href of the feed's next link, for paged results.
+            The link may come after the entries: only use it once
+            nextEntry( ) returned NULL.
+          */
+        std::string getNextHref( ) const { return m_nextHref; }
+
+        /** Get the feed's cmisra:numItems or a negative value if the
+            server didn't provide it. Like the next link, it may come
+            after the entries.
+          */
+        long getNumItems( ) const { return m_numItems; }
+
+        /** Get the cmisra:changeLogToken of a change log feed or an
+            empty string. Like the next link, it may come after the entries.
+          */
+        std::string getChangeLogToken( ) const { return m_changeLogToken; }
+};
+
+#endif
@@ -35,22 +35,83 @@
 #include <libcmis/xml-utils.hxx>
 
 #include "atom-document.hxx"
+#include "atom-feed-reader.hxx"
+#include "atom-object-iterator.hxx"
 #include "atom-session.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 using libcmis::PropertyPtrMap;
 
 namespace
 {
+    string lcl_addContextParams( string url, const libcmis::OperationContext& context )
+    {
+        map< string, string > params = AtomPubSession::getContextParams( context );
+        for ( map< string, string >::iterator it = params.begin( ); it != params.end( ); ++it )
+        {
+            if ( url.find( '?' ) != string::npos )
+                url += "&";
+            else
+                url += "?";
+            url += it->first + "=" + libcmis::escape( it->second );
+        }
+        return url;
+    }
+
+    /** Parse the entries of a cmistree feed, with their nested
+        cmisra:children feeds.
+      */
+    vector< libcmis::ObjectTreePtr > lcl_parseTreeFeed( AtomPubSession* session, xmlNodePtr feedNd )
+    {
+        vector< libcmis::ObjectTreePtr > nodes;
+
+        for ( xmlNodePtr entryNd = feedNd->children; entryNd; entryNd = entryNd->next )
+        {
+            if ( !xmlStrEqual( entryNd->name, BAD_CAST( "entry" ) ) )
+                continue;
+
+            // Detach the children before parsing the entry: the object
+            // shouldn't see the properties and links of its descendants.
+            xmlNodePtr childrenNd = NULL;
+            for ( xmlNodePtr child = entryNd->children; child && !childrenNd; child = child->next )
+            {
+                if ( xmlStrEqual( child->name, BAD_CAST( "children" ) ) )
+                    childrenNd = child;
+            }
+            if ( childrenNd )
+                xmlUnlinkNode( childrenNd );
+
+            libcmis::ObjectPtr object = session->createObjectFromEntry( entryNd );
+            if ( object )
+            {
+                libcmis::ObjectTreePtr node( new libcmis::ObjectTree( object ) );
+                for ( xmlNodePtr child = childrenNd ? childrenNd->children : NULL; child; child = child->next )
+                {
+                    if ( !xmlStrEqual( child->name, BAD_CAST( "feed" ) ) )
+                        continue;
+
+                    vector< libcmis::ObjectTreePtr > children = lcl_parseTreeFeed( session, child );
+                    for ( vector< libcmis::ObjectTreePtr >::iterator it = children.begin( );
+                            it != children.end( ); ++it )
+                        node->addChild( *it );
+                }
+                nodes.push_back( node );
+            }
+
+            if ( childrenNd )
+                xmlFreeNode( childrenNd );
+        }
+
+        return nodes;
+    }
 }
 
 AtomFolder::AtomFolder( AtomPubSession* session, xmlNodePtr entryNd ) :
     libcmis::Object( session ),
     AtomObject( session )
 {
-    xmlDocPtr doc = libcmis::wrapInDoc( entryNd );
-    refreshImpl( doc );
-    xmlFreeDoc( doc );
+    extractInfos( entryNd );
 }
 
 
@@ -58,8 +119,24 @@ AtomFolder::~AtomFolder( )
 {
 }
 
-vector< libcmis::ObjectPtr > AtomFolder::getChildren( )
+vector< libcmis::ObjectPtr > AtomFolder::getChildren( const libcmis::OperationContext& context )
 {
+    libcmis::TraceScope traceScope( "Folder::getChildren", getSession( ) );
+
+    vector< libcmis::ObjectPtr > children;
+
+    libcmis::ObjectIteratorPtr it = listChildren( 0, 0, context );
+    while ( it->hasNext( ) )
+        children.push_back( it->next( ) );
+
+    return children;
+}
+
+libcmis::ObjectIteratorPtr AtomFolder::listChildren( long pageSize, long readAhead,
+                                                     const libcmis::OperationContext& context )
+{
+    libcmis::TraceScope traceScope( "Folder::listChildren", getSession( ) );
+
     const AtomLink* childrenLink = getLink( "down", "application/atom+xml;type=feed" );
 
     // Some servers aren't giving the GetChildren properly... if not defined, we need to try
@@ -69,73 +146,57 @@ vector< libcmis::ObjectPtr > AtomFolder::getChildren( )
                   getAllowableActions()->isDefined( libcmis::ObjectAction::GetChildren ) ) ) )
         throw libcmis::Exception( string( "GetChildren not allowed on node " ) + getId() );
 
-    vector< libcmis::ObjectPtr > children;
+    string url = lcl_addContextParams( childrenLink->getHref( ), context );
+    return libcmis::ObjectIteratorPtr( new AtomObjectIterator( getSession( ), url, pageSize, readAhead ) );
+}
 
-    string pageUrl = childrenLink->getHref( );
+vector< libcmis::ObjectTreePtr > AtomFolder::getTree( int depth, bool foldersOnly,
+        const libcmis::OperationContext& context )
+{
+    libcmis::TraceScope traceScope( "Folder::getTree", getSession( ) );
 
-    bool hasNext = true;
-    while ( hasNext )
-    {
-        string buf;
-        try
-        {
-            buf = getSession()->httpGetRequest( pageUrl )->getStream( )->str( );
-        }
-        catch ( const CurlException& e )
-        {
-            throw e.getCmisException( );
-        }
+    const AtomLink* treeLink = NULL;
+    if ( foldersOnly )
+        treeLink = getLink( "http://docs.oasis-open.org/ns/cmis/link/200908/foldertree", "application/cmistree+xml" );
+    else
+        treeLink = getLink( "down", "application/cmistree+xml" );
 
-        xmlDocPtr doc = xmlReadMemory( buf.c_str(), buf.size(), pageUrl.c_str(), NULL, 0 );
-        if ( NULL != doc )
-        {
-            xmlXPathContextPtr xpathCtx = xmlXPathNewContext( doc );
-            libcmis::registerNamespaces( xpathCtx );
-            if ( NULL != xpathCtx )
-            {
-                // Check if there is a next link to handled paged results
-                const string& nextReq( "/atom:feed/atom:link[@rel='next']/attribute::href" );
-                string nextHref = libcmis::getXPathValue( xpathCtx, nextReq );
-                hasNext = !nextHref.empty( );
-                if ( hasNext )
-                    pageUrl = nextHref;
-
-                // Get the page entries
-                const string& entriesReq( "//atom:entry" );
-                xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression( BAD_CAST( entriesReq.c_str() ), xpathCtx );
-
-                if ( NULL != xpathObj && NULL != xpathObj->nodesetval )
-                {
-                    int size = xpathObj->nodesetval->nodeNr;
-                    for ( int i = 0; i < size; i++ )
-                    {
-                        xmlNodePtr node = xpathObj->nodesetval->nodeTab[i];
-                        xmlDocPtr entryDoc = libcmis::wrapInDoc( node );
-                        libcmis::ObjectPtr cmisObject = getSession()->createObjectFromEntryDoc( entryDoc );
-
-                        if ( cmisObject.get() )
-                            children.push_back( cmisObject );
-                        xmlFreeDoc( entryDoc );
-                    }
-                }
+    // Not all the servers support the descendants services
+    if ( NULL == treeLink )
+        return libcmis::Folder::getTree( depth, foldersOnly, context );
 
-                xmlXPathFreeObject( xpathObj );
-            }
+    string url = treeLink->getHref( );
+    if ( url.find( '?' ) != string::npos )
+        url += "&";
+    else
+        url += "?";
+    url += "depth=" + to_string( depth );
+    url = lcl_addContextParams( url, context );
 
-            xmlXPathFreeContext( xpathCtx );
-        }
-        else
-        {
-            throw libcmis::Exception( "Failed to parse folder infos" );
-        }
+    vector< libcmis::ObjectTreePtr > nodes;
+    try
+    {
+        libcmis::HttpResponsePtr response = getSession( )->httpGetRequest( url );
+        const string& buf = response->getBody( );
+        xmlDocPtr doc = xmlReadMemory( buf.c_str(), buf.size(), url.c_str(), NULL, 0 );
+        if ( NULL == doc )
+            throw libcmis::Exception( "Failed to parse the descendants feed" );
+
+        nodes = lcl_parseTreeFeed( getSession( ), xmlDocGetRootElement( doc ) );
         xmlFreeDoc( doc );
     }
+    catch ( const CurlException& e )
+    {
+        throw e.getCmisException( );
+    }
 
-    return children;
+    return nodes;
 }
 
 libcmis::FolderPtr AtomFolder::createFolder( const PropertyPtrMap& properties )
 {
+    libcmis::TraceScope traceScope( "Folder::createFolder", getSession( ) );
+
     AtomLink* childrenLink = getLink( "down", "application/atom+xml;type=feed" );
 
     if ( ( NULL == childrenLink ) || ( getAllowableActions( ).get() &&
@@ -172,7 +233,7 @@ libcmis::FolderPtr AtomFolder::createFolder( const PropertyPtrMap& properties )
         throw e.getCmisException( );
     }
 
-    string respBuf = response->getStream( )->str( );
+    const string& respBuf = response->getBody( );
     xmlDocPtr doc = xmlReadMemory( respBuf.c_str(), respBuf.size(), getInfosUrl().c_str(), NULL, 0 );
     if ( NULL == doc )
         throw libcmis::Exception( "Failed to parse object infos" );
@@ -190,6 +251,8 @@ libcmis::FolderPtr AtomFolder::createFolder( const PropertyPtrMap& properties )
 libcmis::DocumentPtr AtomFolder::createDocument( const PropertyPtrMap& properties,
         boost::shared_ptr< ostream > os, string contentType, string )
 {
+    libcmis::TraceScope traceScope( "Folder::createDocument", getSession( ) );
+
     AtomLink* childrenLink = getLink( "down", "application/atom+xml;type=feed" );
 
     if ( ( NULL == childrenLink ) || ( getAllowableActions( ).get() &&
@@ -218,8 +281,7 @@ libcmis::DocumentPtr AtomFolder::createDocument( const PropertyPtrMap& propertie
         throw e.getCmisException( );
     }
 
-    string respBuf = response->getStream( )->str( );
-    boost::shared_ptr< xmlDoc > doc( xmlReadMemory( respBuf.c_str(), respBuf.size(), getInfosUrl().c_str(), NULL, XML_PARSE_NOERROR ), xmlFreeDoc );
+    boost::shared_ptr< xmlDoc > doc( xmlReadMemory( response->getBody( ).c_str(), response->getBody( ).size(), getInfosUrl().c_str(), NULL, XML_PARSE_NOERROR ), xmlFreeDoc );
     if ( !doc )
     {
         // We may not have the created document entry in the response body: this is
@@ -237,8 +299,7 @@ libcmis::DocumentPtr AtomFolder::createDocument( const PropertyPtrMap& propertie
             try
             {
                 response = getSession( )->httpGetRequest( it->second );
-                respBuf = response->getStream( )->str( );
-                doc.reset( xmlReadMemory( respBuf.c_str(), respBuf.size(), getInfosUrl().c_str(), NULL, XML_PARSE_NOERROR ), xmlFreeDoc );
+                doc.reset( xmlReadMemory( response->getBody( ).c_str(), response->getBody( ).size(), getInfosUrl().c_str(), NULL, XML_PARSE_NOERROR ), xmlFreeDoc );
             }
             catch ( const CurlException& e )
             {
@@ -263,6 +324,11 @@ libcmis::DocumentPtr AtomFolder::createDocument( const PropertyPtrMap& propertie
 vector< string > AtomFolder::removeTree( bool allVersions, libcmis::UnfileObjects::Type unfile,
         bool continueOnError )
 {
+    libcmis::TraceScope traceScope( "Folder::removeTree", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     const AtomLink* treeLink = getLink( "down", "application/cmistree+xml" );
     if ( NULL == treeLink )
         treeLink = getLink( "http://docs.oasis-open.org/ns/cmis/link/200908/foldertree", "application/cmistree+xml" );
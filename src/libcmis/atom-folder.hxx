@@ -42,7 +42,9 @@ class AtomFolder : public libcmis::Folder, public AtomObject
         ~AtomFolder( );
 
         // virtual pure methods from Folder
-        virtual std::vector< libcmis::ObjectPtr > getChildren( );
+        virtual std::vector< libcmis::ObjectPtr > getChildren( const libcmis::OperationContext& context = libcmis::OperationContext( ) );
+        virtual libcmis::ObjectIteratorPtr listChildren( long pageSize = 0, long readAhead = 0,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
         virtual libcmis::FolderPtr createFolder( const std::map< std::string, libcmis::PropertyPtr >& properties );
         virtual libcmis::DocumentPtr createDocument( const std::map< std::string, libcmis::PropertyPtr >& properties,
@@ -51,6 +53,10 @@ class AtomFolder : public libcmis::Folder, public AtomObject
         virtual std::vector< std::string > removeTree( bool allVersion = true,
                                 libcmis::UnfileObjects::Type unfile = libcmis::UnfileObjects::Delete,
                                 bool continueOnError = false );
+
+    protected:
+        virtual std::vector< libcmis::ObjectTreePtr > getTree( int depth, bool foldersOnly,
+                const libcmis::OperationContext& context );
 };
 
 #endif
@@ -0,0 +1,211 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "atom-object-iterator.hxx"
+
+#include <sstream>
+
+#include "atom-feed-reader.hxx"
+#include "atom-session.hxx"
+
+using namespace std;
+
+namespace
+{
+    string lcl_addParam( string url, const string& param )
+    {
+        if ( url.find( '?' ) != string::npos )
+            url += "&";
+        else
+            url += "?";
+        return url + param;
+    }
+}
+
+AtomObjectIterator::AtomObjectIterator( AtomPubSession* session, const string& url,
+                                        long pageSize, long readAhead ) :
+    libcmis::ObjectIterator( ),
+    m_session( session ),
+    m_url( url ),
+    m_pageSize( pageSize ),
+    m_readAhead( readAhead ),
+    m_firstPageBody( ),
+    m_firstPageContentType( ),
+    m_nextUrl( url ),
+    m_nextSkipCount( 0 ),
+    m_numItems( -1 ),
+    m_receivedItems( 0 ),
+    m_pending( )
+{
+    if ( m_pageSize > 0 )
+        m_nextUrl = lcl_addParam( m_url, "maxItems=" + to_string( m_pageSize ) );
+
+    // Following the next links, only one page can be requested ahead
+    if ( m_pageSize <= 0 && m_readAhead > 1 )
+        m_readAhead = 1;
+}
+
+AtomObjectIterator::AtomObjectIterator( AtomPubSession* session, const string& url,
+                                        const string& firstPageBody, const string& contentType ) :
+    libcmis::ObjectIterator( ),
+    m_session( session ),
+    m_url( url ),
+    m_pageSize( 0 ),
+    m_readAhead( 0 ),
+    m_firstPageBody( firstPageBody ),
+    m_firstPageContentType( contentType ),
+    m_nextUrl( url ),
+    m_nextSkipCount( 0 ),
+    m_numItems( -1 ),
+    m_receivedItems( 0 ),
+    m_pending( )
+{
+}
+
+bool AtomObjectIterator::useSkipCount( ) const
+{
+    return m_readAhead > 1;
+}
+
+void AtomObjectIterator::requestPages( )
+{
+    while ( m_pending.size( ) < size_t( m_readAhead ) + 1 )
+    {
+        string url;
+        if ( useSkipCount( ) )
+        {
+            // No need to go past the end if we know where it is
+            if ( m_numItems >= 0 && m_nextSkipCount >= m_numItems )
+                break;
+
+            url = m_nextUrl;
+            if ( m_nextSkipCount > 0 )
+                url = lcl_addParam( url, "skipCount=" + to_string( m_nextSkipCount ) );
+            m_nextSkipCount += m_pageSize;
+        }
+        else
+        {
+            if ( m_nextUrl.empty( ) )
+                break;
+            url = m_nextUrl;
+            m_nextUrl.clear( );
+        }
+
+        m_pending.push_back( PendingPage( url, m_session->httpGetRequestAsync( url ) ) );
+    }
+}
+
+vector< libcmis::ObjectPtr > AtomObjectIterator::fetchNextPage( )
+{
+    vector< libcmis::ObjectPtr > page;
+
+    string url = m_nextUrl;
+    libcmis::HttpResponsePtr response;
+    try
+    {
+        if ( m_readAhead > 0 )
+        {
+            requestPages( );
+            if ( m_pending.empty( ) )
+            {
+                setHasMoreItems( false );
+                return page;
+            }
+
+            url = m_pending.front( ).first;
+            future< libcmis::HttpResponsePtr > result = move( m_pending.front( ).second );
+            m_pending.pop_front( );
+            response = result.get( );
+        }
+        else if ( !m_firstPageBody.empty( ) )
+        {
+            istringstream is( m_firstPageBody );
+            response = m_session->httpPostRequest( url, is, m_firstPageContentType );
+            m_firstPageBody.clear( );
+        }
+        else
+            response = m_session->httpGetRequest( url );
+    }
+    catch ( const CurlException& e )
+    {
+        throw e.getCmisException( );
+    }
+
+    AtomFeedReader reader( response->getBody( ), url );
+    long entries = 0;
+    for ( xmlNodePtr node = reader.nextEntry( ); node != NULL; node = reader.nextEntry( ) )
+    {
+        ++entries;
+        libcmis::ObjectPtr cmisObject = m_session->createObjectFromEntry( node );
+        if ( cmisObject.get() )
+            page.push_back( cmisObject );
+    }
+
+    if ( reader.getNumItems( ) >= 0 )
+    {
+        m_numItems = reader.getNumItems( );
+        setNumItems( m_numItems );
+    }
+
+    m_receivedItems += entries;
+
+    string nextHref = reader.getNextHref( );
+    setHasMoreItems( !nextHref.empty( ) );
+    if ( nextHref.empty( ) )
+    {
+        // The pages requested ahead are past the end
+        m_pending.clear( );
+    }
+    else
+    {
+        if ( !useSkipCount( ) )
+            m_nextUrl = nextHref;
+        else if ( entries < m_pageSize )
+        {
+            // The server sent less than asked, likely capping the page
+            // size: the pages requested ahead would miss items.
+            m_pending.clear( );
+            if ( entries > 0 )
+            {
+                m_pageSize = entries;
+                m_nextSkipCount = m_receivedItems;
+            }
+            else
+            {
+                m_readAhead = 1;
+                m_nextUrl = nextHref;
+            }
+        }
+
+        // Request the next pages while the caller consumes this one
+        if ( m_readAhead > 0 )
+            requestPages( );
+    }
+
+    return page;
+}
@@ -0,0 +1,114 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _ATOM_OBJECT_ITERATOR_HXX_
+#define _ATOM_OBJECT_ITERATOR_HXX_
+
+#include <deque>
+#include <future>
+#include <string>
+#include <utility>
+
+#include <libcmis/object-iterator.hxx>
+#include <libcmis/xml-utils.hxx>
+
+class AtomPubSession;
+
+/** Iterator over the entries of a paged Atom feed.
+
+    Without read-ahead, each page is requested when the previous one is
+    consumed, following the feed's next links.
+
+    With read-ahead, the request for the next page is sent as soon as
+    the current page is parsed, so that it runs while the caller
+    consumes the objects. For a depth above 1, a page size is needed:
+    the page URLs are then computed with the skipCount parameter rather
+    than read from the next links, and that many pages are kept in
+    flight.
+  */
+class AtomObjectIterator : public libcmis::ObjectIterator
+{
+    private:
+        typedef std::pair< std::string, std::future< libcmis::HttpResponsePtr > > PendingPage;
+
+        AtomPubSession* m_session;
+        std::string m_url;
+        long m_pageSize;
+        long m_readAhead;
+
+        /** Document to post to get the first page, if any.
+          */
+        std::string m_firstPageBody;
+        std::string m_firstPageContentType;
+
+        /** URL of the next page to request when following the next
+            links, empty when there is none.
+          */
+        std::string m_nextUrl;
+
+        /** skipCount of the next page to request when using skipCount.
+          */
+        long m_nextSkipCount;
+        long m_numItems;
+
+        /** Number of entries in the pages parsed so far.
+          */
+        long m_receivedItems;
+
+        std::deque< PendingPage > m_pending;
+
+        bool useSkipCount( ) const;
+
+        /** Send the requests for the pages to read ahead.
+          */
+        void requestPages( );
+
+    public:
+        /** \param url the first page of the feed
+            \param pageSize the maxItems to request or 0 to let the server decide
+            \param readAhead the number of pages to request ahead of the
+                   one being consumed. Values above 1 need a page size.
+          */
+        AtomObjectIterator( AtomPubSession* session, const std::string& url,
+                            long pageSize = 0, long readAhead = 0 );
+
+        /** Iterator getting the first page by posting a document to url,
+            like for the query collection, and the next ones by following
+            the next links.
+          */
+        AtomObjectIterator( AtomPubSession* session, const std::string& url,
+                            const std::string& firstPageBody, const std::string& contentType );
+        virtual ~AtomObjectIterator( ) { }
+
+        AtomObjectIterator( const AtomObjectIterator& copy ) = delete;
+        AtomObjectIterator& operator=( const AtomObjectIterator& copy ) = delete;
+
+    protected:
+        virtual std::vector< libcmis::ObjectPtr > fetchNextPage( );
+};
+
+#endif
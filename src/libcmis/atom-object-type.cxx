@@ -33,6 +33,8 @@
 
 #include <libcmis/xml-utils.hxx>
 
+#include "xpath-context.hxx"
+
 using namespace std;
 using namespace boost;
 
@@ -53,9 +55,7 @@ AtomObjectType::AtomObjectType( AtomPubSession* session, xmlNodePtr entryNd ) :
     m_selfUrl( ),
     m_childrenUrl( )
 {
-    xmlDocPtr doc = libcmis::wrapInDoc( entryNd );
-    refreshImpl( doc );
-    xmlFreeDoc( doc );
+    extractInfos( entryNd );
 }
 
 AtomObjectType::AtomObjectType( const AtomObjectType& copy ) :
@@ -108,10 +108,10 @@ void AtomObjectType::refreshImpl( xmlDocPtr doc )
         vars[URI_TEMPLATE_VAR_ID] = getId( );
         string url = m_session->createUrl( pattern, vars );
 
-        string buf;
+        libcmis::HttpResponsePtr response;
         try
         {
-            buf  = m_session->httpGetRequest( url )->getStream()->str();
+            response = m_session->httpGetRequest( url );
         }
         catch ( const CurlException& e )
         {
@@ -126,6 +126,7 @@ void AtomObjectType::refreshImpl( xmlDocPtr doc )
                 throw e.getCmisException( );
         }
 
+        const string& buf = response->getBody( );
         ownedDoc.reset( xmlReadMemory( buf.c_str(), buf.size(), m_selfUrl.c_str(), NULL, 0 ), xmlFreeDoc );
 
         if ( !ownedDoc )
@@ -134,34 +135,28 @@ void AtomObjectType::refreshImpl( xmlDocPtr doc )
         doc = ownedDoc.get();
     }
 
-    extractInfos( doc );
+    extractInfos( xmlDocGetRootElement( doc ) );
 }
 
-void AtomObjectType::extractInfos( xmlDocPtr doc )
+void AtomObjectType::extractInfos( xmlNodePtr entryNd )
 {
-    xmlXPathContextPtr xpathCtx = xmlXPathNewContext( doc );
+    if ( NULL == entryNd )
+        return;
+
+    libcmis::XPathContext xpathCtx( entryNd->doc, entryNd );
+
+    // Get the self URL
+    m_selfUrl = xpathCtx.getValue( ".//atom:link[@rel='self']/attribute::href" );
 
-    // Register the Service Document namespaces
-    libcmis::registerNamespaces( xpathCtx );
+    // Get the children URL
+    m_childrenUrl = xpathCtx.getValue( ".//atom:link[@rel='down' and @type='application/atom+xml;type=feed']/attribute::href" );
 
-    if ( NULL != xpathCtx )
+    // Get the cmisra:type node
+    xmlXPathObjectPtr xpathObj = xpathCtx.eval( ".//cmisra:type" );
+    if ( NULL != xpathObj && NULL != xpathObj->nodesetval && xpathObj->nodesetval->nodeNr )
     {
-        // Get the self URL
-        string selfUrlReq( "//atom:link[@rel='self']/attribute::href" );
-        m_selfUrl = libcmis::getXPathValue( xpathCtx, selfUrlReq );
-        
-        // Get the children URL
-        string childrenUrlReq( "//atom:link[@rel='down' and @type='application/atom+xml;type=feed']/attribute::href" );
-        m_childrenUrl = libcmis::getXPathValue( xpathCtx, childrenUrlReq );
-        
-        // Get the cmisra:type node
-        xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression( BAD_CAST( "//cmisra:type" ), xpathCtx );
-        if ( NULL != xpathObj && NULL != xpathObj->nodesetval && xpathObj->nodesetval->nodeNr )
-        {
-            xmlNodePtr typeNode = xpathObj->nodesetval->nodeTab[0];
-            initializeFromNode( typeNode );
-        }
-        xmlXPathFreeObject( xpathObj );
+        xmlNodePtr typeNode = xpathObj->nodesetval->nodeTab[0];
+        initializeFromNode( typeNode );
     }
-    xmlXPathFreeContext( xpathCtx );
+    xmlXPathFreeObject( xpathObj );
 }
@@ -57,7 +57,7 @@ class AtomObjectType : public libcmis::ObjectType
     private:
 
         void refreshImpl( xmlDocPtr doc );
-        void extractInfos( xmlDocPtr doc );
+        void extractInfos( xmlNodePtr entryNd );
 };
 
 #endif
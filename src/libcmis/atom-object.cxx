@@ -42,6 +42,8 @@
 #include "atom-folder.hxx"
 #include "atom-object-type.hxx"
 #include "atom-session.hxx"
+#include "trace-scope.hxx"
+#include "xpath-context.hxx"
 
 using namespace std;
 using libcmis::PropertyPtrMap;
@@ -74,13 +76,15 @@ namespace
 
 AtomObject::AtomObject( AtomPubSession* session ) :
     libcmis::Object( session ),
-    m_links( )
+    m_links( ),
+    m_validators( )
 {
 }
 
 AtomObject::AtomObject( const AtomObject& copy ) :
     libcmis::Object( copy ),
-    m_links( copy.m_links )
+    m_links( copy.m_links ),
+    m_validators( copy.m_validators )
 {
 }
 
@@ -90,6 +94,7 @@ AtomObject& AtomObject::operator=( const AtomObject& copy )
     {
         libcmis::Object::operator=( copy );
         m_links = copy.m_links;
+        m_validators = copy.m_validators;
     }
 
     return *this;
@@ -101,6 +106,10 @@ AtomObject::~AtomObject( )
 
 libcmis::ObjectPtr AtomObject::updateProperties( const PropertyPtrMap& properties )
 {
+    libcmis::TraceScope traceScope( "Object::updateProperties", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     if ( getAllowableActions().get() && !getAllowableActions()->isAllowed( libcmis::ObjectAction::UpdateProperties ) )
         throw libcmis::Exception( string( "UpdateProperties is not allowed on object " ) + getId() );
 
@@ -149,7 +158,7 @@ libcmis::ObjectPtr AtomObject::updateProperties( const PropertyPtrMap& propertie
         throw e.getCmisException( );
     }
 
-    string respBuf = response->getStream( )->str( );
+    const string& respBuf = response->getBody( );
     std::shared_ptr< xmlDoc > doc( xmlReadMemory( respBuf.c_str(), respBuf.size(), getInfosUrl().c_str(), NULL, 0 ), xmlFreeDoc );
     if ( !doc )
         throw libcmis::Exception( "Failed to parse object infos" );
@@ -172,7 +181,7 @@ libcmis::AllowableActionsPtr AtomObject::getAllowableActions( )
             try
             {
                 libcmis::HttpResponsePtr response = getSession()->httpGetRequest( link->getHref() );
-                string buf = response->getStream()->str();
+                const string& buf = response->getBody( );
                 std::shared_ptr< xmlDoc > doc( xmlReadMemory( buf.c_str(), buf.size(), link->getHref().c_str(), NULL, 0 ), xmlFreeDoc );
                 xmlNodePtr actionsNode = xmlDocGetRootElement( doc.get() );
                 if ( actionsNode )
@@ -187,21 +196,37 @@ libcmis::AllowableActionsPtr AtomObject::getAllowableActions( )
     return libcmis::Object::getAllowableActions();
 }
 
+void AtomObject::refresh( )
+{
+    libcmis::TraceScope traceScope( "Object::refresh", getSession( ) );
+    refreshImpl( NULL );
+}
+
 void AtomObject::refreshImpl( xmlDocPtr doc )
 {
     std::shared_ptr< xmlDoc > ownedDoc;
+    libcmis::HttpValidators validators;
     if ( NULL == doc )
     {
-        string buf;
+        libcmis::HttpResponsePtr response;
+        validators = m_validators;
         try
         {
-            buf  = getSession()->httpGetRequest( getInfosUrl() )->getStream( )->str( );
+            response = getSession()->httpConditionalGetRequest( getInfosUrl(), validators );
         }
         catch ( const CurlException& e )
         {
             throw e.getCmisException( );
         }
 
+        // Nothing changed since the last refresh: keep the parsed state
+        if ( !response )
+        {
+            m_refreshTimestamp = time( NULL );
+            return;
+        }
+
+        const string& buf = response->getBody( );
         ownedDoc.reset( xmlReadMemory( buf.c_str(), buf.size(), getInfosUrl().c_str(), NULL, 0 ), xmlFreeDoc );
 
         if ( !ownedDoc )
@@ -217,11 +242,18 @@ void AtomObject::refreshImpl( xmlDocPtr doc )
     m_links.clear( );
     m_renditions.clear( );
 
-    extractInfos( doc );
+    extractInfos( xmlDocGetRootElement( doc ) );
+
+    // Only the entries we downloaded ourselves can be revalidated
+    m_validators = validators;
 }
 
 void AtomObject::remove( bool allVersions )
 {
+    libcmis::TraceScope traceScope( "Object::remove", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     if ( getAllowableActions( ).get() && !getAllowableActions()->isAllowed( libcmis::ObjectAction::DeleteObject ) )
         throw libcmis::Exception( string( "DeleteObject not allowed on object " ) + getId() );
 
@@ -248,6 +280,10 @@ void AtomObject::remove( bool allVersions )
 
 void AtomObject::move( boost::shared_ptr< libcmis::Folder > source, boost::shared_ptr< libcmis::Folder > destination )
 {
+    libcmis::TraceScope traceScope( "Object::move", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     AtomFolder* atomDestination = dynamic_cast< AtomFolder* > ( destination.get() );
 
     if ( NULL == atomDestination )
@@ -297,7 +333,7 @@ void AtomObject::move( boost::shared_ptr< libcmis::Folder > source, boost::share
     }
 
     // refresh self from response
-    string respBuf = response->getStream( )->str( );
+    const string& respBuf = response->getBody( );
     std::shared_ptr< xmlDoc > doc( xmlReadMemory( respBuf.c_str(), respBuf.size(), getInfosUrl().c_str(), NULL, 0 ), xmlFreeDoc );
     if ( !doc )
         throw libcmis::Exception( "Failed to parse object infos" );
@@ -312,75 +348,70 @@ string AtomObject::getInfosUrl( )
     return string( );
 }
 
-void AtomObject::extractInfos( xmlDocPtr doc )
+void AtomObject::extractInfos( xmlNodePtr entryNd )
 {
-    xmlXPathContextPtr xpathCtx = xmlXPathNewContext( doc );
+    if ( NULL == entryNd )
+        return;
 
-    libcmis::registerNamespaces( xpathCtx );
+    libcmis::XPathContext xpathCtx( entryNd->doc, entryNd );
 
-    if ( NULL != xpathCtx )
-    {
-        m_links.clear( );
-        m_renditions.clear( );
+    m_links.clear( );
+    m_renditions.clear( );
 
-        // Get all the atom links
-        string linksReq( "//atom:link" );
-        xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression( BAD_CAST( linksReq.c_str() ), xpathCtx );
-        if ( NULL != xpathObj && NULL != xpathObj->nodesetval )
+    // Get all the atom links
+    xmlXPathObjectPtr xpathObj = xpathCtx.eval( ".//atom:link" );
+    if ( NULL != xpathObj && NULL != xpathObj->nodesetval )
+    {
+        int size = xpathObj->nodesetval->nodeNr;
+        for ( int i = 0; i < size; i++ )
         {
-            int size = xpathObj->nodesetval->nodeNr;
-            for ( int i = 0; i < size; i++ )
+            xmlNodePtr node = xpathObj->nodesetval->nodeTab[i];
+            try
             {
-                xmlNodePtr node = xpathObj->nodesetval->nodeTab[i];
-                try
+                AtomLink link( node );
+                // Add to renditions if alternate link
+                if ( link.getRel( ) == "alternate" )
                 {
-                    AtomLink link( node );
-                    // Add to renditions if alternate link
-                    if ( link.getRel( ) == "alternate" )
-                    {
-                        string kind;
-                        map< string, string >::iterator it = link.getOthers().find( "renditionKind" );
-                        if ( it != link.getOthers( ).end() )
-                            kind = it->second;
-
-                        string title;
-                        it = link.getOthers().find( "title" );
-                        if ( it != link.getOthers( ).end( ) )
-                            title = it->second;
-
-                        long length = -1;
-                        it = link.getOthers( ).find( "length" );
-                        if ( it != link.getOthers( ).end( ) )
-                            length = libcmis::parseInteger( it->second );
-
-                        libcmis::RenditionPtr rendition( new libcmis::Rendition(
-                                    string(), link.getType(), kind,
-                                    link.getHref( ), title, length ) );
-
-                        m_renditions.push_back( rendition );
-                    }
-                    else
-                        m_links.push_back( node );
-                }
-                catch ( const libcmis::Exception& )
-                {
-                    // Broken or incomplete link... don't add it
+                    string kind;
+                    map< string, string >::iterator it = link.getOthers().find( "renditionKind" );
+                    if ( it != link.getOthers( ).end() )
+                        kind = it->second;
+
+                    string title;
+                    it = link.getOthers().find( "title" );
+                    if ( it != link.getOthers( ).end( ) )
+                        title = it->second;
+
+                    long length = -1;
+                    it = link.getOthers( ).find( "length" );
+                    if ( it != link.getOthers( ).end( ) )
+                        length = libcmis::parseInteger( it->second );
+
+                    libcmis::RenditionPtr rendition( new libcmis::Rendition(
+                                string(), link.getType(), kind,
+                                link.getHref( ), title, length ) );
+
+                    m_renditions.push_back( rendition );
                 }
+                else
+                    m_links.push_back( node );
+            }
+            catch ( const libcmis::Exception& )
+            {
+                // Broken or incomplete link... don't add it
             }
         }
-        xmlXPathFreeObject( xpathObj );
+    }
+    xmlXPathFreeObject( xpathObj );
 
 
-        xpathObj = xmlXPathEvalExpression( BAD_CAST( "//cmisra:object" ), xpathCtx );
-        if ( xpathObj && xpathObj->nodesetval && xpathObj->nodesetval->nodeNr > 0 )
-        {
-            xmlNodePtr node = xpathObj->nodesetval->nodeTab[0];
-            initializeFromNode( node );
-        }
-        xmlXPathFreeObject( xpathObj );
+    xpathObj = xpathCtx.eval( ".//cmisra:object" );
+    if ( xpathObj && xpathObj->nodesetval && xpathObj->nodesetval->nodeNr > 0 )
+    {
+        xmlNodePtr node = xpathObj->nodesetval->nodeTab[0];
+        initializeFromNode( node );
     }
-
-    xmlXPathFreeContext( xpathCtx );
+    xmlXPathFreeObject( xpathObj );
 }
 
 AtomPubSession* AtomObject::getSession( )
@@ -33,6 +33,8 @@
 
 #include <libcmis/object.hxx>
 
+#include "http-session.hxx"
+
 class AtomPubSession;
 
 class AtomLink
@@ -61,6 +63,9 @@ class AtomObject : public virtual libcmis::Object
 
         std::vector< AtomLink > m_links;
 
+        /// Validators of the entry downloaded by the last refresh
+        libcmis::HttpValidators m_validators;
+
     public:
         AtomObject( AtomPubSession* session );
         AtomObject( const AtomObject& copy );
@@ -76,7 +81,7 @@ class AtomObject : public virtual libcmis::Object
 
         /** Reload the data from the server.
               */
-        virtual void refresh( ) { refreshImpl( NULL ); }
+        virtual void refresh( );
 
         virtual void remove( bool allVersion = true );
 
@@ -90,7 +95,9 @@ class AtomObject : public virtual libcmis::Object
 
         std::string getInfosUrl( );
         virtual void refreshImpl( xmlDocPtr doc );
-        virtual void extractInfos( xmlDocPtr doc );
+        /** Extract the object data from its atom:entry node.
+          */
+        virtual void extractInfos( xmlNodePtr entryNd );
 
         AtomPubSession* getSession( );
 
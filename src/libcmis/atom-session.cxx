@@ -40,8 +40,12 @@
 #include <libcmis/xml-utils.hxx>
 
 #include "atom-document.hxx"
+#include "atom-feed-reader.hxx"
 #include "atom-folder.hxx"
+#include "atom-object-iterator.hxx"
 #include "atom-object-type.hxx"
+#include "trace-scope.hxx"
+#include "xpath-context.hxx"
 
 using namespace std;
 
@@ -136,16 +140,11 @@ void AtomPubSession::initialize( libcmis::HttpResponsePtr response )
     if ( m_repositories.empty() )
     {
         // Pull the content from sAtomPubUrl
-        string buf;
-        if ( response )
-        {
-            buf = response->getStream( )->str( );
-        }
-        else
+        if ( !response )
         {
             try
             {
-                buf = httpGetRequest( m_bindingUrl )->getStream( )->str( );
+                response = httpGetRequest( m_bindingUrl );
             }
             catch ( const CurlException& e )
             {
@@ -153,7 +152,7 @@ void AtomPubSession::initialize( libcmis::HttpResponsePtr response )
             }
         }
 
-        parseServiceDocument( buf );
+        parseServiceDocument( response->getBody( ) );
     }
 }
 
@@ -193,55 +192,67 @@ libcmis::ObjectPtr AtomPubSession::createObjectFromEntryDoc( xmlDocPtr doc, Resu
     if ( NULL != doc )
     {
         // Get the atom:entry node
-        xmlXPathContextPtr xpathCtx = xmlXPathNewContext( doc );
-        libcmis::registerNamespaces( xpathCtx );
-        if ( NULL != xpathCtx )
-        {
-            const string& entriesReq( "//atom:entry" );
-            xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression( BAD_CAST( entriesReq.c_str() ), xpathCtx );
+        libcmis::XPathContext xpathCtx( doc, NULL );
+        xmlXPathObjectPtr xpathObj = xpathCtx.eval( "//atom:entry" );
 
-            if ( NULL != xpathObj && NULL != xpathObj->nodesetval && ( 0 < xpathObj->nodesetval->nodeNr ) )
-            {
-                // Get the entry's base type
-                string baseTypeReq = "//atom:entry[1]//cmis:propertyId[@propertyDefinitionId='cmis:baseTypeId']/cmis:value/text()";
-                string baseType = libcmis::getXPathValue( xpathCtx, baseTypeReq );
+        if ( NULL != xpathObj && NULL != xpathObj->nodesetval && ( 0 < xpathObj->nodesetval->nodeNr ) )
+            cmisObject = createObjectFromEntry( xpathObj->nodesetval->nodeTab[0], res );
+        xmlXPathFreeObject( xpathObj );
+    }
 
-                xmlNodePtr node = xpathObj->nodesetval->nodeTab[0];
-                if ( res == RESULT_FOLDER || baseType == "cmis:folder" )
-                {
-                    cmisObject.reset( new AtomFolder( this, node ) );
-                }
-                else if ( res == RESULT_DOCUMENT || baseType == "cmis:document" )
-                {
-                    cmisObject.reset( new AtomDocument( this, node ) );
-                }
-                else
-                {
-                    // Not a valid CMIS atom entry... weird
-                }
-            }
-            xmlXPathFreeObject( xpathObj );
+    return cmisObject;
+}
+
+libcmis::ObjectPtr AtomPubSession::createObjectFromEntry( xmlNodePtr entryNd, ResultObjectType res )
+{
+    libcmis::ObjectPtr cmisObject;
+
+    if ( NULL != entryNd )
+    {
+        // Get the entry's base type
+        libcmis::XPathContext xpathCtx( entryNd->doc, entryNd );
+        string baseType = xpathCtx.getValue( ".//cmis:propertyId[@propertyDefinitionId='cmis:baseTypeId']/cmis:value/text()" );
+
+        if ( res == RESULT_FOLDER || baseType == "cmis:folder" )
+        {
+            cmisObject.reset( new AtomFolder( this, entryNd ) );
+        }
+        else if ( res == RESULT_DOCUMENT || baseType == "cmis:document" )
+        {
+            cmisObject.reset( new AtomDocument( this, entryNd ) );
+        }
+        else
+        {
+            // Not a valid CMIS atom entry... weird
         }
-        xmlXPathFreeContext( xpathCtx );
     }
 
     return cmisObject;
 }
 
-libcmis::ObjectPtr AtomPubSession::getObject( string id )
+libcmis::ObjectPtr AtomPubSession::getObject( string id, const libcmis::OperationContext& context )
 {
+    libcmis::TraceScope traceScope( "Session::getObject", this );
+
+    libcmis::ObjectPtr cached = getCachedObject( id, context );
+    if ( cached )
+        return cached;
+
     string pattern = getAtomRepository()->getUriTemplate( UriTemplate::ObjectById );
     map< string, string > vars;
     vars[URI_TEMPLATE_VAR_ID] = id;
-    vars[string( "includeAllowableActions" )] = string( "true" );
+    map< string, string > params = getContextParams( context );
+    vars.insert( params.begin( ), params.end( ) );
     string url = createUrl( pattern, vars );
 
     try
     {
-        string buf = httpGetRequest( url )->getStream( )->str( );
+        libcmis::HttpResponsePtr response = httpGetRequest( url );
+        const string& buf = response->getBody( );
         xmlDocPtr doc = xmlReadMemory( buf.c_str(), buf.size(), url.c_str(), NULL, 0 );
         libcmis::ObjectPtr cmisObject = createObjectFromEntryDoc( doc );
         xmlFreeDoc( doc );
+        cacheObject( cmisObject, context );
         return cmisObject;
     }
     catch ( const CurlException& e )
@@ -258,17 +269,21 @@ libcmis::ObjectPtr AtomPubSession::getObject( string id )
     }
 }
 
-libcmis::ObjectPtr AtomPubSession::getObjectByPath( string path )
+libcmis::ObjectPtr AtomPubSession::getObjectByPath( string path, const libcmis::OperationContext& context )
 {
+    libcmis::TraceScope traceScope( "Session::getObjectByPath", this );
+
     string pattern = getAtomRepository()->getUriTemplate( UriTemplate::ObjectByPath );
     map< string, string > vars;
     vars[URI_TEMPLATE_VAR_PATH] = path;
-    vars[string( "includeAllowableActions" )] = string( "true" );
+    map< string, string > params = getContextParams( context );
+    vars.insert( params.begin( ), params.end( ) );
     string url = createUrl( pattern, vars );
 
     try
     {
-        string buf = httpGetRequest( url )->getStream( )->str( );
+        libcmis::HttpResponsePtr response = httpGetRequest( url );
+        const string& buf = response->getBody( );
         xmlDocPtr doc = xmlReadMemory( buf.c_str(), buf.size(), url.c_str(), NULL, 0 );
         libcmis::ObjectPtr cmisObject = createObjectFromEntryDoc( doc );
         xmlFreeDoc( doc );
@@ -290,60 +305,169 @@ libcmis::ObjectPtr AtomPubSession::getObjectByPath( string path )
 
 libcmis::ObjectTypePtr AtomPubSession::getType( string id )
 {
-    libcmis::ObjectTypePtr type( new AtomObjectType( this, id ) );
+    libcmis::TraceScope traceScope( "Session::getType", this );
+
+    libcmis::ObjectTypePtr type = getCachedType( id );
+    if ( !type )
+    {
+        type.reset( new AtomObjectType( this, id ) );
+        cacheType( id, type );
+    }
     return type;
 }
 
-vector< libcmis::ObjectTypePtr > AtomPubSession::getBaseTypes( )
+libcmis::ObjectIteratorPtr AtomPubSession::query( string statement, bool searchAllVersions,
+        long maxItems, const libcmis::OperationContext& context )
 {
-    string url = getAtomRepository( )->getCollectionUrl( Collection::Types );
-    return getChildrenTypes( url );
+    libcmis::TraceScope traceScope( "Session::query", this );
+
+    map< string, string > params = getContextParams( context );
+    // The query selects the properties itself
+    params.erase( "filter" );
+
+    string pattern = getAtomRepository( )->getUriTemplate( UriTemplate::Query );
+    if ( !pattern.empty( ) )
+    {
+        map< string, string > vars( params );
+        vars["q"] = statement;
+        vars["searchAllVersions"] = searchAllVersions ? "true" : "false";
+        if ( maxItems > 0 )
+            vars["maxItems"] = to_string( maxItems );
+        string url = createUrl( pattern, vars );
+
+        return libcmis::ObjectIteratorPtr( new AtomObjectIterator( this, url ) );
+    }
+
+    // Without URI template, post the query to the query collection
+    string url = getAtomRepository( )->getCollectionUrl( Collection::Query );
+    if ( url.empty( ) )
+        throw libcmis::Exception( "Query isn't supported by the repository", "notSupported" );
+
+    xmlBufferPtr buf = xmlBufferCreate( );
+    xmlTextWriterPtr writer = xmlNewTextWriterMemory( buf, 0 );
+
+    xmlTextWriterStartDocument( writer, NULL, NULL, NULL );
+    xmlTextWriterStartElement( writer, BAD_CAST( "cmis:query" ) );
+    xmlTextWriterWriteAttribute( writer, BAD_CAST( "xmlns:cmis" ), BAD_CAST( NS_CMIS_URL ) );
+    xmlTextWriterWriteElement( writer, BAD_CAST( "cmis:statement" ), BAD_CAST( statement.c_str( ) ) );
+    xmlTextWriterWriteElement( writer, BAD_CAST( "cmis:searchAllVersions" ),
+            BAD_CAST( searchAllVersions ? "true" : "false" ) );
+    for ( map< string, string >::iterator it = params.begin( ); it != params.end( ); ++it )
+    {
+        string name = "cmis:" + it->first;
+        xmlTextWriterWriteElement( writer, BAD_CAST( name.c_str( ) ), BAD_CAST( it->second.c_str( ) ) );
+    }
+    if ( maxItems > 0 )
+        xmlTextWriterWriteElement( writer, BAD_CAST( "cmis:maxItems" ), BAD_CAST( to_string( maxItems ).c_str( ) ) );
+    xmlTextWriterEndElement( writer );
+    xmlTextWriterEndDocument( writer );
+
+    string body( ( const char * )xmlBufferContent( buf ), xmlBufferLength( buf ) );
+    xmlFreeTextWriter( writer );
+    xmlBufferFree( buf );
+
+    return libcmis::ObjectIteratorPtr( new AtomObjectIterator( this, url, body, "application/cmisquery+xml" ) );
 }
 
-vector< libcmis::ObjectTypePtr > AtomPubSession::getChildrenTypes( string url )
+libcmis::ContentChanges AtomPubSession::getContentChanges( string changeLogToken, long maxItems )
 {
-    vector< libcmis::ObjectTypePtr > children;
-    string buf;
+    libcmis::TraceScope traceScope( "Session::getContentChanges", this );
+
+    string url = getAtomRepository( )->getChangesUrl( );
+    if ( url.empty( ) )
+        throw libcmis::Exception( "Change log isn't supported by the repository", "notSupported" );
+
+    if ( url.find( '?' ) != string::npos )
+        url += "&";
+    else
+        url += "?";
+    url += "includeProperties=false";
+    if ( !changeLogToken.empty( ) )
+        url += "&changeLogToken=" + libcmis::escape( changeLogToken );
+    if ( maxItems > 0 )
+        url += "&maxItems=" + to_string( maxItems );
+
+    libcmis::HttpResponsePtr response;
     try
     {
-        buf = httpGetRequest( url )->getStream( )->str( );
+        response = httpGetRequest( url );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
 
-    xmlDocPtr doc = xmlReadMemory( buf.c_str(), buf.size(), url.c_str(), NULL, 0 );
-    if ( NULL != doc )
+    vector< libcmis::ChangeEventPtr > events;
+    AtomFeedReader reader( response->getBody( ), url );
+    for ( xmlNodePtr node = reader.nextEntry( ); node != NULL; node = reader.nextEntry( ) )
     {
-        xmlXPathContextPtr xpathCtx = xmlXPathNewContext( doc );
-        libcmis::registerNamespaces( xpathCtx );
-        if ( NULL != xpathCtx )
+        for ( xmlNodePtr child = node->children; child; child = child->next )
         {
-            const string& entriesReq( "//atom:entry" );
-            xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression( BAD_CAST( entriesReq.c_str() ), xpathCtx );
-
-            if ( NULL != xpathObj && NULL != xpathObj->nodesetval )
-            {
-                int size = xpathObj->nodesetval->nodeNr;
-                for ( int i = 0; i < size; i++ )
-                {
-                    xmlNodePtr node = xpathObj->nodesetval->nodeTab[i];
-                    libcmis::ObjectTypePtr type( new AtomObjectType( this, node ) );
-                    children.push_back( type );
-                }
-            }
+            if ( xmlStrEqual( child->name, BAD_CAST( "object" ) ) )
+                events.push_back( libcmis::ChangeEventPtr( new libcmis::ChangeEvent( child ) ) );
+        }
+    }
 
-            xmlXPathFreeObject( xpathObj );
+    // CMIS 1.1 servers give the token in the feed, older ones only
+    // put it in the next link
+    string nextHref = reader.getNextHref( );
+    string nextToken = reader.getChangeLogToken( );
+    if ( nextToken.empty( ) && !nextHref.empty( ) )
+    {
+        string param = "changeLogToken=";
+        size_t pos = nextHref.find( param );
+        if ( pos != string::npos )
+        {
+            pos += param.size( );
+            nextToken = libcmis::unescape( nextHref.substr( pos, nextHref.find( '&', pos ) - pos ) );
         }
+    }
+    if ( nextToken.empty( ) )
+        nextToken = changeLogToken;
 
-        xmlXPathFreeContext( xpathCtx );
+    return libcmis::ContentChanges( events, nextToken, !nextHref.empty( ) );
+}
+
+vector< libcmis::ObjectTypePtr > AtomPubSession::getBaseTypes( )
+{
+    libcmis::TraceScope traceScope( "Session::getBaseTypes", this );
+
+    string url = getAtomRepository( )->getCollectionUrl( Collection::Types );
+    return getChildrenTypes( url );
+}
+
+map< string, string > AtomPubSession::getContextParams( const libcmis::OperationContext& context )
+{
+    map< string, string > params;
+    params[string( "includeAllowableActions" )] = context.isIncludeAllowableActions( ) ? "true" : "false";
+    if ( context.isPropertyFilterSet( ) )
+        params[string( "filter" )] = context.getFilter( );
+    if ( !context.getRenditionFilter( ).empty( ) )
+        params[string( "renditionFilter" )] = context.getRenditionFilter( );
+    if ( context.getIncludeRelationships( ) != libcmis::IncludeRelationships::None )
+        params[string( "includeRelationships" )] = context.getIncludeRelationshipsString( );
+    return params;
+}
+
+vector< libcmis::ObjectTypePtr > AtomPubSession::getChildrenTypes( string url )
+{
+    vector< libcmis::ObjectTypePtr > children;
+    libcmis::HttpResponsePtr response;
+    try
+    {
+        response = httpGetRequest( url );
     }
-    else
+    catch ( const CurlException& e )
+    {
+        throw e.getCmisException( );
+    }
+
+    AtomFeedReader reader( response->getBody( ), url );
+    for ( xmlNodePtr node = reader.nextEntry( ); node != NULL; node = reader.nextEntry( ) )
     {
-        throw libcmis::Exception( "Failed to parse type children infos" );
+        libcmis::ObjectTypePtr type( new AtomObjectType( this, node ) );
+        children.push_back( type );
     }
-    xmlFreeDoc( doc );
 
     return children;
 }
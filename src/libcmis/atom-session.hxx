@@ -58,22 +58,40 @@ class AtomPubSession : public BaseSession
 
         libcmis::ObjectPtr createObjectFromEntryDoc( xmlDocPtr doc, ResultObjectType res=RESULT_DYNAMIC );
 
+        /** Create the object for an atom:entry node, like the ones
+            returned by an AtomFeedReader.
+          */
+        libcmis::ObjectPtr createObjectFromEntry( xmlNodePtr entryNd, ResultObjectType res=RESULT_DYNAMIC );
+
         std::vector< libcmis::ObjectTypePtr > getChildrenTypes( std::string url );
 
+        /** Get the URL parameters matching an operation context, to use
+            as URI template variables or to add to a feed URL.
+          */
+        static std::map< std::string, std::string > getContextParams( const libcmis::OperationContext& context );
+
         // Override session methods
 
         virtual libcmis::RepositoryPtr getRepository( );
 
         virtual bool setRepository( std::string repositoryId );
 
-        virtual libcmis::ObjectPtr getObject( std::string id );
+        virtual libcmis::ObjectPtr getObject( std::string id,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
-        virtual libcmis::ObjectPtr getObjectByPath( std::string path );
+        virtual libcmis::ObjectPtr getObjectByPath( std::string path,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
         virtual libcmis::ObjectTypePtr getType( std::string id );
 
         virtual std::vector< libcmis::ObjectTypePtr > getBaseTypes( );
 
+        virtual libcmis::ContentChanges getContentChanges( std::string changeLogToken = std::string( ),
+                                                           long maxItems = 0 );
+
+        virtual libcmis::ObjectIteratorPtr query( std::string statement, bool searchAllVersions = false,
+                long maxItems = 0, const libcmis::OperationContext& context = libcmis::OperationContext( ) );
+
     protected:
 
         /** Defaults constructor shouldn't be used
@@ -35,7 +35,8 @@ using namespace std;
 AtomRepository::AtomRepository( xmlNodePtr wsNode ):
     Repository( ),
     m_collections( ),
-    m_uriTemplates( )
+    m_uriTemplates( ),
+    m_changesUrl( )
 {
     if ( wsNode != NULL )
     {
@@ -57,6 +58,10 @@ AtomRepository::AtomRepository( xmlNodePtr wsNode ):
                 readUriTemplates( xpathObj->nodesetval );
             xmlXPathFreeObject( xpathObj );
 
+            // Get the change log feed link
+            m_changesUrl = libcmis::getXPathValue( xpathCtx,
+                    "//atom:link[@rel='http://docs.oasis-open.org/ns/cmis/link/200908/changes']/@href" );
+
             // Get the repository infos 
             xpathObj = xmlXPathEvalExpression( BAD_CAST( "//cmisra:repositoryInfo" ), xpathCtx );
             if ( NULL != xpathObj )
@@ -72,7 +77,8 @@ AtomRepository::AtomRepository( xmlNodePtr wsNode ):
 AtomRepository::AtomRepository( const AtomRepository& rCopy ) :
     Repository( rCopy ),
     m_collections( rCopy.m_collections ),
-    m_uriTemplates( rCopy.m_uriTemplates )
+    m_uriTemplates( rCopy.m_uriTemplates ),
+    m_changesUrl( rCopy.m_changesUrl )
 {
 }
 
@@ -88,6 +94,7 @@ AtomRepository& AtomRepository::operator= ( const AtomRepository& rCopy )
     {
         m_collections = rCopy.m_collections;
         m_uriTemplates = rCopy.m_uriTemplates;
+        m_changesUrl = rCopy.m_changesUrl;
     }
 
     return *this;
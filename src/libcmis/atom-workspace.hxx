@@ -71,6 +71,9 @@ class AtomRepository : public libcmis::Repository
         /// URI templates
         std::map< UriTemplate::Type, std::string > m_uriTemplates;
 
+        /// URL of the change log feed, empty if not provided
+        std::string m_changesUrl;
+
     public:
         AtomRepository( xmlNodePtr wsNode = NULL );
         AtomRepository( const AtomRepository& rCopy );
@@ -80,6 +83,7 @@ class AtomRepository : public libcmis::Repository
 
         std::string getCollectionUrl( Collection::Type );
         std::string getUriTemplate( UriTemplate::Type );
+        std::string getChangesUrl( ) { return m_changesUrl; }
 
     private:
         void readCollections( xmlNodeSetPtr pNodeSet );
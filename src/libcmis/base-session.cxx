@@ -39,6 +39,7 @@
 #include <libcmis/xml-utils.hxx>
 
 #include "oauth2-handler.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 
@@ -49,7 +50,13 @@ BaseSession::BaseSession( string bindingUrl, string repositoryId, string usernam
     HttpSession( username, password, noSslCheck, oauth2, verbose, initProtocolsFunction ),
     m_bindingUrl( bindingUrl ),
     m_repositoryId( repositoryId ),
-    m_repositories( )
+    m_repositories( ),
+    m_types( ),
+    m_typeCacheTtl( -1 ),
+    m_typesMutex( ),
+    m_lazyTypeResolution( false ),
+    m_objectCache( ),
+    m_pathCache( )
 {
 }
 
@@ -59,7 +66,13 @@ BaseSession::BaseSession( string sBindingUrl, string repository,
     HttpSession( httpSession ),
     m_bindingUrl( sBindingUrl ),
     m_repositoryId( repository ),
-    m_repositories( )
+    m_repositories( ),
+    m_types( ),
+    m_typeCacheTtl( -1 ),
+    m_typesMutex( ),
+    m_lazyTypeResolution( false ),
+    m_objectCache( ),
+    m_pathCache( )
 {
 }
 
@@ -68,12 +81,20 @@ BaseSession::BaseSession( ) :
     HttpSession( ),
     m_bindingUrl( ),
     m_repositoryId( ),
-    m_repositories( )
+    m_repositories( ),
+    m_types( ),
+    m_typeCacheTtl( -1 ),
+    m_typesMutex( ),
+    m_lazyTypeResolution( false ),
+    m_objectCache( ),
+    m_pathCache( )
 {
 }
 
 BaseSession::~BaseSession( )
 {
+    // The retries use the overridden methods: stop them while they work
+    stopAsyncRequests( );
 }
 
 string BaseSession::createUrl( const string& pattern, map< string, string > variables )
@@ -121,6 +142,17 @@ void BaseSession::setNoSSLCertificateCheck( bool noCheck )
     HttpSession::setNoSSLCertificateCheck( noCheck );
 }
 
+void BaseSession::setCompressedResponses( bool compress )
+{
+    HttpSession::setCompressedResponses( compress );
+}
+
+void BaseSession::setRetryPolicy( unsigned int maxRetries, long initialDelay,
+                                  long maxDelay, long retriesPerMinute )
+{
+    HttpSession::setRetryPolicy( maxRetries, initialDelay, maxDelay, retriesPerMinute );
+}
+
 void BaseSession::setOAuth2Data( libcmis::OAuth2DataPtr oauth2 )
 {
     m_oauth2Handler.reset( new OAuth2Handler( this, oauth2 ) );
@@ -136,12 +168,128 @@ vector< libcmis::RepositoryPtr > BaseSession::getRepositories( )
 
 libcmis::FolderPtr BaseSession::getRootFolder()
 {
+    libcmis::TraceScope traceScope( "Session::getRootFolder", this );
+
     return getFolder( getRootId() );
 }
 
 libcmis::FolderPtr BaseSession::getFolder( string id )
 {
+    libcmis::TraceScope traceScope( "Session::getFolder", this );
+
     libcmis::ObjectPtr object = getObject( id );
     libcmis::FolderPtr folder = boost::dynamic_pointer_cast< libcmis::Folder >( object );
     return folder;
 }
+
+void BaseSession::setTypeCacheTtl( long seconds )
+{
+    lock_guard< mutex > lock( m_typesMutex );
+    m_typeCacheTtl = seconds;
+    if ( 0 == seconds )
+        m_types.clear( );
+}
+
+void BaseSession::invalidateType( string id )
+{
+    lock_guard< mutex > lock( m_typesMutex );
+    m_types.erase( id );
+}
+
+void BaseSession::invalidateTypes( )
+{
+    lock_guard< mutex > lock( m_typesMutex );
+    m_types.clear( );
+}
+
+libcmis::ObjectTypePtr BaseSession::getCachedType( const string& id )
+{
+    lock_guard< mutex > lock( m_typesMutex );
+    map< string, pair< libcmis::ObjectTypePtr, time_t > >::iterator it = m_types.find( id );
+    if ( it == m_types.end( ) )
+    {
+        if ( m_typeCacheTtl != 0 )
+            getStatisticsCounters( ).addTypeCacheLookup( false );
+        return libcmis::ObjectTypePtr( );
+    }
+
+    if ( m_typeCacheTtl >= 0 && difftime( time( NULL ), it->second.second ) >= m_typeCacheTtl )
+    {
+        m_types.erase( it );
+        getStatisticsCounters( ).addTypeCacheLookup( false );
+        return libcmis::ObjectTypePtr( );
+    }
+
+    getStatisticsCounters( ).addTypeCacheLookup( true );
+    return it->second.first;
+}
+
+void BaseSession::cacheType( const string& id, libcmis::ObjectTypePtr type )
+{
+    lock_guard< mutex > lock( m_typesMutex );
+    if ( type && m_typeCacheTtl != 0 )
+        m_types[ id ] = make_pair( type, time( NULL ) );
+}
+
+void BaseSession::setObjectCache( size_t maxObjects, long ttl, size_t maxBytes )
+{
+    m_objectCache.configure( maxObjects, ttl, maxBytes );
+}
+
+void BaseSession::invalidateObject( string id )
+{
+    m_objectCache.remove( id );
+    m_pathCache.remove( id );
+}
+
+void BaseSession::invalidateObjects( )
+{
+    m_objectCache.clear( );
+    m_pathCache.clear( );
+}
+
+libcmis::SessionStatistics BaseSession::getStatistics( )
+{
+    libcmis::SessionStatistics statistics = getStatisticsCounters( ).getStatistics( );
+    statistics.setObjectCache( m_objectCache.getHits( ), m_objectCache.getMisses( ) );
+    statistics.setPathCache( m_pathCache.getHits( ), m_pathCache.getMisses( ) );
+    return statistics;
+}
+
+void BaseSession::resetStatistics( )
+{
+    getStatisticsCounters( ).reset( );
+    m_objectCache.resetCounters( );
+    m_pathCache.resetCounters( );
+}
+
+libcmis::ObjectPtr BaseSession::getCachedObject( const string& id, const libcmis::OperationContext& context )
+{
+    if ( !context.isDefault( ) || !m_objectCache.isEnabled( ) )
+        return libcmis::ObjectPtr( );
+
+    bool expired = false;
+    libcmis::ObjectPtr object = m_objectCache.get( id, expired );
+    if ( object && expired )
+    {
+        // Revalidate the object rather than downloading it again: the
+        // bindings supporting it only get a 304 if it didn't change.
+        try
+        {
+            object->refresh( );
+            m_objectCache.put( object );
+        }
+        catch ( const libcmis::Exception& )
+        {
+            m_objectCache.remove( id );
+            object.reset( );
+        }
+    }
+    return object;
+}
+
+void BaseSession::cacheObject( libcmis::ObjectPtr object, const libcmis::OperationContext& context )
+{
+    if ( context.isDefault( ) )
+        m_objectCache.put( object );
+}
@@ -28,10 +28,12 @@
 #ifndef _BASE_SESSION_HXX_
 #define _BASE_SESSION_HXX_
 
+#include <ctime>
 #include <istream>
 #include <sstream>
 #include <vector>
 #include <map>
+#include <mutex>
 #include <string>
 
 #include <curl/curl.h>
@@ -44,6 +46,8 @@
 #include <libcmis/xml-utils.hxx>
 
 #include "http-session.hxx"
+#include "object-cache.hxx"
+#include "path-cache.hxx"
 
 class OAuth2Handler;
 
@@ -55,6 +59,20 @@ class BaseSession : public libcmis::Session,
         std::string m_repositoryId;
 
         std::vector< libcmis::RepositoryPtr > m_repositories;
+
+    private:
+        /** Type definitions already fetched, with the time they were
+            cached at.
+          */
+        std::map< std::string, std::pair< libcmis::ObjectTypePtr, time_t > > m_types;
+        long m_typeCacheTtl;
+        std::mutex m_typesMutex;
+
+        bool m_lazyTypeResolution;
+
+        ObjectCache m_objectCache;
+        PathCache m_pathCache;
+
     public:
         BaseSession( std::string sBindingUrl, std::string repository,
                      std::string username, std::string password,
@@ -89,12 +107,67 @@ class BaseSession : public libcmis::Session,
 
         virtual void setNoSSLCertificateCheck( bool noCheck );
 
+        virtual void setCompressedResponses( bool compress );
+
+        virtual void setRetryPolicy( unsigned int maxRetries, long initialDelay = 500,
+                                     long maxDelay = 30000, long retriesPerMinute = -1 );
+
         virtual std::vector< libcmis::RepositoryPtr > getRepositories( );
 
         virtual libcmis::FolderPtr getRootFolder();
 
         virtual libcmis::FolderPtr getFolder( std::string id );
 
+        virtual void setTypeCacheTtl( long seconds );
+
+        virtual void invalidateType( std::string id );
+
+        virtual void invalidateTypes( );
+
+        virtual void setLazyTypeResolution( bool lazy ) { m_lazyTypeResolution = lazy; }
+
+        virtual bool isLazyTypeResolution( ) { return m_lazyTypeResolution; }
+
+        virtual void setObjectCache( size_t maxObjects, long ttl = -1, size_t maxBytes = 0 );
+
+        virtual void setPathCacheTtl( long seconds ) { m_pathCache.setTtl( seconds ); }
+
+        virtual void invalidateObject( std::string id );
+
+        virtual void invalidateObjects( );
+
+        virtual long getObjectCacheHits( ) { return m_objectCache.getHits( ); }
+
+        virtual long getObjectCacheMisses( ) { return m_objectCache.getMisses( ); }
+
+        virtual libcmis::SessionStatistics getStatistics( );
+
+        virtual void resetStatistics( );
+
+    protected:
+        /** Get the type definition cached for an id, or an empty pointer
+            if the session has none or it is too old to be used.
+          */
+        libcmis::ObjectTypePtr getCachedType( const std::string& id );
+
+        /** Remember a type definition so the next getType( ) for this
+            id doesn't need to ask the server.
+          */
+        void cacheType( const std::string& id, libcmis::ObjectTypePtr type );
+
+        /** Get the object cached for an id, or an empty pointer if there
+            is none or the context asks for something else than the
+            default data.
+          */
+        libcmis::ObjectPtr getCachedObject( const std::string& id, const libcmis::OperationContext& context );
+
+        /** Remember an object fetched with the given context, if the
+            object cache is enabled and the context is the default one.
+          */
+        void cacheObject( libcmis::ObjectPtr object, const libcmis::OperationContext& context );
+
+        PathCache& getPathCache( ) { return m_pathCache; }
+
     protected:
         BaseSession( );
 
@@ -0,0 +1,332 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "base64.hxx"
+
+#include <cstring>
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define LIBCMIS_BASE64_X86
+#include <immintrin.h>
+#endif
+
+namespace libcmis
+{
+    namespace base64
+    {
+        const unsigned char decodeTable[256] =
+        {
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+            0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+            0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+            0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+        };
+
+        const char encodeTable[65] =
+              "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    }
+}
+
+using namespace libcmis::base64;
+
+namespace
+{
+    size_t lcl_encodeScalar( const unsigned char* in, size_t len, char* out )
+    {
+        size_t i = 0;
+        for ( ; i + 3 <= len; i += 3 )
+        {
+            unsigned long block = ( in[i] << 16 ) | ( in[i + 1] << 8 ) | in[i + 2];
+            *out++ = encodeTable[ ( block >> 18 ) & 0x3F ];
+            *out++ = encodeTable[ ( block >> 12 ) & 0x3F ];
+            *out++ = encodeTable[ ( block >> 6 ) & 0x3F ];
+            *out++ = encodeTable[ block & 0x3F ];
+        }
+        return i;
+    }
+
+    size_t lcl_decodeScalar( const char* in, size_t len, unsigned char* out )
+    {
+        const unsigned char* chars = reinterpret_cast< const unsigned char* >( in );
+        size_t i = 0;
+        for ( ; i + 4 <= len; i += 4 )
+        {
+            unsigned char a = decodeTable[ chars[i] ];
+            unsigned char b = decodeTable[ chars[i + 1] ];
+            unsigned char c = decodeTable[ chars[i + 2] ];
+            unsigned char d = decodeTable[ chars[i + 3] ];
+
+            // 0xFF is the only value with the high bit set
+            if ( ( a | b | c | d ) & 0x80 )
+                break;
+
+            *out++ = ( a << 2 ) | ( b >> 4 );
+            *out++ = ( b << 4 ) | ( c >> 2 );
+            *out++ = ( c << 6 ) | d;
+        }
+        return i;
+    }
+
+#ifdef LIBCMIS_BASE64_X86
+    // The vector code follows the algorithms described by Wojciech Muła
+    // and Daniel Lemire in "Faster Base64 Encoding and Decoding using
+    // AVX2 Instructions".
+
+    __attribute__(( target( "ssse3" ) ))
+    inline __m128i lcl_encodeReshuffle( __m128i in )
+    {
+        // Spread the 12 bytes on 16 and move the 6 bits groups in place
+        in = _mm_shuffle_epi8( in, _mm_set_epi8( 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1 ) );
+        const __m128i t0 = _mm_and_si128( in, _mm_set1_epi32( 0x0FC0FC00 ) );
+        const __m128i t1 = _mm_mulhi_epu16( t0, _mm_set1_epi32( 0x04000040 ) );
+        const __m128i t2 = _mm_and_si128( in, _mm_set1_epi32( 0x003F03F0 ) );
+        const __m128i t3 = _mm_mullo_epi16( t2, _mm_set1_epi32( 0x01000010 ) );
+        return _mm_or_si128( t1, t3 );
+    }
+
+    __attribute__(( target( "ssse3" ) ))
+    inline __m128i lcl_encodeTranslate( __m128i in )
+    {
+        const __m128i lut = _mm_setr_epi8( 65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0 );
+        __m128i indices = _mm_subs_epu8( in, _mm_set1_epi8( 51 ) );
+        const __m128i mask = _mm_cmpgt_epi8( in, _mm_set1_epi8( 25 ) );
+        indices = _mm_sub_epi8( indices, mask );
+        return _mm_add_epi8( in, _mm_shuffle_epi8( lut, indices ) );
+    }
+
+    __attribute__(( target( "ssse3" ) ))
+    size_t lcl_encodeSsse3( const unsigned char* in, size_t len, char* out )
+    {
+        size_t i = 0;
+        // Each step reads 16 bytes but only consumes 12
+        for ( ; i + 16 <= len; i += 12 )
+        {
+            __m128i block = _mm_loadu_si128( reinterpret_cast< const __m128i* >( in + i ) );
+            block = lcl_encodeTranslate( lcl_encodeReshuffle( block ) );
+            _mm_storeu_si128( reinterpret_cast< __m128i* >( out ), block );
+            out += 16;
+        }
+        return i + lcl_encodeScalar( in + i, len - i, out );
+    }
+
+    __attribute__(( target( "ssse3" ) ))
+    size_t lcl_decodeSsse3( const char* in, size_t len, unsigned char* out )
+    {
+        const __m128i lutLo = _mm_setr_epi8( 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                             0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A );
+        const __m128i lutHi = _mm_setr_epi8( 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                             0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 );
+        const __m128i lutRoll = _mm_setr_epi8( 0, 16, 19, 4, -65, -65, -71, -71,
+                                               0, 0, 0, 0, 0, 0, 0, 0 );
+        const __m128i mask2F = _mm_set1_epi8( 0x2F );
+
+        size_t i = 0;
+        for ( ; i + 16 <= len; i += 16 )
+        {
+            __m128i str = _mm_loadu_si128( reinterpret_cast< const __m128i* >( in + i ) );
+
+            const __m128i hiNibbles = _mm_and_si128( _mm_srli_epi32( str, 4 ), mask2F );
+            const __m128i loNibbles = _mm_and_si128( str, mask2F );
+            const __m128i hi = _mm_shuffle_epi8( lutHi, hiNibbles );
+            const __m128i lo = _mm_shuffle_epi8( lutLo, loNibbles );
+
+            // Leave the blocks with other characters to the scalar code
+            if ( _mm_movemask_epi8( _mm_cmpgt_epi8( _mm_and_si128( lo, hi ), _mm_setzero_si128( ) ) ) != 0 )
+                break;
+
+            const __m128i eq2F = _mm_cmpeq_epi8( str, mask2F );
+            const __m128i roll = _mm_shuffle_epi8( lutRoll, _mm_add_epi8( eq2F, hiNibbles ) );
+            str = _mm_add_epi8( str, roll );
+
+            // Pack the 16 6-bits values into 12 bytes
+            const __m128i mergeAbBc = _mm_maddubs_epi16( str, _mm_set1_epi32( 0x01400140 ) );
+            __m128i packed = _mm_madd_epi16( mergeAbBc, _mm_set1_epi32( 0x00011000 ) );
+            packed = _mm_shuffle_epi8( packed, _mm_setr_epi8( 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 ) );
+
+            unsigned char decoded[16];
+            _mm_storeu_si128( reinterpret_cast< __m128i* >( decoded ), packed );
+            memcpy( out, decoded, 12 );
+            out += 12;
+        }
+        return i + lcl_decodeScalar( in + i, len - i, out );
+    }
+
+    __attribute__(( target( "avx2" ) ))
+    size_t lcl_encodeAvx2( const unsigned char* in, size_t len, char* out )
+    {
+        const __m256i shuffle = _mm256_set_epi8( 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                                                 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1 );
+        const __m256i lut = _mm256_setr_epi8( 65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+                                              65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0 );
+
+        size_t i = 0;
+        // Each step reads 28 bytes but only consumes 24
+        for ( ; i + 28 <= len; i += 24 )
+        {
+            __m256i block = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256( _mm_loadu_si128( reinterpret_cast< const __m128i* >( in + i ) ) ),
+                    _mm_loadu_si128( reinterpret_cast< const __m128i* >( in + i + 12 ) ), 1 );
+
+            block = _mm256_shuffle_epi8( block, shuffle );
+            const __m256i t0 = _mm256_and_si256( block, _mm256_set1_epi32( 0x0FC0FC00 ) );
+            const __m256i t1 = _mm256_mulhi_epu16( t0, _mm256_set1_epi32( 0x04000040 ) );
+            const __m256i t2 = _mm256_and_si256( block, _mm256_set1_epi32( 0x003F03F0 ) );
+            const __m256i t3 = _mm256_mullo_epi16( t2, _mm256_set1_epi32( 0x01000010 ) );
+            block = _mm256_or_si256( t1, t3 );
+
+            __m256i indices = _mm256_subs_epu8( block, _mm256_set1_epi8( 51 ) );
+            const __m256i mask = _mm256_cmpgt_epi8( block, _mm256_set1_epi8( 25 ) );
+            indices = _mm256_sub_epi8( indices, mask );
+            block = _mm256_add_epi8( block, _mm256_shuffle_epi8( lut, indices ) );
+
+            _mm256_storeu_si256( reinterpret_cast< __m256i* >( out ), block );
+            out += 32;
+        }
+        return i + lcl_encodeSsse3( in + i, len - i, out );
+    }
+
+    __attribute__(( target( "avx2" ) ))
+    size_t lcl_decodeAvx2( const char* in, size_t len, unsigned char* out )
+    {
+        const __m256i lutLo = _mm256_setr_epi8( 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                                0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                                0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                                0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A );
+        const __m256i lutHi = _mm256_setr_epi8( 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                                0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                                0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                                0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 );
+        const __m256i lutRoll = _mm256_setr_epi8( 0, 16, 19, 4, -65, -65, -71, -71,
+                                                  0, 0, 0, 0, 0, 0, 0, 0,
+                                                  0, 16, 19, 4, -65, -65, -71, -71,
+                                                  0, 0, 0, 0, 0, 0, 0, 0 );
+        const __m256i mask2F = _mm256_set1_epi8( 0x2F );
+
+        size_t i = 0;
+        for ( ; i + 32 <= len; i += 32 )
+        {
+            __m256i str = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( in + i ) );
+
+            const __m256i hiNibbles = _mm256_and_si256( _mm256_srli_epi32( str, 4 ), mask2F );
+            const __m256i loNibbles = _mm256_and_si256( str, mask2F );
+            const __m256i hi = _mm256_shuffle_epi8( lutHi, hiNibbles );
+            const __m256i lo = _mm256_shuffle_epi8( lutLo, loNibbles );
+
+            // Leave the blocks with other characters to the narrower code
+            if ( !_mm256_testz_si256( lo, hi ) )
+                break;
+
+            const __m256i eq2F = _mm256_cmpeq_epi8( str, mask2F );
+            const __m256i roll = _mm256_shuffle_epi8( lutRoll, _mm256_add_epi8( eq2F, hiNibbles ) );
+            str = _mm256_add_epi8( str, roll );
+
+            // Pack the 32 6-bits values into 24 bytes
+            const __m256i mergeAbBc = _mm256_maddubs_epi16( str, _mm256_set1_epi32( 0x01400140 ) );
+            __m256i packed = _mm256_madd_epi16( mergeAbBc, _mm256_set1_epi32( 0x00011000 ) );
+            packed = _mm256_shuffle_epi8( packed, _mm256_setr_epi8(
+                        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 ) );
+            packed = _mm256_permutevar8x32_epi32( packed, _mm256_setr_epi32( 0, 1, 2, 4, 5, 6, -1, -1 ) );
+
+            unsigned char decoded[32];
+            _mm256_storeu_si256( reinterpret_cast< __m256i* >( decoded ), packed );
+            memcpy( out, decoded, 24 );
+            out += 24;
+        }
+        return i + lcl_decodeSsse3( in + i, len - i, out );
+    }
+#endif
+
+    typedef size_t ( *EncodeFunction )( const unsigned char*, size_t, char* );
+    typedef size_t ( *DecodeFunction )( const char*, size_t, unsigned char* );
+
+    struct Implementation
+    {
+        const char* m_name;
+        EncodeFunction m_encode;
+        DecodeFunction m_decode;
+    };
+
+    Implementation lcl_selectImplementation( )
+    {
+#ifdef LIBCMIS_BASE64_X86
+        __builtin_cpu_init( );
+        if ( __builtin_cpu_supports( "avx2" ) )
+        {
+            Implementation avx2 = { "avx2", &lcl_encodeAvx2, &lcl_decodeAvx2 };
+            return avx2;
+        }
+        if ( __builtin_cpu_supports( "ssse3" ) )
+        {
+            Implementation ssse3 = { "ssse3", &lcl_encodeSsse3, &lcl_decodeSsse3 };
+            return ssse3;
+        }
+#endif
+        Implementation scalar = { "scalar", &lcl_encodeScalar, &lcl_decodeScalar };
+        return scalar;
+    }
+
+    const Implementation& lcl_getImplementation( )
+    {
+        static const Implementation implementation = lcl_selectImplementation( );
+        return implementation;
+    }
+}
+
+namespace libcmis
+{
+    namespace base64
+    {
+        size_t encodeBlocks( const unsigned char* in, size_t len, char* out )
+        {
+            return lcl_getImplementation( ).m_encode( in, len, out );
+        }
+
+        size_t decodeBlocks( const char* in, size_t len, unsigned char* out )
+        {
+            return lcl_getImplementation( ).m_decode( in, len, out );
+        }
+
+        const char* getImplementation( )
+        {
+            return lcl_getImplementation( ).m_name;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _BASE64_HXX_
+#define _BASE64_HXX_
+
+#include <cstddef>
+
+namespace libcmis
+{
+    /** Bulk base64 codec used by EncodedData.
+
+        The functions only handle complete blocks: EncodedData keeps the
+        state between chunks and deals with the padding. AVX2 or SSSE3
+        code is used when the CPU supports it, and table-driven scalar
+        code otherwise.
+      */
+    namespace base64
+    {
+        /** Value of a base64 character, or 0xFF if it isn't one.
+          */
+        extern const unsigned char decodeTable[256];
+
+        /** Base64 characters, indexed by their value.
+          */
+        extern const char encodeTable[65];
+
+        /** Encode the complete 3 bytes blocks of the input.
+
+            \param out receives len / 3 * 4 characters
+            \return the number of input bytes consumed
+          */
+        size_t encodeBlocks( const unsigned char* in, size_t len, char* out );
+
+        /** Decode 4 characters blocks until the end of the input or a
+            block containing anything else than base64 characters, like
+            a line break or the padding.
+
+            \param out receives 3 bytes per decoded block
+            \return the number of input characters consumed
+          */
+        size_t decodeBlocks( const char* in, size_t len, unsigned char* out );
+
+        /** Name of the code selected for this CPU: "avx2", "ssse3" or
+            "scalar".
+          */
+        const char* getImplementation( );
+    }
+}
+
+#endif
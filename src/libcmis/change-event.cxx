@@ -0,0 +1,186 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include <libcmis/change-event.hxx>
+
+#include <sstream>
+
+#include <libcmis/exception.hxx>
+#include <libcmis/xml-utils.hxx>
+
+using namespace std;
+
+namespace libcmis
+{
+    ChangeEvent::ChangeEvent( string objectId, ChangeType::Type changeType,
+                              boost::posix_time::ptime changeTime ) :
+        m_objectId( objectId ),
+        m_changeType( changeType ),
+        m_changeTime( changeTime )
+    {
+    }
+
+    ChangeEvent::ChangeEvent( xmlNodePtr node ) :
+        m_objectId( ),
+        m_changeType( ChangeType::Updated ),
+        m_changeTime( )
+    {
+        for ( xmlNodePtr child = node->children; child; child = child->next )
+        {
+            if ( xmlStrEqual( child->name, BAD_CAST( "properties" ) ) )
+            {
+                for ( xmlNodePtr prop = child->children; prop; prop = prop->next )
+                {
+                    string propId = getXmlNodeAttributeValue( prop, "propertyDefinitionId", "" );
+                    if ( propId != "cmis:objectId" )
+                        continue;
+
+                    for ( xmlNodePtr value = prop->children; value; value = value->next )
+                    {
+                        if ( xmlStrEqual( value->name, BAD_CAST( "value" ) ) )
+                        {
+                            xmlChar* content = xmlNodeGetContent( value );
+                            m_objectId = string( ( char* )content );
+                            xmlFree( content );
+                        }
+                    }
+                }
+            }
+            else if ( xmlStrEqual( child->name, BAD_CAST( "changeEventInfo" ) ) )
+            {
+                for ( xmlNodePtr info = child->children; info; info = info->next )
+                {
+                    xmlChar* content = xmlNodeGetContent( info );
+                    string value( ( char* )content );
+                    xmlFree( content );
+
+                    if ( xmlStrEqual( info->name, BAD_CAST( "changeType" ) ) )
+                        m_changeType = parseChangeType( value );
+                    else if ( xmlStrEqual( info->name, BAD_CAST( "changeTime" ) ) )
+                        m_changeTime = parseDateTime( value );
+                }
+            }
+        }
+    }
+
+    ChangeEvent::~ChangeEvent( )
+    {
+    }
+
+    const string& ChangeEvent::getObjectId( ) const
+    {
+        return m_objectId;
+    }
+
+    ChangeType::Type ChangeEvent::getChangeType( ) const
+    {
+        return m_changeType;
+    }
+
+    boost::posix_time::ptime ChangeEvent::getChangeTime( ) const
+    {
+        return m_changeTime;
+    }
+
+    string ChangeEvent::toString( ) const
+    {
+        stringstream buf;
+
+        buf << "Change event:" << endl;
+        buf << "    Object Id: " << m_objectId << endl;
+        buf << "    Change type: ";
+        switch ( m_changeType )
+        {
+            case ChangeType::Created:
+                buf << "created";
+                break;
+            case ChangeType::Updated:
+                buf << "updated";
+                break;
+            case ChangeType::Deleted:
+                buf << "deleted";
+                break;
+            case ChangeType::Security:
+                buf << "security";
+                break;
+        }
+        buf << endl;
+        if ( !m_changeTime.is_not_a_date_time( ) )
+            buf << "    Change time: " << writeDateTime( m_changeTime ) << endl;
+
+        return buf.str( );
+    }
+
+    ChangeType::Type ChangeEvent::parseChangeType( string value )
+    {
+        if ( value == "created" )
+            return ChangeType::Created;
+        else if ( value == "updated" )
+            return ChangeType::Updated;
+        else if ( value == "deleted" )
+            return ChangeType::Deleted;
+        else if ( value == "security" )
+            return ChangeType::Security;
+
+        throw Exception( "Invalid change type: " + value );
+    }
+
+    ContentChanges::ContentChanges( ) :
+        m_events( ),
+        m_changeLogToken( ),
+        m_hasMoreItems( false )
+    {
+    }
+
+    ContentChanges::ContentChanges( const vector< ChangeEventPtr >& events,
+                                    string changeLogToken, bool hasMoreItems ) :
+        m_events( events ),
+        m_changeLogToken( changeLogToken ),
+        m_hasMoreItems( hasMoreItems )
+    {
+    }
+
+    ContentChanges::~ContentChanges( )
+    {
+    }
+
+    const vector< ChangeEventPtr >& ContentChanges::getEvents( ) const
+    {
+        return m_events;
+    }
+
+    const string& ContentChanges::getChangeLogToken( ) const
+    {
+        return m_changeLogToken;
+    }
+
+    bool ContentChanges::hasMoreItems( ) const
+    {
+        return m_hasMoreItems;
+    }
+}
@@ -0,0 +1,196 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "concurrency-limiter.hxx"
+
+#include <algorithm>
+#include <map>
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+using namespace std;
+
+namespace
+{
+    /** Process-wide settings and limiters of the hosts.
+      */
+    struct LimiterRegistry
+    {
+        LimiterRegistry( ) :
+            m_mutex( ),
+            m_initialLimit( 0 ),
+            m_maxLimit( 0 ),
+            m_limiters( )
+        {
+        }
+
+        mutex m_mutex;
+        unsigned int m_initialLimit;
+        unsigned int m_maxLimit;
+        map< string, libcmis::ConcurrencyLimiterPtr > m_limiters;
+    };
+
+    LimiterRegistry& lcl_getRegistry( )
+    {
+        static LimiterRegistry registry;
+        return registry;
+    }
+
+    // A latency above LATENCY_TOLERANCE times the lowest one, plus some
+    // slack for the noise of the fast requests, is taken as congestion.
+    const double LATENCY_TOLERANCE = 2.0;
+    const double LATENCY_SLACK = 10.0;
+}
+
+namespace libcmis
+{
+    ConcurrencyLimiter::ConcurrencyLimiter( unsigned int initialLimit, unsigned int maxLimit ) :
+        m_mutex( ),
+        m_released( ),
+        m_limit( max( 1u, min( initialLimit, maxLimit ) ) ),
+        m_maxLimit( max( 1u, maxLimit ) ),
+        m_inFlight( 0 ),
+        m_queued( 0 ),
+        m_minLatency( 0 )
+    {
+    }
+
+    void ConcurrencyLimiter::acquire( )
+    {
+        unique_lock< mutex > lock( m_mutex );
+        ++m_queued;
+        m_released.wait( lock, [this] { return m_inFlight < static_cast< unsigned int >( m_limit ); } );
+        --m_queued;
+        ++m_inFlight;
+    }
+
+    bool ConcurrencyLimiter::tryAcquire( )
+    {
+        lock_guard< mutex > lock( m_mutex );
+        if ( m_inFlight >= static_cast< unsigned int >( m_limit ) )
+            return false;
+        ++m_inFlight;
+        return true;
+    }
+
+    void ConcurrencyLimiter::addQueued( int count )
+    {
+        lock_guard< mutex > lock( m_mutex );
+        m_queued += count;
+    }
+
+    void ConcurrencyLimiter::release( long latency, bool throttled )
+    {
+        {
+            lock_guard< mutex > lock( m_mutex );
+
+            // Only the requests sent while all the slots were used tell
+            // whether the host could take more.
+            bool saturated = m_inFlight >= static_cast< unsigned int >( m_limit );
+            if ( m_inFlight > 0 )
+                --m_inFlight;
+
+            if ( latency >= 0 )
+            {
+                if ( m_minLatency <= 0 || latency < m_minLatency )
+                    m_minLatency = latency;
+                else
+                    m_minLatency += ( latency - m_minLatency ) * 0.01;
+
+                if ( throttled )
+                    m_limit = max( 1.0, m_limit / 2 );
+                else if ( latency > m_minLatency * LATENCY_TOLERANCE + LATENCY_SLACK )
+                    m_limit = max( 1.0, m_limit * 0.9 );
+                else if ( saturated )
+                    m_limit = min( double( m_maxLimit ), m_limit + 1.0 / m_limit );
+            }
+        }
+        m_released.notify_all( );
+    }
+
+    unsigned int ConcurrencyLimiter::getLimit( )
+    {
+        lock_guard< mutex > lock( m_mutex );
+        return static_cast< unsigned int >( m_limit );
+    }
+
+    unsigned int ConcurrencyLimiter::getQueued( )
+    {
+        lock_guard< mutex > lock( m_mutex );
+        return m_queued;
+    }
+
+    void ConcurrencyLimiter::configure( unsigned int initialLimit, unsigned int maxLimit )
+    {
+        LimiterRegistry& registry = lcl_getRegistry( );
+        lock_guard< mutex > lock( registry.m_mutex );
+        registry.m_initialLimit = initialLimit;
+        registry.m_maxLimit = maxLimit;
+
+        // The requests running keep the limiter they got
+        registry.m_limiters.clear( );
+    }
+
+    ConcurrencyLimiterPtr ConcurrencyLimiter::get( const string& url )
+    {
+        LimiterRegistry& registry = lcl_getRegistry( );
+        lock_guard< mutex > lock( registry.m_mutex );
+        if ( registry.m_maxLimit == 0 )
+            return ConcurrencyLimiterPtr( );
+
+        ConcurrencyLimiterPtr& limiter = registry.m_limiters[ getHost( url ) ];
+        if ( !limiter )
+            limiter.reset( new ConcurrencyLimiter( registry.m_initialLimit, registry.m_maxLimit ) );
+        return limiter;
+    }
+
+    ConcurrencyLimiterPtr ConcurrencyLimiter::find( const string& host )
+    {
+        LimiterRegistry& registry = lcl_getRegistry( );
+        lock_guard< mutex > lock( registry.m_mutex );
+        map< string, ConcurrencyLimiterPtr >::iterator it = registry.m_limiters.find( getHost( host ) );
+        if ( it == registry.m_limiters.end( ) )
+            return ConcurrencyLimiterPtr( );
+        return it->second;
+    }
+
+    string ConcurrencyLimiter::getHost( const string& url )
+    {
+        string::size_type start = url.find( "://" );
+        start = start == string::npos ? 0 : start + 3;
+        string::size_type end = url.find_first_of( "/?#", start );
+        string host = url.substr( start, end == string::npos ? string::npos : end - start );
+
+        // Drop the credentials
+        string::size_type at = host.rfind( '@' );
+        if ( at != string::npos )
+            host = host.substr( at + 1 );
+
+        return boost::to_lower_copy( host );
+    }
+}
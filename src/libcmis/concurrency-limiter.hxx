@@ -0,0 +1,111 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _CONCURRENCY_LIMITER_HXX_
+#define _CONCURRENCY_LIMITER_HXX_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace libcmis
+{
+    class ConcurrencyLimiter;
+    typedef std::shared_ptr< ConcurrencyLimiter > ConcurrencyLimiterPtr;
+
+    /** Adaptive limit of the requests sent at the same time to one host,
+        shared by all the sessions of the process.
+
+        The limit follows an AIMD scheme: it grows slowly while the
+        requests using all of it keep the latency close to the lowest
+        one seen, and is cut when the server throttles the requests with
+        a 429 or 503 status or when the latency rises. The requests past
+        the limit wait for a free slot.
+      */
+    class ConcurrencyLimiter
+    {
+        private:
+            std::mutex m_mutex;
+            std::condition_variable m_released;
+
+            double m_limit;
+            unsigned int m_maxLimit;
+            unsigned int m_inFlight;
+            unsigned int m_queued;
+
+            /// Lowest latency in milliseconds, slowly drifting up
+            double m_minLatency;
+
+        public:
+            ConcurrencyLimiter( unsigned int initialLimit, unsigned int maxLimit );
+
+            ConcurrencyLimiter( const ConcurrencyLimiter& copy ) = delete;
+            ConcurrencyLimiter& operator=( const ConcurrencyLimiter& copy ) = delete;
+
+            /** Wait for a free slot to send a request.
+              */
+            void acquire( );
+
+            /** Take a free slot if there is one, without waiting.
+              */
+            bool tryAcquire( );
+
+            /** Count the requests waiting for a slot outside of acquire( ).
+              */
+            void addQueued( int count );
+
+            /** Free the slot of a request and adapt the limit. A negative
+                latency, in milliseconds, tells that the request didn't
+                complete and doesn't change the limit.
+              */
+            void release( long latency, bool throttled );
+
+            unsigned int getLimit( );
+            unsigned int getQueued( );
+
+            /** Set the limits of the hosts, a 0 maxLimit disabling them,
+                and forget about the current ones.
+              */
+            static void configure( unsigned int initialLimit, unsigned int maxLimit );
+
+            /** Get the limiter of the host of url, or an empty pointer if
+                they are disabled.
+              */
+            static ConcurrencyLimiterPtr get( const std::string& url );
+
+            /** Get the limiter of a host only if requests were sent to it.
+              */
+            static ConcurrencyLimiterPtr find( const std::string& host );
+
+            /** Extract the host[:port] part of a URL.
+              */
+            static std::string getHost( const std::string& url );
+    };
+}
+
+#endif
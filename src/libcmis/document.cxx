@@ -29,12 +29,35 @@
 #include <libcmis/document.hxx>
 
 #include <libcmis/folder.hxx>
+#include <libcmis/xml-utils.hxx>
 
 using namespace std;
 using libcmis::PropertyPtrMap;
 
 namespace libcmis
 {
+    void Document::downloadContentStream( boost::shared_ptr< EncodedData > sink, string streamId )
+    {
+        if ( !sink )
+            throw Exception( "Missing sink" );
+
+        boost::shared_ptr< istream > stream = getContentStream( streamId );
+        if ( !stream )
+            return;
+
+        vector< char > buf( 8192 );
+        while ( stream->good( ) && !sink->hasFailed( ) )
+        {
+            stream->read( &buf[0], buf.size( ) );
+            if ( stream->gcount( ) > 0 )
+                sink->decode( &buf[0], 1, stream->gcount( ) );
+        }
+        sink->finish( );
+
+        if ( sink->hasFailed( ) )
+            throw Exception( "Failed to write the content stream" );
+    }
+
     vector< string > Document::getPaths( )
     {
         vector< string > paths;
@@ -32,6 +32,42 @@
 
 using namespace std;
 
+namespace
+{
+    void lcl_checkDepth( int depth )
+    {
+        if ( depth == 0 || depth < -1 )
+            throw libcmis::Exception( "Invalid depth: " + to_string( depth ), "invalidArgument" );
+    }
+
+    vector< libcmis::ObjectTreePtr > lcl_getTree( libcmis::Folder& folder, int depth, bool foldersOnly,
+                                                  const libcmis::OperationContext& context )
+    {
+        vector< libcmis::ObjectTreePtr > nodes;
+
+        vector< libcmis::ObjectPtr > children = folder.getChildren( context );
+        for ( vector< libcmis::ObjectPtr >::iterator it = children.begin( ); it != children.end( ); ++it )
+        {
+            libcmis::FolderPtr childFolder = boost::dynamic_pointer_cast< libcmis::Folder >( *it );
+            if ( foldersOnly && !childFolder )
+                continue;
+
+            libcmis::ObjectTreePtr node( new libcmis::ObjectTree( *it ) );
+            if ( childFolder && depth != 1 )
+            {
+                vector< libcmis::ObjectTreePtr > grandChildren =
+                    lcl_getTree( *childFolder, depth < 0 ? depth : depth - 1, foldersOnly, context );
+                for ( vector< libcmis::ObjectTreePtr >::iterator child = grandChildren.begin( );
+                        child != grandChildren.end( ); ++child )
+                    node->addChild( *child );
+            }
+            nodes.push_back( node );
+        }
+
+        return nodes;
+    }
+}
+
 namespace libcmis
 {
     vector< string > Folder::getPaths( )
@@ -52,6 +88,29 @@ namespace libcmis
         return m_session->getFolder( getParentId( ) ); 
     }
 
+    ObjectIteratorPtr Folder::listChildren( long, long, const OperationContext& context )
+    {
+        // Bindings without paging support: there is only one page
+        return ObjectIteratorPtr( new ObjectListIterator( getChildren( context ) ) );
+    }
+
+    vector< ObjectTreePtr > Folder::getDescendants( int depth, const OperationContext& context )
+    {
+        lcl_checkDepth( depth );
+        return getTree( depth, false, context );
+    }
+
+    vector< ObjectTreePtr > Folder::getFolderTree( int depth, const OperationContext& context )
+    {
+        lcl_checkDepth( depth );
+        return getTree( depth, true, context );
+    }
+
+    vector< ObjectTreePtr > Folder::getTree( int depth, bool foldersOnly, const OperationContext& context )
+    {
+        return lcl_getTree( *this, depth, foldersOnly, context );
+    }
+
     string Folder::getParentId( )
     {
         return getStringProperty( "cmis:parentId" );
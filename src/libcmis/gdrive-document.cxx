@@ -34,6 +34,7 @@
 #include "gdrive-session.hxx"
 #include "json-utils.hxx"
 #include "gdrive-utils.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 using namespace libcmis;
@@ -100,6 +101,8 @@ string GDriveDocument::getDownloadUrl( string streamId )
 
 vector< libcmis::FolderPtr > GDriveDocument::getParents( ) 
 {
+    libcmis::TraceScope traceScope( "Document::getParents", getSession( ) );
+
     vector< libcmis::FolderPtr > parents;
 
     vector< string > parentsId = getMultiStringProperty( "cmis:parentId" );
@@ -117,6 +120,8 @@ vector< libcmis::FolderPtr > GDriveDocument::getParents( )
 
 boost::shared_ptr< istream > GDriveDocument::getContentStream( string streamId )
 {
+    libcmis::TraceScope traceScope( "Document::getContentStream", getSession( ) );
+
     boost::shared_ptr< istream > stream;
     string streamUrl = getDownloadUrl( streamId );
     if ( streamUrl.empty( ) )
@@ -124,7 +129,7 @@ boost::shared_ptr< istream > GDriveDocument::getContentStream( string streamId )
 
     try
     {
-        stream = getSession( )->httpGetRequest( streamUrl )->getStream( );
+        stream = getSession( )->httpGetContentRequest( streamUrl )->getBodyStream( );
     }
     catch ( const CurlException& e )
     {
@@ -133,6 +138,25 @@ boost::shared_ptr< istream > GDriveDocument::getContentStream( string streamId )
     return stream;
 }
 
+void GDriveDocument::downloadContentStream( boost::shared_ptr< libcmis::EncodedData > sink,
+                                            string streamId )
+{
+    libcmis::TraceScope traceScope( "Document::downloadContentStream", getSession( ) );
+
+    string streamUrl = getDownloadUrl( streamId );
+    if ( streamUrl.empty( ) )
+        throw libcmis::Exception( "can not found stream url" );
+
+    try
+    {
+        getSession( )->httpGetContentRequest( streamUrl, sink );
+    }
+    catch ( const CurlException& e )
+    {
+        throw e.getCmisException( );
+    }
+}
+
 void GDriveDocument::uploadStream( boost::shared_ptr< ostream > os, 
                                    string contentType )
 {
@@ -147,7 +171,7 @@ void GDriveDocument::uploadStream( boost::shared_ptr< ostream > os,
     headers.push_back( string( "Content-Type: " ) + contentType );
     try
     {
-        string res = getSession()->httpPatchRequest( putUrl, *is, headers )->getStream()->str();
+        getSession()->httpPatchRequest( putUrl, *is, headers );
     }
     catch ( const CurlException& e )
     {
@@ -165,6 +189,10 @@ void GDriveDocument::setContentStream( boost::shared_ptr< ostream > os,
                                        string fileName, 
                                        bool /*overwrite*/ ) 
 {
+    libcmis::TraceScope traceScope( "Document::setContentStream", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     if ( !os.get( ) )
         throw libcmis::Exception( "Missing stream" );
 
@@ -178,6 +206,8 @@ void GDriveDocument::setContentStream( boost::shared_ptr< ostream > os,
 
 libcmis::DocumentPtr GDriveDocument::checkOut( )
 {
+    libcmis::TraceScope traceScope( "Document::checkOut", getSession( ) );
+
     // GDrive doesn't have CheckOut, so just return the same document here
     libcmis::ObjectPtr obj = getSession( )->getObject( getId( ) );
     libcmis::DocumentPtr checkout =
@@ -187,6 +217,8 @@ libcmis::DocumentPtr GDriveDocument::checkOut( )
 
 void GDriveDocument::cancelCheckout( )
 {
+    libcmis::TraceScope traceScope( "Document::cancelCheckout", getSession( ) );
+
     // Don't do anything since we don't have CheckOut
 }
 
@@ -198,6 +230,11 @@ libcmis::DocumentPtr GDriveDocument::checkIn(
     std::string contentType, 
     std::string fileName ) 
 {     
+    libcmis::TraceScope traceScope( "Document::checkIn", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     // GDrive doesn't have CheckIn, so just upload the properties, 
     // the content stream and fetch the new document resource.
     updateProperties( properties );
@@ -211,18 +248,22 @@ libcmis::DocumentPtr GDriveDocument::checkIn(
 
 vector< libcmis::DocumentPtr > GDriveDocument::getAllVersions( ) 
 {   
+    libcmis::TraceScope traceScope( "Document::getAllVersions", getSession( ) );
+
     vector< libcmis::DocumentPtr > revisions;
     string versionUrl = GDRIVE_METADATA_LINK + getId( ) + "/revisions";
     // Run the http request to get the properties definition
-    string res;
+    libcmis::HttpResponsePtr response;
     try
     {
-        res = getSession()->httpGetRequest( versionUrl )->getStream()->str();
+        response = getSession()->httpGetRequest( versionUrl );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
+
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );        
     Json::JsonVector objs = jsonRes["revisions"].getList( );
    
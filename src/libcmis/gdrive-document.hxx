@@ -64,6 +64,9 @@ class GDriveDocument : public libcmis::Document, public GDriveObject
         virtual std::vector< libcmis::FolderPtr > getParents( );
         virtual boost::shared_ptr< std::istream > getContentStream( 
                 std::string streamId = std::string( ) );
+
+        virtual void downloadContentStream( boost::shared_ptr< libcmis::EncodedData > sink,
+                                            std::string streamId = std::string( ) );
         
         virtual void setContentStream( boost::shared_ptr< std::ostream > os, 
                                        std::string contentType,
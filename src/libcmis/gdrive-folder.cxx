@@ -28,14 +28,133 @@
 
 #include "gdrive-folder.hxx"
 
+#include <libcmis/xml-utils.hxx>
+
 #include "gdrive-session.hxx"
 #include "gdrive-document.hxx"
 #include "gdrive-property.hxx"
 #include "gdrive-utils.hxx"
+#include "trace-scope.hxx"
+#include "tree-crawler.hxx"
 
 using namespace std;
 using namespace libcmis;
 
+namespace
+{
+    /** Iterator over the children of a folder, following the
+        nextPageToken of the files.list results.
+      */
+    class GDriveChildrenIterator : public libcmis::ObjectIterator
+    {
+        private:
+            GDriveSession* m_session;
+            string m_folderId;
+            long m_pageSize;
+            string m_pageToken;
+            string m_fields;
+
+        public:
+            GDriveChildrenIterator( GDriveSession* session, string folderId, long pageSize,
+                                    const libcmis::OperationContext& context ) :
+                libcmis::ObjectIterator( ),
+                m_session( session ),
+                m_folderId( folderId ),
+                m_pageSize( pageSize ),
+                m_pageToken( ),
+                m_fields( GdriveUtils::toGdriveFields( context,
+                            "kind,id,name,parents,mimeType,createdTime,modifiedTime,thumbnailLink,size" ) )
+            {
+            }
+
+            GDriveChildrenIterator( const GDriveChildrenIterator& copy ) = delete;
+            GDriveChildrenIterator& operator=( const GDriveChildrenIterator& copy ) = delete;
+
+        protected:
+            vector< libcmis::ObjectPtr > fetchNextPage( )
+            {
+                vector< libcmis::ObjectPtr > children;
+
+                // GDrive doesn't support fetch all the children in one query.
+                // Instead of sending multiple queries for children,
+                // we send a single query to search for objects where parents
+                // include the folderID.
+                string query = GDRIVE_METADATA_LINK + "?q=\"" + m_folderId + "\"+in+parents+and+trashed+=+false" +
+                    "&fields=nextPageToken,files(" + m_fields + ")";
+                if ( m_pageSize > 0 )
+                    query += "&pageSize=" + to_string( m_pageSize );
+                if ( !m_pageToken.empty( ) )
+                    query += "&pageToken=" + libcmis::escape( m_pageToken );
+
+                libcmis::HttpResponsePtr response;
+                try
+                {
+                    response = m_session->httpGetRequest( query );
+                }
+                catch ( const CurlException& e )
+                {
+                    throw e.getCmisException( );
+                }
+
+                const string& res = response->getBody( );
+                Json jsonRes = Json::parse( res );
+                Json::JsonVector objs = jsonRes["files"].getList( );
+
+                // Create children objects from Json objects
+                for ( unsigned int i = 0; i < objs.size( ); i++ )
+                    children.push_back( m_session->getObjectFromJson( objs[i] ) );
+
+                m_pageToken = jsonRes["nextPageToken"].toString( );
+                setHasMoreItems( !m_pageToken.empty( ) );
+
+                return children;
+            }
+    };
+
+    /** Crawler listing the children of the folders of a level in parallel.
+      */
+    class GDriveTreeCrawler : public TreeCrawler
+    {
+        private:
+            GDriveSession* m_session;
+            string m_fields;
+
+        public:
+            GDriveTreeCrawler( GDriveSession* session, const libcmis::OperationContext& context ) :
+                TreeCrawler( session ),
+                m_session( session ),
+                m_fields( GdriveUtils::toGdriveFields( context,
+                            "kind,id,name,parents,mimeType,createdTime,modifiedTime,thumbnailLink,size" ) )
+            {
+            }
+
+            GDriveTreeCrawler( const GDriveTreeCrawler& copy ) = delete;
+            GDriveTreeCrawler& operator=( const GDriveTreeCrawler& copy ) = delete;
+
+        protected:
+            string getChildrenUrl( const string& folderId, bool foldersOnly )
+            {
+                string query = GDRIVE_METADATA_LINK + "?q=\"" + folderId + "\"+in+parents+and+trashed+=+false";
+                if ( foldersOnly )
+                    query += "+and+mimeType+=+'" + GDRIVE_FOLDER_MIME_TYPE + "'";
+                return query + "&fields=nextPageToken,files(" + m_fields + ")";
+            }
+
+            string parseChildren( const string& url, const string& body, vector< libcmis::ObjectPtr >& children )
+            {
+                Json jsonRes = Json::parse( body );
+                Json::JsonVector objs = jsonRes["files"].getList( );
+                for ( unsigned int i = 0; i < objs.size( ); i++ )
+                    children.push_back( m_session->getObjectFromJson( objs[i] ) );
+
+                string pageToken = jsonRes["nextPageToken"].toString( );
+                if ( pageToken.empty( ) )
+                    return string( );
+                return url + "&pageToken=" + libcmis::escape( pageToken );
+            }
+    };
+}
+
 GDriveFolder::GDriveFolder( GDriveSession* session ):
     libcmis::Object( session ),
     GDriveObject( session )
@@ -52,44 +171,35 @@ GDriveFolder::~GDriveFolder( )
 {
 }
 
-vector< libcmis::ObjectPtr > GDriveFolder::getChildren( ) 
+vector< libcmis::ObjectPtr > GDriveFolder::getChildren( const libcmis::OperationContext& context )
 {
+    libcmis::TraceScope traceScope( "Folder::getChildren", getSession( ) );
+
     vector< libcmis::ObjectPtr > children;
-    
-    // GDrive doesn't support fetch all the children in one query.
-    // Instead of sending multiple queries for children,
-    // we send a single query to search for objects where parents
-    // include the folderID.
-    string query = GDRIVE_METADATA_LINK + "?q=\"" + getId( ) + "\"+in+parents+and+trashed+=+false" +
-        "&fields=files(kind,id,name,parents,mimeType,createdTime,modifiedTime,thumbnailLink,size)";
-
-    string res;
-    try
-    {
-        res = getSession( )->httpGetRequest( query )->getStream()->str();
-    }
-    catch ( const CurlException& e )
-    {
-        throw e.getCmisException( );
-    }
 
-    Json jsonRes = Json::parse( res );
-    Json::JsonVector objs = jsonRes["files"].getList( );
-    
-    // Create children objects from Json objects
-    for(unsigned int i = 0; i < objs.size(); i++)
-    {   
-        ObjectPtr child;
-        if ( objs[i]["mimeType"].toString( ) == GDRIVE_FOLDER_MIME_TYPE )
-            child.reset( new GDriveFolder( getSession( ), objs[i] ) );
-        else
-            child.reset( new GDriveDocument( getSession( ), objs[i] ) );
-        children.push_back( child );
-    }   
-    
+    libcmis::ObjectIteratorPtr it = listChildren( 0, 0, context );
+    while ( it->hasNext( ) )
+        children.push_back( it->next( ) );
+
     return children;
 }
 
+libcmis::ObjectIteratorPtr GDriveFolder::listChildren( long pageSize, long, const libcmis::OperationContext& context )
+{
+    libcmis::TraceScope traceScope( "Folder::listChildren", getSession( ) );
+
+    return libcmis::ObjectIteratorPtr( new GDriveChildrenIterator( getSession( ), getId( ), pageSize, context ) );
+}
+
+vector< libcmis::ObjectTreePtr > GDriveFolder::getTree( int depth, bool foldersOnly,
+        const libcmis::OperationContext& context )
+{
+    libcmis::TraceScope traceScope( "Folder::getTree", getSession( ) );
+
+    GDriveTreeCrawler crawler( getSession( ), context );
+    return crawler.crawl( getId( ), depth, foldersOnly );
+}
+
 string GDriveFolder::uploadProperties( Json properties )
 {
     // URL for uploading meta data
@@ -100,23 +210,24 @@ string GDriveFolder::uploadProperties( Json properties )
     
     //upload metadata
     std::istringstream is( properties.toString( ) );
-    string response;
+    libcmis::HttpResponsePtr resp;
     try
     {
-        response = getSession()->httpPostRequest( metaUrl, is, "application/json" )
-                                    ->getStream( )->str( );
+        resp = getSession()->httpPostRequest( metaUrl, is, "application/json" );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }    
 
-    return response;
+    return resp->getBody( );
 }
                              
 libcmis::FolderPtr GDriveFolder::createFolder( 
     const PropertyPtrMap& properties ) 
 {
+    libcmis::TraceScope traceScope( "Folder::createFolder", getSession( ) );
+
     Json propsJson = GdriveUtils::toGdriveJson( properties );
  
     // GDrive folder is a file with a different mime type.
@@ -140,6 +251,8 @@ libcmis::DocumentPtr GDriveFolder::createDocument(
     boost::shared_ptr< ostream > os, 
     string contentType, string fileName ) 
 {    
+    libcmis::TraceScope traceScope( "Folder::createDocument", getSession( ) );
+
     if ( !os.get( ) )
         throw libcmis::Exception( "Missing stream" );
     
@@ -175,6 +288,11 @@ vector< string > GDriveFolder::removeTree(
     libcmis::UnfileObjects::Type /*unfile*/, 
     bool /*continueOnError*/ ) 
 {
+    libcmis::TraceScope traceScope( "Folder::removeTree", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     try
     {   
         getSession( )->httpDeleteRequest( GDRIVE_METADATA_LINK + getId( ) );
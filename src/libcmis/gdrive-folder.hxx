@@ -44,7 +44,9 @@ class GDriveFolder : public libcmis::Folder, public GDriveObject
 
         std::string getType( ) { return std::string( "cmis:folder" );}
         std::string getBaseType( ) { return std::string( "cmis:folder" );}        
-        virtual std::vector< libcmis::ObjectPtr > getChildren( );
+        virtual std::vector< libcmis::ObjectPtr > getChildren( const libcmis::OperationContext& context = libcmis::OperationContext( ) );
+        virtual libcmis::ObjectIteratorPtr listChildren( long pageSize = 0, long readAhead = 0,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
         virtual libcmis::FolderPtr createFolder( 
             const libcmis::PropertyPtrMap& properties );
@@ -61,6 +63,10 @@ class GDriveFolder : public libcmis::Folder, public GDriveObject
             bool continueOnError = false );
 
         std::string uploadProperties( Json properties );
+
+    protected:
+        virtual std::vector< libcmis::ObjectTreePtr > getTree( int depth, bool foldersOnly,
+                const libcmis::OperationContext& context );
 };
 
 #endif
@@ -32,23 +32,27 @@
 #include "gdrive-allowable-actions.hxx"
 #include "gdrive-repository.hxx"
 #include "gdrive-utils.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 using namespace libcmis;
 
 GDriveObject::GDriveObject( GDriveSession* session ) :
-    libcmis::Object( session )
+    libcmis::Object( session ),
+    m_validators( )
 {
 }
 
 GDriveObject::GDriveObject( GDriveSession* session, Json json, string id, string name ) :
-    libcmis::Object( session )
+    libcmis::Object( session ),
+    m_validators( )
 {
    initializeFromJson( json, id, name ); 
 }
 
 GDriveObject::GDriveObject( const GDriveObject& copy ) :
-    libcmis::Object( copy )
+    libcmis::Object( copy ),
+    m_validators( copy.m_validators )
 {
 }
 
@@ -57,6 +61,7 @@ GDriveObject& GDriveObject::operator=( const GDriveObject& copy )
     if ( this != &copy )
     {
         libcmis::Object::operator=( copy );
+        m_validators = copy.m_validators;
     }
     return *this;
 }
@@ -135,11 +140,14 @@ void GDriveObject::refreshImpl( Json json )
 {
     m_typeDescription.reset( );
     m_properties.clear( );
+    m_validators.clear( );
     initializeFromJson( json );
 }
 
 vector< RenditionPtr> GDriveObject::getRenditions( string /* filter */ )
 {
+    libcmis::TraceScope traceScope( "Object::getRenditions", getSession( ) );
+
     if ( m_renditions.empty( ) )
     {
         string downloadUrl = GDRIVE_METADATA_LINK + getId( ) + "?alt=media";
@@ -179,6 +187,10 @@ vector< RenditionPtr> GDriveObject::getRenditions( string /* filter */ )
 libcmis::ObjectPtr GDriveObject::updateProperties(
         const PropertyPtrMap& properties )
 {
+    libcmis::TraceScope traceScope( "Object::updateProperties", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     // Make Json object from properties
     Json json = GdriveUtils::toGdriveJson( properties );
 
@@ -196,7 +208,7 @@ libcmis::ObjectPtr GDriveObject::updateProperties(
         throw e.getCmisException( );
     }
     
-    string res = response->getStream( )->str( );
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
     libcmis::ObjectPtr updated( new GDriveObject ( getSession( ), jsonRes ) );
 
@@ -208,21 +220,38 @@ libcmis::ObjectPtr GDriveObject::updateProperties(
 
 void GDriveObject::refresh( )
 {
-    string res;
+    libcmis::TraceScope traceScope( "Object::refresh", getSession( ) );
+
+    libcmis::HttpResponsePtr response;
+    libcmis::HttpValidators validators( m_validators );
     try
     {
-        res  = getSession()->httpGetRequest( getUrl( ) )->getStream( )->str( );
+        response = getSession()->httpConditionalGetRequest( getUrl( ), validators );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
+
+    // Nothing changed since the last refresh: keep the parsed state
+    if ( !response )
+    {
+        m_refreshTimestamp = time( NULL );
+        return;
+    }
+
+    const string& res = response->getBody( );
     Json json = Json::parse( res );
     refreshImpl( json );
+    m_validators = validators;
 }
 
 void GDriveObject::remove( bool /*allVersions*/ )
 {
+    libcmis::TraceScope traceScope( "Object::remove", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     try
     {
         getSession( )->httpDeleteRequest( GDRIVE_METADATA_LINK + getId( ) );
@@ -235,6 +264,10 @@ void GDriveObject::remove( bool /*allVersions*/ )
 
 void GDriveObject::move( FolderPtr /*source*/, FolderPtr destination ) 
 {  
+    libcmis::TraceScope traceScope( "Object::move", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     Json parentsJson;
     parentsJson.add( "addParents", Json(destination->getId( ).c_str()) );
     parentsJson.add( "removeParents", Json(getStringProperty( "cmis:parentId" ).c_str()) );
@@ -251,7 +284,7 @@ void GDriveObject::move( FolderPtr /*source*/, FolderPtr destination )
     {   
         throw e.getCmisException( );
     }
-    string res = response->getStream( )->str( );
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
 
     refreshImpl( jsonRes );
@@ -82,6 +82,10 @@ class GDriveObject : public virtual libcmis::Object
     protected:
         GDriveSession* getSession( );    
 
+
+    private:
+        /// Validators of the JSON downloaded by the last refresh
+        libcmis::HttpValidators m_validators;
 };
 
 #endif
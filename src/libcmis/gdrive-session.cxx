@@ -36,6 +36,7 @@
 #include "gdrive-repository.hxx"
 #include "gdrive-object-type.hxx"
 #include "gdrive-utils.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 
@@ -64,6 +65,7 @@ GDriveSession::GDriveSession() :
 
 GDriveSession::~GDriveSession()
 {
+    stopAsyncRequests( );
 }
 
 
@@ -118,25 +120,40 @@ bool GDriveSession::setRepository( std::string )
     return true;
 }
 
-libcmis::ObjectPtr GDriveSession::getObject( string objectId )
+libcmis::ObjectPtr GDriveSession::getObject( string objectId, const libcmis::OperationContext& context )
 {
+    libcmis::TraceScope traceScope( "Session::getObject", this );
+
     if(objectId == "root") {
         return getRootFolder();
     }
+    libcmis::ObjectPtr cached = getCachedObject( objectId, context );
+    if ( cached )
+        return cached;
+
     // Run the http request to get the properties definition
-    string res;
-    string objectLink = GDRIVE_METADATA_LINK + objectId +
-         "?fields=kind,id,name,parents,mimeType,createdTime,modifiedTime,thumbnailLink,size";
+    libcmis::HttpResponsePtr response;
+    string objectLink = GDRIVE_METADATA_LINK + objectId + "?fields=" +
+         GdriveUtils::toGdriveFields( context,
+                 "kind,id,name,parents,mimeType,createdTime,modifiedTime,thumbnailLink,size" );
     try
     {
-        res = httpGetRequest( objectLink )->getStream()->str();
+        response = httpGetRequest( objectLink );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
+
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
+    libcmis::ObjectPtr object = getObjectFromJson( jsonRes );
+    cacheObject( object, context );
+    return object;
+}
 
+libcmis::ObjectPtr GDriveSession::getObjectFromJson( Json& jsonRes )
+{
     // If we have a folder, then convert the object
     // into a GDriveFolder otherwise, convert it
     // into a GDriveDocument
@@ -161,63 +178,72 @@ libcmis::ObjectPtr GDriveSession::getObject( string objectId )
     return object;
 }
 
-libcmis::ObjectPtr GDriveSession::getObjectByPath( string path )
+libcmis::ObjectPtr GDriveSession::getObjectByPath( string path, const libcmis::OperationContext& context )
 {
-    size_t pos = 0;
-    size_t endpos = 0;
-    string objectId;
-    libcmis::ObjectPtr object;
+    libcmis::TraceScope traceScope( "Session::getObjectByPath", this );
 
-    do
+    vector< string > segments = PathCache::splitPath( path );
+
+    // Only ask for the segments after the longest known prefix
+    string objectId = "root";
+    size_t known = getPathCache( ).resolve( segments, objectId );
+    string knownId = objectId;
+
+    for ( size_t i = known; i < segments.size( ); ++i )
     {
-        endpos = path.find( "/", pos );
-        size_t len = path.length( ) - pos;
-        if ( endpos != string::npos )
-            len = endpos - pos;
+        // Ask for the ID of the child if there is any
+        // somewhat flawed as names are not necessarily unique in GDrive...
+        string query = libcmis::escape("'" + objectId + "' in parents and trashed = false and name='" + segments[i] + "'");
+
+        string childIdUrl = m_bindingUrl + "/files/?q=" + query + "&fields=files(id)";
 
-        string segment = path.substr( pos, len );
-        if ( segment.empty( ) )
+        libcmis::HttpResponsePtr response;
+        try
         {
-            // Root case or ignore double slashes
-            if ( pos == 0 )
-                objectId = "root";
-            else
-                continue;
+            response = httpGetRequest( childIdUrl );
         }
-        else
+        catch ( const CurlException& e )
         {
-            // Normal child case
-            // Ask for the ID of the child if there is any
-            // somewhat flawed as names are not necessarily unique in GDrive...
-            string query = libcmis::escape("'" + objectId + "' in parents and trashed = false and name='" + segment + "'");
+            throw e.getCmisException( );
+        }
 
-            string childIdUrl = m_bindingUrl + "/files/?q=" + query + "&fields=files(id)";
+        const string& res = response->getBody( );
+        Json jsonRes = Json::parse( res );
 
-            string res;
-            try
-            {
-                res = httpGetRequest( childIdUrl )->getStream()->str();
-            }
-            catch ( const CurlException& e )
+        // Did we get an id?
+        Json::JsonVector items = jsonRes["files"].getList();
+        if ( !items.empty( ) )
+            objectId = items[0]["id"].toString( );
+
+        if ( items.empty( ) || objectId.empty( ) )
+        {
+            // The known prefix may have been changed by someone else:
+            // forget it and try again from the root
+            if ( known > 0 )
             {
-                throw e.getCmisException( );
+                getPathCache( ).remove( knownId );
+                return getObjectByPath( path, context );
             }
-            Json jsonRes = Json::parse( res );
-
-            // Did we get an id?
-            Json::JsonVector items = jsonRes["files"].getList();
-            if ( items.empty( ) )
-                throw libcmis::Exception( "Object not found: " + path, "objectNotFound" );
-
-            objectId = items[0]["id"].toString( );
-            if ( objectId.empty( ) )
-                throw libcmis::Exception( "Object not found: " + path, "objectNotFound" );
+            throw libcmis::Exception( "Object not found: " + path, "objectNotFound" );
         }
 
-        pos = endpos + 1;
-    } while ( endpos != string::npos );
+        getPathCache( ).add( segments, i + 1, objectId );
+    }
 
-    return getObject( objectId );
+    if ( known > 0 && known == segments.size( ) )
+    {
+        try
+        {
+            return getObject( objectId, context );
+        }
+        catch ( const libcmis::Exception& )
+        {
+            // Removed by someone else: look for the path again
+            getPathCache( ).remove( objectId );
+            return getObjectByPath( path, context );
+        }
+    }
+    return getObject( objectId, context );
 }
 
 libcmis::FolderPtr GDriveSession::getRootFolder()
@@ -243,13 +269,79 @@ libcmis::FolderPtr GDriveSession::getRootFolder()
 
 libcmis::ObjectTypePtr GDriveSession::getType( string id )
 {
-    libcmis::ObjectTypePtr type( new GdriveObjectType( id ) );
+    libcmis::TraceScope traceScope( "Session::getType", this );
+
+    libcmis::ObjectTypePtr type = getCachedType( id );
+    if ( !type )
+    {
+        type.reset( new GdriveObjectType( id ) );
+        cacheType( id, type );
+    }
     return type;
 }
 
 vector< libcmis::ObjectTypePtr > GDriveSession::getBaseTypes( )
 {
+    libcmis::TraceScope traceScope( "Session::getBaseTypes", this );
+
     vector< libcmis::ObjectTypePtr > types;
     // TODO Implement me
     return types;
 }
+
+libcmis::ContentChanges GDriveSession::getContentChanges( string changeLogToken, long maxItems )
+{
+    libcmis::TraceScope traceScope( "Session::getContentChanges", this );
+
+    vector< libcmis::ChangeEventPtr > events;
+    libcmis::HttpResponsePtr response;
+    try
+    {
+        if ( changeLogToken.empty( ) )
+        {
+            response = httpGetRequest( GDRIVE_CHANGES_LINK + "/startPageToken" );
+            Json jsonRes = Json::parse( response->getBody( ) );
+            return libcmis::ContentChanges( events, jsonRes["startPageToken"].toString( ), false );
+        }
+
+        string url = GDRIVE_CHANGES_LINK + "?pageToken=" + libcmis::escape( changeLogToken ) +
+            "&fields=nextPageToken,newStartPageToken,changes(fileId,removed,time,file(trashed))";
+        if ( maxItems > 0 )
+            url += "&pageSize=" + to_string( maxItems );
+        response = httpGetRequest( url );
+    }
+    catch ( const CurlException& e )
+    {
+        throw e.getCmisException( );
+    }
+
+    Json jsonRes = Json::parse( response->getBody( ) );
+    Json::JsonVector changes = jsonRes["changes"].getList( );
+    for ( Json::JsonVector::iterator it = changes.begin( ); it != changes.end( ); ++it )
+    {
+        // Shared drive changes have no file
+        string fileId = ( *it )["fileId"].toString( );
+        if ( fileId.empty( ) )
+            continue;
+
+        // Drive doesn't tell creations from updates
+        libcmis::ChangeType::Type type = libcmis::ChangeType::Updated;
+        if ( ( *it )["removed"].toString( ) == "true" || ( *it )["file"]["trashed"].toString( ) == "true" )
+            type = libcmis::ChangeType::Deleted;
+
+        boost::posix_time::ptime time;
+        string timeStr = ( *it )["time"].toString( );
+        if ( !timeStr.empty( ) )
+            time = libcmis::parseDateTime( timeStr );
+
+        events.push_back( libcmis::ChangeEventPtr( new libcmis::ChangeEvent( fileId, type, time ) ) );
+    }
+
+    // Either a next page or the token to use for the future changes
+    string nextToken = jsonRes["nextPageToken"].toString( );
+    bool hasMoreItems = !nextToken.empty( );
+    if ( !hasMoreItems )
+        nextToken = jsonRes["newStartPageToken"].toString( );
+
+    return libcmis::ContentChanges( events, nextToken, hasMoreItems );
+}
@@ -31,6 +31,7 @@
 #include <libcmis/repository.hxx>
 
 #include "base-session.hxx"
+#include "json-utils.hxx"
 
 class GDriveSession : public BaseSession
 {
@@ -48,14 +49,24 @@ class GDriveSession : public BaseSession
 
         virtual bool setRepository( std::string );
 
-        virtual libcmis::ObjectPtr getObject( std::string id );
+        virtual libcmis::ObjectPtr getObject( std::string id,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
-        virtual libcmis::ObjectPtr getObjectByPath( std::string path );
+        virtual libcmis::ObjectPtr getObjectByPath( std::string path,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
+
+        libcmis::ObjectPtr getObjectFromJson( Json& jsonRes );
 
         virtual libcmis::ObjectTypePtr getType( std::string id );
 
         virtual std::vector< libcmis::ObjectTypePtr > getBaseTypes( );
 
+        /** Drive keeps no history of the changes: an empty token
+            only gives the token of the current state.
+          */
+        virtual libcmis::ContentChanges getContentChanges( std::string changeLogToken = std::string( ),
+                                                           long maxItems = 0 );
+
         virtual libcmis::FolderPtr getRootFolder();
 
         virtual std::string getRefreshToken();
@@ -28,11 +28,16 @@
 
 #include "gdrive-utils.hxx"
 
+#include <algorithm>
+
+#include <boost/algorithm/string.hpp>
+
 #include <libcmis/xml-utils.hxx>
 
 #include "json-utils.hxx"
 
 using namespace std;
+using libcmis::OperationContext;
 using libcmis::PropertyPtrMap;
 
 string GdriveUtils::toCmisKey( const string& key )
@@ -95,6 +100,34 @@ string GdriveUtils::toGdriveKey( const string& key )
     return convertedKey;
 }
 
+string GdriveUtils::toGdriveFields( const OperationContext& context, const string& defaultFields )
+{
+    if ( !context.isPropertyFilterSet( ) )
+        return defaultFields;
+
+    // The object kind, id, type and parents are always needed to build the object
+    vector< string > fields;
+    fields.push_back( "kind" );
+    fields.push_back( "id" );
+    fields.push_back( "mimeType" );
+    fields.push_back( "parents" );
+
+    vector< string > known;
+    boost::split( known, defaultFields, boost::is_any_of( "," ) );
+
+    const vector< string >& filter = context.getPropertyFilter( );
+    for ( vector< string >::const_iterator it = filter.begin( ); it != filter.end( ); ++it )
+    {
+        string field = toGdriveKey( *it );
+        // Ignore the properties the request wouldn't have returned anyway
+        if ( find( known.begin( ), known.end( ), field ) != known.end( ) &&
+             find( fields.begin( ), fields.end( ), field ) == fields.end( ) )
+            fields.push_back( field );
+    }
+
+    return boost::algorithm::join( fields, "," );
+}
+
 Json GdriveUtils::toGdriveJson( const PropertyPtrMap& properties )
 {
     Json propsJson;
@@ -30,6 +30,7 @@
 
 #include <string>
 
+#include <libcmis/operation-context.hxx>
 #include <libcmis/property.hxx>
 
 #include "json-utils.hxx"
@@ -37,6 +38,7 @@
 static const std::string GDRIVE_FOLDER_MIME_TYPE = "application/vnd.google-apps.folder" ;
 static const std::string GDRIVE_UPLOAD_LINK = "https://www.googleapis.com/upload/drive/v3/files/";
 static const std::string GDRIVE_METADATA_LINK = "https://www.googleapis.com/drive/v3/files/";
+static const std::string GDRIVE_CHANGES_LINK = "https://www.googleapis.com/drive/v3/changes";
 
 class GdriveUtils
 {
@@ -48,6 +50,11 @@ class GdriveUtils
         // Convert a CMIS key to GDrive key
         static std::string toGdriveKey( const std::string& key );
 
+        // Compute the fields parameter of a request from the property filter
+        // of the operation context, or defaultFields if no filter is set
+        static std::string toGdriveFields( const libcmis::OperationContext& context,
+                                           const std::string& defaultFields );
+
         // Convert CMIS properties to GDrive properties
         static Json toGdriveJson( const libcmis::PropertyPtrMap& properties );
 
@@ -0,0 +1,380 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "http-async.hxx"
+
+#include <libcmis/exception.hxx>
+
+using namespace std;
+
+namespace
+{
+    // Without curl_multi_wakeup( ), new requests are only noticed when
+    // curl_multi_wait( ) times out.
+    const int MULTI_WAIT_TIMEOUT_MS = 100;
+}
+
+namespace libcmis
+{
+    HttpAsyncRequest::HttpAsyncRequest( string method, string url,
+                                        HttpCompletionCallback callback ) :
+        m_method( method ),
+        m_url( url ),
+        m_headers( ),
+        m_redirect( true ),
+        m_body( ),
+        m_handle( NULL ),
+        m_share( ),
+        m_headersList( ),
+        m_errBuff( ),
+        m_response( ),
+        m_noHttpErrors( false ),
+        m_no100Continue( false ),
+        m_refreshedToken( false ),
+        m_canRefreshToken( false ),
+        m_authHeader( ),
+        m_retries( 0 ),
+        m_limiter( ),
+        m_waitingSlot( false ),
+        m_startTime( ),
+        m_span( TraceScope::getCurrentSpan( ) ),
+        m_promise( ),
+        m_callback( callback )
+    {
+        curl_global_init( CURL_GLOBAL_ALL );
+        m_handle = curl_easy_init( );
+        if ( NULL == m_handle )
+            throw Exception( "Failed to create a curl handle" );
+    }
+
+    HttpAsyncRequest::~HttpAsyncRequest( )
+    {
+        // Detaches the handle from m_share before it may be released
+        curl_easy_cleanup( m_handle );
+    }
+
+    void HttpAsyncRequest::setBody( istream& is )
+    {
+        m_body.reset( new HttpUploadBody( is ) );
+    }
+
+    void HttpAsyncRequest::complete( )
+    {
+        // Give the stream back to the caller before waking it up
+        m_body.reset( );
+        m_promise.set_value( m_response );
+        if ( m_callback )
+        {
+            try
+            {
+                m_callback( m_response, exception_ptr( ) );
+            }
+            catch ( ... )
+            {
+                // Nobody could catch it on the engine thread
+            }
+        }
+    }
+
+    void HttpAsyncRequest::fail( exception_ptr error )
+    {
+        m_body.reset( );
+        m_promise.set_exception( error );
+        if ( m_callback )
+        {
+            try
+            {
+                m_callback( HttpResponsePtr( ), error );
+            }
+            catch ( ... )
+            {
+            }
+        }
+    }
+
+    HttpAsyncEngine::HttpAsyncEngine( HttpSession* session ) :
+        m_session( session ),
+        m_multi( NULL ),
+        m_mutex( ),
+        m_wakeUp( ),
+        m_queue( ),
+        m_stopping( false ),
+        m_running( ),
+        m_waiting( ),
+        m_delayed( ),
+        m_refreshes( ),
+        m_thread( )
+    {
+        curl_global_init( CURL_GLOBAL_ALL );
+        m_multi = curl_multi_init( );
+        if ( NULL == m_multi )
+            throw Exception( "Failed to create the asynchronous request engine" );
+
+        m_thread = thread( &HttpAsyncEngine::run, this );
+    }
+
+    HttpAsyncEngine::~HttpAsyncEngine( )
+    {
+        {
+            lock_guard< mutex > lock( m_mutex );
+            m_stopping = true;
+        }
+        m_wakeUp.notify_one( );
+#if CURL_AT_LEAST_VERSION(7, 68, 0)
+        curl_multi_wakeup( m_multi );
+#endif
+        m_thread.join( );
+
+        // The refreshed requests are submitted again: cancel them below
+        for ( vector< future< void > >::iterator it = m_refreshes.begin( );
+              it != m_refreshes.end( ); ++it )
+            it->wait( );
+
+        exception_ptr cancelled = make_exception_ptr(
+                CurlException( "Session closed before the request was over", CURLE_OK ) );
+        for ( map< CURL*, HttpAsyncRequestPtr >::iterator it = m_running.begin( );
+              it != m_running.end( ); ++it )
+        {
+            curl_multi_remove_handle( m_multi, it->first );
+            if ( it->second->m_limiter )
+                it->second->m_limiter->release( -1, false );
+            it->second->fail( cancelled );
+        }
+        for ( deque< HttpAsyncRequestPtr >::iterator it = m_queue.begin( );
+              it != m_queue.end( ); ++it )
+            ( *it )->fail( cancelled );
+        for ( deque< HttpAsyncRequestPtr >::iterator it = m_waiting.begin( );
+              it != m_waiting.end( ); ++it )
+        {
+            if ( ( *it )->m_waitingSlot )
+                ( *it )->m_limiter->addQueued( -1 );
+            ( *it )->fail( cancelled );
+        }
+        for ( multimap< chrono::steady_clock::time_point, HttpAsyncRequestPtr >::iterator it = m_delayed.begin( );
+              it != m_delayed.end( ); ++it )
+            it->second->fail( cancelled );
+
+        curl_multi_cleanup( m_multi );
+    }
+
+    void HttpAsyncEngine::submit( HttpAsyncRequestPtr request )
+    {
+        {
+            lock_guard< mutex > lock( m_mutex );
+            m_queue.push_back( request );
+        }
+        m_wakeUp.notify_one( );
+#if CURL_AT_LEAST_VERSION(7, 68, 0)
+        curl_multi_wakeup( m_multi );
+#endif
+    }
+
+    void HttpAsyncEngine::run( )
+    {
+        unique_lock< mutex > lock( m_mutex );
+        while ( !m_stopping )
+        {
+            m_waiting.insert( m_waiting.end( ), m_queue.begin( ), m_queue.end( ) );
+            m_queue.clear( );
+
+            // Add the retries that waited long enough
+            chrono::steady_clock::time_point now = chrono::steady_clock::now( );
+            while ( !m_delayed.empty( ) && m_delayed.begin( )->first <= now )
+            {
+                m_waiting.push_back( m_delayed.begin( )->second );
+                m_delayed.erase( m_delayed.begin( ) );
+            }
+
+            // Start the requests whose host has room for them
+            for ( deque< HttpAsyncRequestPtr >::iterator it = m_waiting.begin( ); it != m_waiting.end( ); )
+            {
+                if ( start( *it ) )
+                    it = m_waiting.erase( it );
+                else
+                    ++it;
+            }
+
+            if ( m_running.empty( ) )
+            {
+                // The slots may be freed by other sessions: check them
+                // from time to time.
+                chrono::steady_clock::time_point wakeUp = chrono::steady_clock::time_point::max( );
+                if ( !m_waiting.empty( ) )
+                    wakeUp = now + chrono::milliseconds( MULTI_WAIT_TIMEOUT_MS );
+                if ( !m_delayed.empty( ) )
+                    wakeUp = min( wakeUp, m_delayed.begin( )->first );
+
+                if ( wakeUp == chrono::steady_clock::time_point::max( ) )
+                    m_wakeUp.wait( lock );
+                else
+                    m_wakeUp.wait_until( lock, wakeUp );
+                continue;
+            }
+
+            lock.unlock( );
+
+            int stillRunning = 0;
+            curl_multi_perform( m_multi, &stillRunning );
+
+            CURLMsg* msg = NULL;
+            int msgsLeft = 0;
+            while ( ( msg = curl_multi_info_read( m_multi, &msgsLeft ) ) != NULL )
+            {
+                if ( CURLMSG_DONE != msg->msg )
+                    continue;
+
+                CURL* handle = msg->easy_handle;
+                CURLcode errCode = msg->data.result;
+                curl_multi_remove_handle( m_multi, handle );
+
+                map< CURL*, HttpAsyncRequestPtr >::iterator it = m_running.find( handle );
+                if ( it != m_running.end( ) )
+                {
+                    HttpAsyncRequestPtr request = it->second;
+                    m_running.erase( it );
+                    finish( request, errCode );
+                }
+            }
+
+            if ( stillRunning > 0 )
+            {
+#if CURL_AT_LEAST_VERSION(7, 68, 0)
+                curl_multi_poll( m_multi, NULL, 0, MULTI_WAIT_TIMEOUT_MS, NULL );
+#else
+                curl_multi_wait( m_multi, NULL, 0, MULTI_WAIT_TIMEOUT_MS, NULL );
+#endif
+            }
+
+            lock.lock( );
+        }
+    }
+
+    bool HttpAsyncEngine::start( HttpAsyncRequestPtr request )
+    {
+        if ( !request->m_limiter )
+            request->m_limiter = ConcurrencyLimiter::get( request->m_url );
+
+        if ( request->m_limiter && !request->m_limiter->tryAcquire( ) )
+        {
+            if ( !request->m_waitingSlot )
+            {
+                request->m_limiter->addQueued( 1 );
+                request->m_waitingSlot = true;
+            }
+            return false;
+        }
+
+        if ( request->m_waitingSlot )
+        {
+            request->m_limiter->addQueued( -1 );
+            request->m_waitingSlot = false;
+        }
+
+        request->m_startTime = chrono::steady_clock::now( );
+        m_running[ request->m_handle ] = request;
+        curl_multi_add_handle( m_multi, request->m_handle );
+        return true;
+    }
+
+    void HttpAsyncEngine::finish( HttpAsyncRequestPtr request, CURLcode errCode )
+    {
+        long status = 0;
+        curl_easy_getinfo( request->m_handle, CURLINFO_RESPONSE_CODE, &status );
+
+        // Free the slot before a retry asks for one again
+        if ( request->m_limiter )
+            request->m_limiter->release( getFirstByteLatency( request->m_handle, request->m_startTime ),
+                                         status == 429 || status == 503 );
+        RequestMetrics metrics = getRequestMetrics( request->m_handle, request->m_method, request->m_url );
+        m_session->getStatisticsCounters( ).addRequest( metrics );
+        reportRequestMetrics( metrics, request->m_span );
+
+        bool isHttpError = errCode == CURLE_HTTP_RETURNED_ERROR;
+        if ( CURLE_OK == errCode || ( request->m_noHttpErrors && isHttpError ) )
+        {
+            request->m_response->getData( )->finish( );
+            request->complete( );
+            return;
+        }
+
+        string errBuff( request->m_errBuff );
+
+        try
+        {
+            long delay = 0;
+            bool needsRefresh = false;
+            if ( m_session->retryAsyncRequest( *request, status, delay, needsRefresh ) )
+            {
+                if ( needsRefresh )
+                    refresh( request );
+                else if ( delay > 0 )
+                    m_delayed.insert( make_pair( chrono::steady_clock::now( ) + chrono::milliseconds( delay ),
+                                                 request ) );
+                else if ( !start( request ) )
+                    m_waiting.push_back( request );
+                return;
+            }
+        }
+        catch ( ... )
+        {
+            request->fail( current_exception( ) );
+            return;
+        }
+
+        request->fail( make_exception_ptr(
+                    CurlException( errBuff, errCode, request->m_url, status ) ) );
+    }
+
+    void HttpAsyncEngine::refresh( HttpAsyncRequestPtr request )
+    {
+        // Forget about the refreshes which are over
+        for ( vector< future< void > >::iterator it = m_refreshes.begin( ); it != m_refreshes.end( ); )
+        {
+            if ( it->wait_for( chrono::seconds( 0 ) ) == future_status::ready )
+                it = m_refreshes.erase( it );
+            else
+                ++it;
+        }
+
+        // The refresh may wait for a synchronous request or for the user:
+        // don't hold the other transfers meanwhile
+        m_refreshes.push_back( async( launch::async, [this, request]( )
+            {
+                try
+                {
+                    m_session->refreshAsyncRequest( *request );
+                }
+                catch ( ... )
+                {
+                    request->fail( current_exception( ) );
+                    return;
+                }
+                submit( request );
+            } ) );
+    }
+}
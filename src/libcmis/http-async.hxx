@@ -0,0 +1,181 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _HTTP_ASYNC_HXX_
+#define _HTTP_ASYNC_HXX_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "concurrency-limiter.hxx"
+#include "http-session.hxx"
+
+namespace libcmis
+{
+    /** State of a request run by the HttpAsyncEngine. It owns its own
+        curl handle and everything the handle points to while the
+        transfer is running.
+      */
+    class HttpAsyncRequest
+    {
+        public:
+            HttpAsyncRequest( std::string method, std::string url,
+                              HttpCompletionCallback callback );
+            ~HttpAsyncRequest( );
+
+            HttpAsyncRequest( const HttpAsyncRequest& copy ) = delete;
+            HttpAsyncRequest& operator=( const HttpAsyncRequest& copy ) = delete;
+
+            /** Set the body to upload from the current position of the
+                stream, which is read while the request is sent and left
+                where it was once the request is over.
+              */
+            void setBody( std::istream& is );
+
+            /** Release the body, resolve the future and call the callback.
+              */
+            void complete( );
+            void fail( std::exception_ptr error );
+
+            std::string m_method;
+            std::string m_url;
+            std::vector< std::string > m_headers;
+            bool m_redirect;
+
+            std::unique_ptr< HttpUploadBody > m_body;
+
+            CURL* m_handle;
+            CurlSharePtr m_share;
+            CurlSlistPtr m_headersList;
+            char m_errBuff[CURL_ERROR_SIZE];
+            HttpResponsePtr m_response;
+
+            /** Settings used for the current attempt.
+              */
+            bool m_noHttpErrors;
+            bool m_no100Continue;
+            bool m_refreshedToken;
+            bool m_canRefreshToken;
+            std::string m_authHeader;
+
+            /** Number of times the request was retried because the
+                server throttled it.
+              */
+            unsigned int m_retries;
+
+            /** Limiter of the request's host, waited for when
+                m_waitingSlot is set.
+              */
+            ConcurrencyLimiterPtr m_limiter;
+            bool m_waitingSlot;
+            std::chrono::steady_clock::time_point m_startTime;
+
+            /** Span of the operation which started the request, as the
+                request is over after the operation when not waited for.
+              */
+            ActiveSpanPtr m_span;
+
+            std::promise< HttpResponsePtr > m_promise;
+            HttpCompletionCallback m_callback;
+    };
+    typedef std::shared_ptr< HttpAsyncRequest > HttpAsyncRequestPtr;
+
+    /** Runs the asynchronous requests of an HttpSession on a curl_multi
+        handle driven by a dedicated thread.
+      */
+    class HttpAsyncEngine
+    {
+        private:
+            HttpSession* m_session;
+            CURLM* m_multi;
+
+            std::mutex m_mutex;
+            std::condition_variable m_wakeUp;
+            std::deque< HttpAsyncRequestPtr > m_queue;
+            bool m_stopping;
+
+            /** Requests added to m_multi, only used by the thread.
+              */
+            std::map< CURL*, HttpAsyncRequestPtr > m_running;
+
+            /** Requests waiting for a free slot of their host, only used
+                by the thread.
+              */
+            std::deque< HttpAsyncRequestPtr > m_waiting;
+
+            /** Retries waiting to be started, only used by the thread.
+              */
+            std::multimap< std::chrono::steady_clock::time_point, HttpAsyncRequestPtr > m_delayed;
+
+            /** Token refreshes run off the thread as they need the
+                session, only used by the thread.
+              */
+            std::vector< std::future< void > > m_refreshes;
+
+            std::thread m_thread;
+
+        public:
+            explicit HttpAsyncEngine( HttpSession* session );
+
+            /** Stop the thread and cancel the requests that are not over.
+              */
+            ~HttpAsyncEngine( );
+
+            HttpAsyncEngine( const HttpAsyncEngine& copy ) = delete;
+            HttpAsyncEngine& operator=( const HttpAsyncEngine& copy ) = delete;
+
+            /** Queue a prepared request: the transfer starts as soon as
+                the thread picks it.
+              */
+            void submit( HttpAsyncRequestPtr request );
+
+        private:
+            void run( );
+
+            /** Refresh the OAuth2 token of a request on another thread
+                and submit the request again.
+              */
+            void refresh( HttpAsyncRequestPtr request );
+
+            /** Add a request to m_multi if its host has a free slot.
+              */
+            bool start( HttpAsyncRequestPtr request );
+            void finish( HttpAsyncRequestPtr request, CURLcode errCode );
+    };
+}
+
+#endif
@@ -29,10 +29,14 @@
 #include "http-session.hxx"
 
 #include <cctype>
+#include <climits>
+#include <cstdlib>
 #include <memory>
 #include <string>
-#include <assert.h>
+#include <thread>
 
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 #include <libxml/xpath.h>
@@ -40,12 +44,40 @@
 #include <libcmis/session-factory.hxx>
 #include <libcmis/xml-utils.hxx>
 
+#include "concurrency-limiter.hxx"
+#include "http-async.hxx"
 #include "oauth2-handler.hxx"
 
 using namespace std;
 
 namespace
 {
+    /** Delay in milliseconds requested by a Retry-After header, given
+        either in seconds or as an HTTP date, or -1 if there is none.
+      */
+    long lcl_parseRetryAfter( const string& value )
+    {
+        if ( value.empty( ) )
+            return -1;
+
+        if ( value.find_first_not_of( "0123456789" ) == string::npos )
+        {
+            long seconds = strtol( value.c_str( ), NULL, 10 );
+            return seconds > LONG_MAX / 1000 ? LONG_MAX : seconds * 1000;
+        }
+
+        istringstream is( value );
+        is.imbue( locale( locale::classic( ),
+                    new boost::posix_time::time_input_facet( "%a, %d %b %Y %H:%M:%S GMT" ) ) );
+        boost::posix_time::ptime date( boost::posix_time::not_a_date_time );
+        is >> date;
+        if ( date.is_not_a_date_time( ) )
+            return -1;
+
+        boost::posix_time::time_duration delay = date - boost::posix_time::second_clock::universal_time( );
+        return delay.is_negative( ) ? 0 : long( delay.total_milliseconds( ) );
+    }
+
     size_t lcl_getHeaders( void *ptr, size_t size, size_t nmemb, void *userdata )
     {
         libcmis::HttpResponse* response = static_cast< libcmis::HttpResponse* >( userdata );
@@ -63,6 +95,8 @@ namespace
 
             if ( "Content-Transfer-Encoding" == name )
                 response->getData( )->setEncoding( value );
+            else if ( boost::iequals( name, "Content-Length" ) )
+                response->reserveBody( strtoul( value.c_str( ), NULL, 10 ) );
         }
 
         return nmemb;
@@ -72,16 +106,19 @@ namespace
     {
         libcmis::EncodedData* encoded = static_cast< libcmis::EncodedData* >( data );
         encoded->decode( buffer, size, nmemb );
+
+        // Abort the transfer if the data can't be written
+        if ( encoded->hasFailed( ) )
+            return 0;
         return nmemb;
     }
 
     size_t lcl_readStream( void* buffer, size_t size, size_t nmemb, void* data )
     {
-        istream& is = *( static_cast< istream* >( data ) );
+        libcmis::HttpUploadBody* body = static_cast< libcmis::HttpUploadBody* >( data );
         char* out = ( char * ) buffer;
-        is.read( out, size * nmemb );
 
-        return is.gcount( ) / size;
+        return body->read( out, size * nmemb ) / size;
     }
 
 #if (LIBCURL_VERSION_MAJOR < 7) || (LIBCURL_VERSION_MAJOR == 7 && LIBCURL_VERSION_MINOR < 85)
@@ -93,11 +130,8 @@ namespace
         {
             case CURLIOCMD_RESTARTREAD:
                 {
-                    istream& is = *( static_cast< istream* >( data ) );
-                    is.clear( );
-                    is.seekg( 0, ios::beg );
-
-                    if ( !is.good() )
+                    libcmis::HttpUploadBody* body = static_cast< libcmis::HttpUploadBody* >( data );
+                    if ( !body->rewind( ) )
                     {
                         fprintf ( stderr, "rewind failed\n" );
                         errCode = CURLIOE_FAILRESTART;
@@ -115,18 +149,8 @@ namespace
 
     int lcl_seekStream(void* data, curl_off_t offset, int origin)
     {
-        std::ios_base::seekdir dir = {};
-        switch (origin)
-        {
-            case SEEK_SET: dir = std::ios_base::beg; break;
-            case SEEK_CUR: dir = std::ios_base::cur; break;
-            case SEEK_END: dir = std::ios_base::end; break;
-            default: assert(false); break;
-        }
-        istream& is = *(static_cast<istream*>(data));
-        is.clear();
-        is.seekg(offset, dir);
-        if (!is.good())
+        libcmis::HttpUploadBody* body = static_cast< libcmis::HttpUploadBody* >( data );
+        if (!body->seek(offset, origin))
         {
             fprintf(stderr, "rewind failed\n");
             return CURL_SEEKFUNC_FAIL;
@@ -134,6 +158,63 @@ namespace
         return CURL_SEEKFUNC_OK;
     }
 
+    void lcl_lockShare( CURL* /*handle*/, curl_lock_data data,
+                        curl_lock_access /*access*/, void* userptr )
+    {
+        libcmis::CurlShare* share = static_cast< libcmis::CurlShare* >( userptr );
+        if ( data < CURL_LOCK_DATA_LAST )
+            share->getLock( data ).lock( );
+    }
+
+    void lcl_unlockShare( CURL* /*handle*/, curl_lock_data data, void* userptr )
+    {
+        libcmis::CurlShare* share = static_cast< libcmis::CurlShare* >( userptr );
+        if ( data < CURL_LOCK_DATA_LAST )
+            share->getLock( data ).unlock( );
+    }
+
+    void lcl_setResponseCallbacks( CURL* handle, libcmis::HttpResponsePtr response )
+    {
+        curl_easy_setopt( handle, CURLOPT_WRITEFUNCTION, lcl_bufferData );
+        curl_easy_setopt( handle, CURLOPT_WRITEDATA, response->getData( ).get( ) );
+
+        curl_easy_setopt( handle, CURLOPT_HEADERFUNCTION, &lcl_getHeaders );
+        curl_easy_setopt( handle, CURLOPT_WRITEHEADER, response.get() );
+
+        // fix Cloudoku too many redirects error
+        // note: though curl doc says -1 is the default for MAXREDIRS, the error i got
+        // said it was 0
+        curl_easy_setopt( handle, CURLOPT_MAXREDIRS, 20);
+    }
+
+    /** Configure the handle to send the content of the stream with the
+        given method: POST, PUT or PATCH.
+      */
+    void lcl_setUploadOptions( CURL* handle, const string& method, libcmis::HttpUploadBody* body )
+    {
+        if ( method == "POST" )
+        {
+            curl_easy_setopt( handle, CURLOPT_POSTFIELDSIZE_LARGE, body->getSize( ) );
+            curl_easy_setopt( handle, CURLOPT_POST, 1 );
+        }
+        else
+        {
+            curl_easy_setopt( handle, CURLOPT_INFILESIZE_LARGE, body->getSize( ) );
+            curl_easy_setopt( handle, CURLOPT_UPLOAD, 1 );
+            if ( method != "PUT" )
+                curl_easy_setopt( handle, CURLOPT_CUSTOMREQUEST, method.c_str( ) );
+        }
+        curl_easy_setopt( handle, CURLOPT_READDATA, body );
+        curl_easy_setopt( handle, CURLOPT_READFUNCTION, lcl_readStream );
+#if (LIBCURL_VERSION_MAJOR > 7) || (LIBCURL_VERSION_MAJOR == 7 && LIBCURL_VERSION_MINOR >= 85)
+        curl_easy_setopt( handle, CURLOPT_SEEKFUNCTION, lcl_seekStream );
+        curl_easy_setopt( handle, CURLOPT_SEEKDATA, body );
+#else
+        curl_easy_setopt( handle, CURLOPT_IOCTLFUNCTION, lcl_ioctlStream );
+        curl_easy_setopt( handle, CURLOPT_IOCTLDATA, body );
+#endif
+    }
+
     template<typename T>
     class ScopeGuard
     {
@@ -175,6 +256,309 @@ void applyTransferLimits( CURL* curlHandle )
     curl_easy_setopt( curlHandle, CURLOPT_LOW_SPEED_TIME, LOW_SPEED_TIME_SECS );
 }
 
+void HttpValidators::update( HttpResponsePtr response )
+{
+    m_etag = response->getHeader( "ETag" );
+    m_lastModified = response->getHeader( "Last-Modified" );
+}
+
+void HttpValidators::clear( )
+{
+    m_etag.clear( );
+    m_lastModified.clear( );
+}
+
+vector< string > HttpValidators::getConditionalHeaders( ) const
+{
+    vector< string > headers;
+    if ( !m_etag.empty( ) )
+        headers.push_back( "If-None-Match: " + m_etag );
+    if ( !m_lastModified.empty( ) )
+        headers.push_back( "If-Modified-Since: " + m_lastModified );
+    return headers;
+}
+
+HttpRetryPolicy::HttpRetryPolicy( ) :
+    m_maxRetries( 0 ),
+    m_initialDelay( 500 ),
+    m_maxDelay( 30000 ),
+    m_retriesPerMinute( -1 ),
+    m_budget( 0 ),
+    m_budgetTime( chrono::steady_clock::now( ) ),
+    m_random( random_device( )( ) ),
+    m_mutex( )
+{
+}
+
+HttpRetryPolicy::HttpRetryPolicy( const HttpRetryPolicy& copy ) :
+    m_maxRetries( copy.m_maxRetries ),
+    m_initialDelay( copy.m_initialDelay ),
+    m_maxDelay( copy.m_maxDelay ),
+    m_retriesPerMinute( copy.m_retriesPerMinute ),
+    m_budget( copy.m_retriesPerMinute > 0 ? copy.m_retriesPerMinute : 0 ),
+    m_budgetTime( chrono::steady_clock::now( ) ),
+    m_random( random_device( )( ) ),
+    m_mutex( )
+{
+}
+
+HttpRetryPolicy& HttpRetryPolicy::operator=( const HttpRetryPolicy& copy )
+{
+    if ( this != &copy )
+        configure( copy.m_maxRetries, copy.m_initialDelay, copy.m_maxDelay, copy.m_retriesPerMinute );
+    return *this;
+}
+
+void HttpRetryPolicy::configure( unsigned int maxRetries, long initialDelay,
+                                 long maxDelay, long retriesPerMinute )
+{
+    lock_guard< mutex > lock( m_mutex );
+    m_maxRetries = maxRetries;
+    m_initialDelay = max( initialDelay, 0L );
+    m_maxDelay = max( maxDelay, m_initialDelay );
+    m_retriesPerMinute = retriesPerMinute;
+    m_budget = retriesPerMinute > 0 ? retriesPerMinute : 0;
+    m_budgetTime = chrono::steady_clock::now( );
+}
+
+long HttpRetryPolicy::getRetryDelay( const string& method, long status,
+                                     unsigned int attempt, HttpResponsePtr response )
+{
+    if ( ( status != 429 && status != 503 ) || !isIdempotent( method ) )
+        return -1;
+
+    lock_guard< mutex > lock( m_mutex );
+    if ( attempt >= m_maxRetries )
+        return -1;
+
+    // Don't come back before the server asked, but don't wait forever
+    long delay = lcl_parseRetryAfter( response ? response->getHeader( "Retry-After" ) : string( ) );
+    if ( delay > m_maxDelay )
+        return -1;
+
+    if ( delay < 0 )
+    {
+        // Exponential backoff: the random half of the delay keeps the
+        // throttled clients from all coming back at the same time.
+        long backoff = m_initialDelay;
+        for ( unsigned int i = 0; i < attempt && backoff < m_maxDelay; ++i )
+            backoff *= 2;
+        backoff = min( backoff, m_maxDelay );
+
+        uniform_int_distribution< long > jitter( 0, backoff / 2 );
+        delay = backoff - backoff / 2 + jitter( m_random );
+    }
+
+    if ( !consumeBudget( ) )
+        return -1;
+    return delay;
+}
+
+bool HttpRetryPolicy::isIdempotent( const string& method )
+{
+    return method == "GET" || method == "HEAD" || method == "PUT" ||
+           method == "DELETE" || method == "OPTIONS";
+}
+
+bool HttpRetryPolicy::consumeBudget( )
+{
+    if ( m_retriesPerMinute < 0 )
+        return true;
+
+    // Refill the budget for the time elapsed since it was last used
+    chrono::steady_clock::time_point now = chrono::steady_clock::now( );
+    double minutes = chrono::duration< double, ratio< 60 > >( now - m_budgetTime ).count( );
+    m_budget = min( double( m_retriesPerMinute ), m_budget + minutes * m_retriesPerMinute );
+    m_budgetTime = now;
+
+    if ( m_budget < 1.0 )
+        return false;
+    m_budget -= 1.0;
+    return true;
+}
+
+long getFirstByteLatency( CURL* curlHandle, chrono::steady_clock::time_point start )
+{
+    double firstByte = -1;
+    curl_easy_getinfo( curlHandle, CURLINFO_STARTTRANSFER_TIME, &firstByte );
+    if ( firstByte > 0 )
+        return long( firstByte * 1000 );
+    return long( chrono::duration_cast< chrono::milliseconds >( chrono::steady_clock::now( ) - start ).count( ) );
+}
+
+RequestMetrics getRequestMetrics( CURL* curlHandle, const string& method, const string& url )
+{
+    long status = 0;
+    double nameLookup = 0;
+    double connect = 0;
+    double appConnect = 0;
+    double startTransfer = 0;
+    double total = 0;
+    curl_easy_getinfo( curlHandle, CURLINFO_RESPONSE_CODE, &status );
+    curl_easy_getinfo( curlHandle, CURLINFO_NAMELOOKUP_TIME, &nameLookup );
+    curl_easy_getinfo( curlHandle, CURLINFO_CONNECT_TIME, &connect );
+    curl_easy_getinfo( curlHandle, CURLINFO_APPCONNECT_TIME, &appConnect );
+    curl_easy_getinfo( curlHandle, CURLINFO_STARTTRANSFER_TIME, &startTransfer );
+    curl_easy_getinfo( curlHandle, CURLINFO_TOTAL_TIME, &total );
+
+#if CURL_AT_LEAST_VERSION(7, 55, 0)
+    curl_off_t downloaded = 0;
+    curl_off_t uploaded = 0;
+    curl_easy_getinfo( curlHandle, CURLINFO_SIZE_DOWNLOAD_T, &downloaded );
+    curl_easy_getinfo( curlHandle, CURLINFO_SIZE_UPLOAD_T, &uploaded );
+#else
+    double downloaded = 0;
+    double uploaded = 0;
+    curl_easy_getinfo( curlHandle, CURLINFO_SIZE_DOWNLOAD, &downloaded );
+    curl_easy_getinfo( curlHandle, CURLINFO_SIZE_UPLOAD, &uploaded );
+#endif
+
+    // The parameters often hold object ids or tokens: leave them out
+    string urlTemplate = url.substr( 0, url.find_first_of( "?#" ) );
+
+    return RequestMetrics( method, urlTemplate, status, nameLookup, connect,
+                           appConnect, startTransfer, total,
+                           long( downloaded ), long( uploaded ) );
+}
+
+void reportRequestMetrics( const RequestMetrics& metrics, const ActiveSpanPtr& span )
+{
+    if ( span )
+        span->addRequest( metrics );
+
+    RequestObserverPtr observer = SessionFactory::getRequestObserver( );
+    if ( !observer )
+        return;
+
+    try
+    {
+        observer->requestDone( metrics );
+    }
+    catch ( ... )
+    {
+        // A broken observer mustn't fail the request
+    }
+}
+
+CurlShare::CurlShare( bool shareDns, bool shareSslSessions, bool shareConnections ) :
+    m_share( NULL ),
+    m_locks( new std::mutex[ CURL_LOCK_DATA_LAST ] )
+{
+    curl_global_init( CURL_GLOBAL_ALL );
+    m_share = curl_share_init( );
+    if ( NULL == m_share )
+        throw Exception( "Failed to create the shared connection cache" );
+
+    curl_share_setopt( m_share, CURLSHOPT_LOCKFUNC, &lcl_lockShare );
+    curl_share_setopt( m_share, CURLSHOPT_UNLOCKFUNC, &lcl_unlockShare );
+    curl_share_setopt( m_share, CURLSHOPT_USERDATA, this );
+
+    if ( shareDns )
+        curl_share_setopt( m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS );
+    if ( shareSslSessions )
+        curl_share_setopt( m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION );
+#if CURL_AT_LEAST_VERSION(7, 57, 0)
+    if ( shareConnections )
+        curl_share_setopt( m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT );
+#else
+    (void)shareConnections;
+#endif
+}
+
+CurlShare::~CurlShare( )
+{
+    // All the easy handles using the share have been cleaned up or
+    // detached by now: the sessions hold a reference on it.
+    curl_share_cleanup( m_share );
+}
+
+HttpUploadBody::HttpUploadBody( istream& is ) :
+    m_stream( &is ),
+    m_start( is.tellg( ) ),
+    m_size( 0 ),
+    m_spool( NULL )
+{
+    if ( m_start != streampos( -1 ) )
+    {
+        is.seekg( 0, ios::end );
+        streampos end = is.tellg( );
+        is.seekg( m_start );
+        if ( end != streampos( -1 ) && is.good( ) )
+        {
+            m_size = end - m_start;
+            return;
+        }
+        is.clear( );
+    }
+
+    // The stream can't seek: keep a copy of the body in a temporary file
+    // to be able to send it again.
+    m_spool = tmpfile( );
+    if ( NULL == m_spool )
+        throw Exception( "Failed to create a temporary file for the request body" );
+
+    char buf[8192];
+    do
+    {
+        is.read( buf, sizeof( buf ) );
+        size_t read = is.gcount( );
+        if ( fwrite( buf, 1, read, m_spool ) != read )
+        {
+            fclose( m_spool );
+            throw Exception( "Failed to write the request body to a temporary file" );
+        }
+        m_size += read;
+    } while ( is.good( ) );
+    ::rewind( m_spool );
+}
+
+HttpUploadBody::~HttpUploadBody( )
+{
+    if ( NULL != m_spool )
+        fclose( m_spool );
+    else
+    {
+        m_stream->clear( );
+        m_stream->seekg( m_start );
+    }
+}
+
+size_t HttpUploadBody::read( char* buffer, size_t length )
+{
+    if ( NULL != m_spool )
+        return fread( buffer, 1, length, m_spool );
+
+    m_stream->read( buffer, length );
+    return m_stream->gcount( );
+}
+
+bool HttpUploadBody::seek( curl_off_t offset, int origin )
+{
+    curl_off_t position = offset;
+    if ( SEEK_END == origin )
+        position += m_size;
+    else if ( SEEK_CUR == origin )
+    {
+        if ( NULL != m_spool )
+            position += ftell( m_spool );
+        else
+        {
+            m_stream->clear( );
+            position += curl_off_t( m_stream->tellg( ) - m_start );
+        }
+    }
+
+    if ( position < 0 || position > m_size )
+        return false;
+
+    if ( NULL != m_spool )
+        return fseek( m_spool, long( position ), SEEK_SET ) == 0;
+
+    m_stream->clear( );
+    m_stream->seekg( m_start + streamoff( position ) );
+    return m_stream->good( );
+}
+
 }
 
 HttpSession::HttpSession( string username, string password, bool noSslCheck,
@@ -182,7 +566,10 @@ HttpSession::HttpSession( string username, string password, bool noSslCheck,
                           libcmis::CurlInitProtocolsFunction initProtocolsFunction) :
     m_curlHandle( NULL ),
     m_CurlInitProtocolsFunction(initProtocolsFunction),
+    m_curlShare( ),
     m_no100Continue( false ),
+    m_requestMutex( ),
+    m_asyncEngine( ),
     m_oauth2Handler( ),
     m_username( username ),
     m_password( password ),
@@ -190,12 +577,15 @@ HttpSession::HttpSession( string username, string password, bool noSslCheck,
     m_verbose( verbose ),
     m_noHttpErrors( false ),
     m_noSSLCheck( noSslCheck ),
-    m_refreshedToken( false ),
     m_inOAuth2Authentication( false ),
+    m_compressResponses( true ),
+    m_retryPolicy( ),
+    m_statistics( ),
     m_authMethod( CURLAUTH_ANY )
 {
     curl_global_init( CURL_GLOBAL_ALL );
     m_curlHandle = curl_easy_init( );
+    attachConnectionCache( );
 
     if ( oauth2 && oauth2->isComplete( ) ){
         setOAuth2Data( oauth2 );
@@ -205,7 +595,10 @@ HttpSession::HttpSession( string username, string password, bool noSslCheck,
 HttpSession::HttpSession( const HttpSession& copy ) :
     m_curlHandle( NULL ),
     m_CurlInitProtocolsFunction( copy.m_CurlInitProtocolsFunction ),
-    m_no100Continue( copy.m_no100Continue ),
+    m_curlShare( ),
+    m_no100Continue( copy.m_no100Continue.load( ) ),
+    m_requestMutex( ),
+    m_asyncEngine( ),
     m_oauth2Handler( copy.m_oauth2Handler ?
                      new OAuth2Handler( this, *copy.m_oauth2Handler ) :
                      nullptr ),
@@ -215,18 +608,26 @@ HttpSession::HttpSession( const HttpSession& copy ) :
     m_verbose( copy.m_verbose ),
     m_noHttpErrors( copy.m_noHttpErrors ),
     m_noSSLCheck( copy.m_noSSLCheck ),
-    m_refreshedToken( false ),
     m_inOAuth2Authentication( false ),
+    m_compressResponses( copy.m_compressResponses ),
+    m_retryPolicy( copy.m_retryPolicy ),
+    m_statistics( ),
     m_authMethod( copy.m_authMethod )
 {
-    // Not sure how sharing curl handles is safe.
+    // Not sure how sharing curl handles is safe, but the connection
+    // cache can be shared: this is what saves the connection of the
+    // session probing the binding in SessionFactory.
     curl_global_init( CURL_GLOBAL_ALL );
     m_curlHandle = curl_easy_init( );
+    attachConnectionCache( );
 }
 
 HttpSession::HttpSession( ) :
     m_curlHandle( NULL ),
+    m_curlShare( ),
     m_no100Continue( false ),
+    m_requestMutex( ),
+    m_asyncEngine( ),
     m_oauth2Handler( ),
     m_username( ),
     m_password( ),
@@ -234,22 +635,29 @@ HttpSession::HttpSession( ) :
     m_verbose( false ),
     m_noHttpErrors( false ),
     m_noSSLCheck( false ),
-    m_refreshedToken( false ),
     m_inOAuth2Authentication( false ),
+    m_compressResponses( true ),
+    m_retryPolicy( ),
+    m_statistics( ),
     m_authMethod( CURLAUTH_ANY )
 {
     curl_global_init( CURL_GLOBAL_ALL );
     m_curlHandle = curl_easy_init( );
+    attachConnectionCache( );
 }
 
 HttpSession& HttpSession::operator=( const HttpSession& copy )
 {
     if ( this != &copy )
     {
+        // The pending asynchronous requests were for the old settings
+        m_asyncEngine.reset( );
+
         curl_easy_cleanup( m_curlHandle );
         m_curlHandle = NULL;
+        m_curlShare.reset( );
         m_CurlInitProtocolsFunction = copy.m_CurlInitProtocolsFunction;
-        m_no100Continue = copy.m_no100Continue;
+        m_no100Continue = copy.m_no100Continue.load( );
         m_oauth2Handler.reset( copy.m_oauth2Handler ?
                                new OAuth2Handler( this, *copy.m_oauth2Handler ) :
                                nullptr );
@@ -259,13 +667,15 @@ HttpSession& HttpSession::operator=( const HttpSession& copy )
         m_verbose = copy.m_verbose;
         m_noHttpErrors = copy.m_noHttpErrors;
         m_noSSLCheck = copy.m_noSSLCheck;
-        m_refreshedToken = copy.m_refreshedToken;
         m_inOAuth2Authentication = copy.m_inOAuth2Authentication;
+        m_compressResponses = copy.m_compressResponses;
+        m_retryPolicy = copy.m_retryPolicy;
         m_authMethod = copy.m_authMethod;
 
         // Not sure how sharing curl handles is safe.
         curl_global_init( CURL_GLOBAL_ALL );
         m_curlHandle = curl_easy_init( );
+        attachConnectionCache( );
     }
 
     return *this;
@@ -273,6 +683,9 @@ HttpSession& HttpSession::operator=( const HttpSession& copy )
 
 HttpSession::~HttpSession( )
 {
+    // Stop the thread before it can use anything being destroyed
+    stopAsyncRequests( );
+
     if ( NULL != m_curlHandle )
         curl_easy_cleanup( m_curlHandle );
 }
@@ -291,383 +704,229 @@ string& HttpSession::getPassword( )
 
 libcmis::HttpResponsePtr HttpSession::httpGetRequest( string url )
 {
-    checkOAuth2( url );
-
-    // Reset the handle for the request
-    curl_easy_reset( m_curlHandle );
-    initProtocols( );
-
-    libcmis::HttpResponsePtr response( new libcmis::HttpResponse( ) );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEFUNCTION, lcl_bufferData );
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEDATA, response->getData( ).get( ) );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_HEADERFUNCTION, &lcl_getHeaders );
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEHEADER, response.get() );
-
-    // fix Cloudoku too many redirects error
-    // note: though curl doc says -1 is the default for MAXREDIRS, the error i got
-    // said it was 0
-    curl_easy_setopt( m_curlHandle, CURLOPT_MAXREDIRS, 20);
-
-    try
-    {
-        httpRunRequest( url );
-        response->getData( )->finish( );
-    }
-    catch ( const CurlException& )
-    {
-        // If the access token is expired, we get 401 error,
-        // Need to use the refresh token to get a new one.
-        if ( getHttpStatus( ) == 401 && !getRefreshToken( ).empty( ) && !m_refreshedToken )
-        {
-            // Refresh the token
-            oauth2Refresh();
-
-            // Resend the query
-            try
-            {
-                // Avoid infinite recursive call
-                m_refreshedToken = true;
-                response = httpGetRequest( url );
-                m_refreshedToken = false;
-            }
-            catch (const CurlException& )
-            {
-                throw;
-            }
-            m_refreshedToken = false;
-        }
-        else throw;
-    }
-    m_refreshedToken = false;
-
-    return response;
+    return httpGetRequest( url, boost::shared_ptr< libcmis::EncodedData >( ) );
 }
 
-libcmis::HttpResponsePtr HttpSession::httpPatchRequest( string url, istream& is, vector< string > headers )
+libcmis::HttpResponsePtr HttpSession::httpGetRequest( string url,
+        boost::shared_ptr< libcmis::EncodedData > sink, vector< string > headers )
 {
-    checkOAuth2( url );
-
-    // Duplicate istream in case we need to retry
-    string isStr( static_cast< stringstream const&>( stringstream( ) << is.rdbuf( ) ).str( ) );
-
-    istringstream isOriginal( isStr ), isBackup( isStr );
-
-    // Reset the handle for the request
-    curl_easy_reset( m_curlHandle );
-    initProtocols( );
-
-    libcmis::HttpResponsePtr response( new libcmis::HttpResponse( ) );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEFUNCTION, lcl_bufferData );
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEDATA, response->getData( ).get( ) );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_HEADERFUNCTION, &lcl_getHeaders );
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEHEADER, response.get() );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_MAXREDIRS, 20);
-
-    // Get the stream length
-    is.seekg( 0, ios::end );
-    long size = is.tellg( );
-    is.seekg( 0, ios::beg );
-    curl_easy_setopt( m_curlHandle, CURLOPT_INFILESIZE, size );
-    curl_easy_setopt( m_curlHandle, CURLOPT_READDATA, &isOriginal );
-    curl_easy_setopt( m_curlHandle, CURLOPT_READFUNCTION, lcl_readStream );
-    curl_easy_setopt( m_curlHandle, CURLOPT_UPLOAD, 1 );
-    curl_easy_setopt( m_curlHandle, CURLOPT_CUSTOMREQUEST, "PATCH" );
-#if (LIBCURL_VERSION_MAJOR > 7) || (LIBCURL_VERSION_MAJOR == 7 && LIBCURL_VERSION_MINOR >= 85)
-    curl_easy_setopt( m_curlHandle, CURLOPT_SEEKFUNCTION, lcl_seekStream );
-    curl_easy_setopt( m_curlHandle, CURLOPT_SEEKDATA, &isOriginal );
-#else
-    curl_easy_setopt( m_curlHandle, CURLOPT_IOCTLFUNCTION, lcl_ioctlStream );
-    curl_easy_setopt( m_curlHandle, CURLOPT_IOCTLDATA, &isOriginal );
-#endif
+    // The content isn't kept in memory when written to the sink
+    libcmis::HttpRequestOptions options;
+    options.m_unboundedResponse = bool( sink );
+    long status = 0;
+    return httpGetRequest( url, sink, headers, options, status );
+}
 
-    // If we know for sure that 100-Continue won't be accepted,
-    // don't even try with it to save one HTTP request.
-    if ( m_no100Continue )
-        headers.push_back( "Expect:" );
-    try
-    {
-        httpRunRequest( url, headers );
-        response->getData( )->finish();
-    }
-    catch ( const CurlException& )
+libcmis::HttpResponsePtr HttpSession::httpGetRequest( const string& url,
+        boost::shared_ptr< libcmis::EncodedData > sink, const vector< string >& headers,
+        const libcmis::HttpRequestOptions& options, long& status )
+{
+    bool refreshedToken = false;
+    for ( unsigned int attempt = 0; ; )
     {
-        long status = getHttpStatus( );
-        /** If we had a HTTP 417 response, this is likely to be due to some
-            HTTP 1.0 proxy / server not accepting the "Expect: 100-continue"
-            header. Try to disable this header and try again.
-        */
-        if ( status == 417 && !m_no100Continue)
+        long delay = 0;
         {
-            // Remember that we don't want 100-Continue for the future requests
-            m_no100Continue = true;
-            response = httpPutRequest( url, isBackup, headers );
-        }
+            lock_guard< recursive_mutex > lock( m_requestMutex );
+            checkOAuth2( url );
 
-        // If the access token is expired, we get 401 error,
-        // Need to use the refresh token to get a new one.
-        if ( status == 401 && !getRefreshToken( ).empty( ) && !m_refreshedToken )
-        {
+            // Reset the handle for the request
+            curl_easy_reset( m_curlHandle );
+            initProtocols( );
 
-            // Refresh the token
-            oauth2Refresh();
+            libcmis::HttpResponsePtr response( sink ?
+                    new libcmis::HttpResponse( sink ) :
+                    new libcmis::HttpResponse( ) );
+            lcl_setResponseCallbacks( m_curlHandle, response );
 
-            // Resend the query
             try
             {
-                // Avoid infinite recursive call
-                m_refreshedToken = true;
-                response = httpPutRequest( url, isBackup, headers );
-                m_refreshedToken = false;
+                httpRunRequest( url, headers, true, "GET", options );
+                response->getData( )->finish( );
+                status = getHttpStatus( );
+                return response;
             }
-            catch (const CurlException&)
+            catch ( const CurlException& )
             {
-                m_refreshedToken = false;
-                throw;
+                // If the access token is expired, we get 401 error,
+                // Need to use the refresh token to get a new one.
+                if ( getHttpStatus( ) == 401 && !getRefreshToken( ).empty( ) && !refreshedToken )
+                {
+                    oauth2Refresh( );
+                    refreshedToken = true;
+                    continue;
+                }
+
+                // The server is throttling us: try again later
+                delay = getRetryDelay( "GET", attempt++, response );
+                if ( delay < 0 )
+                    throw;
             }
         }
-        // Has tried but failed
-        if ( ( status != 417 || m_no100Continue ) &&
-             ( status != 401 || getRefreshToken( ).empty( ) || m_refreshedToken ) ) throw;
+
+        // Let the other threads use the session while waiting
+        this_thread::sleep_for( chrono::milliseconds( delay ) );
     }
-    m_refreshedToken = false;
-    return response;
 }
 
-libcmis::HttpResponsePtr HttpSession::httpPutRequest( string url, istream& is, vector< string > headers )
+libcmis::HttpResponsePtr HttpSession::httpGetContentRequest( string url,
+        boost::shared_ptr< libcmis::EncodedData > sink )
 {
-    checkOAuth2( url );
-
-    // Duplicate istream in case we need to retry
-    string isStr( static_cast< stringstream const&>( stringstream( ) << is.rdbuf( ) ).str( ) );
-
-    istringstream isOriginal( isStr ), isBackup( isStr );
-
-    // Reset the handle for the request
-    curl_easy_reset( m_curlHandle );
-    initProtocols( );
-
-    libcmis::HttpResponsePtr response( new libcmis::HttpResponse( ) );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEFUNCTION, lcl_bufferData );
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEDATA, response->getData( ).get( ) );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_HEADERFUNCTION, &lcl_getHeaders );
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEHEADER, response.get() );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_MAXREDIRS, 20);
+    libcmis::HttpRequestOptions options;
+    options.m_unboundedResponse = bool( sink );
+    options.m_contentRequest = true;
+    long status = 0;
+    return httpGetRequest( url, sink, vector< string >( ), options, status );
+}
 
-    // Get the stream length
-    is.seekg( 0, ios::end );
-    long size = is.tellg( );
-    is.seekg( 0, ios::beg );
-    curl_easy_setopt( m_curlHandle, CURLOPT_INFILESIZE, size );
-    curl_easy_setopt( m_curlHandle, CURLOPT_READDATA, &isOriginal );
-    curl_easy_setopt( m_curlHandle, CURLOPT_READFUNCTION, lcl_readStream );
-    curl_easy_setopt( m_curlHandle, CURLOPT_UPLOAD, 1 );
-#if (LIBCURL_VERSION_MAJOR > 7) || (LIBCURL_VERSION_MAJOR == 7 && LIBCURL_VERSION_MINOR >= 85)
-    curl_easy_setopt( m_curlHandle, CURLOPT_SEEKFUNCTION, lcl_seekStream );
-    curl_easy_setopt( m_curlHandle, CURLOPT_SEEKDATA, &isOriginal );
-#else
-    curl_easy_setopt( m_curlHandle, CURLOPT_IOCTLFUNCTION, lcl_ioctlStream );
-    curl_easy_setopt( m_curlHandle, CURLOPT_IOCTLDATA, &isOriginal );
-#endif
+libcmis::HttpResponsePtr HttpSession::httpConditionalGetRequest( string url,
+        libcmis::HttpValidators& validators )
+{
+    long status = 0;
+    libcmis::HttpResponsePtr response = httpGetRequest( url,
+            boost::shared_ptr< libcmis::EncodedData >( ),
+            validators.getConditionalHeaders( ), libcmis::HttpRequestOptions( ), status );
 
-    // If we know for sure that 100-Continue won't be accepted,
-    // don't even try with it to save one HTTP request.
-    if ( m_no100Continue )
-        headers.push_back( "Expect:" );
-    try
-    {
-        httpRunRequest( url, headers );
-        response->getData( )->finish();
-    }
-    catch ( const CurlException& )
-    {
-        long status = getHttpStatus( );
-        /** If we had a HTTP 417 response, this is likely to be due to some
-            HTTP 1.0 proxy / server not accepting the "Expect: 100-continue"
-            header. Try to disable this header and try again.
-        */
-        if ( status == 417 && !m_no100Continue)
-        {
-            // Remember that we don't want 100-Continue for the future requests
-            m_no100Continue = true;
-            response = httpPutRequest( url, isBackup, headers );
-        }
+    if ( status == 304 )
+        return libcmis::HttpResponsePtr( );
 
-        // If the access token is expired, we get 401 error,
-        // Need to use the refresh token to get a new one.
-        if ( status == 401 && !getRefreshToken( ).empty( ) && !m_refreshedToken )
-        {
+    validators.update( response );
+    return response;
+}
 
-            // Refresh the token
-            oauth2Refresh();
+libcmis::HttpResponsePtr HttpSession::httpPatchRequest( string url, istream& is, vector< string > headers )
+{
+    libcmis::HttpUploadBody body( is );
+    return httpUploadRequest( "PATCH", url, body, headers, true );
+}
 
-            // Resend the query
-            try
-            {
-                // Avoid infinite recursive call
-                m_refreshedToken = true;
-                response = httpPutRequest( url, isBackup, headers );
-                m_refreshedToken = false;
-            }
-            catch (const CurlException& )
-            {
-                m_refreshedToken = false;
-                throw;
-            }
-        }
-        // Has tried but failed
-        if ( ( status != 417 || m_no100Continue ) &&
-             ( status != 401 || getRefreshToken( ).empty( ) || m_refreshedToken ) ) throw;
-    }
-    m_refreshedToken = false;
-    return response;
+libcmis::HttpResponsePtr HttpSession::httpPutRequest( string url, istream& is, vector< string > headers )
+{
+    libcmis::HttpUploadBody body( is );
+    return httpUploadRequest( "PUT", url, body, headers, true );
 }
 
 libcmis::HttpResponsePtr HttpSession::httpPostRequest( const string& url, istream& is,
     const string& contentType, bool redirect )
 {
-    checkOAuth2( url );
-
-    // Duplicate istream in case we need to retry
-    string isStr( static_cast< stringstream const&>( stringstream( ) << is.rdbuf( ) ).str( ) );
-
-    istringstream isOriginal( isStr ), isBackup( isStr );
-
-    // Reset the handle for the request
-    curl_easy_reset( m_curlHandle );
-    initProtocols( );
-
-    libcmis::HttpResponsePtr response( new libcmis::HttpResponse( ) );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEFUNCTION, lcl_bufferData );
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEDATA, response->getData( ).get( ) );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_HEADERFUNCTION, &lcl_getHeaders );
-    curl_easy_setopt( m_curlHandle, CURLOPT_WRITEHEADER, response.get() );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_MAXREDIRS, 20);
-
-    // Get the stream length
-    is.seekg( 0, ios::end );
-    long size = is.tellg( );
-    is.seekg( 0, ios::beg );
-    curl_easy_setopt( m_curlHandle, CURLOPT_POSTFIELDSIZE, size );
-    curl_easy_setopt( m_curlHandle, CURLOPT_READDATA, &isOriginal );
-    curl_easy_setopt( m_curlHandle, CURLOPT_READFUNCTION, lcl_readStream );
-    curl_easy_setopt( m_curlHandle, CURLOPT_POST, 1 );
-#if (LIBCURL_VERSION_MAJOR > 7) || (LIBCURL_VERSION_MAJOR == 7 && LIBCURL_VERSION_MINOR >= 85)
-    curl_easy_setopt( m_curlHandle, CURLOPT_SEEKFUNCTION, lcl_seekStream );
-    curl_easy_setopt( m_curlHandle, CURLOPT_SEEKDATA, &isOriginal );
-#else
-    curl_easy_setopt( m_curlHandle, CURLOPT_IOCTLFUNCTION, lcl_ioctlStream );
-    curl_easy_setopt( m_curlHandle, CURLOPT_IOCTLDATA, &isOriginal );
-#endif
+    libcmis::HttpUploadBody body( is );
 
     vector< string > headers;
     headers.push_back( string( "Content-Type:" ) + contentType );
 
-    // If we know for sure that 100-Continue won't be accepted,
-    // don't even try with it to save one HTTP request.
-    if ( m_no100Continue )
-        headers.push_back( "Expect:" );
-    try
-    {
-        httpRunRequest( url, headers, redirect );
-        response->getData( )->finish();
-    }
-    catch ( const CurlException& )
-    {
-
-        long status = getHttpStatus( );
-        /** If we had a HTTP 417 response, this is likely to be due to some
-            HTTP 1.0 proxy / server not accepting the "Expect: 100-continue"
-            header. Try to disable this header and try again.
-        */
-        if ( status == 417 && !m_no100Continue )
-        {
-            // Remember that we don't want 100-Continue for the future requests
-            m_no100Continue = true;
-            response = httpPostRequest( url, isBackup, contentType, redirect );
-        }
+    return httpUploadRequest( "POST", url, body, headers, redirect );
+}
 
-        // If the access token is expired, we get 401 error,
-        // Need to use the refresh token to get a new one.
-        if ( status == 401 && !getRefreshToken( ).empty( ) && !m_refreshedToken )
+libcmis::HttpResponsePtr HttpSession::httpUploadRequest( const string& method, const string& url,
+    libcmis::HttpUploadBody& body, const vector< string >& headers, bool redirect )
+{
+    bool refreshedToken = false;
+    for ( unsigned int attempt = 0; ; )
+    {
+        long delay = 0;
         {
-            // Refresh the token
-            oauth2Refresh();
-
-            // Resend the query
+            lock_guard< recursive_mutex > lock( m_requestMutex );
+            checkOAuth2( url );
+
+            // Reset the handle for the request
+            curl_easy_reset( m_curlHandle );
+            initProtocols( );
+
+            libcmis::HttpResponsePtr response( new libcmis::HttpResponse( ) );
+            lcl_setResponseCallbacks( m_curlHandle, response );
+            lcl_setUploadOptions( m_curlHandle, method, &body );
+
+            // If we know for sure that 100-Continue won't be accepted,
+            // don't even try with it to save one HTTP request.
+            vector< string > requestHeaders( headers );
+            if ( m_no100Continue )
+                requestHeaders.push_back( "Expect:" );
             try
             {
-                // Avoid infinite recursive call
-                m_refreshedToken = true;
-                response = httpPostRequest( url, isBackup, contentType, redirect );
-                m_refreshedToken = false;
+                httpRunRequest( url, requestHeaders, redirect, method );
+                response->getData( )->finish();
+                return response;
             }
-            catch (const CurlException& )
+            catch ( const CurlException& )
             {
-                m_refreshedToken = false;
-                throw;
+                long status = getHttpStatus( );
+                /** If we had a HTTP 417 response, this is likely to be due to some
+                    HTTP 1.0 proxy / server not accepting the "Expect: 100-continue"
+                    header. Try to disable this header and try again.
+                */
+                if ( status == 417 && !m_no100Continue && body.rewind( ) )
+                {
+                    // Remember that we don't want 100-Continue for the future requests
+                    m_no100Continue = true;
+                    continue;
+                }
+
+                // If the access token is expired, we get 401 error,
+                // Need to use the refresh token to get a new one.
+                if ( status == 401 && !getRefreshToken( ).empty( ) && !refreshedToken &&
+                     body.rewind( ) )
+                {
+                    oauth2Refresh( );
+                    refreshedToken = true;
+                    continue;
+                }
+
+                // The server is throttling us: try again later
+                delay = getRetryDelay( method, attempt++, response );
+                if ( delay < 0 || !body.rewind( ) )
+                    throw;
             }
         }
 
-        // Has tried but failed
-        if ( ( status != 417 || m_no100Continue ) &&
-             ( status != 401 || getRefreshToken( ).empty( ) || m_refreshedToken ) ) throw;
+        // Let the other threads use the session while waiting
+        this_thread::sleep_for( chrono::milliseconds( delay ) );
     }
-    m_refreshedToken = false;
-
-    return response;
 }
 
 void HttpSession::httpDeleteRequest( string url )
 {
-    checkOAuth2( url );
-
-    // Reset the handle for the request
-    curl_easy_reset( m_curlHandle );
-    initProtocols( );
-
-    curl_easy_setopt( m_curlHandle, CURLOPT_CUSTOMREQUEST, "DELETE" );
-    try
-    {
-        httpRunRequest( url );
-    }
-    catch ( const CurlException& )
+    bool refreshedToken = false;
+    for ( unsigned int attempt = 0; ; )
     {
-        // If the access token is expired, we get 401 error,
-        // Need to use the refresh token to get a new one.
-        if ( getHttpStatus( ) == 401 && !getRefreshToken( ).empty( ) && !m_refreshedToken )
+        long delay = 0;
         {
+            lock_guard< recursive_mutex > lock( m_requestMutex );
+            checkOAuth2( url );
 
-            // Refresh the token
-            oauth2Refresh();
+            // Reset the handle for the request
+            curl_easy_reset( m_curlHandle );
+            initProtocols( );
 
-            // Resend the query
+            // Only the headers matter, for the Retry-After one
+            libcmis::HttpResponsePtr response( new libcmis::HttpResponse( ) );
+            lcl_setResponseCallbacks( m_curlHandle, response );
+
+            curl_easy_setopt( m_curlHandle, CURLOPT_CUSTOMREQUEST, "DELETE" );
             try
             {
-                // Avoid infinite recursive call
-                m_refreshedToken = true;
-                httpDeleteRequest( url );
-                m_refreshedToken = false;
+                httpRunRequest( url, vector< string >( ), true, "DELETE" );
+                return;
             }
-            catch (const CurlException& )
+            catch ( const CurlException& )
             {
-                m_refreshedToken = false;
-                throw;
+                // If the access token is expired, we get 401 error,
+                // Need to use the refresh token to get a new one.
+                if ( getHttpStatus( ) == 401 && !getRefreshToken( ).empty( ) && !refreshedToken )
+                {
+                    oauth2Refresh( );
+                    refreshedToken = true;
+                    continue;
+                }
+
+                // The server is throttling us: try again later
+                delay = getRetryDelay( "DELETE", attempt++, response );
+                if ( delay < 0 )
+                    throw;
             }
         }
-        else throw;
+
+        // Let the other threads use the session while waiting
+        this_thread::sleep_for( chrono::milliseconds( delay ) );
     }
-    m_refreshedToken = false;
 }
 
 void HttpSession::checkCredentials( )
@@ -684,26 +943,74 @@ void HttpSession::checkCredentials( )
     }
 }
 
-void HttpSession::httpRunRequest( string url, vector< string > headers, bool redirect )
+void HttpSession::httpRunRequest( string url, vector< string > headers, bool redirect,
+        const string& method, const libcmis::HttpRequestOptions& options )
+{
+    attachConnectionCache( );
+
+    char errBuff[CURL_ERROR_SIZE];
+    libcmis::CurlSlistPtr headersList = prepareRequest( m_curlHandle, url, headers, redirect,
+                                                        errBuff, options );
+
+    // Don't send more requests at once than the host can take
+    libcmis::ConcurrencyLimiterPtr limiter = libcmis::ConcurrencyLimiter::get( url );
+    if ( limiter )
+        limiter->acquire( );
+    chrono::steady_clock::time_point start = chrono::steady_clock::now( );
+
+    // Perform the query
+    CURLcode errCode = curl_easy_perform( m_curlHandle );
+
+    if ( limiter )
+    {
+        long status = 0;
+        curl_easy_getinfo( m_curlHandle, CURLINFO_RESPONSE_CODE, &status );
+        limiter->release( libcmis::getFirstByteLatency( m_curlHandle, start ), status == 429 || status == 503 );
+    }
+    libcmis::RequestMetrics metrics = libcmis::getRequestMetrics( m_curlHandle, method, url );
+    m_statistics.addRequest( metrics );
+    libcmis::reportRequestMetrics( metrics, libcmis::TraceScope::getCurrentSpan( ) );
+
+    // Process the response
+    bool isHttpError = errCode == CURLE_HTTP_RETURNED_ERROR;
+    if ( CURLE_OK != errCode && !( m_noHttpErrors && isHttpError ) )
+    {
+        long httpError = 0;
+        curl_easy_getinfo( m_curlHandle, CURLINFO_RESPONSE_CODE, &httpError );
+
+        bool errorFixed = false;
+        // If we had a bad certificate, then try to get more details
+        if ( CURLE_SSL_CACERT == errCode )
+            handleSslCacertRecovery( errBuff, errCode, httpError, isHttpError, errorFixed );
+
+        if ( !errorFixed )
+            throw CurlException( string( errBuff ), errCode, url, httpError );
+    }
+}
+
+libcmis::CurlSlistPtr HttpSession::prepareRequest( CURL* handle, const string& url,
+        vector< string > headers, bool redirect, char* errBuff,
+        const libcmis::HttpRequestOptions& options )
 {
     libcmis::rejectControlChars( url, "URL" );
     for ( vector< string >::const_iterator it = headers.begin( ); it != headers.end( ); ++it )
         libcmis::rejectControlChars( *it, "header" );
 
-    libcmis::applyTransferLimits( m_curlHandle );
+    libcmis::applyTransferLimits( handle );
+    if ( options.m_unboundedResponse )
+        curl_easy_setopt( handle, CURLOPT_MAXFILESIZE_LARGE, curl_off_t( 0 ) );
 
     // Redirect
-    curl_easy_setopt( m_curlHandle, CURLOPT_FOLLOWLOCATION, redirect);
+    curl_easy_setopt( handle, CURLOPT_FOLLOWLOCATION, redirect);
 
     // Activate the cookie engine
-    curl_easy_setopt( m_curlHandle, CURLOPT_COOKIEFILE, "" );
+    curl_easy_setopt( handle, CURLOPT_COOKIEFILE, "" );
 
     // Grab something from the web
-    curl_easy_setopt( m_curlHandle, CURLOPT_URL, url.c_str() );
+    curl_easy_setopt( handle, CURLOPT_URL, url.c_str() );
 
     // Set the headers
-    struct deleter { void operator()(curl_slist* p) const { curl_slist_free_all(p); } };
-    unique_ptr<struct curl_slist, deleter> headers_slist;
+    libcmis::CurlSlistPtr headers_slist;
     for ( vector< string >::iterator it = headers.begin( ); it != headers.end( ); ++it )
         headers_slist.reset(curl_slist_append(headers_slist.release(), it->c_str()));
 
@@ -720,65 +1027,233 @@ void HttpSession::httpRunRequest( string url, vector< string > headers, bool red
     {
         libcmis::rejectControlChars( getUsername(), "username" );
         libcmis::rejectControlChars( getPassword(), "password" );
-        curl_easy_setopt( m_curlHandle, CURLOPT_HTTPAUTH, m_authMethod );
-        curl_easy_setopt( m_curlHandle, CURLOPT_USERNAME, getUsername().c_str() );
-        curl_easy_setopt( m_curlHandle, CURLOPT_PASSWORD, getPassword().c_str() );
+        curl_easy_setopt( handle, CURLOPT_HTTPAUTH, m_authMethod );
+        curl_easy_setopt( handle, CURLOPT_USERNAME, getUsername().c_str() );
+        curl_easy_setopt( handle, CURLOPT_PASSWORD, getPassword().c_str() );
     }
 
-    curl_easy_setopt(m_curlHandle, CURLOPT_HTTPHEADER, headers_slist.get());
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headers_slist.get());
 
     // Set the proxy configuration if any
     if ( !libcmis::SessionFactory::getProxy( ).empty() )
     {
-        curl_easy_setopt( m_curlHandle, CURLOPT_PROXY, libcmis::SessionFactory::getProxy( ).c_str() );
-        curl_easy_setopt( m_curlHandle, CURLOPT_NOPROXY, libcmis::SessionFactory::getNoProxy( ).c_str() );
+        curl_easy_setopt( handle, CURLOPT_PROXY, libcmis::SessionFactory::getProxy( ).c_str() );
+        curl_easy_setopt( handle, CURLOPT_NOPROXY, libcmis::SessionFactory::getNoProxy( ).c_str() );
         const string& proxyUser = libcmis::SessionFactory::getProxyUser( );
         const string& proxyPass = libcmis::SessionFactory::getProxyPass( );
         if ( !proxyUser.empty( ) && !proxyPass.empty( ) )
         {
-            curl_easy_setopt( m_curlHandle, CURLOPT_PROXYAUTH, CURLAUTH_ANY );
-            curl_easy_setopt( m_curlHandle, CURLOPT_PROXYUSERNAME, proxyUser.c_str( ) );
-            curl_easy_setopt( m_curlHandle, CURLOPT_PROXYPASSWORD, proxyPass.c_str( ) );
+            curl_easy_setopt( handle, CURLOPT_PROXYAUTH, CURLAUTH_ANY );
+            curl_easy_setopt( handle, CURLOPT_PROXYUSERNAME, proxyUser.c_str( ) );
+            curl_easy_setopt( handle, CURLOPT_PROXYPASSWORD, proxyPass.c_str( ) );
         }
     }
 
     // Get some feedback when something wrong happens
-    char errBuff[CURL_ERROR_SIZE];
     errBuff[0] = 0;
-    curl_easy_setopt( m_curlHandle, CURLOPT_ERRORBUFFER, errBuff );
+    curl_easy_setopt( handle, CURLOPT_ERRORBUFFER, errBuff );
 
     // We want to get the response even if there is an Http error
     if ( !m_noHttpErrors )
-        curl_easy_setopt( m_curlHandle, CURLOPT_FAILONERROR, 1 );
+        curl_easy_setopt( handle, CURLOPT_FAILONERROR, 1 );
 
     if ( m_verbose )
-        curl_easy_setopt( m_curlHandle, CURLOPT_VERBOSE, 1 );
+        curl_easy_setopt( handle, CURLOPT_VERBOSE, 1 );
+
+    // Let the server compress the response: curl decodes it before the
+    // data reaches the response. The content streams are often compressed
+    // already and their size has to match the one of the document: get
+    // them as they are.
+    if ( m_compressResponses && !options.m_contentRequest )
+        curl_easy_setopt( handle, CURLOPT_ACCEPT_ENCODING, "" );
 
     // We want to get the certificate infos in error cases
-    curl_easy_setopt( m_curlHandle, CURLOPT_CERTINFO, 1 );
+    curl_easy_setopt( handle, CURLOPT_CERTINFO, 1 );
 
-    applySslVerifyForRequest( );
+    applySslVerifyForRequest( handle );
 
-    // Perform the query
-    CURLcode errCode = curl_easy_perform( m_curlHandle );
+    return headers_slist;
+}
 
-    // Process the response
-    bool isHttpError = errCode == CURLE_HTTP_RETURNED_ERROR;
-    if ( CURLE_OK != errCode && !( m_noHttpErrors && isHttpError ) )
+future< libcmis::HttpResponsePtr > HttpSession::httpGetRequestAsync( string url,
+        libcmis::HttpCompletionCallback callback )
+{
+    libcmis::HttpAsyncRequestPtr request( new libcmis::HttpAsyncRequest( "GET", url, callback ) );
+    return httpAsyncRequest( request );
+}
+
+future< libcmis::HttpResponsePtr > HttpSession::httpPatchRequestAsync( string url,
+        istream& is, vector< string > headers, libcmis::HttpCompletionCallback callback )
+{
+    libcmis::HttpAsyncRequestPtr request( new libcmis::HttpAsyncRequest( "PATCH", url, callback ) );
+    request->m_headers = headers;
+    request->setBody( is );
+    return httpAsyncRequest( request );
+}
+
+future< libcmis::HttpResponsePtr > HttpSession::httpPutRequestAsync( string url,
+        istream& is, vector< string > headers, libcmis::HttpCompletionCallback callback )
+{
+    libcmis::HttpAsyncRequestPtr request( new libcmis::HttpAsyncRequest( "PUT", url, callback ) );
+    request->m_headers = headers;
+    request->setBody( is );
+    return httpAsyncRequest( request );
+}
+
+future< libcmis::HttpResponsePtr > HttpSession::httpPostRequestAsync( const string& url,
+        istream& is, const string& contentType, bool redirect,
+        libcmis::HttpCompletionCallback callback )
+{
+    libcmis::HttpAsyncRequestPtr request( new libcmis::HttpAsyncRequest( "POST", url, callback ) );
+    request->m_headers.push_back( string( "Content-Type:" ) + contentType );
+    request->m_redirect = redirect;
+    request->setBody( is );
+    return httpAsyncRequest( request );
+}
+
+future< libcmis::HttpResponsePtr > HttpSession::httpDeleteRequestAsync( string url,
+        libcmis::HttpCompletionCallback callback )
+{
+    libcmis::HttpAsyncRequestPtr request( new libcmis::HttpAsyncRequest( "DELETE", url, callback ) );
+    return httpAsyncRequest( request );
+}
+
+future< libcmis::HttpResponsePtr > HttpSession::httpAsyncRequest( libcmis::HttpAsyncRequestPtr request )
+{
+    future< libcmis::HttpResponsePtr > result = request->m_promise.get_future( );
+    try
     {
-        long httpError = 0;
-        curl_easy_getinfo( m_curlHandle, CURLINFO_RESPONSE_CODE, &httpError );
+        prepareAsyncRequest( *request );
+    }
+    catch ( ... )
+    {
+        // Report the errors the same way whether they happen before or
+        // during the transfer
+        request->fail( current_exception( ) );
+        return result;
+    }
 
-        bool errorFixed = false;
-        // If we had a bad certificate, then try to get more details
-        if ( CURLE_SSL_CACERT == errCode )
-            handleSslCacertRecovery( errBuff, errCode, httpError, isHttpError, errorFixed );
+    {
+        lock_guard< recursive_mutex > lock( m_requestMutex );
+        if ( !m_asyncEngine )
+            m_asyncEngine.reset( new libcmis::HttpAsyncEngine( this ) );
+    }
+    m_asyncEngine->submit( request );
+    return result;
+}
 
-        if ( !errorFixed )
-            throw CurlException( string( errBuff ), errCode, url, httpError );
+void HttpSession::prepareAsyncRequest( libcmis::HttpAsyncRequest& request )
+{
+    lock_guard< recursive_mutex > lock( m_requestMutex );
+    checkOAuth2( request.m_url );
+
+    CURL* handle = request.m_handle;
+    curl_easy_reset( handle );
+    initProtocols( handle );
+
+    libcmis::CurlSharePtr share = libcmis::getConnectionCache( );
+    if ( share != request.m_share )
+    {
+        curl_easy_setopt( handle, CURLOPT_SHARE, share ? share->getHandle( ) : NULL );
+        request.m_share = share;
     }
+
+    request.m_response.reset( new libcmis::HttpResponse( ) );
+    lcl_setResponseCallbacks( handle, request.m_response );
+
+    vector< string > headers = request.m_headers;
+    if ( request.m_body )
+    {
+        request.m_body->rewind( );
+        lcl_setUploadOptions( handle, request.m_method, request.m_body.get( ) );
+
+        // If we know for sure that 100-Continue won't be accepted,
+        // don't even try with it to save one HTTP request.
+        request.m_no100Continue = m_no100Continue;
+        if ( m_no100Continue )
+            headers.push_back( "Expect:" );
+    }
+    else if ( request.m_method != "GET" )
+        curl_easy_setopt( handle, CURLOPT_CUSTOMREQUEST, request.m_method.c_str( ) );
+
+    request.m_noHttpErrors = m_noHttpErrors;
+    request.m_authHeader = m_oauth2Handler ? m_oauth2Handler->getHttpHeader( ) : string( );
+    request.m_canRefreshToken = !getRefreshToken( ).empty( );
+    request.m_headersList = prepareRequest( handle, request.m_url, headers,
+                                            request.m_redirect, request.m_errBuff,
+                                            libcmis::HttpRequestOptions( ) );
 }
 
+bool HttpSession::retryAsyncRequest( libcmis::HttpAsyncRequest& request, long status,
+                                     long& delay, bool& refresh )
+{
+    delay = 0;
+    refresh = false;
+    if ( status == 417 && request.m_body && !request.m_no100Continue )
+    {
+        // Same as for the synchronous requests: some HTTP 1.0 proxy or
+        // server didn't accept the "Expect: 100-continue" header.
+        m_no100Continue = true;
+        request.m_no100Continue = true;
+        request.m_headersList.reset( curl_slist_append( request.m_headersList.release( ), "Expect:" ) );
+        curl_easy_setopt( request.m_handle, CURLOPT_HTTPHEADER, request.m_headersList.get( ) );
+    }
+    else if ( status == 401 && !request.m_refreshedToken && request.m_canRefreshToken )
+    {
+        request.m_refreshedToken = true;
+        refresh = true;
+        return true;
+    }
+    else
+    {
+        // The server is throttling us: the engine sends it again later
+        delay = m_retryPolicy.getRetryDelay( request.m_method, status,
+                                             request.m_retries, request.m_response );
+        if ( delay < 0 )
+            return false;
+
+        ++request.m_retries;
+        m_statistics.addRetry( );
+    }
+
+    // The handle keeps its settings: only the response and the body
+    // need to start over
+    request.m_response.reset( new libcmis::HttpResponse( ) );
+    lcl_setResponseCallbacks( request.m_handle, request.m_response );
+    if ( request.m_body )
+        request.m_body->rewind( );
+    return true;
+}
+
+void HttpSession::refreshAsyncRequest( libcmis::HttpAsyncRequest& request )
+{
+    lock_guard< recursive_mutex > lock( m_requestMutex );
+
+    // Another request may already have refreshed the expired token
+    if ( m_oauth2Handler->getHttpHeader( ) == request.m_authHeader )
+        oauth2Refresh( );
+    prepareAsyncRequest( request );
+}
+
+long HttpSession::getRetryDelay( const string& method, unsigned int attempt,
+                                 libcmis::HttpResponsePtr response )
+{
+    long delay = m_retryPolicy.getRetryDelay( method, getHttpStatus( ), attempt, response );
+    if ( delay >= 0 )
+        m_statistics.addRetry( );
+    return delay;
+}
+
+void HttpSession::setRetryPolicy( unsigned int maxRetries, long initialDelay,
+                                  long maxDelay, long retriesPerMinute )
+{
+    m_retryPolicy.configure( maxRetries, initialDelay, maxDelay, retriesPerMinute );
+}
+
+void HttpSession::stopAsyncRequests( )
+{
+    m_asyncEngine.reset( );
+}
 
 void HttpSession::checkOAuth2( string url )
 {
@@ -841,17 +1316,29 @@ void HttpSession::oauth2Authenticate( )
     m_oauth2Handler->fetchTokens( string( authCode ) );
 }
 
+void HttpSession::attachConnectionCache( )
+{
+    libcmis::CurlSharePtr share = libcmis::getConnectionCache( );
+    if ( share != m_curlShare )
+    {
+        // Setting the new share detaches the handle from the old one
+        // before we release our reference on it.
+        curl_easy_setopt( m_curlHandle, CURLOPT_SHARE, share ? share->getHandle( ) : NULL );
+        m_curlShare = share;
+    }
+}
+
 void HttpSession::setNoSSLCertificateCheck( bool noCheck )
 {
     m_noSSLCheck = noCheck;
 }
 
-void HttpSession::applySslVerifyForRequest( )
+void HttpSession::applySslVerifyForRequest( CURL* handle )
 {
     if ( m_noSSLCheck )
     {
-        curl_easy_setopt(m_curlHandle, CURLOPT_SSL_VERIFYHOST, 0);
-        curl_easy_setopt(m_curlHandle, CURLOPT_SSL_VERIFYPEER, 0);
+        curl_easy_setopt(handle, CURLOPT_SSL_VERIFYHOST, 0);
+        curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, 0);
     }
 }
 
@@ -932,23 +1419,29 @@ string HttpSession::getRefreshToken( )
 void HttpSession::oauth2Refresh( )
 {
     const ScopeGuard<bool> inOauth2Guard(m_inOAuth2Authentication, true);
+    m_statistics.addTokenRefresh( );
     m_oauth2Handler->refresh( );
 }
 
 void HttpSession::initProtocols( )
+{
+    initProtocols( m_curlHandle );
+}
+
+void HttpSession::initProtocols( CURL* handle )
 {
 #if (LIBCURL_VERSION_MAJOR > 7) || (LIBCURL_VERSION_MAJOR == 7 && LIBCURL_VERSION_MINOR >= 85)
     auto const protocols = "https,http";
-    curl_easy_setopt(m_curlHandle, CURLOPT_PROTOCOLS_STR, protocols);
-    curl_easy_setopt(m_curlHandle, CURLOPT_REDIR_PROTOCOLS_STR, protocols);
+    curl_easy_setopt(handle, CURLOPT_PROTOCOLS_STR, protocols);
+    curl_easy_setopt(handle, CURLOPT_REDIR_PROTOCOLS_STR, protocols);
 #else
     const unsigned long protocols = CURLPROTO_HTTP | CURLPROTO_HTTPS;
-    curl_easy_setopt(m_curlHandle, CURLOPT_PROTOCOLS, protocols);
-    curl_easy_setopt(m_curlHandle, CURLOPT_REDIR_PROTOCOLS, protocols);
+    curl_easy_setopt(handle, CURLOPT_PROTOCOLS, protocols);
+    curl_easy_setopt(handle, CURLOPT_REDIR_PROTOCOLS, protocols);
 #endif
     if (m_CurlInitProtocolsFunction)
     {
-        (*m_CurlInitProtocolsFunction)(m_curlHandle);
+        (*m_CurlInitProtocolsFunction)(handle);
     }
 }
 
@@ -28,12 +28,21 @@
 #ifndef _HTTP_SESSION_HXX_
 #define _HTTP_SESSION_HXX_
 
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <future>
 #include <istream>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <sstream>
 #include <vector>
 #include <string>
 
+#include <boost/shared_ptr.hpp>
 #include <curl/curl.h>
 #include <libxml/xmlstring.h>
 #include <libxml/xpath.h>
@@ -42,11 +51,32 @@
 #include <libcmis/oauth2-data.hxx>
 #include <libcmis/xml-utils.hxx>
 
+#include "statistics-counters.hxx"
+#include "trace-scope.hxx"
+
 class OAuth2Handler;
 
 namespace libcmis {
     typedef void(*CurlInitProtocolsFunction)(CURL *);
 
+    class HttpAsyncEngine;
+    class HttpAsyncRequest;
+
+    struct CurlSlistDeleter
+    {
+        void operator()( curl_slist* list ) const { curl_slist_free_all( list ); }
+    };
+    typedef std::unique_ptr< curl_slist, CurlSlistDeleter > CurlSlistPtr;
+
+    /** Called when an asynchronous request is over, either with its
+        response or with the exception that made it fail.
+
+        The callback is run by the thread driving the transfers: it needs
+        to be quick and mustn't wait for another asynchronous request of
+        the same session.
+      */
+    typedef std::function< void ( HttpResponsePtr, std::exception_ptr ) > HttpCompletionCallback;
+
     /** Throw libcmis::Exception if s contains CR, LF or NUL. libcurl
         started rejecting these in CURLOPT_URL at 7.84 and in
         curl_slist_append at 7.86.
@@ -59,6 +89,189 @@ namespace libcmis {
         data transfer for 30s.
       */
     void applyTransferLimits(CURL* curlHandle);
+
+    /** Time in milliseconds until the first byte of the response of a
+        transfer started at start: unlike the total time, it doesn't
+        depend on the size of the content.
+      */
+    long getFirstByteLatency( CURL* curlHandle, std::chrono::steady_clock::time_point start );
+
+    /** Read the timings and sizes of the transfer just performed by
+        curlHandle.
+      */
+    RequestMetrics getRequestMetrics( CURL* curlHandle, const std::string& method, const std::string& url );
+
+    /** Give the metrics of a request to the request observer of the
+        SessionFactory and to the span of the operation which sent it,
+        if any.
+      */
+    void reportRequestMetrics( const RequestMetrics& metrics, const ActiveSpanPtr& span );
+
+    /** Process-wide cache shared by the curl handles of all the sessions.
+
+        Depending on the options it has been created with, it holds the
+        DNS cache, the TLS session cache and the pool of live connections,
+        so that a new session to an already known host doesn't pay for a
+        new DNS lookup, TCP connect and TLS handshake.
+
+        The curl_share handle is guarded by one mutex per shared data type
+        as the sessions may be used from several threads.
+      */
+    class CurlShare
+    {
+        private:
+            CURLSH* m_share;
+            std::unique_ptr< std::mutex[] > m_locks;
+
+        public:
+            CurlShare( bool shareDns, bool shareSslSessions, bool shareConnections );
+            ~CurlShare( );
+
+            CurlShare( const CurlShare& copy ) = delete;
+            CurlShare& operator=( const CurlShare& copy ) = delete;
+
+            CURLSH* getHandle( ) { return m_share; }
+
+            /** Get the mutex guarding one of the curl_lock_data.
+              */
+            std::mutex& getLock( int data ) { return m_locks[data]; }
+    };
+    typedef boost::shared_ptr< CurlShare > CurlSharePtr;
+
+    /** Get the connection cache the sessions need to use, following the
+        options set on the SessionFactory, or an empty pointer if nothing
+        is shared.
+      */
+    CurlSharePtr getConnectionCache( );
+
+    /** Options of a single request, given to the functions setting up
+        its curl handle instead of being kept in the session, so that
+        they don't leak into the requests sent meanwhile, like an OAuth2
+        token refresh.
+      */
+    struct HttpRequestOptions
+    {
+        /// The response is written to a sink: don't bound its size
+        bool m_unboundedResponse;
+
+        /// Get a content stream as it is, without asking for compression
+        bool m_contentRequest;
+
+        HttpRequestOptions( ) : m_unboundedResponse( false ), m_contentRequest( false ) { }
+    };
+
+    /** Validators of the last representation of a resource that was
+        downloaded, sent back with the next GET of that resource to let
+        the server answer 304 Not Modified instead of the whole content.
+      */
+    class HttpValidators
+    {
+        private:
+            std::string m_etag;
+            std::string m_lastModified;
+
+        public:
+            HttpValidators( ) : m_etag( ), m_lastModified( ) { }
+
+            /** Remember the ETag and Last-Modified headers of response.
+              */
+            void update( libcmis::HttpResponsePtr response );
+            void clear( );
+
+            bool empty( ) const { return m_etag.empty( ) && m_lastModified.empty( ); }
+            std::string getETag( ) const { return m_etag; }
+
+            /** If-None-Match and If-Modified-Since headers for the
+                conditional request.
+              */
+            std::vector< std::string > getConditionalHeaders( ) const;
+    };
+
+    /** Decides when the requests throttled by the server with a 429 or
+        503 status are sent again.
+
+        Only the idempotent requests are retried, after an exponential
+        backoff with jitter or the delay given by the Retry-After header.
+        The session's retries are also limited by a budget refilled over
+        time so that a failing server isn't flooded.
+      */
+    class HttpRetryPolicy
+    {
+        private:
+            unsigned int m_maxRetries;
+            long m_initialDelay;
+            long m_maxDelay;
+            long m_retriesPerMinute;
+
+            double m_budget;
+            std::chrono::steady_clock::time_point m_budgetTime;
+            std::mt19937 m_random;
+
+            std::mutex m_mutex;
+
+        public:
+            HttpRetryPolicy( );
+            HttpRetryPolicy( const HttpRetryPolicy& copy );
+            HttpRetryPolicy& operator=( const HttpRetryPolicy& copy );
+
+            /** Set the number of retries of a request, 0 disabling them,
+                the delays in milliseconds and the number of retries the
+                session can do per minute, negative for no limit.
+              */
+            void configure( unsigned int maxRetries, long initialDelay,
+                            long maxDelay, long retriesPerMinute );
+
+            /** Get how many milliseconds to wait before sending again a
+                request that failed with status after attempt retries,
+                or -1 if it mustn't be retried. A delay requested by the
+                server longer than the maximum one isn't waited for.
+              */
+            long getRetryDelay( const std::string& method, long status,
+                                unsigned int attempt, HttpResponsePtr response );
+
+            static bool isIdempotent( const std::string& method );
+
+        private:
+            bool consumeBudget( );
+    };
+
+    /** Body of a POST, PUT or PATCH request read straight from the
+        caller's stream, starting at its current position, so that big
+        uploads aren't copied in memory.
+
+        The body is rewound whenever curl or a retried request needs to
+        send it again. Streams that can't seek are spooled to a temporary
+        file first. Once done, the stream is put back at the position the
+        body started from.
+      */
+    class HttpUploadBody
+    {
+        private:
+            std::istream* m_stream;
+            std::streampos m_start;
+            curl_off_t m_size;
+            FILE* m_spool;
+
+        public:
+            explicit HttpUploadBody( std::istream& is );
+            ~HttpUploadBody( );
+
+            HttpUploadBody( const HttpUploadBody& copy ) = delete;
+            HttpUploadBody& operator=( const HttpUploadBody& copy ) = delete;
+
+            curl_off_t getSize( ) const { return m_size; }
+
+            /** Read the next bytes of the body, returns the number of
+                bytes read: 0 at the end of the body.
+              */
+            size_t read( char* buffer, size_t length );
+
+            /** Move in the body like fseek( ). The offsets are relative
+                to the start of the body, not of the underlying stream.
+              */
+            bool seek( curl_off_t offset, int origin );
+            bool rewind( ) { return seek( 0, SEEK_SET ); }
+    };
 }
 
 class CurlException : public std::exception
@@ -109,11 +322,24 @@ class CurlException : public std::exception
 
 class HttpSession
 {
+    friend class libcmis::HttpAsyncEngine;
+
     protected:
         CURL* m_curlHandle;
         libcmis::CurlInitProtocolsFunction m_CurlInitProtocolsFunction = nullptr;
     private:
-        bool  m_no100Continue;
+        libcmis::CurlSharePtr m_curlShare;
+        /** Set once a server refused the "Expect: 100-continue" header,
+            possibly by the asynchronous requests engine.
+          */
+        std::atomic< bool > m_no100Continue;
+
+        /** Serializes the requests on m_curlHandle and the changes of the
+            authentication state between the caller threads and the
+            asynchronous requests being prepared.
+          */
+        std::recursive_mutex m_requestMutex;
+        std::unique_ptr< libcmis::HttpAsyncEngine > m_asyncEngine;
     protected:
         std::unique_ptr<OAuth2Handler> m_oauth2Handler;
         std::string m_username;
@@ -123,8 +349,12 @@ class HttpSession
         bool m_verbose;
         bool m_noHttpErrors;
         bool m_noSSLCheck;
-        bool m_refreshedToken;
         bool m_inOAuth2Authentication;
+        bool m_compressResponses;
+        libcmis::HttpRetryPolicy m_retryPolicy;
+
+        /// Not copied: the counters of a copy start from zero
+        libcmis::StatisticsCounters m_statistics;
         unsigned long m_authMethod;
     public:
         HttpSession( std::string username, std::string password,
@@ -134,6 +364,10 @@ class HttpSession
                      libcmis::CurlInitProtocolsFunction = nullptr);
 
         HttpSession( const HttpSession& copy );
+
+        /** Asynchronous requests still pending are cancelled: their
+            futures and callbacks get a cancelled CurlException.
+          */
         virtual ~HttpSession( );
 
         HttpSession& operator=( const HttpSession& copy );
@@ -152,6 +386,32 @@ class HttpSession
         virtual void setOAuth2Data( libcmis::OAuth2DataPtr oauth2 );
 
         libcmis::HttpResponsePtr httpGetRequest( std::string url );
+
+        /** Download the content of url straight to sink as it arrives:
+            it isn't kept in the response and its size isn't bounded.
+          */
+        libcmis::HttpResponsePtr httpGetRequest( std::string url,
+                                                 boost::shared_ptr< libcmis::EncodedData > sink,
+                                                 std::vector< std::string > headers = std::vector< std::string >( ) );
+
+        /** GET url only if it changed since validators were filled, and
+            update them from the response.
+
+            \return
+                the response or an empty pointer if the server answered
+                304 Not Modified.
+          */
+        libcmis::HttpResponsePtr httpConditionalGetRequest( std::string url,
+                                                 libcmis::HttpValidators& validators );
+
+        /** GET a content stream, to url or straight to sink when set.
+            Unlike the other requests, it never asks for a compressed
+            response.
+          */
+        libcmis::HttpResponsePtr httpGetContentRequest( std::string url,
+                                                 boost::shared_ptr< libcmis::EncodedData > sink =
+                                                     boost::shared_ptr< libcmis::EncodedData >( ) );
+
         libcmis::HttpResponsePtr httpPatchRequest( std::string url,
                                                  std::istream& is,
                                                  std::vector< std::string > headers );
@@ -164,12 +424,62 @@ class HttpSession
                                                   bool redirect = true );
         void httpDeleteRequest( std::string url );
 
+        /** Asynchronous variants of the http*Request methods.
+
+            The requests are run by a thread of the session driving a
+            curl_multi handle, so that several of them can be in flight
+            at the same time. Like for the synchronous requests, the body
+            to upload is read from the stream while the request is sent
+            and again for its retries: the stream has to outlive the
+            request. Only the unseekable streams are copied, to a
+            temporary file, before the method returns.
+
+            The result is provided both by the returned future and by
+            the optional callback. The future throws the CurlException
+            (or libcmis::Exception) that made the request fail. The
+            expired OAuth2 token and HTTP 417 cases are retried like for
+            the synchronous requests.
+          */
+        std::future< libcmis::HttpResponsePtr > httpGetRequestAsync( std::string url,
+                libcmis::HttpCompletionCallback callback = libcmis::HttpCompletionCallback( ) );
+        std::future< libcmis::HttpResponsePtr > httpPatchRequestAsync( std::string url,
+                std::istream& is,
+                std::vector< std::string > headers,
+                libcmis::HttpCompletionCallback callback = libcmis::HttpCompletionCallback( ) );
+        std::future< libcmis::HttpResponsePtr > httpPutRequestAsync( std::string url,
+                std::istream& is,
+                std::vector< std::string > headers,
+                libcmis::HttpCompletionCallback callback = libcmis::HttpCompletionCallback( ) );
+        std::future< libcmis::HttpResponsePtr > httpPostRequestAsync( const std::string& url,
+                std::istream& is,
+                const std::string& contentType,
+                bool redirect = true,
+                libcmis::HttpCompletionCallback callback = libcmis::HttpCompletionCallback( ) );
+
+        /** The response provided for the DELETE request has no content.
+          */
+        std::future< libcmis::HttpResponsePtr > httpDeleteRequestAsync( std::string url,
+                libcmis::HttpCompletionCallback callback = libcmis::HttpCompletionCallback( ) );
+
         long getHttpStatus( );
 
         void setNoSSLCertificateCheck( bool noCheck );
 
+        /** Let the server compress the responses, which curl decodes
+            transparently. Enabled by default.
+          */
+        void setCompressedResponses( bool compress ) { m_compressResponses = compress; }
+
+        /** Retry the idempotent requests failing with a 429 or 503 status,
+            see HttpRetryPolicy::configure( ). Disabled by default.
+          */
+        void setRetryPolicy( unsigned int maxRetries, long initialDelay = 500,
+                             long maxDelay = 30000, long retriesPerMinute = -1 );
+
         virtual std::string getRefreshToken( );
 
+        libcmis::StatisticsCounters& getStatisticsCounters( ) { return m_statistics; }
+
     protected:
         HttpSession( );
 
@@ -181,11 +491,43 @@ class HttpSession
         void setAuthMethod( unsigned long authMethod ) { m_authMethod = authMethod; }
         virtual void httpRunRequest( std::string url,
                                     std::vector< std::string > headers = std::vector< std::string > ( ),
-                                    bool redirect = true );
+                                    bool redirect = true,
+                                    const std::string& method = std::string( "GET" ),
+                                    const libcmis::HttpRequestOptions& options = libcmis::HttpRequestOptions( ) );
+
+        /** Set the options common to all the requests on a freshly reset
+            curl handle: URL, headers, credentials, proxy and error
+            reporting in errBuff, which needs CURL_ERROR_SIZE bytes, as
+            well as the options of this very request.
+
+            The returned headers list is used by the handle and has to be
+            kept until the request is over.
+          */
+        virtual libcmis::CurlSlistPtr prepareRequest( CURL* handle,
+                                                      const std::string& url,
+                                                      std::vector< std::string > headers,
+                                                      bool redirect,
+                                                      char* errBuff,
+                                                      const libcmis::HttpRequestOptions& options );
         void initProtocols( );
+        void initProtocols( CURL* handle );
+
+        /** Attach the curl handle to the connection cache currently
+            provided by SessionFactory. This is a no-op if the handle
+            already uses it, but picks up a new cache after the previous
+            one has been flushed or reconfigured.
+          */
+        void attachConnectionCache( );
+
+        /** Stop the thread running the asynchronous requests and cancel
+            the ones that are not over. The sessions overriding the methods
+            used to prepare the requests call it first in their destructor:
+            the retries would otherwise use their destroyed parts.
+          */
+        void stopAsyncRequests( );
 
         /** Apply CURLOPT_SSL_VERIFY{PEER,HOST} for the request about to run. */
-        void applySslVerifyForRequest( );
+        void applySslVerifyForRequest( CURL* handle );
 
         /** Handle a CURLE_SSL_CACERT failure: re-run with verification off
             to obtain the cert chain, prompt the caller's
@@ -201,8 +543,57 @@ class HttpSession
 
     private:
         void checkCredentials( );
+
+        /** Run a GET request, retrying it if needed, and give the
+            status of its last attempt.
+          */
+        libcmis::HttpResponsePtr httpGetRequest( const std::string& url,
+                                                 boost::shared_ptr< libcmis::EncodedData > sink,
+                                                 const std::vector< std::string >& headers,
+                                                 const libcmis::HttpRequestOptions& options,
+                                                 long& status );
+
+        /** Run a POST, PUT or PATCH request, sending the body again
+            after rewinding it if the request needs to be retried.
+          */
+        libcmis::HttpResponsePtr httpUploadRequest( const std::string& method,
+                                                    const std::string& url,
+                                                    libcmis::HttpUploadBody& body,
+                                                    const std::vector< std::string >& headers,
+                                                    bool redirect );
         void checkOAuth2( std::string url );
         void oauth2Refresh( );
+
+        std::future< libcmis::HttpResponsePtr > httpAsyncRequest(
+                std::shared_ptr< libcmis::HttpAsyncRequest > request );
+
+        /** Set up the curl handle of an asynchronous request for its
+            next attempt.
+          */
+        void prepareAsyncRequest( libcmis::HttpAsyncRequest& request );
+
+        /** Decide whether a failed asynchronous request is worth another
+            attempt and set it up for it. This runs on the engine thread
+            and doesn't wait for the session, which may be busy with a
+            synchronous request: if the OAuth2 token has to be refreshed,
+            refresh is set and refreshAsyncRequest( ) has to be run on
+            another thread to prepare the request.
+          */
+        bool retryAsyncRequest( libcmis::HttpAsyncRequest& request, long status,
+                                long& delay, bool& refresh );
+
+        /** Refresh the OAuth2 token rejected for an asynchronous request,
+            unless another request already did it, and prepare the request
+            again.
+          */
+        void refreshAsyncRequest( libcmis::HttpAsyncRequest& request );
+
+        /** Time to wait before retrying a synchronous request throttled
+            by the server, or -1 if the retry policy doesn't allow another
+            attempt. The caller waits without holding m_requestMutex.
+          */
+        long getRetryDelay( const std::string& method, unsigned int attempt,
+                            libcmis::HttpResponsePtr response );
 };
 
 #endif
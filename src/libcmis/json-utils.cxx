@@ -35,6 +35,8 @@
 #include <libcmis/exception.hxx>
 #include <libcmis/xml-utils.hxx>
 
+#include "memory-stream.hxx"
+
 using namespace std;
 using namespace libcmis;
 using namespace boost;
@@ -221,7 +223,7 @@ Json Json::parse( const string& str )
         return malformedJsonFallback( str );
 
     ptree pTree;
-    std::stringstream ss( str );
+    libcmis::MemoryStream ss( str.data( ), str.size( ) );
     if ( ss.good( ) )
     {
         try
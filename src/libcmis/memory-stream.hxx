@@ -0,0 +1,91 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _MEMORY_STREAM_HXX_
+#define _MEMORY_STREAM_HXX_
+
+#include <istream>
+#include <streambuf>
+
+namespace libcmis
+{
+    /** Stream buffer reading a block of memory in place.
+      */
+    class MemoryStreamBuffer : public std::streambuf
+    {
+        public:
+            MemoryStreamBuffer( const char* data, size_t size ) :
+                std::streambuf( )
+            {
+                // The memory is only read through the get area
+                char* begin = const_cast< char* >( data );
+                setg( begin, begin, begin + size );
+            }
+
+        protected:
+            pos_type seekoff( off_type off, std::ios_base::seekdir dir,
+                              std::ios_base::openmode which = std::ios_base::in )
+            {
+                off_type position = off;
+                if ( dir == std::ios_base::cur )
+                    position += gptr( ) - eback( );
+                else if ( dir == std::ios_base::end )
+                    position += egptr( ) - eback( );
+
+                if ( !( which & std::ios_base::in ) || position < 0 ||
+                     position > egptr( ) - eback( ) )
+                    return pos_type( off_type( -1 ) );
+
+                setg( eback( ), eback( ) + position, egptr( ) );
+                return pos_type( position );
+            }
+
+            pos_type seekpos( pos_type pos, std::ios_base::openmode which = std::ios_base::in )
+            {
+                return seekoff( off_type( pos ), std::ios_base::beg, which );
+            }
+    };
+
+    /** Stream reading a block of memory without copying it, unlike
+        std::istringstream. The memory has to outlive the stream.
+      */
+    class MemoryStream : public std::istream
+    {
+        private:
+            MemoryStreamBuffer m_buffer;
+
+        public:
+            MemoryStream( const char* data, size_t size ) :
+                std::istream( NULL ),
+                m_buffer( data, size )
+            {
+                rdbuf( &m_buffer );
+            }
+    };
+}
+
+#endif
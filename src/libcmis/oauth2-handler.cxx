@@ -125,7 +125,7 @@ void OAuth2Handler::fetchTokens( string authCode )
                 "Couldn't get tokens from the authorization code ");
     }
 
-    Json jresp = Json::parse( resp->getStream( )->str( ) );
+    Json jresp = Json::parse( resp->getBody( ) );
     m_access = jresp[ "access_token" ].toString( );
     m_refresh = jresp[ "refresh_token" ].toString( );
 
@@ -155,7 +155,7 @@ void OAuth2Handler::refresh( )
         throw libcmis::Exception( "Couldn't refresh token ");
     }
 
-    Json jresp = Json::parse( resp->getStream( )->str( ) );
+    Json jresp = Json::parse( resp->getBody( ) );
     m_access = jresp[ "access_token" ].toString();
 
     if ( m_access.empty( ) )
@@ -59,16 +59,17 @@ string OAuth2Providers::OAuth2Alfresco( HttpSession* session, const string& auth
     static const string CONTENT_TYPE( "application/x-www-form-urlencoded" );
    
     // Log in
-    string res;
+    libcmis::HttpResponsePtr response;
     try
     {
-        res = session->httpGetRequest( authUrl )->getStream( )->str( );
+        response = session->httpGetRequest( authUrl );
     }
     catch ( const CurlException& )
     {
         return string( );
     }
 
+    const string& res = response->getBody( );
     string loginPost, loginLink;
 
     if ( !parseResponse( res.c_str( ), loginPost, loginLink ) ) 
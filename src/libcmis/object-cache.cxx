@@ -0,0 +1,172 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "object-cache.hxx"
+
+using namespace std;
+
+namespace
+{
+    /** Rough estimate of the memory used by an object: its properties
+        make most of it.
+      */
+    size_t lcl_estimateSize( libcmis::ObjectPtr object )
+    {
+        size_t size = 512;
+        libcmis::PropertyPtrMap& properties = object->getProperties( );
+        for ( libcmis::PropertyPtrMap::iterator it = properties.begin( ); it != properties.end( ); ++it )
+        {
+            size += 64 + it->first.size( );
+            if ( !it->second )
+                continue;
+
+            vector< string > values = it->second->getStrings( );
+            for ( vector< string >::iterator value = values.begin( ); value != values.end( ); ++value )
+                size += sizeof( string ) + value->size( );
+        }
+        return size;
+    }
+}
+
+ObjectCache::ObjectCache( ) :
+    m_lru( ),
+    m_entries( ),
+    m_maxObjects( 0 ),
+    m_ttl( -1 ),
+    m_maxBytes( 0 ),
+    m_bytes( 0 ),
+    m_hits( 0 ),
+    m_misses( 0 ),
+    m_mutex( )
+{
+}
+
+void ObjectCache::configure( size_t maxObjects, long ttl, size_t maxBytes )
+{
+    lock_guard< mutex > lock( m_mutex );
+    m_maxObjects = maxObjects;
+    m_ttl = ttl;
+    m_maxBytes = maxBytes;
+    evict( );
+}
+
+bool ObjectCache::isEnabled( )
+{
+    lock_guard< mutex > lock( m_mutex );
+    return m_maxObjects > 0 && m_ttl != 0;
+}
+
+libcmis::ObjectPtr ObjectCache::get( const string& id, bool& expired )
+{
+    lock_guard< mutex > lock( m_mutex );
+    map< string, Entry >::iterator it = m_entries.find( id );
+    if ( it == m_entries.end( ) )
+    {
+        ++m_misses;
+        return libcmis::ObjectPtr( );
+    }
+
+    expired = m_ttl >= 0 && difftime( time( NULL ), it->second.m_time ) >= m_ttl;
+    if ( expired )
+        ++m_misses;
+    else
+        ++m_hits;
+    m_lru.splice( m_lru.begin( ), m_lru, it->second.m_lruPos );
+    return it->second.m_object;
+}
+
+void ObjectCache::put( libcmis::ObjectPtr object )
+{
+    if ( !object )
+        return;
+
+    string id = object->getId( );
+    size_t size = lcl_estimateSize( object );
+
+    lock_guard< mutex > lock( m_mutex );
+    if ( m_maxObjects == 0 || m_ttl == 0 || id.empty( ) )
+        return;
+
+    map< string, Entry >::iterator it = m_entries.find( id );
+    if ( it != m_entries.end( ) )
+        removeEntry( it );
+
+    m_lru.push_front( id );
+    m_entries.insert( make_pair( id, Entry( object, size, m_lru.begin( ) ) ) );
+    m_bytes += size;
+    evict( );
+}
+
+void ObjectCache::remove( const string& id )
+{
+    lock_guard< mutex > lock( m_mutex );
+    map< string, Entry >::iterator it = m_entries.find( id );
+    if ( it != m_entries.end( ) )
+        removeEntry( it );
+}
+
+void ObjectCache::clear( )
+{
+    lock_guard< mutex > lock( m_mutex );
+    m_entries.clear( );
+    m_lru.clear( );
+    m_bytes = 0;
+}
+
+long ObjectCache::getHits( )
+{
+    lock_guard< mutex > lock( m_mutex );
+    return m_hits;
+}
+
+long ObjectCache::getMisses( )
+{
+    lock_guard< mutex > lock( m_mutex );
+    return m_misses;
+}
+
+void ObjectCache::resetCounters( )
+{
+    lock_guard< mutex > lock( m_mutex );
+    m_hits = 0;
+    m_misses = 0;
+}
+
+void ObjectCache::removeEntry( map< string, Entry >::iterator it )
+{
+    m_bytes -= it->second.m_size;
+    m_lru.erase( it->second.m_lruPos );
+    m_entries.erase( it );
+}
+
+void ObjectCache::evict( )
+{
+    while ( !m_lru.empty( ) &&
+            ( m_entries.size( ) > m_maxObjects || ( m_maxBytes > 0 && m_bytes > m_maxBytes ) ) )
+        removeEntry( m_entries.find( m_lru.back( ) ) );
+}
@@ -0,0 +1,111 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _OBJECT_CACHE_HXX_
+#define _OBJECT_CACHE_HXX_
+
+#include <ctime>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <libcmis/object.hxx>
+
+/** Bounded cache of the objects of a session, keyed by their id.
+
+    The least recently used objects are dropped first when the number
+    of objects or the estimated size of their properties go past the
+    limits. Entries older than the TTL are kept until they are looked
+    up, to let the session revalidate them.
+  */
+class ObjectCache
+{
+    private:
+        struct Entry
+        {
+            libcmis::ObjectPtr m_object;
+            time_t m_time;
+            size_t m_size;
+            std::list< std::string >::iterator m_lruPos;
+
+            Entry( libcmis::ObjectPtr object, size_t size, std::list< std::string >::iterator lruPos ) :
+                m_object( object ), m_time( time( NULL ) ), m_size( size ), m_lruPos( lruPos )
+            {
+            }
+        };
+
+        /// Ids of the cached objects, the most recently used first
+        std::list< std::string > m_lru;
+        std::map< std::string, Entry > m_entries;
+
+        size_t m_maxObjects;
+        long m_ttl;
+        size_t m_maxBytes;
+        size_t m_bytes;
+
+        long m_hits;
+        long m_misses;
+
+        std::mutex m_mutex;
+
+    public:
+        ObjectCache( );
+
+        ObjectCache( const ObjectCache& copy ) = delete;
+        ObjectCache& operator=( const ObjectCache& copy ) = delete;
+
+        /** Set the cache limits: a 0 maxObjects disables the cache, a
+            negative ttl keeps the objects until they are evicted and
+            a 0 maxBytes doesn't limit the memory.
+          */
+        void configure( size_t maxObjects, long ttl, size_t maxBytes );
+
+        bool isEnabled( );
+
+        /** Get the cached object for an id or an empty pointer, counting
+            the hits and misses. expired is set if the object is older
+            than the TTL and needs to be revalidated: that counts as a miss.
+          */
+        libcmis::ObjectPtr get( const std::string& id, bool& expired );
+
+        void put( libcmis::ObjectPtr object );
+
+        void remove( const std::string& id );
+
+        void clear( );
+
+        long getHits( );
+        long getMisses( );
+        void resetCounters( );
+
+    private:
+        void removeEntry( std::map< std::string, Entry >::iterator it );
+        void evict( );
+};
+
+#endif
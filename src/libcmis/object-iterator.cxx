@@ -0,0 +1,110 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include <libcmis/object-iterator.hxx>
+
+using namespace std;
+
+namespace libcmis
+{
+    ObjectIterator::ObjectIterator( ) :
+        m_page( ),
+        m_position( 0 ),
+        m_started( false ),
+        m_hasMoreItems( true ),
+        m_numItems( -1 )
+    {
+    }
+
+    void ObjectIterator::fillPage( )
+    {
+        while ( m_position >= m_page.size( ) && ( !m_started || m_hasMoreItems ) )
+        {
+            m_started = true;
+            m_page = fetchNextPage( );
+            m_position = 0;
+
+            // Don't loop forever on a server sending empty pages
+            if ( m_page.empty( ) )
+                m_hasMoreItems = false;
+        }
+    }
+
+    bool ObjectIterator::hasNext( )
+    {
+        fillPage( );
+        return m_position < m_page.size( );
+    }
+
+    ObjectPtr ObjectIterator::next( )
+    {
+        if ( !hasNext( ) )
+            throw Exception( "No more objects to iterate on" );
+        return m_page[ m_position++ ];
+    }
+
+    vector< ObjectPtr > ObjectIterator::nextPage( )
+    {
+        vector< ObjectPtr > page;
+        if ( hasNext( ) )
+        {
+            page.assign( m_page.begin( ) + m_position, m_page.end( ) );
+            m_position = m_page.size( );
+        }
+        return page;
+    }
+
+    bool ObjectIterator::hasMoreItems( )
+    {
+        if ( !m_started )
+            fillPage( );
+        return m_hasMoreItems;
+    }
+
+    long ObjectIterator::getNumItems( )
+    {
+        if ( !m_started )
+            fillPage( );
+        return m_numItems;
+    }
+
+    ObjectListIterator::ObjectListIterator( const vector< ObjectPtr >& objects ) :
+        ObjectIterator( ),
+        m_objects( objects )
+    {
+        setNumItems( objects.size( ) );
+    }
+
+    vector< ObjectPtr > ObjectListIterator::fetchNextPage( )
+    {
+        setHasMoreItems( false );
+        vector< ObjectPtr > page;
+        page.swap( m_objects );
+        return page;
+    }
+}
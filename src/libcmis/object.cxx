@@ -33,6 +33,8 @@
 #include <libcmis/session.hxx>
 #include <libcmis/xml-utils.hxx>
 
+#include "xpath-context.hxx"
+
 using namespace std;
 
 namespace libcmis
@@ -89,17 +91,14 @@ namespace libcmis
 
     void Object::initializeFromNode( xmlNodePtr node )
     {
-        // Even if node is NULL we'll have an empty doc, so no need
-        // to worry about it.
-        xmlDocPtr doc = wrapInDoc( node );
-        xmlXPathContextPtr xpathCtx = xmlXPathNewContext( doc );
-
-        libcmis::registerNamespaces( xpathCtx );
-
-        if ( NULL != xpathCtx )
+        // The queries are relative to the node: no need to copy it
+        // into its own document.
+        if ( NULL != node )
         {
+            XPathContext xpathCtx( node->doc, node );
+
             // Get the allowableActions
-            xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression( BAD_CAST( "//cmis:allowableActions" ), xpathCtx );
+            xmlXPathObjectPtr xpathObj = xpathCtx.eval( ".//cmis:allowableActions" );
             if ( xpathObj && xpathObj->nodesetval && xpathObj->nodesetval->nodeNr > 0 )
             {
                 xmlNodePtr actionsNode = xpathObj->nodesetval->nodeTab[0];
@@ -107,23 +106,27 @@ namespace libcmis
             }
             xmlXPathFreeObject( xpathObj );
 
-            // TODO Get rid of this request:
+            // TODO Get rid of this request when not in lazy type resolution mode:
             //   * Too time consuming
             //   * Makes secondary aspect properties annoying to create
             //   * Prevents from getting Alfresco additional properties
             // First get the type id as it will give us the property definitions
-            string typeIdReq( "/*/cmis:properties/cmis:propertyId[@propertyDefinitionId='cmis:objectTypeId']/cmis:value/text()" );
-            m_typeId = libcmis::getXPathValue( xpathCtx, typeIdReq );
+            m_typeId = xpathCtx.getValue( "cmis:properties/cmis:propertyId[@propertyDefinitionId='cmis:objectTypeId']/cmis:value/text()" );
+
+            // In lazy mode the properties get temporary definitions
+            // completed by getTypeDescription( )
+            libcmis::ObjectTypePtr typeDescription = m_typeDescription;
+            if ( !typeDescription && !( m_session != NULL && m_session->isLazyTypeResolution( ) ) )
+                typeDescription = getTypeDescription( );
 
-            string propertiesReq( "/*/cmis:properties/*" );
-            xpathObj = xmlXPathEvalExpression( BAD_CAST( propertiesReq.c_str() ), xpathCtx );
+            xpathObj = xpathCtx.eval( "cmis:properties/*" );
             if ( NULL != xpathObj && NULL != xpathObj->nodesetval )
             {
                 int size = xpathObj->nodesetval->nodeNr;
                 for ( int i = 0; i < size; i++ )
                 {
                     xmlNodePtr propertyNode = xpathObj->nodesetval->nodeTab[i];
-                    libcmis::PropertyPtr property = libcmis::parseProperty( propertyNode, getTypeDescription( ) );
+                    libcmis::PropertyPtr property = libcmis::parseProperty( propertyNode, typeDescription );
                     if ( property != NULL )
                         m_properties[ property->getPropertyType( )->getId() ] = property;
                 }
@@ -131,9 +134,6 @@ namespace libcmis
             xmlXPathFreeObject( xpathObj );
         }
 
-        xmlXPathFreeContext( xpathCtx );
-        xmlFreeDoc( doc );
-
         m_refreshTimestamp = time( NULL );
     }
 
@@ -292,8 +292,19 @@ namespace libcmis
     libcmis::ObjectTypePtr Object::getTypeDescription( )
     {
         if ( !m_typeDescription.get( ) && m_session != NULL )
+        {
             m_typeDescription = m_session->getType( getType( ) );
 
+            // Complete the properties parsed without their definitions
+            vector< ObjectTypePtr > types( 1, m_typeDescription );
+            for ( PropertyPtrMap::iterator it = m_properties.begin( );
+                  it != m_properties.end( ); ++it )
+            {
+                if ( it->second && it->second->getPropertyType( ) )
+                    it->second->getPropertyType( )->update( types );
+            }
+        }
+
         return m_typeDescription;
     }
 
@@ -34,6 +34,7 @@
 #include "onedrive-session.hxx"
 #include "onedrive-utils.hxx"
 #include "json-utils.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 using namespace libcmis;
@@ -56,6 +57,8 @@ OneDriveDocument::~OneDriveDocument( )
 
 vector< libcmis::FolderPtr > OneDriveDocument::getParents( ) 
 {
+    libcmis::TraceScope traceScope( "Document::getParents", getSession( ) );
+
     vector< libcmis::FolderPtr > parents;
 
     string parentId = getStringProperty( "cmis:parentId" );
@@ -68,6 +71,8 @@ vector< libcmis::FolderPtr > OneDriveDocument::getParents( )
 
 boost::shared_ptr< istream > OneDriveDocument::getContentStream( string /*streamId*/ )
 {
+    libcmis::TraceScope traceScope( "Document::getContentStream", getSession( ) );
+
     boost::shared_ptr< istream > stream;
     string streamUrl = getStringProperty( "source" );
     if ( streamUrl.empty( ) )
@@ -75,7 +80,7 @@ boost::shared_ptr< istream > OneDriveDocument::getContentStream( string /*stream
 
     try
     {
-        stream = getSession( )->httpGetRequest( streamUrl )->getStream( );
+        stream = getSession( )->httpGetContentRequest( streamUrl )->getBodyStream( );
     }
     catch ( const CurlException& e )
     {
@@ -84,11 +89,34 @@ boost::shared_ptr< istream > OneDriveDocument::getContentStream( string /*stream
     return stream;
 }
 
+void OneDriveDocument::downloadContentStream( boost::shared_ptr< libcmis::EncodedData > sink,
+                                              string /*streamId*/ )
+{
+    libcmis::TraceScope traceScope( "Document::downloadContentStream", getSession( ) );
+
+    string streamUrl = getStringProperty( "source" );
+    if ( streamUrl.empty( ) )
+        throw libcmis::Exception( "could not find stream url" );
+
+    try
+    {
+        getSession( )->httpGetContentRequest( streamUrl, sink );
+    }
+    catch ( const CurlException& e )
+    {
+        throw e.getCmisException( );
+    }
+}
+
 void OneDriveDocument::setContentStream( boost::shared_ptr< ostream > os, 
                                          string /*contentType*/, 
                                          string fileName, 
                                          bool bReplaceExisting )
 {
+    libcmis::TraceScope traceScope( "Document::setContentStream", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     if ( !os.get( ) )
         throw libcmis::Exception( "Missing stream" );
 
@@ -139,6 +167,8 @@ void OneDriveDocument::setContentStream( boost::shared_ptr< ostream > os,
 
 libcmis::DocumentPtr OneDriveDocument::checkOut( )
 {
+    libcmis::TraceScope traceScope( "Document::checkOut", getSession( ) );
+
     // OneDrive doesn't have CheckOut, so just return the same document here
     // TODO: no longer true - onedrive now has checkout/checkin
     libcmis::ObjectPtr obj = getSession( )->getObject( getId( ) );
@@ -149,6 +179,8 @@ libcmis::DocumentPtr OneDriveDocument::checkOut( )
 
 void OneDriveDocument::cancelCheckout( )
 {
+    libcmis::TraceScope traceScope( "Document::cancelCheckout", getSession( ) );
+
     // Don't do anything since we don't have CheckOut
 }
 
@@ -159,6 +191,11 @@ libcmis::DocumentPtr OneDriveDocument::checkIn( bool /*isMajor*/,
                                                 std::string contentType, 
                                                 std::string fileName ) 
 {     
+    libcmis::TraceScope traceScope( "Document::checkIn", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     // OneDrive doesn't have CheckIn, so just upload the properties, 
     // the content stream and fetch the new document resource.
     updateProperties( properties );
@@ -171,5 +208,7 @@ libcmis::DocumentPtr OneDriveDocument::checkIn( bool /*isMajor*/,
 
 vector< libcmis::DocumentPtr > OneDriveDocument::getAllVersions( ) 
 {   
+    libcmis::TraceScope traceScope( "Document::getAllVersions", getSession( ) );
+
     return vector< libcmis::DocumentPtr > ( );
 }
@@ -53,6 +53,9 @@ class OneDriveDocument : public libcmis::Document, public OneDriveObject
 
         virtual boost::shared_ptr< std::istream > getContentStream( std::string streamId = std::string( ) );
 
+        virtual void downloadContentStream( boost::shared_ptr< libcmis::EncodedData > sink,
+                                            std::string streamId = std::string( ) );
+
         virtual void setContentStream( boost::shared_ptr< std::ostream > os, 
                                        std::string contentType,
                                        std::string fileName, 
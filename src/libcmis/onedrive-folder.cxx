@@ -28,14 +28,121 @@
 
 #include "onedrive-folder.hxx"
 
+#include <boost/property_tree/ptree.hpp>
+
 #include "onedrive-document.hxx"
 #include "onedrive-session.hxx"
 #include "onedrive-property.hxx"
 #include "onedrive-utils.hxx"
+#include "trace-scope.hxx"
+#include "tree-crawler.hxx"
 
 using namespace std;
 using namespace libcmis;
 
+namespace
+{
+    /** Iterator over the children of a folder, following the
+        @odata.nextLink of the results.
+      */
+    class OneDriveChildrenIterator : public libcmis::ObjectIterator
+    {
+        private:
+            OneDriveSession* m_session;
+            string m_nextUrl;
+
+        public:
+            OneDriveChildrenIterator( OneDriveSession* session, string url ) :
+                libcmis::ObjectIterator( ),
+                m_session( session ),
+                m_nextUrl( url )
+            {
+            }
+
+            OneDriveChildrenIterator( const OneDriveChildrenIterator& copy ) = delete;
+            OneDriveChildrenIterator& operator=( const OneDriveChildrenIterator& copy ) = delete;
+
+        protected:
+            vector< libcmis::ObjectPtr > fetchNextPage( )
+            {
+                vector< libcmis::ObjectPtr > children;
+
+                libcmis::HttpResponsePtr response;
+                try
+                {
+                    response = m_session->httpGetRequest( m_nextUrl );
+                }
+                catch ( const CurlException& e )
+                {
+                    throw e.getCmisException( );
+                }
+
+                const string& res = response->getBody( );
+                Json jsonRes = Json::parse( res );
+                Json::JsonVector objs = jsonRes["value"].getList( );
+
+                // Create children objects from Json objects
+                for ( unsigned int i = 0; i < objs.size( ); i++ )
+                    children.push_back( m_session->getObjectFromJson( objs[i] ) );
+
+                // Json::operator[] would split the @odata keys on the dots
+                typedef boost::property_tree::ptree::path_type Path;
+                const boost::property_tree::ptree& tree = jsonRes.getTree( );
+                m_nextUrl = tree.get< string >( Path( "@odata.nextLink", '/' ), string( ) );
+                setHasMoreItems( !m_nextUrl.empty( ) );
+
+                boost::optional< long > count = tree.get_optional< long >( Path( "@odata.count", '/' ) );
+                if ( count )
+                    setNumItems( *count );
+
+                return children;
+            }
+    };
+
+    /** Crawler listing the children of the folders of a level in parallel.
+      */
+    class OneDriveTreeCrawler : public TreeCrawler
+    {
+        private:
+            OneDriveSession* m_session;
+            string m_select;
+
+        public:
+            OneDriveTreeCrawler( OneDriveSession* session, const libcmis::OperationContext& context ) :
+                TreeCrawler( session ),
+                m_session( session ),
+                m_select( OneDriveUtils::toOneDriveSelect( context ) )
+            {
+            }
+
+            OneDriveTreeCrawler( const OneDriveTreeCrawler& copy ) = delete;
+            OneDriveTreeCrawler& operator=( const OneDriveTreeCrawler& copy ) = delete;
+
+        protected:
+            string getChildrenUrl( const string& folderId, bool )
+            {
+                // The children can't be filtered on their facets: the
+                // crawler leaves the documents out when needed.
+                string url = m_session->getBindingUrl( ) + "/me/drive/items/" + folderId + "/children";
+                if ( !m_select.empty( ) )
+                    url += "?$select=" + libcmis::escape( m_select );
+                return url;
+            }
+
+            string parseChildren( const string&, const string& body, vector< libcmis::ObjectPtr >& children )
+            {
+                Json jsonRes = Json::parse( body );
+                Json::JsonVector objs = jsonRes["value"].getList( );
+                for ( unsigned int i = 0; i < objs.size( ); i++ )
+                    children.push_back( m_session->getObjectFromJson( objs[i] ) );
+
+                // Json::operator[] would split the @odata keys on the dots
+                typedef boost::property_tree::ptree::path_type Path;
+                return jsonRes.getTree( ).get< string >( Path( "@odata.nextLink", '/' ), string( ) );
+            }
+    };
+}
+
 OneDriveFolder::OneDriveFolder( OneDriveSession* session ):
     libcmis::Object( session ),
     OneDriveObject( session )
@@ -52,52 +159,69 @@ OneDriveFolder::~OneDriveFolder( )
 {
 }
 
-vector< libcmis::ObjectPtr > OneDriveFolder::getChildren( ) 
+vector< libcmis::ObjectPtr > OneDriveFolder::getChildren( const libcmis::OperationContext& context )
 {
+    libcmis::TraceScope traceScope( "Folder::getChildren", getSession( ) );
+
     vector< libcmis::ObjectPtr > children;
-    // TODO: limited to 200 items by default - to get more one would have to
-    // follow @odata.nextLink or change pagination size
+
+    libcmis::ObjectIteratorPtr it = listChildren( 0, 0, context );
+    while ( it->hasNext( ) )
+        children.push_back( it->next( ) );
+
+    return children;
+}
+
+libcmis::ObjectIteratorPtr OneDriveFolder::listChildren( long pageSize, long, const libcmis::OperationContext& context )
+{
+    libcmis::TraceScope traceScope( "Folder::listChildren", getSession( ) );
+
     string query = getSession( )->getBindingUrl( ) + "/me/drive/items/" + getId( ) + "/children";
+    if ( pageSize > 0 )
+        query += "?$top=" + to_string( pageSize );
 
-    string res;
-    try
+    string select = OneDriveUtils::toOneDriveSelect( context );
+    if ( !select.empty( ) )
     {
-        res = getSession( )->httpGetRequest( query )->getStream()->str();
-    }
-    catch ( const CurlException& e )
-    {
-        throw e.getCmisException( );
+        if ( query.find( '?' ) != string::npos )
+            query += "&";
+        else
+            query += "?";
+        query += "$select=" + libcmis::escape( select );
     }
 
-    Json jsonRes = Json::parse( res );
-    Json::JsonVector objs = jsonRes["value"].getList( );
-    
-    // Create children objects from Json objects
-    for(unsigned int i = 0; i < objs.size(); i++)
-    {   
-        children.push_back( getSession( )->getObjectFromJson( objs[i] ) );
-    }   
-    
-    return children;
+    return libcmis::ObjectIteratorPtr( new OneDriveChildrenIterator( getSession( ), query ) );
+}
+
+vector< libcmis::ObjectTreePtr > OneDriveFolder::getTree( int depth, bool foldersOnly,
+        const libcmis::OperationContext& context )
+{
+    libcmis::TraceScope traceScope( "Folder::getTree", getSession( ) );
+
+    OneDriveTreeCrawler crawler( getSession( ), context );
+    return crawler.crawl( getId( ), depth, foldersOnly );
 }
 
 libcmis::FolderPtr OneDriveFolder::createFolder( 
     const PropertyPtrMap& properties ) 
 {
+    libcmis::TraceScope traceScope( "Folder::createFolder", getSession( ) );
+
     Json propsJson = OneDriveUtils::toOneDriveJson( properties );
     string uploadUrl = getSession( )->getBindingUrl( ) + "/me/drive/items/" + getId( ) + "/children";
     
     std::istringstream is( propsJson.toString( ) );
-    string response;
+    libcmis::HttpResponsePtr resp;
     try
     {
-        response = getSession()->httpPostRequest( uploadUrl, is, "application/json" )
-                                    ->getStream( )->str( );
+        resp = getSession()->httpPostRequest( uploadUrl, is, "application/json" );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
+
+    const string& response = resp->getBody( );
     Json jsonRes = Json::parse( response );
     libcmis::FolderPtr folderPtr( new OneDriveFolder( getSession( ), jsonRes ) );
 
@@ -110,6 +234,8 @@ libcmis::DocumentPtr OneDriveFolder::createDocument(
     boost::shared_ptr< ostream > os, 
     string /*contentType*/, string fileName ) 
 {    
+    libcmis::TraceScope traceScope( "Folder::createDocument", getSession( ) );
+
     if ( !os.get( ) )
         throw libcmis::Exception( "Missing stream" );
     
@@ -130,19 +256,19 @@ libcmis::DocumentPtr OneDriveFolder::createDocument(
     string newDocUrl = getSession( )->getBindingUrl( ) + "/me/drive/items/" +
                        getId( ) + ":/" + fileName + ":/content";
     boost::shared_ptr< istream> is ( new istream ( os->rdbuf( ) ) );
-    string res;
+    libcmis::HttpResponsePtr response;
     // this will only create the file and return it's id, name and source url
     try
     {
         vector< string > headers;
-        res = getSession( )->httpPutRequest( newDocUrl, *is, headers )
-                                ->getStream( )->str( );
+        response = getSession( )->httpPutRequest( newDocUrl, *is, headers );
     }
     catch (const CurlException& e)
     {
         throw e.getCmisException( );
     }
-    
+
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
     DocumentPtr document( new OneDriveDocument( getSession( ), jsonRes ) );
 
@@ -159,6 +285,11 @@ vector< string > OneDriveFolder::removeTree(
     libcmis::UnfileObjects::Type /*unfile*/, 
     bool /*continueOnError*/ ) 
 {
+    libcmis::TraceScope traceScope( "Folder::removeTree", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     remove( ); 
     // Nothing to return here
     return vector< string >( );
@@ -44,7 +44,9 @@ class OneDriveFolder : public libcmis::Folder, public OneDriveObject
 
         std::string getType( ) { return std::string( "cmis:folder" );}
         std::string getBaseType( ) { return std::string( "cmis:folder" );}        
-        virtual std::vector< libcmis::ObjectPtr > getChildren( );
+        virtual std::vector< libcmis::ObjectPtr > getChildren( const libcmis::OperationContext& context = libcmis::OperationContext( ) );
+        virtual libcmis::ObjectIteratorPtr listChildren( long pageSize = 0, long readAhead = 0,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
         virtual libcmis::FolderPtr createFolder( 
             const libcmis::PropertyPtrMap& properties );
@@ -59,6 +61,10 @@ class OneDriveFolder : public libcmis::Folder, public OneDriveObject
             bool allVersion = true, 
             libcmis::UnfileObjects::Type unfile = libcmis::UnfileObjects::Delete, 
             bool continueOnError = false );
+
+    protected:
+        virtual std::vector< libcmis::ObjectTreePtr > getTree( int depth, bool foldersOnly,
+                const libcmis::OperationContext& context );
 };
 
 #endif
@@ -31,23 +31,27 @@
 #include "onedrive-property.hxx"
 #include "onedrive-repository.hxx"
 #include "onedrive-utils.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 using namespace libcmis;
 
 OneDriveObject::OneDriveObject( OneDriveSession* session ) :
-    libcmis::Object( session )
+    libcmis::Object( session ),
+    m_validators( )
 {
 }
 
 OneDriveObject::OneDriveObject( OneDriveSession* session, Json json, string id, string name ) :
-    libcmis::Object( session )
+    libcmis::Object( session ),
+    m_validators( )
 {
    initializeFromJson( json, id, name ); 
 }
 
 OneDriveObject::OneDriveObject( const OneDriveObject& copy ) :
-    libcmis::Object( copy )
+    libcmis::Object( copy ),
+    m_validators( copy.m_validators )
 {
 }
 
@@ -56,6 +60,7 @@ OneDriveObject& OneDriveObject::operator=( const OneDriveObject& copy )
     if ( this != &copy )
     {
         libcmis::Object::operator=( copy );
+        m_validators = copy.m_validators;
     }
     return *this;
 }
@@ -95,26 +100,44 @@ void OneDriveObject::refreshImpl( Json json )
 {
     m_typeDescription.reset( );
     m_properties.clear( );
+    m_validators.clear( );
     initializeFromJson( json );
 }
 
 void OneDriveObject::refresh( )
 {
-    string res;
+    libcmis::TraceScope traceScope( "Object::refresh", getSession( ) );
+
+    libcmis::HttpResponsePtr response;
+    libcmis::HttpValidators validators( m_validators );
     try
     {
-        res  = getSession()->httpGetRequest( getUrl( ) )->getStream( )->str( );
+        response = getSession()->httpConditionalGetRequest( getUrl( ), validators );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
+
+    // Nothing changed since the last refresh: keep the parsed state
+    if ( !response )
+    {
+        m_refreshTimestamp = time( NULL );
+        return;
+    }
+
+    const string& res = response->getBody( );
     Json json = Json::parse( res );
     refreshImpl( json );
+    m_validators = validators;
 }
 
 void OneDriveObject::remove( bool /*allVersions*/ )
 {
+    libcmis::TraceScope traceScope( "Object::remove", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     try
     {
         getSession( )->httpDeleteRequest( getUrl( ) );
@@ -147,6 +170,10 @@ vector< string> OneDriveObject::getMultiStringProperty( const string& propertyNa
 libcmis::ObjectPtr OneDriveObject::updateProperties(
         const PropertyPtrMap& properties )
 {
+    libcmis::TraceScope traceScope( "Object::updateProperties", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     // Make Json object from properties
     Json json = OneDriveUtils::toOneDriveJson( properties );
 
@@ -164,7 +191,7 @@ libcmis::ObjectPtr OneDriveObject::updateProperties(
         throw e.getCmisException( );
     }
     
-    string res = response->getStream( )->str( );
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
     libcmis::ObjectPtr updated = getSession()->getObjectFromJson( jsonRes );
 
@@ -176,6 +203,10 @@ libcmis::ObjectPtr OneDriveObject::updateProperties(
 
 void OneDriveObject::move( FolderPtr /*source*/, FolderPtr destination ) 
 {  
+    libcmis::TraceScope traceScope( "Object::move", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     Json destJson;
     Json destId( destination->getId( ).c_str( ) );
     destJson.add( "destination", destId );
@@ -191,7 +222,7 @@ void OneDriveObject::move( FolderPtr /*source*/, FolderPtr destination )
     {   
         throw e.getCmisException( );
     }
-    string res = response->getStream( )->str( );
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
 
     refreshImpl( jsonRes );
@@ -72,5 +72,9 @@ class OneDriveObject : public virtual libcmis::Object
     protected:
         OneDriveSession* getSession( );    
 
+
+    private:
+        /// Validators of the JSON downloaded by the last refresh
+        libcmis::HttpValidators m_validators;
 };
 #endif
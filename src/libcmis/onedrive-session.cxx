@@ -28,12 +28,16 @@
 
 #include "onedrive-session.hxx"
 
+#include <boost/property_tree/ptree.hpp>
+
 #include "oauth2-handler.hxx"
 #include "onedrive-object-type.hxx"
 #include "onedrive-document.hxx"
 #include "onedrive-folder.hxx"
 #include "onedrive-object.hxx"
 #include "onedrive-repository.hxx"
+#include "onedrive-utils.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 
@@ -62,6 +66,7 @@ OneDriveSession::OneDriveSession() :
 
 OneDriveSession::~OneDriveSession()
 {
+    stopAsyncRequests( );
 }
 
 void OneDriveSession::setOAuth2Data( libcmis::OAuth2DataPtr oauth2 )
@@ -110,23 +115,36 @@ libcmis::RepositoryPtr OneDriveSession::getRepository( )
     return repo;
 }
 
-libcmis::ObjectPtr OneDriveSession::getObject( string objectId )
+libcmis::ObjectPtr OneDriveSession::getObject( string objectId, const libcmis::OperationContext& context )
 {
+    libcmis::TraceScope traceScope( "Session::getObject", this );
+
+    libcmis::ObjectPtr cached = getCachedObject( objectId, context );
+    if ( cached )
+        return cached;
+
     // Run the http request to get the properties definition
-    string res;
+    libcmis::HttpResponsePtr response;
     string objectLink = m_bindingUrl + "/me/drive/items/" + objectId;
     if (objectId == getRootId())
         objectLink = m_bindingUrl + objectId;
+    string select = OneDriveUtils::toOneDriveSelect( context );
+    if ( !select.empty( ) )
+        objectLink += "?$select=" + libcmis::escape( select );
     try
     {
-        res = httpGetRequest( objectLink )->getStream()->str();
+        response = httpGetRequest( objectLink );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
+
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
-    return getObjectFromJson( jsonRes );
+    libcmis::ObjectPtr object = getObjectFromJson( jsonRes );
+    cacheObject( object, context );
+    return object;
 }
 
 libcmis::ObjectPtr OneDriveSession::getObjectFromJson( Json& jsonRes ) 
@@ -147,24 +165,53 @@ libcmis::ObjectPtr OneDriveSession::getObjectFromJson( Json& jsonRes )
     return object;
 }
 
-libcmis::ObjectPtr OneDriveSession::getObjectByPath( string path )
+libcmis::ObjectPtr OneDriveSession::getObjectByPath( string path, const libcmis::OperationContext& context )
 {
-    string res;
+    libcmis::TraceScope traceScope( "Session::getObjectByPath", this );
+
+    vector< string > segments = PathCache::splitPath( path );
+    string cachedId;
+    if ( !segments.empty( ) && getPathCache( ).resolve( segments, cachedId ) == segments.size( ) )
+    {
+        try
+        {
+            return getObject( cachedId, context );
+        }
+        catch ( const libcmis::Exception& )
+        {
+            // Removed by someone else: look for the path again
+            getPathCache( ).remove( cachedId );
+        }
+    }
+
+    libcmis::HttpResponsePtr response;
     string objectQuery = m_bindingUrl + "/me/drive/root:" + libcmis::escape( path );
+    string select = OneDriveUtils::toOneDriveSelect( context );
+    if ( !select.empty( ) )
+        objectQuery += "?$select=" + libcmis::escape( select );
     try
     {
-        res = httpGetRequest( objectQuery )->getStream( )->str( );
+        response = httpGetRequest( objectQuery );
     }
     catch ( const CurlException& e )
     {
         throw libcmis::Exception( "No file could be found for path " + path + ": " + e.what() );
     }
+
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
-    return getObjectFromJson( jsonRes );
+    libcmis::ObjectPtr object = getObjectFromJson( jsonRes );
+    getPathCache( ).add( segments, segments.size( ), object->getId( ) );
+    return object;
 }
 
 bool OneDriveSession::isAPathMatch( Json objectJson, string path )
 {
+    vector< string > segments = PathCache::splitPath( path );
+    string cachedId;
+    if ( !segments.empty( ) && getPathCache( ).resolve( segments, cachedId ) == segments.size( ) )
+        return cachedId == objectJson["id"].toString( );
+
     string parentId = objectJson["parent_id"].toString( );
     string objectName = objectJson["name"].toString( );
     size_t pos = path.rfind("/");
@@ -181,28 +228,100 @@ bool OneDriveSession::isAPathMatch( Json objectJson, string path )
         return false;
     }
 
-    string res;
+    libcmis::HttpResponsePtr response;
     string parentUrl = m_bindingUrl + "/" + parentId;
     try
     {
-        res = httpGetRequest( parentUrl )->getStream( )->str( );
+        response = httpGetRequest( parentUrl );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
+
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
     return isAPathMatch( jsonRes, truncatedPath );
 }
 
 libcmis::ObjectTypePtr OneDriveSession::getType( string id )
 {
-    libcmis::ObjectTypePtr type( new OneDriveObjectType( id ) );
+    libcmis::TraceScope traceScope( "Session::getType", this );
+
+    libcmis::ObjectTypePtr type = getCachedType( id );
+    if ( !type )
+    {
+        type.reset( new OneDriveObjectType( id ) );
+        cacheType( id, type );
+    }
     return type;
 }
 
 vector< libcmis::ObjectTypePtr > OneDriveSession::getBaseTypes( )
 {
+    libcmis::TraceScope traceScope( "Session::getBaseTypes", this );
+
     vector< libcmis::ObjectTypePtr > types;
     return types;
 }
+
+libcmis::ContentChanges OneDriveSession::getContentChanges( string changeLogToken, long maxItems )
+{
+    libcmis::TraceScope traceScope( "Session::getContentChanges", this );
+
+    // The links returned by the delta API already have all the parameters
+    string url = changeLogToken;
+    if ( url.find( "://" ) == string::npos )
+    {
+        url = m_bindingUrl + "/me/drive/root/delta";
+        string sep = "?";
+        if ( !changeLogToken.empty( ) )
+        {
+            url += sep + "token=" + libcmis::escape( changeLogToken );
+            sep = "&";
+        }
+        if ( maxItems > 0 )
+            url += sep + "$top=" + to_string( maxItems );
+    }
+
+    libcmis::HttpResponsePtr response;
+    try
+    {
+        response = httpGetRequest( url );
+    }
+    catch ( const CurlException& e )
+    {
+        throw e.getCmisException( );
+    }
+
+    vector< libcmis::ChangeEventPtr > events;
+    Json jsonRes = Json::parse( response->getBody( ) );
+    Json::JsonVector items = jsonRes["value"].getList( );
+    for ( Json::JsonVector::iterator it = items.begin( ); it != items.end( ); ++it )
+    {
+        libcmis::ChangeType::Type type = libcmis::ChangeType::Updated;
+        string created = ( *it )["createdDateTime"].toString( );
+        string modified = ( *it )["lastModifiedDateTime"].toString( );
+        if ( !( *it )["deleted"].toString( ).empty( ) )
+            type = libcmis::ChangeType::Deleted;
+        else if ( !created.empty( ) && created == modified )
+            type = libcmis::ChangeType::Created;
+
+        boost::posix_time::ptime time;
+        if ( !modified.empty( ) )
+            time = libcmis::parseDateTime( modified );
+
+        events.push_back( libcmis::ChangeEventPtr(
+                    new libcmis::ChangeEvent( ( *it )["id"].toString( ), type, time ) ) );
+    }
+
+    // Json::operator[] would split the @odata keys on the dots
+    typedef boost::property_tree::ptree::path_type Path;
+    const boost::property_tree::ptree& tree = jsonRes.getTree( );
+    string nextToken = tree.get< string >( Path( "@odata.nextLink", '/' ), string( ) );
+    bool hasMoreItems = !nextToken.empty( );
+    if ( !hasMoreItems )
+        nextToken = tree.get< string >( Path( "@odata.deltaLink", '/' ), changeLogToken );
+
+    return libcmis::ContentChanges( events, nextToken, hasMoreItems );
+}
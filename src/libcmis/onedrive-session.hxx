@@ -49,14 +49,22 @@ class OneDriveSession : public BaseSession
 
         virtual bool setRepository( std::string ) { return true; }
 
-        virtual libcmis::ObjectPtr getObject( std::string id );
+        virtual libcmis::ObjectPtr getObject( std::string id,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
-        virtual libcmis::ObjectPtr getObjectByPath( std::string path );
+        virtual libcmis::ObjectPtr getObjectByPath( std::string path,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
         virtual libcmis::ObjectTypePtr getType( std::string id );
         
         virtual std::vector< libcmis::ObjectTypePtr > getBaseTypes( );
 
+        /** Uses the drive delta API: the change log tokens are the
+            @odata.nextLink or @odata.deltaLink URLs of the results.
+          */
+        virtual libcmis::ContentChanges getContentChanges( std::string changeLogToken = std::string( ),
+                                                           long maxItems = 0 );
+
         libcmis::ObjectPtr getObjectFromJson( Json& jsonRes );
 
         bool isAPathMatch( Json objectJson, std::string path );
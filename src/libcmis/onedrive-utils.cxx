@@ -28,11 +28,16 @@
 
 #include "onedrive-utils.hxx"
 
+#include <algorithm>
+
+#include <boost/algorithm/string.hpp>
+
 #include <libcmis/xml-utils.hxx>
 
 #include "json-utils.hxx"
 
 using namespace std;
+using libcmis::OperationContext;
 using libcmis::PropertyPtrMap;
 
 string OneDriveUtils::toCmisKey( const string& key )
@@ -79,6 +84,33 @@ string OneDriveUtils::toOneDriveKey( const string& key )
     return convertedKey;
 }
 
+string OneDriveUtils::toOneDriveSelect( const OperationContext& context )
+{
+    if ( !context.isPropertyFilterSet( ) )
+        return string( );
+
+    // The facets telling the object type, its parent and the download
+    // link are always needed to build the object
+    vector< string > fields;
+    fields.push_back( "id" );
+    fields.push_back( "folder" );
+    fields.push_back( "file" );
+    fields.push_back( "parentReference" );
+    fields.push_back( "@microsoft.graph.downloadUrl" );
+
+    static const char* filterable[] = { "name", "description", "createdDateTime",
+                                        "lastModifiedDateTime", "size", "from" };
+    const vector< string >& filter = context.getPropertyFilter( );
+    for ( size_t i = 0; i < sizeof( filterable ) / sizeof( char* ); ++i )
+    {
+        string cmisKey = toCmisKey( filterable[i] );
+        if ( find( filter.begin( ), filter.end( ), cmisKey ) != filter.end( ) )
+            fields.push_back( filterable[i] );
+    }
+
+    return boost::algorithm::join( fields, "," );
+}
+
 bool OneDriveUtils::checkUpdatable( const std::string& key)
 {
     bool updatable = ( key == "name" ||
@@ -30,6 +30,7 @@
 
 #include <string>
 
+#include <libcmis/operation-context.hxx>
 #include <libcmis/property.hxx>
 
 #include "json-utils.hxx"
@@ -44,6 +45,10 @@ class OneDriveUtils
         // Convert a CMIS key to OneDrive key
         static std::string toOneDriveKey( const std::string& key );
 
+        // Compute the $select parameter of a request from the property filter
+        // of the operation context, or an empty string if no filter is set
+        static std::string toOneDriveSelect( const libcmis::OperationContext& context );
+
         // Check if a property is updatable
         static bool checkUpdatable( const std::string& key);
 
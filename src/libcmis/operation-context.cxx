@@ -0,0 +1,151 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include <libcmis/operation-context.hxx>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+    // Properties needed to create the objects whatever the filter
+    const char* const REQUIRED_PROPERTIES[] =
+    {
+        "cmis:objectId",
+        "cmis:objectTypeId",
+        "cmis:baseTypeId"
+    };
+}
+
+namespace libcmis
+{
+    OperationContext::OperationContext( ) :
+        m_propertyFilter( ),
+        m_includeAllowableActions( true ),
+        m_renditionFilter( ),
+        m_includeRelationships( IncludeRelationships::None )
+    {
+    }
+
+    void OperationContext::setPropertyFilter( const vector< string >& propertyIds )
+    {
+        m_propertyFilter = propertyIds;
+    }
+
+    const vector< string >& OperationContext::getPropertyFilter( ) const
+    {
+        return m_propertyFilter;
+    }
+
+    bool OperationContext::isPropertyFilterSet( ) const
+    {
+        return !m_propertyFilter.empty( );
+    }
+
+    string OperationContext::getFilter( ) const
+    {
+        if ( m_propertyFilter.empty( ) )
+            return "*";
+
+        vector< string > ids( REQUIRED_PROPERTIES,
+                              REQUIRED_PROPERTIES + sizeof( REQUIRED_PROPERTIES ) / sizeof( char* ) );
+        for ( vector< string >::const_iterator it = m_propertyFilter.begin( );
+                it != m_propertyFilter.end( ); ++it )
+        {
+            if ( find( ids.begin( ), ids.end( ), *it ) == ids.end( ) )
+                ids.push_back( *it );
+        }
+
+        string filter;
+        for ( vector< string >::iterator it = ids.begin( ); it != ids.end( ); ++it )
+        {
+            if ( !filter.empty( ) )
+                filter += ",";
+            filter += *it;
+        }
+        return filter;
+    }
+
+    void OperationContext::setIncludeAllowableActions( bool include )
+    {
+        m_includeAllowableActions = include;
+    }
+
+    bool OperationContext::isIncludeAllowableActions( ) const
+    {
+        return m_includeAllowableActions;
+    }
+
+    void OperationContext::setRenditionFilter( const string& filter )
+    {
+        m_renditionFilter = filter;
+    }
+
+    const string& OperationContext::getRenditionFilter( ) const
+    {
+        return m_renditionFilter;
+    }
+
+    void OperationContext::setIncludeRelationships( IncludeRelationships::Type include )
+    {
+        m_includeRelationships = include;
+    }
+
+    IncludeRelationships::Type OperationContext::getIncludeRelationships( ) const
+    {
+        return m_includeRelationships;
+    }
+
+    string OperationContext::getIncludeRelationshipsString( ) const
+    {
+        string value;
+        switch ( m_includeRelationships )
+        {
+            case IncludeRelationships::None:
+                value = "none";
+                break;
+            case IncludeRelationships::Source:
+                value = "source";
+                break;
+            case IncludeRelationships::Target:
+                value = "target";
+                break;
+            case IncludeRelationships::Both:
+                value = "both";
+                break;
+        }
+        return value;
+    }
+
+    bool OperationContext::isDefault( ) const
+    {
+        return m_propertyFilter.empty( ) && m_includeAllowableActions &&
+               m_renditionFilter.empty( ) && m_includeRelationships == IncludeRelationships::None;
+    }
+}
@@ -0,0 +1,166 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "path-cache.hxx"
+
+using namespace std;
+
+PathCache::PathCache( ) :
+    m_root( ),
+    m_ttl( 0 ),
+    m_hits( 0 ),
+    m_misses( 0 ),
+    m_mutex( )
+{
+}
+
+void PathCache::setTtl( long seconds )
+{
+    lock_guard< mutex > lock( m_mutex );
+    m_ttl = seconds;
+    if ( 0 == seconds )
+        m_root.m_children.clear( );
+}
+
+size_t PathCache::resolve( const vector< string >& segments, string& id )
+{
+    lock_guard< mutex > lock( m_mutex );
+    if ( 0 == m_ttl )
+        return 0;
+
+    time_t now = time( NULL );
+    Node* node = &m_root;
+    size_t count = 0;
+    for ( size_t i = 0; i < segments.size( ); ++i )
+    {
+        map< string, Node >::iterator it = node->m_children.find( segments[i] );
+        if ( it == node->m_children.end( ) )
+            break;
+
+        // The segments added only to reach a longer path have no id:
+        // they can't expire nor end the known prefix.
+        if ( !it->second.m_id.empty( ) )
+        {
+            // The paths below an expired segment can't be trusted either
+            if ( m_ttl > 0 && difftime( now, it->second.m_time ) >= m_ttl )
+            {
+                node->m_children.erase( it );
+                break;
+            }
+
+            id = it->second.m_id;
+            count = i + 1;
+        }
+        node = &it->second;
+    }
+
+    if ( count == segments.size( ) )
+        ++m_hits;
+    else
+        ++m_misses;
+
+    return count;
+}
+
+void PathCache::add( const vector< string >& segments, size_t count, const string& id )
+{
+    lock_guard< mutex > lock( m_mutex );
+    if ( 0 == m_ttl || 0 == count || count > segments.size( ) )
+        return;
+
+    Node* node = &m_root;
+    for ( size_t i = 0; i < count; ++i )
+        node = &node->m_children[ segments[i] ];
+
+    if ( node->m_id != id )
+        node->m_children.clear( );
+    node->m_id = id;
+    node->m_time = time( NULL );
+}
+
+void PathCache::remove( const string& id )
+{
+    lock_guard< mutex > lock( m_mutex );
+    removeId( m_root, id );
+}
+
+void PathCache::clear( )
+{
+    lock_guard< mutex > lock( m_mutex );
+    m_root.m_children.clear( );
+}
+
+long PathCache::getHits( )
+{
+    lock_guard< mutex > lock( m_mutex );
+    return m_hits;
+}
+
+long PathCache::getMisses( )
+{
+    lock_guard< mutex > lock( m_mutex );
+    return m_misses;
+}
+
+void PathCache::resetCounters( )
+{
+    lock_guard< mutex > lock( m_mutex );
+    m_hits = 0;
+    m_misses = 0;
+}
+
+vector< string > PathCache::splitPath( const string& path )
+{
+    vector< string > segments;
+    size_t pos = 0;
+    while ( pos <= path.size( ) )
+    {
+        size_t endpos = path.find( '/', pos );
+        if ( endpos == string::npos )
+            endpos = path.size( );
+        if ( endpos > pos )
+            segments.push_back( path.substr( pos, endpos - pos ) );
+        pos = endpos + 1;
+    }
+    return segments;
+}
+
+void PathCache::removeId( Node& node, const string& id )
+{
+    map< string, Node >::iterator it = node.m_children.begin( );
+    while ( it != node.m_children.end( ) )
+    {
+        if ( it->second.m_id == id )
+            node.m_children.erase( it++ );
+        else
+        {
+            removeId( it->second, id );
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _PATH_CACHE_HXX_
+#define _PATH_CACHE_HXX_
+
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** Cache of the ids of the objects found by path, for the bindings
+    resolving the paths one segment at a time.
+
+    The known paths are stored as a trie of their segments: resolving
+    a path only needs to ask the server for the segments after the
+    longest known prefix.
+  */
+class PathCache
+{
+    private:
+        struct Node
+        {
+            std::string m_id;
+            time_t m_time;
+            std::map< std::string, Node > m_children;
+
+            Node( ) : m_id( ), m_time( 0 ), m_children( ) { }
+        };
+
+        Node m_root;
+        long m_ttl;
+        long m_hits;
+        long m_misses;
+        std::mutex m_mutex;
+
+    public:
+        PathCache( );
+
+        PathCache( const PathCache& copy ) = delete;
+        PathCache& operator=( const PathCache& copy ) = delete;
+
+        /** Set how long, in seconds, the ids are reused. 0, the default,
+            disables the cache and a negative value keeps the ids until
+            they are invalidated.
+          */
+        void setTtl( long seconds );
+
+        /** Find the longest known prefix of a path. Finding the whole
+            path counts as a hit, anything shorter as a miss.
+
+            \param segments the path segments, as given by splitPath( )
+            \param id set to the id of the object at the end of the prefix,
+                    untouched if no prefix is known.
+
+            \return the number of segments of the known prefix
+          */
+        size_t resolve( const std::vector< std::string >& segments, std::string& id );
+
+        /** Remember the id of the object at the path made of the first
+            count segments.
+          */
+        void add( const std::vector< std::string >& segments, size_t count, const std::string& id );
+
+        /** Forget the paths of an object and of all the paths below them,
+            for example when it is renamed, moved or deleted.
+          */
+        void remove( const std::string& id );
+
+        void clear( );
+
+        long getHits( );
+        long getMisses( );
+        void resetCounters( );
+
+        /** Split a path into its segments, ignoring the empty ones.
+          */
+        static std::vector< std::string > splitPath( const std::string& path );
+
+    private:
+        static void removeId( Node& node, const std::string& id );
+};
+
+#endif
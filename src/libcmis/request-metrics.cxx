@@ -0,0 +1,69 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include <libcmis/request-metrics.hxx>
+
+using namespace std;
+
+namespace libcmis
+{
+    RequestMetrics::RequestMetrics( ) :
+        m_method( ),
+        m_urlTemplate( ),
+        m_status( 0 ),
+        m_nameLookupTime( 0 ),
+        m_connectTime( 0 ),
+        m_appConnectTime( 0 ),
+        m_startTransferTime( 0 ),
+        m_totalTime( 0 ),
+        m_downloadSize( 0 ),
+        m_uploadSize( 0 )
+    {
+    }
+
+    RequestMetrics::RequestMetrics( string method, string urlTemplate, long status,
+            double nameLookupTime, double connectTime,
+            double appConnectTime, double startTransferTime,
+            double totalTime, long downloadSize, long uploadSize ) :
+        m_method( method ),
+        m_urlTemplate( urlTemplate ),
+        m_status( status ),
+        m_nameLookupTime( nameLookupTime ),
+        m_connectTime( connectTime ),
+        m_appConnectTime( appConnectTime ),
+        m_startTransferTime( startTransferTime ),
+        m_totalTime( totalTime ),
+        m_downloadSize( downloadSize ),
+        m_uploadSize( uploadSize )
+    {
+    }
+
+    RequestMetrics::~RequestMetrics( )
+    {
+    }
+}
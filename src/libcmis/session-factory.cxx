@@ -28,7 +28,10 @@
 
 #include <libcmis/session-factory.hxx>
 
+#include <mutex>
+
 #include "atom-session.hxx"
+#include "concurrency-limiter.hxx"
 #include "gdrive-session.hxx"
 #include "onedrive-session.hxx"
 #include "sharepoint-session.hxx"
@@ -36,6 +39,53 @@
 
 using namespace std;
 
+namespace
+{
+    struct ConnectionCacheConfig
+    {
+        ConnectionCacheConfig( ) :
+            m_mutex( ),
+            m_shareDns( true ),
+            m_shareSslSessions( true ),
+            m_shareConnections( true ),
+            m_share( )
+        {
+        }
+
+        std::mutex m_mutex;
+        bool m_shareDns;
+        bool m_shareSslSessions;
+        bool m_shareConnections;
+        libcmis::CurlSharePtr m_share;
+    };
+
+    ConnectionCacheConfig& lcl_getConnectionCacheConfig( )
+    {
+        static ConnectionCacheConfig config;
+        return config;
+    }
+
+    // The observer and the exporter are read by the threads of the
+    // asynchronous requests
+    mutex& lcl_getRequestObserverMutex( )
+    {
+        static mutex observerMutex;
+        return observerMutex;
+    }
+
+    libcmis::RequestObserverPtr& lcl_getRequestObserver( )
+    {
+        static libcmis::RequestObserverPtr observer;
+        return observer;
+    }
+
+    libcmis::TraceExporterPtr& lcl_getTraceExporter( )
+    {
+        static libcmis::TraceExporterPtr exporter;
+        return exporter;
+    }
+}
+
 namespace libcmis
 {
     CurlInitProtocolsFunction g_CurlInitProtocolsFunction = 0;
@@ -63,6 +113,81 @@ namespace libcmis
         SessionFactory::s_proxyPass = proxyPass;
     }
 
+    void SessionFactory::setConnectionCacheOptions( bool shareDns,
+            bool shareSslSessions, bool shareConnections )
+    {
+        ConnectionCacheConfig& config = lcl_getConnectionCacheConfig( );
+        lock_guard< mutex > guard( config.m_mutex );
+        config.m_shareDns = shareDns;
+        config.m_shareSslSessions = shareSslSessions;
+        config.m_shareConnections = shareConnections;
+        config.m_share.reset( );
+    }
+
+    void SessionFactory::flushConnectionCache( )
+    {
+        ConnectionCacheConfig& config = lcl_getConnectionCacheConfig( );
+        lock_guard< mutex > guard( config.m_mutex );
+        config.m_share.reset( );
+    }
+
+    CurlSharePtr getConnectionCache( )
+    {
+        ConnectionCacheConfig& config = lcl_getConnectionCacheConfig( );
+        lock_guard< mutex > guard( config.m_mutex );
+
+        // The cache is created lazily after a flush so that idle
+        // processes don't hold anything.
+        if ( !config.m_share &&
+             ( config.m_shareDns || config.m_shareSslSessions || config.m_shareConnections ) )
+        {
+            config.m_share.reset( new CurlShare( config.m_shareDns,
+                        config.m_shareSslSessions, config.m_shareConnections ) );
+        }
+        return config.m_share;
+    }
+
+    void SessionFactory::setConcurrencyLimits( unsigned int initialLimit, unsigned int maxLimit )
+    {
+        ConcurrencyLimiter::configure( initialLimit, maxLimit );
+    }
+
+    unsigned int SessionFactory::getConcurrencyLimit( const string& host )
+    {
+        ConcurrencyLimiterPtr limiter = ConcurrencyLimiter::find( host );
+        return limiter ? limiter->getLimit( ) : 0;
+    }
+
+    unsigned int SessionFactory::getQueuedRequests( const string& host )
+    {
+        ConcurrencyLimiterPtr limiter = ConcurrencyLimiter::find( host );
+        return limiter ? limiter->getQueued( ) : 0;
+    }
+
+    void SessionFactory::setRequestObserver( const RequestObserverPtr& observer )
+    {
+        lock_guard< mutex > guard( lcl_getRequestObserverMutex( ) );
+        lcl_getRequestObserver( ) = observer;
+    }
+
+    RequestObserverPtr SessionFactory::getRequestObserver( )
+    {
+        lock_guard< mutex > guard( lcl_getRequestObserverMutex( ) );
+        return lcl_getRequestObserver( );
+    }
+
+    void SessionFactory::setTraceExporter( const TraceExporterPtr& exporter )
+    {
+        lock_guard< mutex > guard( lcl_getRequestObserverMutex( ) );
+        lcl_getTraceExporter( ) = exporter;
+    }
+
+    TraceExporterPtr SessionFactory::getTraceExporter( )
+    {
+        lock_guard< mutex > guard( lcl_getRequestObserverMutex( ) );
+        return lcl_getTraceExporter( );
+    }
+
     Session* SessionFactory::createSession( string bindingUrl, string username,
             string password, string repository, bool noSslCheck,
             libcmis::OAuth2DataPtr oauth2, bool verbose )
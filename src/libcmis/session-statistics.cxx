@@ -0,0 +1,224 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include <libcmis/session-statistics.hxx>
+
+using namespace std;
+
+namespace
+{
+    // Exact buckets, then as many buckets per power of two
+    const size_t SUB_BUCKETS = 8;
+    const int SUB_BUCKETS_BITS = 3;
+
+    // Up to 2^36µs, about 19 hours
+    const int MAX_EXPONENT = 35;
+    const size_t BUCKETS_COUNT = SUB_BUCKETS + ( MAX_EXPONENT - SUB_BUCKETS_BITS + 1 ) * SUB_BUCKETS;
+}
+
+namespace libcmis
+{
+    LatencyHistogram::LatencyHistogram( ) :
+        m_counts( BUCKETS_COUNT, 0 ),
+        m_count( 0 ),
+        m_minimum( 0 ),
+        m_maximum( 0 ),
+        m_sum( 0 )
+    {
+    }
+
+    LatencyHistogram::LatencyHistogram( vector< long > counts, long minimum, long maximum, double sum ) :
+        m_counts( counts ),
+        m_count( 0 ),
+        m_minimum( minimum ),
+        m_maximum( maximum ),
+        m_sum( sum )
+    {
+        m_counts.resize( BUCKETS_COUNT, 0 );
+        for ( vector< long >::const_iterator it = m_counts.begin( ); it != m_counts.end( ); ++it )
+            m_count += *it;
+    }
+
+    LatencyHistogram::~LatencyHistogram( )
+    {
+    }
+
+    double LatencyHistogram::getMinimum( ) const
+    {
+        return m_count > 0 ? m_minimum / 1000.0 : 0;
+    }
+
+    double LatencyHistogram::getMaximum( ) const
+    {
+        return m_count > 0 ? m_maximum / 1000.0 : 0;
+    }
+
+    double LatencyHistogram::getMean( ) const
+    {
+        return m_count > 0 ? m_sum / m_count / 1000.0 : 0;
+    }
+
+    double LatencyHistogram::getPercentile( double percentile ) const
+    {
+        if ( m_count == 0 )
+            return 0;
+
+        double rank = percentile / 100.0 * m_count;
+        long seen = 0;
+        for ( size_t i = 0; i < m_counts.size( ); ++i )
+        {
+            seen += m_counts[i];
+            if ( seen > 0 && seen >= rank )
+            {
+                // The highest value of the bucket, without going past
+                // the highest value counted
+                long value = m_maximum;
+                if ( i + 1 < m_counts.size( ) && getBucketLowerBound( i + 1 ) - 1 < m_maximum )
+                    value = getBucketLowerBound( i + 1 ) - 1;
+                if ( value < m_minimum )
+                    value = m_minimum;
+                return value / 1000.0;
+            }
+        }
+        return getMaximum( );
+    }
+
+    size_t LatencyHistogram::getBucketsCount( )
+    {
+        return BUCKETS_COUNT;
+    }
+
+    size_t LatencyHistogram::getBucket( long microseconds )
+    {
+        if ( microseconds < long( SUB_BUCKETS ) )
+            return microseconds > 0 ? size_t( microseconds ) : 0;
+
+        int exponent = 0;
+        for ( unsigned long value = microseconds; value > 1; value >>= 1 )
+            ++exponent;
+        if ( exponent > MAX_EXPONENT )
+            return BUCKETS_COUNT - 1;
+
+        size_t sub = ( microseconds >> ( exponent - SUB_BUCKETS_BITS ) ) & ( SUB_BUCKETS - 1 );
+        return SUB_BUCKETS + ( exponent - SUB_BUCKETS_BITS ) * SUB_BUCKETS + sub;
+    }
+
+    long LatencyHistogram::getBucketLowerBound( size_t bucket )
+    {
+        if ( bucket < SUB_BUCKETS )
+            return long( bucket );
+
+        size_t exponent = ( bucket - SUB_BUCKETS ) / SUB_BUCKETS + SUB_BUCKETS_BITS;
+        size_t sub = ( bucket - SUB_BUCKETS ) % SUB_BUCKETS;
+        return long( ( SUB_BUCKETS + sub ) << ( exponent - SUB_BUCKETS_BITS ) );
+    }
+
+    SessionStatistics::SessionStatistics( ) :
+        m_requestsByMethod( ),
+        m_responsesByClass( 6, 0 ),
+        m_bytesReceived( 0 ),
+        m_bytesSent( 0 ),
+        m_retries( 0 ),
+        m_tokenRefreshes( 0 ),
+        m_objectCacheHits( 0 ),
+        m_objectCacheMisses( 0 ),
+        m_typeCacheHits( 0 ),
+        m_typeCacheMisses( 0 ),
+        m_pathCacheHits( 0 ),
+        m_pathCacheMisses( 0 ),
+        m_latencies( )
+    {
+    }
+
+    SessionStatistics::~SessionStatistics( )
+    {
+    }
+
+    long SessionStatistics::getRequests( const string& method ) const
+    {
+        map< string, long >::const_iterator it = m_requestsByMethod.find( method );
+        return it != m_requestsByMethod.end( ) ? it->second : 0;
+    }
+
+    long SessionStatistics::getRequestsCount( ) const
+    {
+        long count = 0;
+        for ( map< string, long >::const_iterator it = m_requestsByMethod.begin( );
+                it != m_requestsByMethod.end( ); ++it )
+            count += it->second;
+        return count;
+    }
+
+    long SessionStatistics::getResponses( int statusClass ) const
+    {
+        if ( statusClass < 0 || size_t( statusClass ) >= m_responsesByClass.size( ) )
+            return 0;
+        return m_responsesByClass[ statusClass ];
+    }
+
+    void SessionStatistics::addRequests( const string& method, long count )
+    {
+        if ( count > 0 )
+            m_requestsByMethod[ method ] += count;
+    }
+
+    void SessionStatistics::addResponses( int statusClass, long count )
+    {
+        if ( statusClass >= 0 && size_t( statusClass ) < m_responsesByClass.size( ) )
+            m_responsesByClass[ statusClass ] += count;
+    }
+
+    void SessionStatistics::setBytes( long received, long sent )
+    {
+        m_bytesReceived = received;
+        m_bytesSent = sent;
+    }
+
+    void SessionStatistics::setObjectCache( long hits, long misses )
+    {
+        m_objectCacheHits = hits;
+        m_objectCacheMisses = misses;
+    }
+
+    void SessionStatistics::setTypeCache( long hits, long misses )
+    {
+        m_typeCacheHits = hits;
+        m_typeCacheMisses = misses;
+    }
+
+    void SessionStatistics::setPathCache( long hits, long misses )
+    {
+        m_pathCacheHits = hits;
+        m_pathCacheMisses = misses;
+    }
+
+    void SessionStatistics::setLatency( const string& name, const LatencyHistogram& histogram )
+    {
+        m_latencies[ name ] = histogram;
+    }
+}
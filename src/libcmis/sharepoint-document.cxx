@@ -31,6 +31,7 @@
 #include "sharepoint-session.hxx"
 #include "sharepoint-utils.hxx"
 #include "json-utils.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 using namespace libcmis;
@@ -53,6 +54,8 @@ SharePointDocument::~SharePointDocument( )
 
 vector< libcmis::FolderPtr > SharePointDocument::getParents( ) 
 {
+    libcmis::TraceScope traceScope( "Document::getParents", getSession( ) );
+
     vector< libcmis::FolderPtr > parents;
 
     string parentId = getStringProperty( "cmis:parentId" );
@@ -65,12 +68,14 @@ vector< libcmis::FolderPtr > SharePointDocument::getParents( )
 
 boost::shared_ptr< istream > SharePointDocument::getContentStream( string /*streamId*/ )
 {
+    libcmis::TraceScope traceScope( "Document::getContentStream", getSession( ) );
+
     boost::shared_ptr< istream > stream;
     // file uri + /$value
     string streamUrl = getId( ) + "/%24value";
     try
     {
-        stream = getSession( )->httpGetRequest( streamUrl )->getStream( );
+        stream = getSession( )->httpGetContentRequest( streamUrl )->getBodyStream( );
     }
     catch ( const CurlException& e )
     {
@@ -79,11 +84,32 @@ boost::shared_ptr< istream > SharePointDocument::getContentStream( string /*stre
     return stream;
 }
 
+void SharePointDocument::downloadContentStream( boost::shared_ptr< libcmis::EncodedData > sink,
+                                                string /*streamId*/ )
+{
+    libcmis::TraceScope traceScope( "Document::downloadContentStream", getSession( ) );
+
+    // file uri + /$value
+    string streamUrl = getId( ) + "/%24value";
+    try
+    {
+        getSession( )->httpGetContentRequest( streamUrl, sink );
+    }
+    catch ( const CurlException& e )
+    {
+        throw e.getCmisException( );
+    }
+}
+
 void SharePointDocument::setContentStream( boost::shared_ptr< ostream > os, 
                                            string contentType, 
                                            string /*fileName*/, 
                                            bool /*overwrite*/ ) 
 {
+    libcmis::TraceScope traceScope( "Document::setContentStream", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     if ( !os.get( ) )
         throw libcmis::Exception( "Missing stream" );
 
@@ -112,6 +138,10 @@ void SharePointDocument::setContentStream( boost::shared_ptr< ostream > os,
 
 libcmis::DocumentPtr SharePointDocument::checkOut( )
 {
+    libcmis::TraceScope traceScope( "Document::checkOut", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     istringstream is( "" );
     string url = getId( ) + "/checkout";
     try 
@@ -130,6 +160,11 @@ libcmis::DocumentPtr SharePointDocument::checkOut( )
 
 void SharePointDocument::cancelCheckout( )
 {
+    libcmis::TraceScope traceScope( "Document::cancelCheckout", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     istringstream is( "" );
     string url = getId( ) + "/undocheckout";
     try 
@@ -149,6 +184,11 @@ libcmis::DocumentPtr SharePointDocument::checkIn( bool isMajor,
                                                   std::string contentType, 
                                                   std::string fileName ) 
 {     
+    libcmis::TraceScope traceScope( "Document::checkIn", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     setContentStream( stream, contentType, fileName );
     comment = libcmis::escape( comment );
     string url = getId( ) + "/checkin(comment='" + comment + "'";
@@ -178,18 +218,21 @@ libcmis::DocumentPtr SharePointDocument::checkIn( bool isMajor,
 
 vector< libcmis::DocumentPtr > SharePointDocument::getAllVersions( ) 
 {   
-    string res;
+    libcmis::TraceScope traceScope( "Document::getAllVersions", getSession( ) );
+
+    libcmis::HttpResponsePtr response;
     string url = getStringProperty( "Versions" );
     vector< libcmis::DocumentPtr > allVersions;
     try
     {
-        res = getSession( )->httpGetRequest( url )->getStream( )->str( );
+        response = getSession( )->httpGetRequest( url );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
 
+    const string& res = response->getBody( );
     // adding the latest version
     libcmis::ObjectPtr obj = getSession( )->getObject( getId( ) );
     libcmis::DocumentPtr doc =
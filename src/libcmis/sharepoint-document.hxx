@@ -51,6 +51,9 @@ class SharePointDocument : public libcmis::Document, public SharePointObject
         virtual std::vector< libcmis::FolderPtr > getParents( );
         virtual boost::shared_ptr< std::istream > getContentStream( std::string streamId = std::string( ) );
 
+        virtual void downloadContentStream( boost::shared_ptr< libcmis::EncodedData > sink,
+                                            std::string streamId = std::string( ) );
+
         virtual void setContentStream( boost::shared_ptr< std::ostream > os, 
                                        std::string contentType,
                                        std::string fileName, 
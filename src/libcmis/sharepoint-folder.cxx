@@ -32,10 +32,76 @@
 #include "sharepoint-session.hxx"
 #include "sharepoint-property.hxx"
 #include "sharepoint-utils.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 using namespace libcmis;
 
+namespace
+{
+    /** Iterator over the children of a folder, following the __next
+        link of each of the collections in turn.
+      */
+    class SharePointChildrenIterator : public libcmis::ObjectIterator
+    {
+        private:
+            SharePointSession* m_session;
+            string m_folderId;
+            vector< string > m_urls;
+            size_t m_current;
+
+        public:
+            SharePointChildrenIterator( SharePointSession* session, string folderId,
+                                        const vector< string >& urls ) :
+                libcmis::ObjectIterator( ),
+                m_session( session ),
+                m_folderId( folderId ),
+                m_urls( urls ),
+                m_current( 0 )
+            {
+            }
+
+            SharePointChildrenIterator( const SharePointChildrenIterator& copy ) = delete;
+            SharePointChildrenIterator& operator=( const SharePointChildrenIterator& copy ) = delete;
+
+        protected:
+            vector< libcmis::ObjectPtr > fetchNextPage( )
+            {
+                vector< libcmis::ObjectPtr > children;
+
+                // Skip the empty collections as empty pages would end the iteration
+                while ( children.empty( ) && m_current < m_urls.size( ) )
+                {
+                    libcmis::HttpResponsePtr response;
+                    try
+                    {
+                        response = m_session->httpGetRequest( m_urls[m_current] );
+                    }
+                    catch ( const CurlException& e )
+                    {
+                        throw e.getCmisException( );
+                    }
+
+                    const string& res = response->getBody( );
+                    Json jsonRes = Json::parse( res );
+                    Json::JsonVector objs = jsonRes["d"]["results"].getList( );
+                    for ( unsigned int i = 0; i < objs.size( ); i++ )
+                        children.push_back( m_session->getObjectFromJson( objs[i], m_folderId ) );
+
+                    string next = jsonRes["d"]["__next"].toString( );
+                    if ( next.empty( ) )
+                        ++m_current;
+                    else
+                        m_urls[m_current] = next;
+                }
+
+                setHasMoreItems( m_current < m_urls.size( ) );
+
+                return children;
+            }
+    };
+}
+
 SharePointFolder::SharePointFolder( SharePointSession* session ):
     libcmis::Object( session ),
     SharePointObject( session )
@@ -58,16 +124,17 @@ string SharePointFolder::getParentId( )
     if ( parentId.empty( ) )
     {
         string parentUrl = getStringProperty( "ParentFolder" );
-        string res;
+        libcmis::HttpResponsePtr response;
         try
         {
-            res = getSession( )->httpGetRequest( parentUrl )->getStream( )->str( );
+            response = getSession( )->httpGetRequest( parentUrl );
         }
         catch ( const CurlException& e )
         {
             throw e.getCmisException( );
         }
 
+        const string& res = response->getBody( );
         Json jsonRes = Json::parse( res );
         parentId = jsonRes["d"]["__metadata"]["uri"].toString( );
         PropertyPtr property;
@@ -78,34 +145,51 @@ string SharePointFolder::getParentId( )
     return parentId;
 }
 
-vector< libcmis::ObjectPtr > SharePointFolder::getChildren( ) 
+vector< libcmis::ObjectPtr > SharePointFolder::getChildren( const libcmis::OperationContext& context )
 {
+    libcmis::TraceScope traceScope( "Folder::getChildren", getSession( ) );
+
     vector< libcmis::ObjectPtr > children;
-    string filesUrl = getStringProperty( "Files" );
-    string foldersUrl = getStringProperty( "Folders" );
 
-    Json::JsonVector objs = getChildrenImpl( filesUrl );
-    Json::JsonVector folders = getChildrenImpl( foldersUrl );
-    objs.insert( objs.begin( ), folders.begin( ), folders.end( ) );
+    libcmis::ObjectIteratorPtr it = listChildren( 0, 0, context );
+    while ( it->hasNext( ) )
+        children.push_back( it->next( ) );
 
-    for ( unsigned int i = 0; i < objs.size( ); i++)
+    return children;
+}
+
+libcmis::ObjectIteratorPtr SharePointFolder::listChildren( long pageSize, long,
+        const libcmis::OperationContext& context )
+{
+    libcmis::TraceScope traceScope( "Folder::listChildren", getSession( ) );
+
+    // List the folders first, then the files
+    vector< string > urls;
+    urls.push_back( getStringProperty( "Folders" ) );
+    urls.push_back( getStringProperty( "Files" ) );
+    for ( vector< string >::iterator it = urls.begin( ); it != urls.end( ); ++it )
     {
-        children.push_back( getSession( )->getObjectFromJson( objs[i], getId( ) ) );
+        if ( pageSize > 0 )
+            *it += "?$top=" + to_string( pageSize );
+        *it = SharePointUtils::addSelect( *it, context );
     }
-    return children;
+
+    return libcmis::ObjectIteratorPtr( new SharePointChildrenIterator( getSession( ), getId( ), urls ) );
 }
 
 Json::JsonVector SharePointFolder::getChildrenImpl( string url )
 {
-    string res;
+    libcmis::HttpResponsePtr response;
     try
     {
-        res = getSession( )->httpGetRequest( url )->getStream( )->str( );
+        response = getSession( )->httpGetRequest( url );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
+
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
     Json::JsonVector objs = jsonRes["d"]["results"].getList( );
     return objs;
@@ -113,6 +197,8 @@ Json::JsonVector SharePointFolder::getChildrenImpl( string url )
 
 libcmis::FolderPtr SharePointFolder::createFolder( const PropertyPtrMap& properties ) 
 {
+    libcmis::TraceScope traceScope( "Folder::createFolder", getSession( ) );
+
     string folderName;
     for ( PropertyPtrMap::const_iterator it = properties.begin() ; 
             it != properties.end() ; ++it )
@@ -137,15 +223,17 @@ libcmis::FolderPtr SharePointFolder::createFolder( const PropertyPtrMap& propert
     folderUrl += "/folders/add('" + relativeUrl + "')";
 
     istringstream is( "" );
-    string res;
+    libcmis::HttpResponsePtr response;
     try 
     {   
-        res = getSession( )->httpPostRequest( folderUrl, is, "" )->getStream( )->str( );
+        response = getSession( )->httpPostRequest( folderUrl, is, "" );
     }
     catch ( const CurlException& e )
     {   
         throw e.getCmisException( );
     }
+
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
 
     libcmis::FolderPtr newFolder( new SharePointFolder( getSession( ), jsonRes, getId( ) ) );
@@ -157,6 +245,8 @@ libcmis::DocumentPtr SharePointFolder::createDocument( const PropertyPtrMap& pro
                                                        string contentType, 
                                                        string fileName ) 
 {    
+    libcmis::TraceScope traceScope( "Folder::createDocument", getSession( ) );
+
     if ( !os.get( ) )
         throw libcmis::Exception( "Missing stream" );
 
@@ -178,16 +268,17 @@ libcmis::DocumentPtr SharePointFolder::createDocument( const PropertyPtrMap& pro
 
     // Upload stream
     boost::shared_ptr< istream> is ( new istream ( os->rdbuf( ) ) );
-    string res;
+    libcmis::HttpResponsePtr response;
     try
     {
-        res = getSession( )->httpPostRequest( url, *is, contentType )->getStream( )->str( );
+        response = getSession( )->httpPostRequest( url, *is, contentType );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
 
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
     DocumentPtr document( new SharePointDocument( getSession( ), jsonRes, getId( ) ) );
     return document;
@@ -197,6 +288,11 @@ vector< string > SharePointFolder::removeTree( bool /*allVersions*/,
                                                libcmis::UnfileObjects::Type /*unfile*/, 
                                                bool /*continueOnError*/ ) 
 {
+    libcmis::TraceScope traceScope( "Folder::removeTree", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     remove( ); 
     // Nothing to return here
     return vector< string >( );
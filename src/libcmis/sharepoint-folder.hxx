@@ -47,7 +47,9 @@ class SharePointFolder : public libcmis::Folder, public SharePointObject
         std::string getType( ) { return std::string( "cmis:folder" );}
         std::string getBaseType( ) { return std::string( "cmis:folder" );}        
         virtual std::string getParentId( );
-        virtual std::vector< libcmis::ObjectPtr > getChildren( );
+        virtual std::vector< libcmis::ObjectPtr > getChildren( const libcmis::OperationContext& context = libcmis::OperationContext( ) );
+        virtual libcmis::ObjectIteratorPtr listChildren( long pageSize = 0, long readAhead = 0,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
         Json::JsonVector getChildrenImpl( std::string url );
 
@@ -31,23 +31,27 @@
 #include "sharepoint-property.hxx"
 #include "sharepoint-repository.hxx"
 #include "sharepoint-utils.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 using namespace libcmis;
 
 SharePointObject::SharePointObject( SharePointSession* session ) :
-    libcmis::Object( session )
+    libcmis::Object( session ),
+    m_validators( )
 {
 }
 
 SharePointObject::SharePointObject( SharePointSession* session, Json json, string parentId, string name ) :
-    libcmis::Object( session )
+    libcmis::Object( session ),
+    m_validators( )
 {
    initializeFromJson( json, parentId, name ); 
 }
 
 SharePointObject::SharePointObject( const SharePointObject& copy ) :
-    libcmis::Object( copy )
+    libcmis::Object( copy ),
+    m_validators( copy.m_validators )
 {
 }
 
@@ -56,6 +60,7 @@ SharePointObject& SharePointObject::operator=( const SharePointObject& copy )
     if ( this != &copy )
     {
         libcmis::Object::operator=( copy );
+        m_validators = copy.m_validators;
     }
     return *this;
 }
@@ -129,26 +134,44 @@ void SharePointObject::refreshImpl( Json json )
 {
     m_typeDescription.reset( );
     m_properties.clear( );
+    m_validators.clear( );
     initializeFromJson( json );
 }
 
 void SharePointObject::refresh( )
 {
-    string res;
+    libcmis::TraceScope traceScope( "Object::refresh", getSession( ) );
+
+    libcmis::HttpResponsePtr response;
+    libcmis::HttpValidators validators( m_validators );
     try
     {
-        res  = getSession( )->httpGetRequest( getId( ) )->getStream( )->str( );
+        response = getSession( )->httpConditionalGetRequest( getId( ), validators );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
+
+    // Nothing changed since the last refresh: keep the parsed state
+    if ( !response )
+    {
+        m_refreshTimestamp = time( NULL );
+        return;
+    }
+
+    const string& res = response->getBody( );
     Json json = Json::parse( res );
     refreshImpl( json );
+    m_validators = validators;
 }
 
 void SharePointObject::remove( bool /*allVersions*/ )
 {
+    libcmis::TraceScope traceScope( "Object::remove", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     try
     {
         getSession( )->httpDeleteRequest( getId( ) );
@@ -171,6 +194,10 @@ vector< string> SharePointObject::getMultiStringProperty( const string& property
 libcmis::ObjectPtr SharePointObject::updateProperties(
         const PropertyPtrMap& /*properties*/ )
 {
+    libcmis::TraceScope traceScope( "Object::updateProperties", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     // there are no updateable properties so just return the same object
     libcmis::ObjectPtr updated = getSession( )->getObject( getId( ) );
     return updated;
@@ -178,6 +205,10 @@ libcmis::ObjectPtr SharePointObject::updateProperties(
 
 void SharePointObject::move( FolderPtr /*source*/, FolderPtr destination ) 
 {  
+    libcmis::TraceScope traceScope( "Object::move", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     if ( !getStringProperty( "cmis:checkinComment" ).empty( ) )
     {
         // only documents can be moved and only documents have this property
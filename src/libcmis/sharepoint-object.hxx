@@ -70,5 +70,9 @@ class SharePointObject : public virtual libcmis::Object
     protected:
         SharePointSession* getSession( );    
 
+
+    private:
+        /// Validators of the JSON downloaded by the last refresh
+        libcmis::HttpValidators m_validators;
 };
 #endif
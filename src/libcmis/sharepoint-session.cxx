@@ -36,6 +36,7 @@
 #include "sharepoint-object-type.hxx"
 #include "sharepoint-repository.hxx"
 #include "sharepoint-utils.hxx"
+#include "trace-scope.hxx"
 
 using namespace std;
 
@@ -72,7 +73,7 @@ SharePointSession::SharePointSession( string baseUrl,
     BaseSession( baseUrl, string(), httpSession ),
     m_digestCode( string( ) ) 
 {
-    if ( !SharePointUtils::isSharePoint( response->getStream( )->str( ) ) )
+    if ( !SharePointUtils::isSharePoint( response->getBody( ) ) )
     {
         throw libcmis::Exception( "Not a SharePoint service" );
     }
@@ -88,6 +89,7 @@ SharePointSession::SharePointSession() :
 
 SharePointSession::~SharePointSession()
 {
+    stopAsyncRequests( );
 }
 
 bool SharePointSession::setRepository( string )
@@ -102,20 +104,30 @@ libcmis::RepositoryPtr SharePointSession::getRepository( )
     return repo;
 }
 
-libcmis::ObjectPtr SharePointSession::getObject( string objectId )
+libcmis::ObjectPtr SharePointSession::getObject( string objectId, const libcmis::OperationContext& context )
 {
+    libcmis::TraceScope traceScope( "Session::getObject", this );
+
+    libcmis::ObjectPtr cached = getCachedObject( objectId, context );
+    if ( cached )
+        return cached;
+
     // objectId is uri for the file
-    string res;
+    libcmis::HttpResponsePtr response;
     try
     {
-        res = httpGetRequest( objectId )->getStream()->str();
+        response = httpGetRequest( SharePointUtils::addSelect( objectId, context ) );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
+
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
-    return getObjectFromJson( jsonRes );
+    libcmis::ObjectPtr object = getObjectFromJson( jsonRes );
+    cacheObject( object, context );
+    return object;
 }
 
 libcmis::ObjectPtr SharePointSession::getObjectFromJson( Json& jsonRes, string parentId ) 
@@ -141,8 +153,10 @@ libcmis::ObjectPtr SharePointSession::getObjectFromJson( Json& jsonRes, string p
     return object;
 }
 
-libcmis::ObjectPtr SharePointSession::getObjectByPath( string path )
+libcmis::ObjectPtr SharePointSession::getObjectByPath( string path, const libcmis::OperationContext& context )
 {
+    libcmis::TraceScope traceScope( "Session::getObjectByPath", this );
+
     libcmis::ObjectPtr object;
     path = libcmis::escape( path );
     // we don't know the object type so we try with Folder first
@@ -150,141 +164,72 @@ libcmis::ObjectPtr SharePointSession::getObjectByPath( string path )
     {
         string folderUrl = getBindingUrl( ) + "/getFolderByServerRelativeUrl";
         folderUrl += "('" + path + "')";
-        object = getObject( folderUrl );
+        object = getObject( folderUrl, context );
     }
     catch ( const libcmis::Exception &e )
     {
         // it's not a Folder, maybe it's a File
         string fileUrl = getBindingUrl( ) + "/getFileByServerRelativeUrl";
         fileUrl += "('" + path + "')";
-        object = getObject( fileUrl );
+        object = getObject( fileUrl, context );
     }
     return object;
 }
 
 libcmis::ObjectTypePtr SharePointSession::getType( string id )
 {
-    libcmis::ObjectTypePtr type( new SharePointObjectType( id ) );
+    libcmis::TraceScope traceScope( "Session::getType", this );
+
+    libcmis::ObjectTypePtr type = getCachedType( id );
+    if ( !type )
+    {
+        type.reset( new SharePointObjectType( id ) );
+        cacheType( id, type );
+    }
     return type;
 }
 
 vector< libcmis::ObjectTypePtr > SharePointSession::getBaseTypes( )
 {
+    libcmis::TraceScope traceScope( "Session::getBaseTypes", this );
+
     vector< libcmis::ObjectTypePtr > types;
     return types;
 }
 
 Json SharePointSession::getJsonFromUrl( string url )
 {
-    string response;
+    libcmis::HttpResponsePtr response;
     try
     {
-        response = httpGetRequest( url )->getStream()->str();
+        response = httpGetRequest( url );
     }
     catch ( const CurlException& e )
     {
         throw e.getCmisException( );
     }
-    return Json::parse( response );
+
+    return Json::parse( response->getBody( ) );
 }
 
-/* Overwriting HttpSession::httpRunRequest to add the "accept:application/json" header */
-void SharePointSession::httpRunRequest( string url, vector< string > headers, bool redirect )
+/* Overwriting HttpSession::prepareRequest to add the "accept:application/json" header */
+libcmis::CurlSlistPtr SharePointSession::prepareRequest( CURL* handle, const string& url,
+        vector< string > headers, bool redirect, char* errBuff,
+        const libcmis::HttpRequestOptions& options )
 {
-    libcmis::rejectControlChars( url, "URL" );
-    for ( vector< string >::const_iterator it = headers.begin( ); it != headers.end( ); ++it )
-        libcmis::rejectControlChars( *it, "header" );
-
     // The base class entry points already call initProtocols() right after
     // their curl_easy_reset, but re-assert it here so this override stays
     // safe if a future caller skips the reset+initProtocols pattern.
-    initProtocols();
-
-    libcmis::applyTransferLimits( m_curlHandle );
-
-    // Redirect
-    curl_easy_setopt( m_curlHandle, CURLOPT_FOLLOWLOCATION, redirect);
-
-    // Activate the cookie engine
-    curl_easy_setopt( m_curlHandle, CURLOPT_COOKIEFILE, "" );
-
-    // Grab something from the web
-    curl_easy_setopt( m_curlHandle, CURLOPT_URL, url.c_str() );
-
-    // Set the headers
-    struct deleter { void operator()(curl_slist* p) const { curl_slist_free_all(p); } };
-    unique_ptr<struct curl_slist, deleter> headers_slist;
-    for ( vector< string >::iterator it = headers.begin( ); it != headers.end( ); ++it )
-        headers_slist.reset(curl_slist_append(headers_slist.release(), it->c_str()));
+    initProtocols( handle );
 
-    headers_slist.reset(curl_slist_append(headers_slist.release(), "accept:application/json; odata=verbose"));
-    headers_slist.reset(curl_slist_append(headers_slist.release(), ("x-requestdigest:" + m_digestCode).c_str()));
+    headers.push_back( "accept:application/json; odata=verbose" );
+    headers.push_back( "x-requestdigest:" + m_digestCode );
     // newer Sharepoint requires this; this can be detected based on header
     // "x-msdavext_error" starting with "917656;" typically with a 403 status
     // but since this class is specifically for SharePoint just add it always
-    headers_slist.reset(curl_slist_append(headers_slist.release(), "X-FORMS_BASED_AUTH_ACCEPTED: f"));
+    headers.push_back( "X-FORMS_BASED_AUTH_ACCEPTED: f" );
 
-    if ( !getUsername().empty() && !getPassword().empty() )
-    {
-        libcmis::rejectControlChars( getUsername(), "username" );
-        libcmis::rejectControlChars( getPassword(), "password" );
-        curl_easy_setopt( m_curlHandle, CURLOPT_HTTPAUTH, m_authMethod );
-        curl_easy_setopt( m_curlHandle, CURLOPT_USERNAME, getUsername().c_str() );
-        curl_easy_setopt( m_curlHandle, CURLOPT_PASSWORD, getPassword().c_str() );
-    }
-
-    curl_easy_setopt(m_curlHandle, CURLOPT_HTTPHEADER, headers_slist.get());
-
-    // Set the proxy configuration if any
-    if ( !libcmis::SessionFactory::getProxy( ).empty() )
-    {
-        curl_easy_setopt( m_curlHandle, CURLOPT_PROXY, libcmis::SessionFactory::getProxy( ).c_str() );
-        curl_easy_setopt( m_curlHandle, CURLOPT_NOPROXY, libcmis::SessionFactory::getNoProxy( ).c_str() );
-        const string& proxyUser = libcmis::SessionFactory::getProxyUser( );
-        const string& proxyPass = libcmis::SessionFactory::getProxyPass( );
-        if ( !proxyUser.empty( ) && !proxyPass.empty( ) )
-        {
-            curl_easy_setopt( m_curlHandle, CURLOPT_PROXYAUTH, CURLAUTH_ANY );
-            curl_easy_setopt( m_curlHandle, CURLOPT_PROXYUSERNAME, proxyUser.c_str( ) );
-            curl_easy_setopt( m_curlHandle, CURLOPT_PROXYPASSWORD, proxyPass.c_str( ) );
-        }
-    }
-
-    // Get some feedback when something wrong happens
-    char errBuff[CURL_ERROR_SIZE];
-    errBuff[0] = 0;
-    curl_easy_setopt( m_curlHandle, CURLOPT_ERRORBUFFER, errBuff );
-
-    // We want to get the response even if there is an Http error
-    if ( !m_noHttpErrors )
-        curl_easy_setopt( m_curlHandle, CURLOPT_FAILONERROR, 1 );
-
-    if ( m_verbose )
-        curl_easy_setopt( m_curlHandle, CURLOPT_VERBOSE, 1 );
-
-    // We want to get the certificate infos in error cases
-    curl_easy_setopt( m_curlHandle, CURLOPT_CERTINFO, 1 );
-
-    applySslVerifyForRequest( );
-
-    // Perform the query
-    CURLcode errCode = curl_easy_perform( m_curlHandle );
-
-    // Process the response
-    bool isHttpError = errCode == CURLE_HTTP_RETURNED_ERROR;
-    if ( CURLE_OK != errCode && !( m_noHttpErrors && isHttpError ) )
-    {
-        long httpError = 0;
-        curl_easy_getinfo( m_curlHandle, CURLINFO_RESPONSE_CODE, &httpError );
-
-        bool errorFixed = false;
-        // If we had a bad certificate, then try to get more details
-        if ( CURLE_SSL_CACERT == errCode )
-            handleSslCacertRecovery( errBuff, errCode, httpError, isHttpError, errorFixed );
-
-        if ( !errorFixed )
-            throw CurlException( string( errBuff ), errCode, url, httpError );
-    }
+    return HttpSession::prepareRequest( handle, url, headers, redirect, errBuff, options );
 }
 
 libcmis::HttpResponsePtr SharePointSession::httpPutRequest( std::string url,
@@ -352,7 +297,7 @@ void SharePointSession::fetchDigestCodeCurl( )
     // url = http://host/_api/contextinfo, first we remove the '/web' part
     string url = m_bindingUrl.substr( 0, m_bindingUrl.size( ) - 4 ) + "/contextinfo";
     response = HttpSession::httpPostRequest( url, is, "" );
-    string res = response->getStream( )->str( );
+    const string& res = response->getBody( );
     Json jsonRes = Json::parse( res );
     m_digestCode = jsonRes["d"]["GetContextWebInformation"]["FormDigestValue"].toString( );
     libcmis::rejectControlChars( m_digestCode, "FormDigestValue" );
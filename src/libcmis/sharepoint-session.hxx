@@ -52,9 +52,11 @@ class SharePointSession : public BaseSession
 
         virtual bool setRepository( std::string );
 
-        virtual libcmis::ObjectPtr getObject( std::string id );
+        virtual libcmis::ObjectPtr getObject( std::string id,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
-        virtual libcmis::ObjectPtr getObjectByPath( std::string path );
+        virtual libcmis::ObjectPtr getObjectByPath( std::string path,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
         virtual libcmis::ObjectTypePtr getType( std::string id );
         
@@ -67,9 +69,12 @@ class SharePointSession : public BaseSession
 
         void fetchDigestCode( );
 
-        void httpRunRequest( std::string url,
-                             std::vector< std::string > headers,
-                             bool redirect );
+        libcmis::CurlSlistPtr prepareRequest( CURL* handle,
+                                              const std::string& url,
+                                              std::vector< std::string > headers,
+                                              bool redirect,
+                                              char* errBuff,
+                                              const libcmis::HttpRequestOptions& options );
 
         libcmis::HttpResponsePtr httpPutRequest( std::string url,
                                                  std::istream& is,
@@ -28,6 +28,9 @@
 
 #include "sharepoint-utils.hxx"
 
+#include <algorithm>
+
+#include <boost/algorithm/string.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <libcmis/xml-utils.hxx>
@@ -35,6 +38,7 @@
 #include "json-utils.hxx"
 
 using namespace std;
+using libcmis::OperationContext;
 using libcmis::PropertyPtrMap;
 
 string SharePointUtils::toCmisKey( const string& key )
@@ -63,6 +67,50 @@ string SharePointUtils::toCmisKey( const string& key )
     return convertedKey;
 }
 
+string SharePointUtils::toSharePointSelect( const OperationContext& context )
+{
+    if ( !context.isPropertyFilterSet( ) )
+        return string( );
+
+    // The name and the links to the related resources are always needed
+    // to build and navigate the object
+    vector< string > fields;
+    fields.push_back( "Name" );
+    fields.push_back( "ServerRelativeUrl" );
+    fields.push_back( "Files" );
+    fields.push_back( "Folders" );
+    fields.push_back( "ParentFolder" );
+    fields.push_back( "Properties" );
+    fields.push_back( "Author" );
+    fields.push_back( "Versions" );
+
+    static const char* filterable[] = { "TimeCreated", "TimeLastModified", "Length",
+                                        "UIVersionLabel", "CheckInComment", "CheckOutType" };
+    const vector< string >& filter = context.getPropertyFilter( );
+    for ( size_t i = 0; i < sizeof( filterable ) / sizeof( char* ); ++i )
+    {
+        string cmisKey = toCmisKey( filterable[i] );
+        if ( find( filter.begin( ), filter.end( ), cmisKey ) != filter.end( ) )
+            fields.push_back( filterable[i] );
+    }
+
+    return boost::algorithm::join( fields, "," );
+}
+
+string SharePointUtils::addSelect( const string& url, const OperationContext& context )
+{
+    string select = toSharePointSelect( context );
+    if ( select.empty( ) )
+        return url;
+
+    string result = url;
+    if ( result.find( '?' ) != string::npos )
+        result += "&";
+    else
+        result += "?";
+    return result + "$select=" + libcmis::escape( select );
+}
+
 libcmis::PropertyType::Type SharePointUtils::getPropertyType( const string& key )
 {
     libcmis::PropertyType::Type propertyType;
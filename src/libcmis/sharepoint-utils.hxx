@@ -30,6 +30,7 @@
 
 #include <string>
 
+#include <libcmis/operation-context.hxx>
 #include <libcmis/property.hxx>
 
 #include "json-utils.hxx"
@@ -41,6 +42,14 @@ class SharePointUtils
         // Convert a SharePoint Property key to a CMIS key
         static std::string toCmisKey( const std::string& key);
 
+        // Compute the $select parameter of a request from the property filter
+        // of the operation context, or an empty string if no filter is set
+        static std::string toSharePointSelect( const libcmis::OperationContext& context );
+
+        // Appends the $select parameter computed from the context to url
+        static std::string addSelect( const std::string& url,
+                                      const libcmis::OperationContext& context );
+
         // Returns the property type (String/Bool/Integer etc )
         static libcmis::PropertyType::Type getPropertyType( const std::string& key );
 
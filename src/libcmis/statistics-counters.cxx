@@ -0,0 +1,245 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "statistics-counters.hxx"
+
+#include <climits>
+#include <cstring>
+#include <memory>
+
+using namespace std;
+
+namespace
+{
+    const char* const METHODS[] = { "GET", "HEAD", "POST", "PUT", "PATCH", "DELETE", "OTHER" };
+    const char* const REQUEST_LATENCIES[] = { "HTTP GET", "HTTP HEAD", "HTTP POST", "HTTP PUT",
+                                              "HTTP PATCH", "HTTP DELETE", "HTTP OTHER" };
+
+    size_t lcl_getMethodIndex( const string& method )
+    {
+        const size_t count = sizeof( METHODS ) / sizeof( METHODS[0] );
+        for ( size_t i = 0; i < count - 1; ++i )
+        {
+            if ( method == METHODS[i] )
+                return i;
+        }
+        return count - 1;
+    }
+
+    void lcl_storeMin( atomic< long >& value, long candidate )
+    {
+        long current = value.load( memory_order_relaxed );
+        while ( candidate < current &&
+                !value.compare_exchange_weak( current, candidate, memory_order_relaxed ) )
+        {
+        }
+    }
+
+    void lcl_storeMax( atomic< long >& value, long candidate )
+    {
+        long current = value.load( memory_order_relaxed );
+        while ( candidate > current &&
+                !value.compare_exchange_weak( current, candidate, memory_order_relaxed ) )
+        {
+        }
+    }
+}
+
+namespace libcmis
+{
+    class StatisticsCounters::Histogram
+    {
+        public:
+            explicit Histogram( const char* name ) :
+                m_name( name ),
+                m_counts( new atomic< long >[ LatencyHistogram::getBucketsCount( ) ] ),
+                m_minimum( LONG_MAX ),
+                m_maximum( 0 ),
+                m_sum( 0 )
+            {
+                reset( );
+            }
+
+            Histogram( const Histogram& copy ) = delete;
+            Histogram& operator=( const Histogram& copy ) = delete;
+
+            void add( long microseconds )
+            {
+                m_counts[ LatencyHistogram::getBucket( microseconds ) ].fetch_add( 1, memory_order_relaxed );
+                m_sum.fetch_add( microseconds, memory_order_relaxed );
+                lcl_storeMin( m_minimum, microseconds );
+                lcl_storeMax( m_maximum, microseconds );
+            }
+
+            void reset( )
+            {
+                for ( size_t i = 0; i < LatencyHistogram::getBucketsCount( ); ++i )
+                    m_counts[i].store( 0, memory_order_relaxed );
+                m_minimum.store( LONG_MAX, memory_order_relaxed );
+                m_maximum.store( 0, memory_order_relaxed );
+                m_sum.store( 0, memory_order_relaxed );
+            }
+
+            LatencyHistogram getSnapshot( ) const
+            {
+                vector< long > counts( LatencyHistogram::getBucketsCount( ) );
+                for ( size_t i = 0; i < counts.size( ); ++i )
+                    counts[i] = m_counts[i].load( memory_order_relaxed );
+                return LatencyHistogram( counts, m_minimum.load( memory_order_relaxed ),
+                                         m_maximum.load( memory_order_relaxed ),
+                                         double( m_sum.load( memory_order_relaxed ) ) );
+            }
+
+            const char* m_name;
+
+        private:
+            unique_ptr< atomic< long >[] > m_counts;
+            atomic< long > m_minimum;
+            atomic< long > m_maximum;
+            atomic< long long > m_sum;
+    };
+
+    StatisticsCounters::StatisticsCounters( ) :
+        m_requests( ),
+        m_responses( ),
+        m_bytesReceived( 0 ),
+        m_bytesSent( 0 ),
+        m_retries( 0 ),
+        m_tokenRefreshes( 0 ),
+        m_typeCacheHits( 0 ),
+        m_typeCacheMisses( 0 ),
+        m_histograms( )
+    {
+        for ( size_t i = 0; i < METHODS_COUNT; ++i )
+            m_requests[i].store( 0 );
+        for ( size_t i = 0; i < STATUS_CLASSES_COUNT; ++i )
+            m_responses[i].store( 0 );
+        for ( size_t i = 0; i < HISTOGRAMS_COUNT; ++i )
+            m_histograms[i].store( NULL );
+    }
+
+    StatisticsCounters::~StatisticsCounters( )
+    {
+        for ( size_t i = 0; i < HISTOGRAMS_COUNT; ++i )
+            delete m_histograms[i].load( );
+    }
+
+    void StatisticsCounters::addRequest( const RequestMetrics& metrics )
+    {
+        size_t method = lcl_getMethodIndex( metrics.getMethod( ) );
+        m_requests[ method ].fetch_add( 1, memory_order_relaxed );
+
+        long statusClass = metrics.getStatus( ) / 100;
+        if ( statusClass < 0 || statusClass >= long( STATUS_CLASSES_COUNT ) )
+            statusClass = 0;
+        m_responses[ statusClass ].fetch_add( 1, memory_order_relaxed );
+
+        m_bytesReceived.fetch_add( metrics.getDownloadSize( ), memory_order_relaxed );
+        m_bytesSent.fetch_add( metrics.getUploadSize( ), memory_order_relaxed );
+        addLatency( REQUEST_LATENCIES[ method ], long( metrics.getTotalTime( ) * 1000000 ) );
+    }
+
+    void StatisticsCounters::addTypeCacheLookup( bool hit )
+    {
+        if ( hit )
+            m_typeCacheHits.fetch_add( 1, memory_order_relaxed );
+        else
+            m_typeCacheMisses.fetch_add( 1, memory_order_relaxed );
+    }
+
+    void StatisticsCounters::addLatency( const char* name, long microseconds )
+    {
+        for ( size_t i = 0; i < HISTOGRAMS_COUNT; ++i )
+        {
+            Histogram* histogram = m_histograms[i].load( memory_order_acquire );
+            if ( histogram == NULL )
+            {
+                // Take the free slot, unless another thread was faster
+                unique_ptr< Histogram > created( new Histogram( name ) );
+                if ( m_histograms[i].compare_exchange_strong( histogram, created.get( ),
+                                                              memory_order_acq_rel ) )
+                    histogram = created.release( );
+            }
+
+            if ( strcmp( histogram->m_name, name ) == 0 )
+            {
+                histogram->add( microseconds );
+                return;
+            }
+        }
+    }
+
+    SessionStatistics StatisticsCounters::getStatistics( ) const
+    {
+        SessionStatistics statistics;
+        for ( size_t i = 0; i < METHODS_COUNT; ++i )
+            statistics.addRequests( METHODS[i], m_requests[i].load( memory_order_relaxed ) );
+        for ( size_t i = 0; i < STATUS_CLASSES_COUNT; ++i )
+            statistics.addResponses( int( i ), m_responses[i].load( memory_order_relaxed ) );
+        statistics.setBytes( m_bytesReceived.load( memory_order_relaxed ),
+                             m_bytesSent.load( memory_order_relaxed ) );
+        statistics.setRetries( m_retries.load( memory_order_relaxed ) );
+        statistics.setTokenRefreshes( m_tokenRefreshes.load( memory_order_relaxed ) );
+        statistics.setTypeCache( m_typeCacheHits.load( memory_order_relaxed ),
+                                 m_typeCacheMisses.load( memory_order_relaxed ) );
+
+        for ( size_t i = 0; i < HISTOGRAMS_COUNT; ++i )
+        {
+            Histogram* histogram = m_histograms[i].load( memory_order_acquire );
+            if ( histogram == NULL )
+                break;
+
+            LatencyHistogram latency = histogram->getSnapshot( );
+            if ( latency.getCount( ) > 0 )
+                statistics.setLatency( histogram->m_name, latency );
+        }
+        return statistics;
+    }
+
+    void StatisticsCounters::reset( )
+    {
+        for ( size_t i = 0; i < METHODS_COUNT; ++i )
+            m_requests[i].store( 0, memory_order_relaxed );
+        for ( size_t i = 0; i < STATUS_CLASSES_COUNT; ++i )
+            m_responses[i].store( 0, memory_order_relaxed );
+        m_bytesReceived.store( 0, memory_order_relaxed );
+        m_bytesSent.store( 0, memory_order_relaxed );
+        m_retries.store( 0, memory_order_relaxed );
+        m_tokenRefreshes.store( 0, memory_order_relaxed );
+        m_typeCacheHits.store( 0, memory_order_relaxed );
+        m_typeCacheMisses.store( 0, memory_order_relaxed );
+
+        // The histograms stay allocated as other threads may be updating them
+        for ( size_t i = 0; i < HISTOGRAMS_COUNT; ++i )
+        {
+            Histogram* histogram = m_histograms[i].load( memory_order_acquire );
+            if ( histogram != NULL )
+                histogram->reset( );
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _STATISTICS_COUNTERS_HXX_
+#define _STATISTICS_COUNTERS_HXX_
+
+#include <atomic>
+
+#include <libcmis/request-metrics.hxx>
+#include <libcmis/session-statistics.hxx>
+
+namespace libcmis
+{
+    /** Counters behind the statistics of a session.
+
+        They are updated by the threads sending the requests without any
+        lock: the snapshots taken during updates may be slightly off.
+      */
+    class StatisticsCounters
+    {
+        private:
+            class Histogram;
+
+            static const size_t METHODS_COUNT = 7;
+            static const size_t STATUS_CLASSES_COUNT = 6;
+
+            /// The operations and requests with a histogram, up to the first 64 names
+            static const size_t HISTOGRAMS_COUNT = 64;
+
+            std::atomic< long > m_requests[ METHODS_COUNT ];
+            std::atomic< long > m_responses[ STATUS_CLASSES_COUNT ];
+            std::atomic< long > m_bytesReceived;
+            std::atomic< long > m_bytesSent;
+            std::atomic< long > m_retries;
+            std::atomic< long > m_tokenRefreshes;
+            std::atomic< long > m_typeCacheHits;
+            std::atomic< long > m_typeCacheMisses;
+
+            /// Allocated on first use and never freed before the counters
+            std::atomic< Histogram* > m_histograms[ HISTOGRAMS_COUNT ];
+
+        public:
+            StatisticsCounters( );
+            ~StatisticsCounters( );
+
+            StatisticsCounters( const StatisticsCounters& copy ) = delete;
+            StatisticsCounters& operator=( const StatisticsCounters& copy ) = delete;
+
+            /** Count a request that is over and its duration.
+              */
+            void addRequest( const RequestMetrics& metrics );
+            void addRetry( ) { ++m_retries; }
+            void addTokenRefresh( ) { ++m_tokenRefreshes; }
+            void addTypeCacheLookup( bool hit );
+
+            /** Count the duration in microseconds of an operation. The name
+                is usually a literal and needs to outlive the counters.
+              */
+            void addLatency( const char* name, long microseconds );
+
+            /** Fill the statistics with the counters, except the ones of
+                the object and path caches kept by the caches themselves.
+              */
+            SessionStatistics getStatistics( ) const;
+
+            void reset( );
+    };
+}
+
+#endif
@@ -0,0 +1,152 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "trace-scope.hxx"
+
+#include <atomic>
+#include <exception>
+
+#include <libcmis/session-factory.hxx>
+
+#include "http-session.hxx"
+
+using namespace std;
+
+namespace
+{
+    libcmis::ActiveSpanPtr& lcl_getCurrentSpan( )
+    {
+        static thread_local libcmis::ActiveSpanPtr span;
+        return span;
+    }
+
+    unsigned long lcl_newSpanId( )
+    {
+        static atomic< unsigned long > lastId( 0 );
+        return ++lastId;
+    }
+
+    // The exporters get the spans one at a time
+    mutex& lcl_getExportMutex( )
+    {
+        static mutex exportMutex;
+        return exportMutex;
+    }
+
+    int lcl_uncaughtExceptions( )
+    {
+#if __cplusplus >= 201703L
+        return uncaught_exceptions( );
+#else
+        return uncaught_exception( ) ? 1 : 0;
+#endif
+    }
+}
+
+namespace libcmis
+{
+    ActiveSpan::ActiveSpan( unsigned long traceId, unsigned long id,
+                            unsigned long parentId, const char* name ) :
+        m_mutex( ),
+        m_span( traceId, id, parentId, name, boost::posix_time::microsec_clock::universal_time( ) ),
+        m_start( chrono::steady_clock::now( ) )
+    {
+    }
+
+    void ActiveSpan::addRequest( const RequestMetrics& metrics )
+    {
+        lock_guard< mutex > lock( m_mutex );
+        m_span.addRequest( metrics );
+    }
+
+    TraceSpan ActiveSpan::finish( bool failed )
+    {
+        lock_guard< mutex > lock( m_mutex );
+        m_span.setDuration( chrono::duration< double >( chrono::steady_clock::now( ) - m_start ).count( ) );
+        m_span.setFailed( failed );
+        return m_span;
+    }
+
+    TraceScope::TraceScope( const char* name, HttpSession* session ) :
+        m_name( name ),
+        m_session( session ),
+        m_start( chrono::steady_clock::now( ) ),
+        m_exporter( SessionFactory::getTraceExporter( ) ),
+        m_span( ),
+        m_parent( ),
+        m_uncaughtExceptions( lcl_uncaughtExceptions( ) )
+    {
+        if ( !m_exporter )
+            return;
+
+        m_parent = lcl_getCurrentSpan( );
+        unsigned long id = lcl_newSpanId( );
+        if ( m_parent )
+            m_span.reset( new ActiveSpan( m_parent->getTraceId( ), id, m_parent->getId( ), name ) );
+        else
+            m_span.reset( new ActiveSpan( id, id, 0, name ) );
+        lcl_getCurrentSpan( ) = m_span;
+    }
+
+    TraceScope::~TraceScope( )
+    {
+        if ( m_session != NULL )
+        {
+            try
+            {
+                chrono::microseconds duration = chrono::duration_cast< chrono::microseconds >(
+                        chrono::steady_clock::now( ) - m_start );
+                m_session->getStatisticsCounters( ).addLatency( m_name, long( duration.count( ) ) );
+            }
+            catch ( ... )
+            {
+                // Not enough memory for a new histogram: too bad
+            }
+        }
+
+        if ( !m_span )
+            return;
+
+        lcl_getCurrentSpan( ) = m_parent;
+        try
+        {
+            TraceSpan span = m_span->finish( lcl_uncaughtExceptions( ) > m_uncaughtExceptions );
+            lock_guard< mutex > lock( lcl_getExportMutex( ) );
+            m_exporter->exportSpan( span );
+        }
+        catch ( ... )
+        {
+            // A broken exporter mustn't fail the operation
+        }
+    }
+
+    ActiveSpanPtr TraceScope::getCurrentSpan( )
+    {
+        return lcl_getCurrentSpan( );
+    }
+}
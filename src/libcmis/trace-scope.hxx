@@ -0,0 +1,109 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _TRACE_SCOPE_HXX_
+#define _TRACE_SCOPE_HXX_
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include <libcmis/request-metrics.hxx>
+#include <libcmis/trace.hxx>
+
+class HttpSession;
+
+namespace libcmis
+{
+    /** Span of an operation still running.
+
+        It is shared with the asynchronous requests started by the
+        operation, which may add themselves from another thread.
+      */
+    class ActiveSpan
+    {
+        private:
+            std::mutex m_mutex;
+            TraceSpan m_span;
+            std::chrono::steady_clock::time_point m_start;
+
+        public:
+            ActiveSpan( unsigned long traceId, unsigned long id,
+                        unsigned long parentId, const char* name );
+
+            ActiveSpan( const ActiveSpan& copy ) = delete;
+            ActiveSpan& operator=( const ActiveSpan& copy ) = delete;
+
+            unsigned long getTraceId( ) const { return m_span.getTraceId( ); }
+            unsigned long getId( ) const { return m_span.getId( ); }
+
+            void addRequest( const RequestMetrics& metrics );
+
+            /** Set the duration and the outcome of the span and get a copy
+                of it for the exporter.
+              */
+            TraceSpan finish( bool failed );
+    };
+    typedef std::shared_ptr< ActiveSpan > ActiveSpanPtr;
+
+    /** Open a span for the public operation it is declared in, if an
+        exporter is set on the SessionFactory, and export it when going
+        out of scope.
+
+        The HTTP requests sent by the thread in the meantime are added to
+        the span, and the operations called from there get child spans.
+        The duration of the operation is also counted in the statistics
+        of the session, if any.
+      */
+    class TraceScope
+    {
+        private:
+            const char* m_name;
+            HttpSession* m_session;
+            std::chrono::steady_clock::time_point m_start;
+            TraceExporterPtr m_exporter;
+            ActiveSpanPtr m_span;
+            ActiveSpanPtr m_parent;
+            int m_uncaughtExceptions;
+
+        public:
+            /** The name needs to outlive the session, like a literal.
+              */
+            TraceScope( const char* name, HttpSession* session );
+            ~TraceScope( );
+
+            TraceScope( const TraceScope& copy ) = delete;
+            TraceScope& operator=( const TraceScope& copy ) = delete;
+
+            /** The span of the operation running in the calling thread,
+                or an empty pointer.
+              */
+            static ActiveSpanPtr getCurrentSpan( );
+    };
+}
+
+#endif
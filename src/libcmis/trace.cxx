@@ -0,0 +1,162 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include <libcmis/trace.hxx>
+
+#include <iomanip>
+#include <sstream>
+
+#include <libcmis/exception.hxx>
+#include <libcmis/xml-utils.hxx>
+
+using namespace std;
+
+namespace
+{
+    string lcl_jsonString( const string& value )
+    {
+        stringstream out;
+        out << '"';
+        for ( string::const_iterator it = value.begin( ); it != value.end( ); ++it )
+        {
+            unsigned char c = static_cast< unsigned char >( *it );
+            if ( c == '"' || c == '\\' )
+                out << '\\' << *it;
+            else if ( c < 0x20 )
+                out << "\\u" << hex << setw( 4 ) << setfill( '0' ) << int( c ) << dec;
+            else
+                out << *it;
+        }
+        out << '"';
+        return out.str( );
+    }
+}
+
+namespace libcmis
+{
+    TraceSpan::TraceSpan( ) :
+        m_traceId( 0 ),
+        m_id( 0 ),
+        m_parentId( 0 ),
+        m_name( ),
+        m_startTime( ),
+        m_duration( 0 ),
+        m_failed( false ),
+        m_requests( )
+    {
+    }
+
+    TraceSpan::TraceSpan( unsigned long traceId, unsigned long id, unsigned long parentId,
+                          string name, boost::posix_time::ptime startTime ) :
+        m_traceId( traceId ),
+        m_id( id ),
+        m_parentId( parentId ),
+        m_name( name ),
+        m_startTime( startTime ),
+        m_duration( 0 ),
+        m_failed( false ),
+        m_requests( )
+    {
+    }
+
+    TraceSpan::~TraceSpan( )
+    {
+    }
+
+    long TraceSpan::getDownloadSize( ) const
+    {
+        long size = 0;
+        for ( vector< RequestMetrics >::const_iterator it = m_requests.begin( );
+                it != m_requests.end( ); ++it )
+            size += it->getDownloadSize( );
+        return size;
+    }
+
+    long TraceSpan::getUploadSize( ) const
+    {
+        long size = 0;
+        for ( vector< RequestMetrics >::const_iterator it = m_requests.begin( );
+                it != m_requests.end( ); ++it )
+            size += it->getUploadSize( );
+        return size;
+    }
+
+    JsonLinesTraceExporter::JsonLinesTraceExporter( const string& path ) :
+        TraceExporter( ),
+        m_stream( path.c_str( ), ios_base::out | ios_base::app )
+    {
+        if ( !m_stream )
+            throw Exception( "Failed to open the trace file: " + path );
+    }
+
+    JsonLinesTraceExporter::~JsonLinesTraceExporter( )
+    {
+    }
+
+    void JsonLinesTraceExporter::exportSpan( const TraceSpan& span )
+    {
+        m_stream << toJson( span ) << '\n';
+        m_stream.flush( );
+    }
+
+    string JsonLinesTraceExporter::toJson( const TraceSpan& span )
+    {
+        stringstream out;
+        out << "{\"traceId\":" << span.getTraceId( )
+            << ",\"spanId\":" << span.getId( )
+            << ",\"parentId\":" << span.getParentId( )
+            << ",\"name\":" << lcl_jsonString( span.getName( ) )
+            << ",\"start\":" << lcl_jsonString( writeDateTime( span.getStartTime( ) ) )
+            << ",\"duration\":" << span.getDuration( )
+            << ",\"failed\":" << ( span.hasFailed( ) ? "true" : "false" )
+            << ",\"downloadSize\":" << span.getDownloadSize( )
+            << ",\"uploadSize\":" << span.getUploadSize( )
+            << ",\"requests\":[";
+
+        const vector< RequestMetrics >& requests = span.getRequests( );
+        for ( vector< RequestMetrics >::const_iterator it = requests.begin( );
+                it != requests.end( ); ++it )
+        {
+            if ( it != requests.begin( ) )
+                out << ',';
+            out << "{\"method\":" << lcl_jsonString( it->getMethod( ) )
+                << ",\"url\":" << lcl_jsonString( it->getUrlTemplate( ) )
+                << ",\"status\":" << it->getStatus( )
+                << ",\"nameLookupTime\":" << it->getNameLookupTime( )
+                << ",\"connectTime\":" << it->getConnectTime( )
+                << ",\"appConnectTime\":" << it->getAppConnectTime( )
+                << ",\"startTransferTime\":" << it->getStartTransferTime( )
+                << ",\"totalTime\":" << it->getTotalTime( )
+                << ",\"downloadSize\":" << it->getDownloadSize( )
+                << ",\"uploadSize\":" << it->getUploadSize( )
+                << '}';
+        }
+        out << "]}";
+        return out.str( );
+    }
+}
@@ -0,0 +1,154 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "tree-crawler.hxx"
+
+#include <deque>
+#include <future>
+
+#include <libcmis/folder.hxx>
+
+using namespace std;
+
+namespace
+{
+    /** A page of the children of a folder waiting for its request.
+      */
+    struct QueuedPage
+    {
+        QueuedPage( libcmis::ObjectTreePtr parent, const string& url, const string& pageUrl ) :
+            m_parent( parent ),
+            m_url( url ),
+            m_pageUrl( pageUrl )
+        {
+        }
+
+        libcmis::ObjectTreePtr m_parent;
+        string m_url;
+        string m_pageUrl;
+    };
+
+    /** A request for a page of the children of a folder.
+      */
+    struct PendingPage
+    {
+        PendingPage( libcmis::ObjectTreePtr parent, const string& url,
+                     future< libcmis::HttpResponsePtr >&& response ) :
+            m_parent( parent ),
+            m_url( url ),
+            m_response( move( response ) )
+        {
+        }
+
+        libcmis::ObjectTreePtr m_parent;
+        string m_url;
+        future< libcmis::HttpResponsePtr > m_response;
+    };
+}
+
+TreeCrawler::TreeCrawler( HttpSession* session, size_t maxRequests ) :
+    m_session( session ),
+    m_maxRequests( maxRequests > 0 ? maxRequests : 1 )
+{
+}
+
+TreeCrawler::~TreeCrawler( )
+{
+}
+
+vector< libcmis::ObjectTreePtr > TreeCrawler::crawl( const string& folderId, int depth, bool foldersOnly )
+{
+    // The root node isn't returned, it only collects the first level
+    libcmis::ObjectTreePtr root( new libcmis::ObjectTree( libcmis::ObjectPtr( ) ) );
+
+    vector< pair< string, libcmis::ObjectTreePtr > > level;
+    level.push_back( make_pair( folderId, root ) );
+
+    for ( int current = 1; !level.empty( ); ++current )
+    {
+        vector< pair< string, libcmis::ObjectTreePtr > > nextLevel;
+        deque< QueuedPage > queued;
+        deque< PendingPage > pending;
+
+        for ( vector< pair< string, libcmis::ObjectTreePtr > >::iterator it = level.begin( );
+              it != level.end( ); ++it )
+        {
+            string url = getChildrenUrl( it->first, foldersOnly );
+            queued.push_back( QueuedPage( it->second, url, url ) );
+        }
+
+        while ( !queued.empty( ) || !pending.empty( ) )
+        {
+            while ( !queued.empty( ) && pending.size( ) < m_maxRequests )
+            {
+                QueuedPage& page = queued.front( );
+                pending.push_back( PendingPage( page.m_parent, page.m_url,
+                                                m_session->httpGetRequestAsync( page.m_pageUrl ) ) );
+                queued.pop_front( );
+            }
+
+            PendingPage page = move( pending.front( ) );
+            pending.pop_front( );
+
+            libcmis::HttpResponsePtr response;
+            try
+            {
+                response = page.m_response.get( );
+            }
+            catch ( const CurlException& e )
+            {
+                throw e.getCmisException( );
+            }
+
+            vector< libcmis::ObjectPtr > children;
+            string nextUrl = parseChildren( page.m_url, response->getBody( ), children );
+            if ( !nextUrl.empty( ) )
+            {
+                // The other pages of the folder wait for a free request
+                // like the folders not listed yet
+                queued.push_back( QueuedPage( page.m_parent, page.m_url, nextUrl ) );
+            }
+
+            for ( vector< libcmis::ObjectPtr >::iterator it = children.begin( ); it != children.end( ); ++it )
+            {
+                bool isFolder = boost::dynamic_pointer_cast< libcmis::Folder >( *it ).get( ) != NULL;
+                if ( foldersOnly && !isFolder )
+                    continue;
+
+                libcmis::ObjectTreePtr node( new libcmis::ObjectTree( *it ) );
+                page.m_parent->addChild( node );
+                if ( isFolder && ( depth < 0 || current < depth ) )
+                    nextLevel.push_back( make_pair( ( *it )->getId( ), node ) );
+            }
+        }
+
+        level.swap( nextLevel );
+    }
+
+    return root->getChildren( );
+}
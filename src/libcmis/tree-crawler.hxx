@@ -0,0 +1,89 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _TREE_CRAWLER_HXX_
+#define _TREE_CRAWLER_HXX_
+
+#include <string>
+#include <vector>
+
+#include <libcmis/object-tree.hxx>
+
+#include "http-session.hxx"
+
+/** Builds the tree of the objects below a folder for the bindings
+    without a descendants service.
+
+    Instead of walking the tree one folder after the other, the children
+    of all the folders of a level are requested at the same time with
+    the asynchronous requests of the session: crawling the tree costs
+    one round trip per level (and per page of children), not one per
+    folder.
+  */
+class TreeCrawler
+{
+    private:
+        HttpSession* m_session;
+        size_t m_maxRequests;
+
+    public:
+        /** \param maxRequests the maximum number of requests in flight
+          */
+        TreeCrawler( HttpSession* session, size_t maxRequests = 8 );
+        virtual ~TreeCrawler( );
+
+        TreeCrawler( const TreeCrawler& copy ) = delete;
+        TreeCrawler& operator=( const TreeCrawler& copy ) = delete;
+
+        /** Get the tree below a folder.
+
+            \param depth the number of levels to fetch or -1 for all of them
+            \param foldersOnly whether to leave the other objects out of the tree
+          */
+        std::vector< libcmis::ObjectTreePtr > crawl( const std::string& folderId, int depth, bool foldersOnly );
+
+    protected:
+        /** Provides the URL of the first page of children of a folder.
+            When foldersOnly is true, the URL may ask the server to list
+            the folders only.
+          */
+        virtual std::string getChildrenUrl( const std::string& folderId, bool foldersOnly ) = 0;
+
+        /** Parse a page of children.
+
+            \param url the URL of the first page of children
+            \param body the body of the response
+            \param children filled with the parsed objects
+
+            \return the URL of the next page or an empty string if this
+                    is the last one.
+          */
+        virtual std::string parseChildren( const std::string& url, const std::string& body,
+                                           std::vector< libcmis::ObjectPtr >& children ) = 0;
+};
+
+#endif
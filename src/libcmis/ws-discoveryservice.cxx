@@ -0,0 +1,116 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "ws-discoveryservice.hxx"
+
+#include "ws-requests.hxx"
+#include "ws-session.hxx"
+
+using namespace std;
+
+DiscoveryService::DiscoveryService( ) :
+    m_session( NULL ),
+    m_url( "" )
+{
+}
+
+DiscoveryService::DiscoveryService( WSSession* session ) :
+    m_session( session ),
+    m_url( session->getServiceUrl( "DiscoveryService" ) )
+{
+}
+
+DiscoveryService::DiscoveryService( const DiscoveryService& copy ) :
+    m_session( copy.m_session ),
+    m_url( copy.m_url )
+{
+}
+
+DiscoveryService::~DiscoveryService( )
+{
+}
+
+DiscoveryService& DiscoveryService::operator=( const DiscoveryService& copy )
+{
+    if ( this != &copy )
+    {
+        m_session = copy.m_session;
+        m_url = copy.m_url;
+    }
+
+    return *this;
+}
+
+vector< libcmis::ObjectPtr > DiscoveryService::query( string repoId, string statement,
+        bool searchAllVersions, long maxItems, long skipCount,
+        bool& hasMoreItems, long& numItems, const libcmis::OperationContext& context )
+{
+    vector< libcmis::ObjectPtr > results;
+    hasMoreItems = false;
+    numItems = -1;
+
+    QueryRequest request( repoId, statement, searchAllVersions, maxItems, skipCount, context );
+    vector< SoapResponsePtr > responses = m_session->soapRequest( m_url, request );
+    if ( responses.size( ) == 1 )
+    {
+        SoapResponse* resp = responses.front( ).get( );
+        QueryResponse* response = dynamic_cast< QueryResponse* >( resp );
+        if ( response != NULL )
+        {
+            results = response->getObjects( );
+            hasMoreItems = response->hasMoreItems( );
+            numItems = response->getNumItems( );
+        }
+    }
+
+    return results;
+}
+
+libcmis::ContentChanges DiscoveryService::getContentChanges( string repoId, string changeLogToken,
+        long maxItems )
+{
+    libcmis::ContentChanges changes;
+
+    GetContentChangesRequest request( repoId, changeLogToken, maxItems );
+    vector< SoapResponsePtr > responses = m_session->soapRequest( m_url, request );
+    if ( responses.size( ) == 1 )
+    {
+        SoapResponse* resp = responses.front( ).get( );
+        GetContentChangesResponse* response = dynamic_cast< GetContentChangesResponse* >( resp );
+        if ( response != NULL )
+        {
+            string nextToken = response->getChangeLogToken( );
+            if ( nextToken.empty( ) )
+                nextToken = changeLogToken;
+            changes = libcmis::ContentChanges( response->getEvents( ), nextToken,
+                                               response->hasMoreItems( ) );
+        }
+    }
+
+    return changes;
+}
@@ -0,0 +1,75 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _WS_DISCOVERYSERVICE_HXX_
+#define _WS_DISCOVERYSERVICE_HXX_
+
+#include <string>
+#include <vector>
+
+#include <libcmis/change-event.hxx>
+#include <libcmis/object.hxx>
+#include <libcmis/operation-context.hxx>
+
+class WSSession;
+
+class DiscoveryService
+{
+    private:
+        WSSession* m_session;
+        std::string m_url;
+
+    public:
+
+        DiscoveryService( WSSession* session );
+        DiscoveryService( const DiscoveryService& copy );
+        ~DiscoveryService( );
+
+        DiscoveryService& operator=( const DiscoveryService& copy );
+
+        /** Get a page of the results of a query.
+
+            \param maxItems the page size or 0 to let the server decide
+            \param skipCount the number of results to skip
+            \param hasMoreItems set to true if there are results after the page
+            \param numItems set to the total number of results or a negative
+                    value if the server doesn't provide it
+          */
+        std::vector< libcmis::ObjectPtr > query( std::string repoId, std::string statement,
+                bool searchAllVersions, long maxItems, long skipCount,
+                bool& hasMoreItems, long& numItems,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
+
+        libcmis::ContentChanges getContentChanges( std::string repoId, std::string changeLogToken,
+                long maxItems );
+
+    private:
+
+        DiscoveryService( );
+};
+
+#endif
@@ -28,6 +28,8 @@
 
 #include "ws-document.hxx"
 
+#include "trace-scope.hxx"
+
 using namespace std;
 using libcmis::PropertyPtrMap;
 
@@ -43,12 +45,16 @@ WSDocument::~WSDocument( )
 
 vector< libcmis::FolderPtr > WSDocument::getParents( )
 {
+    libcmis::TraceScope traceScope( "Document::getParents", getSession( ) );
+
     string repoId = getSession( )->getRepositoryId( );
     return getSession( )->getNavigationService( ).getObjectParents( repoId, getId( ) );
 }
 
 boost::shared_ptr< istream > WSDocument::getContentStream( std::string /* streamId */ ) 
 {
+    libcmis::TraceScope traceScope( "Document::getContentStream", getSession( ) );
+
     string repoId = getSession( )->getRepositoryId( );
     return getSession( )->getObjectService( ).getContentStream( repoId, getId( ) );
 }
@@ -56,6 +62,10 @@ boost::shared_ptr< istream > WSDocument::getContentStream( std::string /* stream
 void WSDocument::setContentStream( boost::shared_ptr< ostream > os, string contentType,
                                string fileName, bool overwrite )
 {
+    libcmis::TraceScope traceScope( "Document::setContentStream", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     string repoId = getSession( )->getRepositoryId( );
     getSession( )->getObjectService( ).setContentStream( repoId, getId( ),
             overwrite, getChangeToken( ), os, contentType, fileName );
@@ -65,12 +75,21 @@ void WSDocument::setContentStream( boost::shared_ptr< ostream > os, string conte
 
 libcmis::DocumentPtr WSDocument::checkOut( )
 {
+    libcmis::TraceScope traceScope( "Document::checkOut", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     string repoId = getSession( )->getRepositoryId( );
     return getSession( )->getVersioningService( ).checkOut( repoId, getId( ) );
 }
 
 void WSDocument::cancelCheckout( )
 {
+    libcmis::TraceScope traceScope( "Document::cancelCheckout", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     string repoId = getSession( )->getRepositoryId( );
     getSession( )->getVersioningService( ).cancelCheckOut( repoId, getId( ) );
 }
@@ -80,6 +99,11 @@ libcmis::DocumentPtr WSDocument::checkIn( bool isMajor, string comment,
                           boost::shared_ptr< ostream > stream,
                           string contentType, string fileName )
 {
+    libcmis::TraceScope traceScope( "Document::checkIn", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     string repoId = getSession( )->getRepositoryId( );
     libcmis::DocumentPtr newVersion;
 
@@ -121,6 +145,8 @@ libcmis::DocumentPtr WSDocument::checkIn( bool isMajor, string comment,
 
 vector< libcmis::DocumentPtr > WSDocument::getAllVersions( )
 {
+    libcmis::TraceScope traceScope( "Document::getAllVersions", getSession( ) );
+
     vector< libcmis::DocumentPtr > versions;
     string repoId = getSession( )->getRepositoryId( );
     PropertyPtrMap::const_iterator it = getProperties( ).find( string( "cmis:versionSeriesId" ) );
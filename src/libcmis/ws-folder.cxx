@@ -28,9 +28,58 @@
 
 #include "ws-folder.hxx"
 
+#include "trace-scope.hxx"
+
 using namespace std;
 using libcmis::PropertyPtrMap;
 
+namespace
+{
+    /** Iterator over the children of a folder, requesting the pages
+        with an increasing skipCount.
+      */
+    class WSChildrenIterator : public libcmis::ObjectIterator
+    {
+        private:
+            WSSession* m_session;
+            string m_folderId;
+            long m_pageSize;
+            long m_skipCount;
+            libcmis::OperationContext m_context;
+
+        public:
+            WSChildrenIterator( WSSession* session, string folderId, long pageSize,
+                                const libcmis::OperationContext& context ) :
+                libcmis::ObjectIterator( ),
+                m_session( session ),
+                m_folderId( folderId ),
+                m_pageSize( pageSize ),
+                m_skipCount( 0 ),
+                m_context( context )
+            {
+            }
+
+            WSChildrenIterator( const WSChildrenIterator& copy ) = delete;
+            WSChildrenIterator& operator=( const WSChildrenIterator& copy ) = delete;
+
+        protected:
+            vector< libcmis::ObjectPtr > fetchNextPage( )
+            {
+                bool hasMoreItems = false;
+                long numItems = -1;
+                string repoId = m_session->getRepositoryId( );
+                vector< libcmis::ObjectPtr > children = m_session->getNavigationService( ).getChildren(
+                        repoId, m_folderId, m_pageSize, m_skipCount, hasMoreItems, numItems, m_context );
+
+                m_skipCount += children.size( );
+                setHasMoreItems( hasMoreItems );
+                setNumItems( numItems );
+
+                return children;
+            }
+    };
+}
+
 WSFolder::WSFolder( const WSObject& object ) :
     libcmis::Object( object ),
     WSObject( object )
@@ -41,14 +90,39 @@ WSFolder::~WSFolder( )
 {
 }
 
-vector< libcmis::ObjectPtr > WSFolder::getChildren( )
+vector< libcmis::ObjectPtr > WSFolder::getChildren( const libcmis::OperationContext& context )
+{
+    libcmis::TraceScope traceScope( "Folder::getChildren", getSession( ) );
+
+    vector< libcmis::ObjectPtr > children;
+
+    libcmis::ObjectIteratorPtr it = listChildren( 0, 0, context );
+    while ( it->hasNext( ) )
+        children.push_back( it->next( ) );
+
+    return children;
+}
+
+libcmis::ObjectIteratorPtr WSFolder::listChildren( long pageSize, long, const libcmis::OperationContext& context )
+{
+    libcmis::TraceScope traceScope( "Folder::listChildren", getSession( ) );
+
+    return libcmis::ObjectIteratorPtr( new WSChildrenIterator( getSession( ), getId( ), pageSize, context ) );
+}
+
+vector< libcmis::ObjectTreePtr > WSFolder::getTree( int depth, bool foldersOnly,
+        const libcmis::OperationContext& context )
 {
+    libcmis::TraceScope traceScope( "Folder::getTree", getSession( ) );
+
     string repoId = getSession( )->getRepositoryId( );
-    return getSession( )->getNavigationService( ).getChildren( repoId, getId( ) );
+    return getSession( )->getNavigationService( ).getDescendants( repoId, getId( ), depth, foldersOnly, context );
 }
 
 libcmis::FolderPtr WSFolder::createFolder( const PropertyPtrMap& properties )
 {
+    libcmis::TraceScope traceScope( "Folder::createFolder", getSession( ) );
+
     string repoId = getSession( )->getRepositoryId( );
     return getSession( )->getObjectService( ).createFolder( repoId, properties, getId( ) );
 }
@@ -56,12 +130,19 @@ libcmis::FolderPtr WSFolder::createFolder( const PropertyPtrMap& properties )
 libcmis::DocumentPtr WSFolder::createDocument( const PropertyPtrMap& properties,
                         boost::shared_ptr< ostream > os, string contentType, string fileName )
 {
+    libcmis::TraceScope traceScope( "Folder::createDocument", getSession( ) );
+
     string repoId = getSession( )->getRepositoryId( );
     return getSession( )->getObjectService( ).createDocument( repoId, properties, getId( ), os, contentType, fileName );
 }
 
 vector< string > WSFolder::removeTree( bool allVersion, libcmis::UnfileObjects::Type unfile, bool continueOnError )
 {
+    libcmis::TraceScope traceScope( "Folder::removeTree", getSession( ) );
+
+    // The change affects other objects than this one
+    m_session->invalidateObjects( );
+
     string repoId = getSession( )->getRepositoryId( );
     return getSession( )->getObjectService( ).deleteTree( repoId, getId( ), allVersion, unfile, continueOnError );
 }
@@ -84,18 +84,51 @@ vector< libcmis::FolderPtr > NavigationService::getObjectParents( std::string re
 }
 
 vector< libcmis::ObjectPtr > NavigationService::getChildren( string repoId, string folderId )
+{
+    bool hasMoreItems = false;
+    long numItems = -1;
+    return getChildren( repoId, folderId, 0, 0, hasMoreItems, numItems );
+}
+
+vector< libcmis::ObjectPtr > NavigationService::getChildren( string repoId, string folderId,
+        long maxItems, long skipCount, bool& hasMoreItems, long& numItems,
+        const libcmis::OperationContext& context )
 {
     vector< libcmis::ObjectPtr > children;
+    hasMoreItems = false;
+    numItems = -1;
 
-    GetChildrenRequest request( repoId, folderId );
+    GetChildrenRequest request( repoId, folderId, maxItems, skipCount, context );
     vector< SoapResponsePtr > responses = m_session->soapRequest( m_url, request );
     if ( responses.size( ) == 1 )
     {
         SoapResponse* resp = responses.front( ).get( );
         GetChildrenResponse* response = dynamic_cast< GetChildrenResponse* >( resp );
         if ( response != NULL )
+        {
             children = response->getChildren( );
+            hasMoreItems = response->hasMoreItems( );
+            numItems = response->getNumItems( );
+        }
     }
 
     return children;
 }
+
+vector< libcmis::ObjectTreePtr > NavigationService::getDescendants( string repoId, string folderId,
+        int depth, bool foldersOnly, const libcmis::OperationContext& context )
+{
+    vector< libcmis::ObjectTreePtr > descendants;
+
+    GetDescendantsRequest request( repoId, folderId, depth, foldersOnly, context );
+    vector< SoapResponsePtr > responses = m_session->soapRequest( m_url, request );
+    if ( responses.size( ) == 1 )
+    {
+        SoapResponse* resp = responses.front( ).get( );
+        GetDescendantsResponse* response = dynamic_cast< GetDescendantsResponse* >( resp );
+        if ( response != NULL )
+            descendants = response->getDescendants( );
+    }
+
+    return descendants;
+}
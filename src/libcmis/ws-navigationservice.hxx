@@ -52,6 +52,27 @@ class NavigationService
         std::vector< libcmis::FolderPtr > getObjectParents( std::string repoId, std::string objectId );
         std::vector< libcmis::ObjectPtr > getChildren( std::string repoId, std::string folderId );
 
+        /** Get a page of the children of a folder.
+
+            \param maxItems the page size or 0 to let the server decide
+            \param skipCount the number of children to skip
+            \param hasMoreItems set to true if there are children after the page
+            \param numItems set to the total number of children or a negative
+                    value if the server doesn't provide it
+          */
+        std::vector< libcmis::ObjectPtr > getChildren( std::string repoId, std::string folderId,
+                long maxItems, long skipCount, bool& hasMoreItems, long& numItems,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
+
+        /** Get the tree of objects below a folder in one request.
+
+            \param depth the number of levels to fetch or -1 for all of them
+            \param foldersOnly use getFolderTree instead of getDescendants
+          */
+        std::vector< libcmis::ObjectTreePtr > getDescendants( std::string repoId, std::string folderId,
+                int depth, bool foldersOnly,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
+
     private:
 
         NavigationService( );
@@ -65,7 +65,9 @@ WSObjectType& WSObjectType::operator=( const WSObjectType& copy )
 
 void WSObjectType::refresh( )
 {
-    libcmis::ObjectTypePtr type = m_session->getType( m_id );
+    // Don't use the session's getType( ): it would give the cached type
+    libcmis::ObjectTypePtr type = m_session->getRepositoryService( ).getTypeDefinition(
+            m_session->getRepositoryId( ), m_id );
     const auto other = dynamic_cast< const WSObjectType* >( type.get( ) );
     if ( other != NULL )
         *this = *other;
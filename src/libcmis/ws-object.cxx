@@ -28,6 +28,7 @@
 
 #include "ws-object.hxx"
 
+#include "trace-scope.hxx"
 #include "ws-document.hxx"
 #include "ws-folder.hxx"
 
@@ -66,6 +67,8 @@ WSObject& WSObject::operator=( const WSObject& copy )
 
 vector< libcmis::RenditionPtr > WSObject::getRenditions( string filter )
 {
+    libcmis::TraceScope traceScope( "Object::getRenditions", getSession( ) );
+
     // Check that the server supports that optional feature. There is no need to check it
     // when getting the object as we may get them by shear luck
     libcmis::RepositoryPtr repo = getSession( )->getRepository( );
@@ -82,6 +85,10 @@ vector< libcmis::RenditionPtr > WSObject::getRenditions( string filter )
 libcmis::ObjectPtr WSObject::updateProperties(
         const PropertyPtrMap& properties )
 {
+    libcmis::TraceScope traceScope( "Object::updateProperties", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     // No need to send HTTP request if there is nothing to update
     if ( properties.empty( ) )
     {
@@ -98,12 +105,18 @@ libcmis::ObjectPtr WSObject::updateProperties(
         }
         return object;
     }
+
+    // Only the updatable properties are sent: make sure ours know if they are
+    getTypeDescription( );
+
     string repoId = getSession( )->getRepositoryId( );
     return getSession( )->getObjectService( ).updateProperties( repoId, this->getId( ), properties, this->getChangeToken( ) );
 }
 
 void WSObject::refresh( )
 {
+    libcmis::TraceScope traceScope( "Object::refresh", getSession( ) );
+
     libcmis::ObjectPtr object = m_session->getObject( getId( ) );
     const auto other = dynamic_cast< const WSObject* >( object.get( ) );
     if ( other != NULL )
@@ -112,12 +125,20 @@ void WSObject::refresh( )
 
 void WSObject::remove( bool allVersions )
 {
+    libcmis::TraceScope traceScope( "Object::remove", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     string repoId = getSession( )->getRepositoryId( );
     getSession( )->getObjectService( ).deleteObject( repoId, this->getId( ), allVersions );
 }
 
 void WSObject::move( libcmis::FolderPtr source, libcmis::FolderPtr destination )
 {
+    libcmis::TraceScope traceScope( "Object::move", getSession( ) );
+
+    m_session->invalidateObject( getId( ) );
+
     string repoId = getSession( )->getRepositoryId( );
     getSession( )->getObjectService( ).move( repoId, getId( ), destination->getId( ), source->getId( ) );
 
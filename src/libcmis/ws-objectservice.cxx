@@ -67,11 +67,12 @@ ObjectService& ObjectService::operator=( const ObjectService& copy )
     return *this;
 }
 
-libcmis::ObjectPtr ObjectService::getObject( const string& repoId, const string& id )
+libcmis::ObjectPtr ObjectService::getObject( const string& repoId, const string& id,
+        const libcmis::OperationContext& context )
 {
     libcmis::ObjectPtr object;
 
-    GetObjectRequest request( repoId, id );
+    GetObjectRequest request( repoId, id, context );
     vector< SoapResponsePtr > responses = m_session->soapRequest( m_url, request );
     if ( responses.size( ) == 1 )
     {
@@ -84,11 +85,12 @@ libcmis::ObjectPtr ObjectService::getObject( const string& repoId, const string&
     return object;
 }
 
-libcmis::ObjectPtr ObjectService::getObjectByPath( const string& repoId, const string& path )
+libcmis::ObjectPtr ObjectService::getObjectByPath( const string& repoId, const string& path,
+        const libcmis::OperationContext& context )
 {
     libcmis::ObjectPtr object;
 
-    GetObjectByPathRequest request( repoId, path );
+    GetObjectByPathRequest request( repoId, path, context );
     vector< SoapResponsePtr > responses = m_session->soapRequest( m_url, request );
     if ( responses.size( ) == 1 )
     {
@@ -55,9 +55,11 @@ class ObjectService
 
         ObjectService& operator=( const ObjectService& copy );
 
-        libcmis::ObjectPtr getObject( const std::string& repoId, const std::string& id );
+        libcmis::ObjectPtr getObject( const std::string& repoId, const std::string& id,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
-        libcmis::ObjectPtr getObjectByPath( const std::string& repoId, const std::string& path );
+        libcmis::ObjectPtr getObjectByPath( const std::string& repoId, const std::string& path,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
         std::vector< libcmis::RenditionPtr > getRenditions(
                 const std::string& repoId, const std::string& objectId, const std::string& filter );
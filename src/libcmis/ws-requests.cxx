@@ -38,6 +38,82 @@
 using namespace std;
 using libcmis::PropertyPtrMap;
 
+namespace
+{
+    /** Write the elements for an operation context, in the order shared by
+        getObject, getObjectByPath and getChildren. Without a rendition
+        filter in the context, all the renditions are requested: some
+        servers like Alfresco are providing them only this way and it saves
+        time (another HTTP request) anyway.
+      */
+    void lcl_writeOperationContext( xmlTextWriterPtr writer, const libcmis::OperationContext& context )
+    {
+        if ( context.isPropertyFilterSet( ) )
+            xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:filter" ), BAD_CAST( context.getFilter( ).c_str( ) ) );
+        xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:includeAllowableActions" ),
+                BAD_CAST( context.isIncludeAllowableActions( ) ? "true" : "false" ) );
+        if ( context.getIncludeRelationships( ) != libcmis::IncludeRelationships::None )
+            xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:includeRelationships" ),
+                    BAD_CAST( context.getIncludeRelationshipsString( ).c_str( ) ) );
+
+        string renditionFilter = context.getRenditionFilter( );
+        if ( renditionFilter.empty( ) )
+            renditionFilter = "*";
+        xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:renditionFilter" ), BAD_CAST( renditionFilter.c_str( ) ) );
+    }
+
+    libcmis::ObjectPtr lcl_createObject( WSSession* session, xmlNodePtr node )
+    {
+        libcmis::ObjectPtr object;
+        WSObject tmp( session, node );
+        if ( tmp.getBaseType( ) == "cmis:folder" )
+            object.reset( new WSFolder( tmp ) );
+        else if ( tmp.getBaseType( ) == "cmis:document" )
+            object.reset( new WSDocument( tmp ) );
+        else
+            object.reset( new WSObject( session, node ) );
+        return object;
+    }
+
+    /** Parse the cmisObjectInFolderContainerType children of node named
+        containerName, and their descendants.
+      */
+    vector< libcmis::ObjectTreePtr > lcl_parseContainers( WSSession* session, xmlNodePtr node,
+                                                          const char* containerName )
+    {
+        vector< libcmis::ObjectTreePtr > nodes;
+
+        for ( xmlNodePtr container = node->children; container; container = container->next )
+        {
+            if ( !xmlStrEqual( container->name, BAD_CAST( containerName ) ) )
+                continue;
+
+            libcmis::ObjectTreePtr treeNode;
+            for ( xmlNodePtr child = container->children; child && !treeNode; child = child->next )
+            {
+                if ( !xmlStrEqual( child->name, BAD_CAST( "objectInFolder" ) ) )
+                    continue;
+
+                for ( xmlNodePtr gdchild = child->children; gdchild && !treeNode; gdchild = gdchild->next )
+                {
+                    if ( xmlStrEqual( gdchild->name, BAD_CAST( "object" ) ) )
+                        treeNode.reset( new libcmis::ObjectTree( lcl_createObject( session, gdchild ) ) );
+                }
+            }
+
+            if ( treeNode )
+            {
+                vector< libcmis::ObjectTreePtr > children = lcl_parseContainers( session, container, "children" );
+                for ( vector< libcmis::ObjectTreePtr >::iterator it = children.begin( ); it != children.end( ); ++it )
+                    treeNode->addChild( *it );
+                nodes.push_back( treeNode );
+            }
+        }
+
+        return nodes;
+    }
+}
+
 CmisSoapFaultDetail::CmisSoapFaultDetail( xmlNodePtr node ) :
     SoapFaultDetail( ),
     m_type( ),
@@ -281,11 +357,7 @@ void GetObjectRequest::toXml( xmlTextWriterPtr writer )
 
     xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:repositoryId" ), BAD_CAST( m_repositoryId.c_str( ) ) );
     xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:objectId" ), BAD_CAST( m_id.c_str( ) ) );
-    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:includeAllowableActions" ), BAD_CAST( "true" ) );
-
-    // Ask for renditions... some servers like Alfresco are providing them only this way
-    // and it saves time (another HTTP request) anyway.
-    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:renditionFilter" ), BAD_CAST( "*" ) );
+    lcl_writeOperationContext( writer, m_context );
 
     xmlTextWriterEndElement( writer );
 }
@@ -329,8 +401,7 @@ void GetObjectByPathRequest::toXml( xmlTextWriterPtr writer )
 
     xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:repositoryId" ), BAD_CAST( m_repositoryId.c_str( ) ) );
     xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:path" ), BAD_CAST( m_path.c_str( ) ) );
-    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:includeAllowableActions" ), BAD_CAST( "true" ) );
-    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:renditionFilter" ), BAD_CAST( "*" ) );
+    lcl_writeOperationContext( writer, m_context );
 
     xmlTextWriterEndElement( writer );
 }
@@ -570,8 +641,11 @@ void GetChildrenRequest::toXml( xmlTextWriterPtr writer )
 
     xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:repositoryId" ), BAD_CAST( m_repositoryId.c_str( ) ) );
     xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:folderId" ), BAD_CAST( m_folderId.c_str( ) ) );
-    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:includeAllowableActions" ), BAD_CAST( "true" ) );
-    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:renditionFilter" ), BAD_CAST( "*" ) );
+    lcl_writeOperationContext( writer, m_context );
+    if ( m_maxItems > 0 )
+        xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:maxItems" ), BAD_CAST( to_string( m_maxItems ).c_str( ) ) );
+    if ( m_skipCount > 0 )
+        xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:skipCount" ), BAD_CAST( to_string( m_skipCount ).c_str( ) ) );
 
     xmlTextWriterEndElement( writer );
 }
@@ -612,8 +686,152 @@ SoapResponsePtr GetChildrenResponse::create( xmlNodePtr node, RelatedMultipart&,
                         }
                     }
                 }
+                else if ( xmlStrEqual( gdchild->name, BAD_CAST( "hasMoreItems" ) ) )
+                {
+                    xmlChar* content = xmlNodeGetContent( gdchild );
+                    response->m_hasMoreItems = libcmis::parseBool( string( ( char* )content ) );
+                    xmlFree( content );
+                }
+                else if ( xmlStrEqual( gdchild->name, BAD_CAST( "numItems" ) ) )
+                {
+                    xmlChar* content = xmlNodeGetContent( gdchild );
+                    response->m_numItems = libcmis::parseInteger( string( ( char* )content ) );
+                    xmlFree( content );
+                }
+            }
+        }
+    }
+
+    return SoapResponsePtr( response );
+}
+
+void GetDescendantsRequest::toXml( xmlTextWriterPtr writer )
+{
+    if ( m_foldersOnly )
+        xmlTextWriterStartElement( writer, BAD_CAST( "cmism:getFolderTree" ) );
+    else
+        xmlTextWriterStartElement( writer, BAD_CAST( "cmism:getDescendants" ) );
+    xmlTextWriterWriteAttribute( writer, BAD_CAST( "xmlns:cmis" ), BAD_CAST( NS_CMIS_URL ) );
+    xmlTextWriterWriteAttribute( writer, BAD_CAST( "xmlns:cmism" ), BAD_CAST( NS_CMISM_URL ) );
+
+    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:repositoryId" ), BAD_CAST( m_repositoryId.c_str( ) ) );
+    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:folderId" ), BAD_CAST( m_folderId.c_str( ) ) );
+    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:depth" ), BAD_CAST( to_string( m_depth ).c_str( ) ) );
+    lcl_writeOperationContext( writer, m_context );
+
+    xmlTextWriterEndElement( writer );
+}
+
+SoapResponsePtr GetDescendantsResponse::create( xmlNodePtr node, RelatedMultipart&, SoapSession* session )
+{
+    GetDescendantsResponse* response = new GetDescendantsResponse( );
+    WSSession* wsSession = dynamic_cast< WSSession* >( session );
+
+    response->m_descendants = lcl_parseContainers( wsSession, node, "objects" );
+
+    return SoapResponsePtr( response );
+}
+
+void QueryRequest::toXml( xmlTextWriterPtr writer )
+{
+    xmlTextWriterStartElement( writer, BAD_CAST( "cmism:query" ) );
+    xmlTextWriterWriteAttribute( writer, BAD_CAST( "xmlns:cmis" ), BAD_CAST( NS_CMIS_URL ) );
+    xmlTextWriterWriteAttribute( writer, BAD_CAST( "xmlns:cmism" ), BAD_CAST( NS_CMISM_URL ) );
+
+    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:repositoryId" ), BAD_CAST( m_repositoryId.c_str( ) ) );
+    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:statement" ), BAD_CAST( m_statement.c_str( ) ) );
+    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:searchAllVersions" ),
+            BAD_CAST( m_searchAllVersions ? "true" : "false" ) );
+    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:includeAllowableActions" ),
+            BAD_CAST( m_context.isIncludeAllowableActions( ) ? "true" : "false" ) );
+    if ( m_context.getIncludeRelationships( ) != libcmis::IncludeRelationships::None )
+        xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:includeRelationships" ),
+                BAD_CAST( m_context.getIncludeRelationshipsString( ).c_str( ) ) );
+    if ( !m_context.getRenditionFilter( ).empty( ) )
+        xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:renditionFilter" ),
+                BAD_CAST( m_context.getRenditionFilter( ).c_str( ) ) );
+    if ( m_maxItems > 0 )
+        xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:maxItems" ), BAD_CAST( to_string( m_maxItems ).c_str( ) ) );
+    if ( m_skipCount > 0 )
+        xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:skipCount" ), BAD_CAST( to_string( m_skipCount ).c_str( ) ) );
+
+    xmlTextWriterEndElement( writer );
+}
+
+SoapResponsePtr QueryResponse::create( xmlNodePtr node, RelatedMultipart&, SoapSession* session )
+{
+    QueryResponse* response = new QueryResponse( );
+    WSSession* wsSession = dynamic_cast< WSSession* >( session );
+
+    for ( xmlNodePtr child = node->children; child; child = child->next )
+    {
+        if ( !xmlStrEqual( child->name, BAD_CAST( "objects" ) ) )
+            continue;
+
+        for ( xmlNodePtr gdchild = child->children; gdchild; gdchild = gdchild->next )
+        {
+            if ( xmlStrEqual( gdchild->name, BAD_CAST( "objects" ) ) )
+                response->m_objects.push_back( lcl_createObject( wsSession, gdchild ) );
+            else if ( xmlStrEqual( gdchild->name, BAD_CAST( "hasMoreItems" ) ) )
+            {
+                xmlChar* content = xmlNodeGetContent( gdchild );
+                response->m_hasMoreItems = libcmis::parseBool( string( ( char* )content ) );
+                xmlFree( content );
+            }
+            else if ( xmlStrEqual( gdchild->name, BAD_CAST( "numItems" ) ) )
+            {
+                xmlChar* content = xmlNodeGetContent( gdchild );
+                response->m_numItems = libcmis::parseInteger( string( ( char* )content ) );
+                xmlFree( content );
+            }
+        }
+    }
+
+    return SoapResponsePtr( response );
+}
+
+void GetContentChangesRequest::toXml( xmlTextWriterPtr writer )
+{
+    xmlTextWriterStartElement( writer, BAD_CAST( "cmism:getContentChanges" ) );
+    xmlTextWriterWriteAttribute( writer, BAD_CAST( "xmlns:cmis" ), BAD_CAST( NS_CMIS_URL ) );
+    xmlTextWriterWriteAttribute( writer, BAD_CAST( "xmlns:cmism" ), BAD_CAST( NS_CMISM_URL ) );
+
+    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:repositoryId" ), BAD_CAST( m_repositoryId.c_str( ) ) );
+    if ( !m_changeLogToken.empty( ) )
+        xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:changeLogToken" ), BAD_CAST( m_changeLogToken.c_str( ) ) );
+    xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:includeProperties" ), BAD_CAST( "false" ) );
+    if ( m_maxItems > 0 )
+        xmlTextWriterWriteElement( writer, BAD_CAST( "cmism:maxItems" ), BAD_CAST( to_string( m_maxItems ).c_str( ) ) );
+
+    xmlTextWriterEndElement( writer );
+}
+
+SoapResponsePtr GetContentChangesResponse::create( xmlNodePtr node, RelatedMultipart&, SoapSession* )
+{
+    GetContentChangesResponse* response = new GetContentChangesResponse( );
+
+    for ( xmlNodePtr child = node->children; child; child = child->next )
+    {
+        if ( xmlStrEqual( child->name, BAD_CAST( "objects" ) ) )
+        {
+            for ( xmlNodePtr gdchild = child->children; gdchild; gdchild = gdchild->next )
+            {
+                if ( xmlStrEqual( gdchild->name, BAD_CAST( "objects" ) ) )
+                    response->m_events.push_back( libcmis::ChangeEventPtr( new libcmis::ChangeEvent( gdchild ) ) );
+                else if ( xmlStrEqual( gdchild->name, BAD_CAST( "hasMoreItems" ) ) )
+                {
+                    xmlChar* content = xmlNodeGetContent( gdchild );
+                    response->m_hasMoreItems = libcmis::parseBool( string( ( char* )content ) );
+                    xmlFree( content );
+                }
             }
         }
+        else if ( xmlStrEqual( child->name, BAD_CAST( "changeLogToken" ) ) )
+        {
+            xmlChar* content = xmlNodeGetContent( child );
+            response->m_changeLogToken = string( ( char* )content );
+            xmlFree( content );
+        }
     }
 
     return SoapResponsePtr( response );
@@ -37,11 +37,14 @@
 #include <boost/shared_ptr.hpp>
 #include <libxml/tree.h>
 
+#include <libcmis/change-event.hxx>
 #include <libcmis/document.hxx>
 #include <libcmis/exception.hxx>
 #include <libcmis/folder.hxx>
 #include <libcmis/object.hxx>
 #include <libcmis/object-type.hxx>
+#include <libcmis/operation-context.hxx>
+#include <libcmis/object-tree.hxx>
 #include <libcmis/repository.hxx>
 
 #include "ws-soap.hxx"
@@ -208,11 +211,14 @@ class GetObjectRequest : public SoapRequest
     private:
         std::string m_repositoryId;
         std::string m_id;
+        libcmis::OperationContext m_context;
 
     public:
-        GetObjectRequest( std::string repoId, std::string id ) :
+        GetObjectRequest( std::string repoId, std::string id,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) ) :
             m_repositoryId( repoId ),
-            m_id( id )
+            m_id( id ),
+            m_context( context )
         {
         }
 
@@ -244,11 +250,14 @@ class GetObjectByPathRequest : public SoapRequest
     private:
         std::string m_repositoryId;
         std::string m_path;
+        libcmis::OperationContext m_context;
 
     public:
-        GetObjectByPathRequest( std::string repoId, std::string path ) :
+        GetObjectByPathRequest( std::string repoId, std::string path,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) ) :
             m_repositoryId( repoId ),
-            m_path( path )
+            m_path( path ),
+            m_context( context )
         {
         }
 
@@ -465,12 +474,24 @@ class GetChildrenRequest : public SoapRequest
     private:
         std::string m_repositoryId;
         std::string m_folderId;
+        long m_maxItems;
+        long m_skipCount;
+        libcmis::OperationContext m_context;
 
     public:
+        /** \param maxItems the page size or 0 to let the server decide
+            \param skipCount the number of children to skip
+          */
         GetChildrenRequest( std::string repoId,
-                std::string folderId ) :
+                std::string folderId,
+                long maxItems = 0,
+                long skipCount = 0,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) ) :
             m_repositoryId( repoId ),
-            m_folderId( folderId )
+            m_folderId( folderId ),
+            m_maxItems( maxItems ),
+            m_skipCount( skipCount ),
+            m_context( context )
         {
         }
 
@@ -483,8 +504,10 @@ class GetChildrenResponse : public SoapResponse
 {
     private:
         std::vector< libcmis::ObjectPtr > m_children;
+        bool m_hasMoreItems;
+        long m_numItems;
 
-        GetChildrenResponse( ) : SoapResponse( ), m_children( ) { }
+        GetChildrenResponse( ) : SoapResponse( ), m_children( ), m_hasMoreItems( false ), m_numItems( -1 ) { }
 
     public:
 
@@ -495,6 +518,159 @@ class GetChildrenResponse : public SoapResponse
         static SoapResponsePtr create( xmlNodePtr node, RelatedMultipart& multipart, SoapSession* session );
 
         std::vector< libcmis::ObjectPtr > getChildren( ) { return m_children; }
+        bool hasMoreItems( ) { return m_hasMoreItems; }
+
+        /** Provides the total number of children or a negative value
+            if the server didn't send it.
+          */
+        long getNumItems( ) { return m_numItems; }
+};
+
+/** Request for getDescendants or, for folders only, getFolderTree.
+  */
+class GetDescendantsRequest : public SoapRequest
+{
+    private:
+        std::string m_repositoryId;
+        std::string m_folderId;
+        int m_depth;
+        bool m_foldersOnly;
+        libcmis::OperationContext m_context;
+
+    public:
+        GetDescendantsRequest( std::string repoId,
+                std::string folderId,
+                int depth,
+                bool foldersOnly,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) ) :
+            m_repositoryId( repoId ),
+            m_folderId( folderId ),
+            m_depth( depth ),
+            m_foldersOnly( foldersOnly ),
+            m_context( context )
+        {
+        }
+
+        ~GetDescendantsRequest( ) { }
+
+        void toXml( xmlTextWriterPtr writer );
+};
+
+class GetDescendantsResponse : public SoapResponse
+{
+    private:
+        std::vector< libcmis::ObjectTreePtr > m_descendants;
+
+        GetDescendantsResponse( ) : SoapResponse( ), m_descendants( ) { }
+
+    public:
+
+        /** Parse cmism:getDescendantsResponse or cmism:getFolderTreeResponse.
+            This function assumes that the node is the expected one: this is
+            normally ensured by the SoapResponseFactory.
+          */
+        static SoapResponsePtr create( xmlNodePtr node, RelatedMultipart& multipart, SoapSession* session );
+
+        std::vector< libcmis::ObjectTreePtr > getDescendants( ) { return m_descendants; }
+};
+
+class QueryRequest : public SoapRequest
+{
+    private:
+        std::string m_repositoryId;
+        std::string m_statement;
+        bool m_searchAllVersions;
+        long m_maxItems;
+        long m_skipCount;
+        libcmis::OperationContext m_context;
+
+    public:
+        QueryRequest( std::string repoId,
+                std::string statement,
+                bool searchAllVersions,
+                long maxItems = 0,
+                long skipCount = 0,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) ) :
+            m_repositoryId( repoId ),
+            m_statement( statement ),
+            m_searchAllVersions( searchAllVersions ),
+            m_maxItems( maxItems ),
+            m_skipCount( skipCount ),
+            m_context( context )
+        {
+        }
+
+        ~QueryRequest( ) { }
+
+        void toXml( xmlTextWriterPtr writer );
+};
+
+class QueryResponse : public SoapResponse
+{
+    private:
+        std::vector< libcmis::ObjectPtr > m_objects;
+        bool m_hasMoreItems;
+        long m_numItems;
+
+        QueryResponse( ) : SoapResponse( ), m_objects( ), m_hasMoreItems( false ), m_numItems( -1 ) { }
+
+    public:
+
+        /** Parse cmism:queryResponse. This function
+            assumes that the node is the expected one: this is
+            normally ensured by the SoapResponseFactory.
+          */
+        static SoapResponsePtr create( xmlNodePtr node, RelatedMultipart& multipart, SoapSession* session );
+
+        std::vector< libcmis::ObjectPtr > getObjects( ) { return m_objects; }
+        bool hasMoreItems( ) { return m_hasMoreItems; }
+
+        /** Provides the total number of results or a negative value
+            if the server didn't send it.
+          */
+        long getNumItems( ) { return m_numItems; }
+};
+
+class GetContentChangesRequest : public SoapRequest
+{
+    private:
+        std::string m_repositoryId;
+        std::string m_changeLogToken;
+        long m_maxItems;
+
+    public:
+        GetContentChangesRequest( std::string repoId, std::string changeLogToken, long maxItems = 0 ) :
+            m_repositoryId( repoId ),
+            m_changeLogToken( changeLogToken ),
+            m_maxItems( maxItems )
+        {
+        }
+
+        ~GetContentChangesRequest( ) { }
+
+        void toXml( xmlTextWriterPtr writer );
+};
+
+class GetContentChangesResponse : public SoapResponse
+{
+    private:
+        std::vector< libcmis::ChangeEventPtr > m_events;
+        std::string m_changeLogToken;
+        bool m_hasMoreItems;
+
+        GetContentChangesResponse( ) : SoapResponse( ), m_events( ), m_changeLogToken( ), m_hasMoreItems( false ) { }
+
+    public:
+
+        /** Parse cmism:getContentChangesResponse. This function
+            assumes that the node is the expected one: this is
+            normally ensured by the SoapResponseFactory.
+          */
+        static SoapResponsePtr create( xmlNodePtr node, RelatedMultipart& multipart, SoapSession* session );
+
+        std::vector< libcmis::ChangeEventPtr > getEvents( ) { return m_events; }
+        std::string getChangeLogToken( ) { return m_changeLogToken; }
+        bool hasMoreItems( ) { return m_hasMoreItems; }
 };
 
 class CreateFolderRequest : public SoapRequest
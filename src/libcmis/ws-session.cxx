@@ -37,15 +37,68 @@
 
 #include <libcmis/xml-utils.hxx>
 
+#include "trace-scope.hxx"
 #include "ws-requests.hxx"
+#include "xpath-context.hxx"
 
 using namespace std;
 
+namespace
+{
+    /** Iterator over the results of a query, requesting the pages
+        with an increasing skipCount.
+      */
+    class WSQueryIterator : public libcmis::ObjectIterator
+    {
+        private:
+            WSSession* m_session;
+            string m_statement;
+            bool m_searchAllVersions;
+            long m_pageSize;
+            long m_skipCount;
+            libcmis::OperationContext m_context;
+
+        public:
+            WSQueryIterator( WSSession* session, string statement, bool searchAllVersions,
+                             long pageSize, const libcmis::OperationContext& context ) :
+                libcmis::ObjectIterator( ),
+                m_session( session ),
+                m_statement( statement ),
+                m_searchAllVersions( searchAllVersions ),
+                m_pageSize( pageSize ),
+                m_skipCount( 0 ),
+                m_context( context )
+            {
+            }
+
+            WSQueryIterator( const WSQueryIterator& copy ) = delete;
+            WSQueryIterator& operator=( const WSQueryIterator& copy ) = delete;
+
+        protected:
+            vector< libcmis::ObjectPtr > fetchNextPage( )
+            {
+                bool hasMoreItems = false;
+                long numItems = -1;
+                string repoId = m_session->getRepositoryId( );
+                vector< libcmis::ObjectPtr > results = m_session->getDiscoveryService( ).query(
+                        repoId, m_statement, m_searchAllVersions, m_pageSize, m_skipCount,
+                        hasMoreItems, numItems, m_context );
+
+                m_skipCount += results.size( );
+                setHasMoreItems( hasMoreItems );
+                setNumItems( numItems );
+
+                return results;
+            }
+    };
+}
+
 WSSession::WSSession( const string& bindingUrl, const string& repositoryId, const string& username,
         const string& password, bool noSslCheck, libcmis::OAuth2DataPtr oauth2,
         bool verbose ) :
     BaseSession( bindingUrl, repositoryId, username, password, noSslCheck, oauth2, verbose ),
     m_servicesUrls( ),
+    m_discoveryService( NULL ),
     m_navigationService( NULL ),
     m_objectService( NULL ),
     m_repositoryService( NULL ),
@@ -63,6 +116,7 @@ WSSession::WSSession( const string& bindingUrl, const string& repositoryId,
                       libcmis::HttpResponsePtr response ) :
     BaseSession( bindingUrl, repositoryId, httpSession ),
     m_servicesUrls( ),
+    m_discoveryService( NULL ),
     m_navigationService( NULL ),
     m_objectService( NULL ),
     m_repositoryService( NULL ),
@@ -78,6 +132,7 @@ WSSession::WSSession( const string& bindingUrl, const string& repositoryId,
 WSSession::WSSession( ) :
     BaseSession( ),
     m_servicesUrls( ),
+    m_discoveryService( NULL ),
     m_navigationService( NULL ),
     m_objectService( NULL ),
     m_repositoryService( NULL ),
@@ -89,6 +144,7 @@ WSSession::WSSession( ) :
 
 WSSession::~WSSession( )
 {
+    delete m_discoveryService;
     delete m_navigationService;
     delete m_objectService;
     delete m_repositoryService;
@@ -99,9 +155,9 @@ string WSSession::getWsdl( string url, libcmis::HttpResponsePtr response )
 {
     string buf;
     if ( response )
-        buf = response->getStream( )->str( );
+        buf = response->getBody( );
     else
-        buf = httpGetRequest( url )->getStream( )->str( );
+        buf = httpGetRequest( url )->getBody( );
 
     // Do we have a wsdl file?
     bool isWsdl = false;
@@ -134,7 +190,7 @@ string WSSession::getWsdl( string url, libcmis::HttpResponsePtr response )
             url += "&";
         url += "wsdl";
 
-        buf = httpGetRequest( url )->getStream( )->str( );
+        buf = httpGetRequest( url )->getBody( );
     }
 
     return buf;
@@ -156,14 +212,14 @@ vector< SoapResponsePtr > WSSession::soapRequest( string& url, SoapRequest& requ
             string responseType = it->second;
             if ( string::npos != responseType.find( "multipart/related" ) )
             {
-                RelatedMultipart answer( response->getStream( )->str( ), responseType );
+                RelatedMultipart answer( response->getBody( ), responseType );
 
                 responses = getResponseFactory( ).parseResponse( answer );
             }
             else if ( string::npos != responseType.find( "text/xml" ) )
             {
                 // Parse the envelope
-                string xml = response->getStream( )->str( );
+                string xml = response->getBody( );
                 responses = getResponseFactory( ).parseResponse( xml );
             }
         }
@@ -200,36 +256,29 @@ void WSSession::parseWsdl( const string& buf )
         // Get all the services soap URLs
         m_servicesUrls.clear( );
 
-        xmlXPathContextPtr xpathCtx = xmlXPathNewContext( doc.get() );
-        libcmis::registerCmisWSNamespaces( xpathCtx );
+        libcmis::XPathContext xpathCtx( doc.get( ), NULL );
+        xmlXPathObjectPtr xpathObj = xpathCtx.eval( "//wsdl:service" );
 
-        if ( NULL != xpathCtx )
+        if ( xpathObj != NULL )
         {
-            string serviceXPath( "//wsdl:service" );
-            xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression( BAD_CAST( serviceXPath.c_str() ), xpathCtx );
+            int nbServices = 0;
+            if ( xpathObj->nodesetval )
+                nbServices = xpathObj->nodesetval->nodeNr;
 
-            if ( xpathObj != NULL )
+            for ( int i = 0; i < nbServices; i++ )
             {
-                int nbServices = 0;
-                if ( xpathObj->nodesetval )
-                    nbServices = xpathObj->nodesetval->nodeNr;
-
-                for ( int i = 0; i < nbServices; i++ )
-                {
-                    // What service do we have here?
-                    xmlNodePtr node = xpathObj->nodesetval->nodeTab[i];
-                    string name = libcmis::getXmlNodeAttributeValue( node, "name" );
-
-                    // Gimme you soap:address location attribute
-                    string locationXPath = serviceXPath + "[@name='" + name + "']/wsdl:port/soap:address/attribute::location";
-                    string location = libcmis::getXPathValue( xpathCtx, locationXPath );
-
-                    m_servicesUrls[name] = location;
-                }
+                // What service do we have here?
+                xmlNodePtr node = xpathObj->nodesetval->nodeTab[i];
+                string name = libcmis::getXmlNodeAttributeValue( node, "name" );
+
+                // Gimme you soap:address location attribute
+                libcmis::XPathContext serviceCtx( doc.get( ), node );
+                string location = serviceCtx.getValue( "wsdl:port/soap:address/attribute::location" );
+
+                m_servicesUrls[name] = location;
             }
-            xmlXPathFreeObject( xpathObj );
         }
-        xmlXPathFreeContext( xpathCtx );
+        xmlXPathFreeObject( xpathObj );
     }
     else
         throw libcmis::Exception( "Failed to parse service document" );
@@ -297,6 +346,10 @@ map< string, SoapResponseCreator > WSSession::getResponseMapping( )
     mapping[ "{" + string( NS_CMISM_URL ) + "}getContentStreamResponse" ] = &GetContentStreamResponse::create;
     mapping[ "{" + string( NS_CMISM_URL ) + "}getObjectParentsResponse" ] = &GetObjectParentsResponse::create;
     mapping[ "{" + string( NS_CMISM_URL ) + "}getChildrenResponse" ] = &GetChildrenResponse::create;
+    mapping[ "{" + string( NS_CMISM_URL ) + "}queryResponse" ] = &QueryResponse::create;
+    mapping[ "{" + string( NS_CMISM_URL ) + "}getContentChangesResponse" ] = &GetContentChangesResponse::create;
+    mapping[ "{" + string( NS_CMISM_URL ) + "}getDescendantsResponse" ] = &GetDescendantsResponse::create;
+    mapping[ "{" + string( NS_CMISM_URL ) + "}getFolderTreeResponse" ] = &GetDescendantsResponse::create;
     mapping[ "{" + string( NS_CMISM_URL ) + "}createFolderResponse" ] = &CreateFolderResponse::create;
     // Use the same response object than folders as it contains the same elements
     mapping[ "{" + string( NS_CMISM_URL ) + "}createDocumentResponse" ] = &CreateFolderResponse::create;
@@ -356,6 +409,13 @@ VersioningService& WSSession::getVersioningService( )
     return *m_versioningService;
 }
 
+DiscoveryService& WSSession::getDiscoveryService( )
+{
+    if ( m_discoveryService == NULL )
+        m_discoveryService = new DiscoveryService( this );
+    return *m_discoveryService;
+}
+
 libcmis::RepositoryPtr WSSession::getRepository( )
 {
     // Check if we already have the repository
@@ -395,22 +455,58 @@ bool WSSession::setRepository( string repositoryId )
     return success;
 }
 
-libcmis::ObjectPtr WSSession::getObject( string id )
+libcmis::ObjectPtr WSSession::getObject( string id, const libcmis::OperationContext& context )
 {
-    return getObjectService( ).getObject( getRepositoryId( ), id );
+    libcmis::TraceScope traceScope( "Session::getObject", this );
+
+    libcmis::ObjectPtr cached = getCachedObject( id, context );
+    if ( cached )
+        return cached;
+
+    libcmis::ObjectPtr object = getObjectService( ).getObject( getRepositoryId( ), id, context );
+    cacheObject( object, context );
+    return object;
 }
 
-libcmis::ObjectPtr WSSession::getObjectByPath( string path )
+libcmis::ObjectPtr WSSession::getObjectByPath( string path, const libcmis::OperationContext& context )
 {
-    return getObjectService( ).getObjectByPath( getRepositoryId( ), path );
+    libcmis::TraceScope traceScope( "Session::getObjectByPath", this );
+
+    return getObjectService( ).getObjectByPath( getRepositoryId( ), path, context );
 }
 
 libcmis::ObjectTypePtr WSSession::getType( string id )
 {
-    return getRepositoryService( ).getTypeDefinition( m_repositoryId, id );
+    libcmis::TraceScope traceScope( "Session::getType", this );
+
+    libcmis::ObjectTypePtr type = getCachedType( id );
+    if ( !type )
+    {
+        type = getRepositoryService( ).getTypeDefinition( m_repositoryId, id );
+        cacheType( id, type );
+    }
+    return type;
 }
 
 vector< libcmis::ObjectTypePtr > WSSession::getBaseTypes( )
 {
+    libcmis::TraceScope traceScope( "Session::getBaseTypes", this );
+
     return getRepositoryService().getTypeChildren( m_repositoryId, "" );
 }
+
+libcmis::ObjectIteratorPtr WSSession::query( string statement, bool searchAllVersions,
+        long maxItems, const libcmis::OperationContext& context )
+{
+    libcmis::TraceScope traceScope( "Session::query", this );
+
+    return libcmis::ObjectIteratorPtr( new WSQueryIterator( this, statement, searchAllVersions,
+                                                            maxItems, context ) );
+}
+
+libcmis::ContentChanges WSSession::getContentChanges( string changeLogToken, long maxItems )
+{
+    libcmis::TraceScope traceScope( "Session::getContentChanges", this );
+
+    return getDiscoveryService( ).getContentChanges( getRepositoryId( ), changeLogToken, maxItems );
+}
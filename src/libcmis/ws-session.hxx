@@ -32,6 +32,7 @@
 #include <string>
 
 #include "base-session.hxx"
+#include "ws-discoveryservice.hxx"
 #include "ws-navigationservice.hxx"
 #include "ws-objectservice.hxx"
 #include "ws-repositoryservice.hxx"
@@ -42,6 +43,7 @@ class WSSession : public BaseSession, public SoapSession
 {
     private:
         std::map< std::string, std::string > m_servicesUrls;
+        DiscoveryService*  m_discoveryService;
         NavigationService* m_navigationService;
         ObjectService*     m_objectService;
         RepositoryService* m_repositoryService;
@@ -90,6 +92,8 @@ class WSSession : public BaseSession, public SoapSession
 
         VersioningService& getVersioningService( );
 
+        DiscoveryService& getDiscoveryService( );
+
 
         // Override session methods
 
@@ -97,14 +101,22 @@ class WSSession : public BaseSession, public SoapSession
 
         virtual bool setRepository( std::string repositoryId );
 
-        virtual libcmis::ObjectPtr getObject( std::string id );
+        virtual libcmis::ObjectPtr getObject( std::string id,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
-        virtual libcmis::ObjectPtr getObjectByPath( std::string path );
+        virtual libcmis::ObjectPtr getObjectByPath( std::string path,
+                const libcmis::OperationContext& context = libcmis::OperationContext( ) );
 
         virtual libcmis::ObjectTypePtr getType( std::string id );
 
         virtual std::vector< libcmis::ObjectTypePtr > getBaseTypes( );
 
+        virtual libcmis::ContentChanges getContentChanges( std::string changeLogToken = std::string( ),
+                                                           long maxItems = 0 );
+
+        virtual libcmis::ObjectIteratorPtr query( std::string statement, bool searchAllVersions = false,
+                long maxItems = 0, const libcmis::OperationContext& context = libcmis::OperationContext( ) );
+
     private:
 
         // Default constructor shouldn't be called
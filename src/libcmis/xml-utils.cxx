@@ -28,6 +28,7 @@
 
 #include <libcmis/xml-utils.hxx>
 
+#include <algorithm>
 #include <errno.h>
 #include <memory>
 #include <sstream>
@@ -43,29 +44,30 @@
 #endif
 #include <curl/curl.h>
 
+#include "base64.hxx"
+#include "memory-stream.hxx"
 
 using namespace std;
 
 namespace
 {
-    static const char chars64[]=
-          "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    // Size of the chunks decoded or encoded at once by the bulk codec
+    const size_t BASE64_CHUNK_SIZE = 3 * 4 * 1024;
 
-    bool lcl_getBufValue( char encoded, int* value )
+    /** Stream reading a response body in place, keeping it alive.
+      */
+    class BodyStream : public libcmis::MemoryStream
     {
-        bool found = false;
-        const char *i = chars64;
-        while ( !found && *i )
-        {
-            if ( *i == encoded )
+        private:
+            boost::shared_ptr< string > m_body;
+
+        public:
+            explicit BodyStream( boost::shared_ptr< string > body ) :
+                libcmis::MemoryStream( body->data( ), body->size( ) ),
+                m_body( body )
             {
-                found = true;
-                *value = ( i - chars64 );
             }
-            ++i;
-        }
-        return found;
-    }
+    };
 }
 
 namespace libcmis
@@ -74,6 +76,10 @@ namespace libcmis
         m_writer( NULL ),
         m_stream( stream ),
         m_outStream( NULL ),
+        m_buffer( NULL ),
+        m_writeFunction( NULL ),
+        m_writeData( NULL ),
+        m_failed( false ),
         m_encoding( ),
         m_decode( false ),
         m_pendingValue( 0 ),
@@ -86,6 +92,26 @@ namespace libcmis
         m_writer( NULL ),
         m_stream( NULL ),
         m_outStream( stream ),
+        m_buffer( NULL ),
+        m_writeFunction( NULL ),
+        m_writeData( NULL ),
+        m_failed( false ),
+        m_encoding( ),
+        m_decode( false ),
+        m_pendingValue( 0 ),
+        m_pendingRank( 0 ),
+        m_missingBytes( 0 )
+    {
+    }
+
+    EncodedData::EncodedData( string* buffer ) :
+        m_writer( NULL ),
+        m_stream( NULL ),
+        m_outStream( NULL ),
+        m_buffer( buffer ),
+        m_writeFunction( NULL ),
+        m_writeData( NULL ),
+        m_failed( false ),
         m_encoding( ),
         m_decode( false ),
         m_pendingValue( 0 ),
@@ -98,6 +124,26 @@ namespace libcmis
         m_writer( writer ),
         m_stream( NULL ),
         m_outStream( NULL ),
+        m_buffer( NULL ),
+        m_writeFunction( NULL ),
+        m_writeData( NULL ),
+        m_failed( false ),
+        m_encoding( ),
+        m_decode( false ),
+        m_pendingValue( 0 ),
+        m_pendingRank( 0 ),
+        m_missingBytes( 0 )
+    {
+    }
+
+    EncodedData::EncodedData( WriteFunction writeFunction, void* userData ) :
+        m_writer( NULL ),
+        m_stream( NULL ),
+        m_outStream( NULL ),
+        m_buffer( NULL ),
+        m_writeFunction( writeFunction ),
+        m_writeData( userData ),
+        m_failed( false ),
         m_encoding( ),
         m_decode( false ),
         m_pendingValue( 0 ),
@@ -110,6 +156,10 @@ namespace libcmis
         m_writer( copy.m_writer ),
         m_stream( copy.m_stream ),
         m_outStream( copy.m_outStream ),
+        m_buffer( copy.m_buffer ),
+        m_writeFunction( copy.m_writeFunction ),
+        m_writeData( copy.m_writeData ),
+        m_failed( copy.m_failed ),
         m_encoding( copy.m_encoding ),
         m_decode( copy.m_decode ),
         m_pendingValue( copy.m_pendingValue ),
@@ -125,6 +175,10 @@ namespace libcmis
             m_writer = copy.m_writer;
             m_stream = copy.m_stream;
             m_outStream = copy.m_outStream;
+            m_buffer = copy.m_buffer;
+            m_writeFunction = copy.m_writeFunction;
+            m_writeData = copy.m_writeData;
+            m_failed = copy.m_failed;
             m_encoding = copy.m_encoding;
             m_decode = copy.m_decode;
             m_pendingValue = copy.m_pendingValue;
@@ -139,9 +193,16 @@ namespace libcmis
         if ( m_writer )
             xmlTextWriterWriteRawLen( m_writer, ( xmlChar* )buf, size * nmemb );
         else if ( m_stream )
-            fwrite( buf, size, nmemb, m_stream );
+            m_failed |= fwrite( buf, size, nmemb, m_stream ) < nmemb;
         else if ( m_outStream )
+        {
             m_outStream->write( ( const char* )buf, size * nmemb );
+            m_failed |= m_outStream->fail( );
+        }
+        else if ( m_buffer )
+            m_buffer->append( ( const char* )buf, size * nmemb );
+        else if ( m_writeFunction )
+            m_failed |= m_writeFunction( buf, size, nmemb, m_writeData ) < nmemb;
     }
 
     void EncodedData::decode( void* buf, size_t size, size_t nmemb )
@@ -194,10 +255,10 @@ namespace libcmis
             {
                 // Missing bytes should be zeroed: no need to do it
                 char encoded[4];
-                encoded[0] = chars64[ ( m_pendingValue & 0xFC0000 ) >> 18 ];
-                encoded[1] = chars64[ ( m_pendingValue & 0x03F000 ) >> 12 ];
-                encoded[2] = chars64[ ( m_pendingValue & 0x000FC0 ) >> 6  ];
-                encoded[3] = chars64[ ( m_pendingValue & 0x00003F )       ];
+                encoded[0] = libcmis::base64::encodeTable[ ( m_pendingValue & 0xFC0000 ) >> 18 ];
+                encoded[1] = libcmis::base64::encodeTable[ ( m_pendingValue & 0x03F000 ) >> 12 ];
+                encoded[2] = libcmis::base64::encodeTable[ ( m_pendingValue & 0x000FC0 ) >> 6  ];
+                encoded[3] = libcmis::base64::encodeTable[ ( m_pendingValue & 0x00003F )       ];
 
                 // Output the padding
                 int nEquals = 3 - m_pendingRank;
@@ -221,8 +282,27 @@ namespace libcmis
         size_t i = 0;
         while ( i < len )
         {
-            int value = 0;
-            if ( lcl_getBufValue( buf[i], &value ) )
+            // Between blocks, decode as much as possible at once: only the
+            // characters out of the alphabet need the slow path below
+            if ( byteRank == 0 && missingBytes == 0 )
+            {
+                unsigned char decoded[BASE64_CHUNK_SIZE / 4 * 3];
+                size_t consumed = 0;
+                do
+                {
+                    size_t chunkSize = min( len - i, BASE64_CHUNK_SIZE );
+                    consumed = libcmis::base64::decodeBlocks( buf + i, chunkSize, decoded );
+                    if ( consumed > 0 )
+                        write( decoded, 1, consumed / 4 * 3 );
+                    i += consumed;
+                } while ( consumed == BASE64_CHUNK_SIZE );
+
+                if ( i >= len )
+                    break;
+            }
+
+            unsigned char value = libcmis::base64::decodeTable[ static_cast< unsigned char >( buf[i] ) ];
+            if ( value != 0xFF )
             {
                 blockValue += value << ( ( 3 - byteRank ) * 6 );
                 ++byteRank;
@@ -262,22 +342,38 @@ namespace libcmis
     {
         unsigned long blockValue = m_pendingValue;
         int byteRank = m_pendingRank;
+        const unsigned char* bytes = reinterpret_cast< const unsigned char* >( buf );
 
         size_t i = 0;
         while ( i < len )
         {
-            // Cast the char to an unsigned char or we'll shift negative values
-            blockValue += static_cast< unsigned char >( buf[i] ) << ( 2 - byteRank ) * 8;
+            // Between blocks, encode all the complete ones at once
+            if ( byteRank == 0 && len - i >= 3 )
+            {
+                char encoded[BASE64_CHUNK_SIZE / 3 * 4];
+                while ( len - i >= 3 )
+                {
+                    size_t chunkSize = min( len - i, BASE64_CHUNK_SIZE );
+                    size_t consumed = libcmis::base64::encodeBlocks( bytes + i, chunkSize, encoded );
+                    write( encoded, 1, consumed / 3 * 4 );
+                    i += consumed;
+                }
+
+                if ( i >= len )
+                    break;
+            }
+
+            blockValue += bytes[i] << ( 2 - byteRank ) * 8;
             ++byteRank;
 
             // Reached the end of a block, encode it
             if ( byteRank >= 3 )
             {
                 char encoded[4];
-                encoded[0] = chars64[ ( blockValue & 0xFC0000 ) >> 18 ];
-                encoded[1] = chars64[ ( blockValue & 0x03F000 ) >> 12 ];
-                encoded[2] = chars64[ ( blockValue & 0x000FC0 ) >> 6  ];
-                encoded[3] = chars64[ ( blockValue & 0x00003F )       ];
+                encoded[0] = libcmis::base64::encodeTable[ ( blockValue & 0xFC0000 ) >> 18 ];
+                encoded[1] = libcmis::base64::encodeTable[ ( blockValue & 0x03F000 ) >> 12 ];
+                encoded[2] = libcmis::base64::encodeTable[ ( blockValue & 0x000FC0 ) >> 6  ];
+                encoded[3] = libcmis::base64::encodeTable[ ( blockValue & 0x00003F )       ];
 
                 write( encoded, 1, 4 );
 
@@ -294,11 +390,53 @@ namespace libcmis
 
     HttpResponse::HttpResponse( ) :
         m_headers( ),
+        m_body( new string( ) ),
+        m_bodyBuffered( true ),
         m_stream( ),
         m_data( )
     {
-        m_stream.reset( new stringstream( ) );
-        m_data.reset( new EncodedData( m_stream.get( ) ) );
+        m_data.reset( new EncodedData( m_body.get( ) ) );
+    }
+
+    HttpResponse::HttpResponse( boost::shared_ptr< EncodedData > data ) :
+        m_headers( ),
+        m_body( new string( ) ),
+        m_bodyBuffered( false ),
+        m_stream( ),
+        m_data( data )
+    {
+    }
+
+    string HttpResponse::getHeader( const string& name ) const
+    {
+        for ( map< string, string >::const_iterator it = m_headers.begin( );
+                it != m_headers.end( ); ++it )
+        {
+            if ( boost::iequals( it->first, name ) )
+                return it->second;
+        }
+        return string( );
+    }
+
+    boost::shared_ptr< istream > HttpResponse::getBodyStream( )
+    {
+        return boost::shared_ptr< istream >( new BodyStream( m_body ) );
+    }
+
+    boost::shared_ptr< stringstream > HttpResponse::getStream( )
+    {
+        if ( !m_stream )
+            m_stream.reset( new stringstream( *m_body ) );
+        return m_stream;
+    }
+
+    void HttpResponse::reserveBody( size_t size )
+    {
+        // Don't let a bogus size allocate a lot of memory upfront: past
+        // that, the buffer grows as the data arrives.
+        static const size_t MAX_RESERVED_SIZE = 16 * 1024 * 1024;
+        if ( m_bodyBuffered )
+            m_body->reserve( min( size, MAX_RESERVED_SIZE ) );
     }
 
     void registerNamespaces( xmlXPathContextPtr xpathCtx )
@@ -0,0 +1,152 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+
+#include "xpath-context.hxx"
+
+#include <unordered_map>
+#include <vector>
+
+#include <libcmis/exception.hxx>
+#include <libcmis/xml-utils.hxx>
+
+using namespace std;
+
+namespace
+{
+    /** Contexts and compiled expressions of a thread: libxml2 doesn't
+        allow sharing them between threads.
+      */
+    class ThreadCache
+    {
+        private:
+            vector< xmlXPathContextPtr > m_contexts;
+            unordered_map< string, xmlXPathCompExprPtr > m_expressions;
+
+        public:
+            ThreadCache( ) : m_contexts( ), m_expressions( ) { }
+
+            ~ThreadCache( )
+            {
+                for ( vector< xmlXPathContextPtr >::iterator it = m_contexts.begin( );
+                      it != m_contexts.end( ); ++it )
+                    xmlXPathFreeContext( *it );
+
+                for ( unordered_map< string, xmlXPathCompExprPtr >::iterator it = m_expressions.begin( );
+                      it != m_expressions.end( ); ++it )
+                    xmlXPathFreeCompExpr( it->second );
+            }
+
+            ThreadCache( const ThreadCache& copy ) = delete;
+            ThreadCache& operator=( const ThreadCache& copy ) = delete;
+
+            xmlXPathContextPtr takeContext( )
+            {
+                xmlXPathContextPtr ctx = NULL;
+                if ( m_contexts.empty( ) )
+                {
+                    ctx = xmlXPathNewContext( NULL );
+                    if ( NULL == ctx )
+                        throw libcmis::Exception( "Failed to create XPath context" );
+                    libcmis::registerNamespaces( ctx );
+                    libcmis::registerCmisWSNamespaces( ctx );
+                }
+                else
+                {
+                    ctx = m_contexts.back( );
+                    m_contexts.pop_back( );
+                }
+                return ctx;
+            }
+
+            void giveContext( xmlXPathContextPtr ctx )
+            {
+                m_contexts.push_back( ctx );
+            }
+
+            xmlXPathCompExprPtr getExpression( const string& expression )
+            {
+                unordered_map< string, xmlXPathCompExprPtr >::iterator it = m_expressions.find( expression );
+                if ( it != m_expressions.end( ) )
+                    return it->second;
+
+                xmlXPathCompExprPtr compiled = xmlXPathCompile( BAD_CAST( expression.c_str( ) ) );
+                if ( NULL == compiled )
+                    throw libcmis::Exception( "Invalid XPath expression: " + expression );
+                m_expressions[ expression ] = compiled;
+                return compiled;
+            }
+    };
+
+    ThreadCache& lcl_getThreadCache( )
+    {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+}
+
+namespace libcmis
+{
+    XPathContext::XPathContext( xmlDocPtr doc, xmlNodePtr node ) :
+        m_ctx( lcl_getThreadCache( ).takeContext( ) )
+    {
+        // Reset what a previous evaluation may have changed
+        m_ctx->doc = doc;
+        m_ctx->node = node;
+        m_ctx->contextSize = -1;
+        m_ctx->proximityPosition = -1;
+    }
+
+    XPathContext::~XPathContext( )
+    {
+        m_ctx->doc = NULL;
+        m_ctx->node = NULL;
+        lcl_getThreadCache( ).giveContext( m_ctx );
+    }
+
+    xmlXPathObjectPtr XPathContext::eval( const string& expression )
+    {
+        return xmlXPathCompiledEval( lcl_getThreadCache( ).getExpression( expression ), m_ctx );
+    }
+
+    string XPathContext::getValue( const string& expression )
+    {
+        string value;
+        xmlXPathObjectPtr xpathObj = eval( expression );
+        if ( xpathObj && xpathObj->nodesetval && xpathObj->nodesetval->nodeNr > 0 )
+        {
+            xmlChar* content = xmlNodeGetContent( xpathObj->nodesetval->nodeTab[0] );
+            if ( content )
+            {
+                value = string( ( char* )content );
+                xmlFree( content );
+            }
+        }
+        xmlXPathFreeObject( xpathObj );
+        return value;
+    }
+}
@@ -0,0 +1,76 @@
+/* libcmis
+ * Version: MPL 1.1 / GPLv2+ / LGPLv2+
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License or as specified alternatively below. You may obtain a copy of
+ * the License at http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * Major Contributor(s):
+ * Copyright (C) 2026 The libcmis contributors
+ *
+ *
+ * All Rights Reserved.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms of
+ * either the GNU General Public License Version 2 or later (the "GPLv2+"), or
+ * the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+ * in which case the provisions of the GPLv2+ or the LGPLv2+ are applicable
+ * instead of those above.
+ */
+#ifndef _XPATH_CONTEXT_HXX_
+#define _XPATH_CONTEXT_HXX_
+
+#include <string>
+
+#include <libxml/tree.h>
+#include <libxml/xpath.h>
+
+namespace libcmis
+{
+    /** XPath context for the fixed queries of the library.
+
+        The underlying xmlXPathContext is taken from a per-thread pool
+        and already knows all the namespaces used by libcmis. It goes
+        back to the pool when this object is destroyed. The expressions
+        are compiled the first time a thread evaluates them and then
+        kept for that thread, so they need to be constant strings: the
+        dynamic queries still need xmlXPathEvalExpression.
+      */
+    class XPathContext
+    {
+        private:
+            xmlXPathContextPtr m_ctx;
+
+        public:
+            /** \param doc the document to query
+                \param node the node relative queries start from
+              */
+            XPathContext( xmlDocPtr doc, xmlNodePtr node );
+            ~XPathContext( );
+
+            XPathContext( const XPathContext& copy ) = delete;
+            XPathContext& operator=( const XPathContext& copy ) = delete;
+
+            xmlXPathContextPtr get( ) { return m_ctx; }
+
+            /** Evaluate a constant expression. The result needs to be
+                freed with xmlXPathFreeObject.
+              */
+            xmlXPathObjectPtr eval( const std::string& expression );
+
+            /** Get the content of the first node matching a constant
+                expression, or an empty string.
+              */
+            std::string getValue( const std::string& expression );
+    };
+}
+
+#endif